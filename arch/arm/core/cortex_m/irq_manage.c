@@ -279,3 +279,25 @@ ISR_DIRECT_DECLARE(z_arm_irq_direct_dynamic_dispatch_no_reschedule)
 #endif /* CONFIG_DYNAMIC_DIRECT_INTERRUPTS */
 
 #endif /* CONFIG_DYNAMIC_INTERRUPTS */
+
+#ifdef CONFIG_ARCH_HAS_PERF_STACK_TRACE
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	const struct __basic_sf *frame;
+
+	/* Threads run on the process stack, where the exception frame of a
+	 * thread preempted by a non-nested interrupt is stacked. The other
+	 * frames cannot be walked, as the Thumb frame pointer does not point
+	 * to the saved frame pointer and return address, so only the
+	 * program counter is returned.
+	 */
+	if ((size == 0U) || ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) == 0U)) {
+		return 0;
+	}
+
+	frame = (const struct __basic_sf *)__get_PSP();
+	buf[0] = frame->pc;
+
+	return 1;
+}
+#endif /* CONFIG_ARCH_HAS_PERF_STACK_TRACE */
@@ -17,6 +17,7 @@
 #include <zephyr/irq.h>
 #include <zephyr/pm/pm.h>
 #include <cmsis_core.h>
+#include <ksched.h>
 
 /**
  *
@@ -74,7 +75,10 @@ void _isr_wrapper(void)
 	irq_number -= 16;
 
 	struct _isr_table_entry *entry = &_sw_isr_table[irq_number];
+
+	z_sched_usage_isr_enter();
 	(entry->isr)(entry->arg);
+	z_sched_usage_isr_exit(irq_number);
 
 #if defined(CONFIG_ARM_CUSTOM_INTERRUPT_CONTROLLER)
 	z_soc_irq_eoi(irq_number);
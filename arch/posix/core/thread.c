@@ -57,6 +57,10 @@ void arch_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 void posix_arch_thread_entry(void *pa_thread_status)
 {
 	posix_thread_status_t *ptr = pa_thread_status;
+
+#if defined(CONFIG_ARCH_HAS_PERF_STACK_TRACE)
+	ptr->entry_frame = __builtin_frame_address(0);
+#endif
 	posix_irq_full_unlock();
 	z_thread_entry(ptr->entry_point, ptr->arg1, ptr->arg2, ptr->arg3);
 }
@@ -27,6 +27,11 @@ typedef struct {
 	int aborted;
 #endif
 
+#if defined(CONFIG_ARCH_HAS_PERF_STACK_TRACE)
+	/* Frame of the thread entry, above which the frames are the host's */
+	void *entry_frame;
+#endif
+
 	/*
 	 * Note: If more elements are added to this structure, remember to
 	 * update ARCH_POSIX_RECOMMENDED_STACK_SIZE in the configuration.
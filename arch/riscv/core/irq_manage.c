@@ -54,3 +54,52 @@ int arch_irq_connect_dynamic(unsigned int irq, unsigned int priority,
 	return irq;
 }
 #endif /* CONFIG_DYNAMIC_INTERRUPTS */
+
+#ifdef CONFIG_ARCH_HAS_PERF_STACK_TRACE
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	struct stack_frame {
+		uintptr_t fp;
+		uintptr_t ra;
+	} *frame;
+	const z_arch_esf_t *esf;
+	uintptr_t fp;
+	size_t n = 0;
+
+	/* The registers of a thread preempted by a non-nested interrupt
+	 * are saved on its stack, and its stack pointer at the base of the
+	 * interrupt stack, see isr.S.
+	 */
+	if ((size == 0U) || (_current_cpu->nested != 1U)) {
+		return 0;
+	}
+
+	esf = *(const z_arch_esf_t **)((uintptr_t)_current_cpu->irq_stack - 16);
+
+	buf[n++] = esf->mepc;
+	fp = esf->s0;
+
+#ifdef CONFIG_THREAD_STACK_INFO
+	/* Only follow frame pointers within the stack of the thread. The
+	 * frame pointer points past the return address and the previous
+	 * frame pointer.
+	 */
+	uintptr_t stack_start = _current->stack_info.start;
+	uintptr_t stack_end = stack_start + _current->stack_info.size;
+
+	while ((n < size) && (fp % sizeof(uintptr_t) == 0U) &&
+	       (fp >= stack_start + sizeof(*frame)) && (fp <= stack_end)) {
+		frame = (struct stack_frame *)fp - 1;
+
+		if (frame->ra == 0U) {
+			break;
+		}
+
+		buf[n++] = frame->ra;
+		fp = frame->fp;
+	}
+#endif /* CONFIG_THREAD_STACK_INFO */
+
+	return n;
+}
+#endif /* CONFIG_ARCH_HAS_PERF_STACK_TRACE */
@@ -191,3 +191,41 @@ bool arch_irq_is_used(unsigned int irq)
 {
 	return atomic_test_bit(irq_reserved, irq);
 }
+
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	struct stack_frame {
+		uintptr_t next;
+		uintptr_t ret_addr;
+	} *frame;
+	size_t n = 0;
+
+	/* The registers of a thread preempted by a non-nested interrupt
+	 * are saved in the thread, see irq_enter_unnested.
+	 */
+	if ((size == 0U) || (arch_curr_cpu()->nested != 1U)) {
+		return 0;
+	}
+
+	buf[n++] = _current->callee_saved.rip;
+	frame = (struct stack_frame *)_current->callee_saved.rbp;
+
+#ifdef CONFIG_THREAD_STACK_INFO
+	/* Only follow frame pointers within the stack of the thread. */
+	uintptr_t stack_start = _current->stack_info.start;
+	uintptr_t stack_end = stack_start + _current->stack_info.size;
+
+	while ((n < size) && ((uintptr_t)frame % sizeof(uintptr_t) == 0U) &&
+	       ((uintptr_t)frame >= stack_start) &&
+	       ((uintptr_t)frame + sizeof(*frame) <= stack_end)) {
+		if (frame->ret_addr == 0U) {
+			break;
+		}
+
+		buf[n++] = frame->ret_addr;
+		frame = (struct stack_frame *)frame->next;
+	}
+#endif /* CONFIG_THREAD_STACK_INFO */
+
+	return n;
+}
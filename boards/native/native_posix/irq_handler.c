@@ -31,6 +31,7 @@ static int currently_running_irq = -1;
 static inline void vector_to_irq(int irq_nbr, int *may_swap)
 {
 	sys_trace_isr_enter();
+	z_sched_usage_isr_enter();
 
 	if (irq_vector_table[irq_nbr].func == NULL) { /* LCOV_EXCL_BR_LINE */
 		/* LCOV_EXCL_START */
@@ -52,6 +53,7 @@ static inline void vector_to_irq(int irq_nbr, int *may_swap)
 		}
 	}
 
+	z_sched_usage_isr_exit(irq_nbr);
 	sys_trace_isr_exit();
 }
 
@@ -29,9 +29,15 @@ static struct _isr_list irq_vector_table[N_IRQS] = { { 0 } };
 
 static int currently_running_irq = -1;
 
+/* Frame of the outermost IRQ handler call, whose return address is in the
+ * interrupted code
+ */
+static uintptr_t *interrupted_frame;
+
 static inline void vector_to_irq(int irq_nbr, int *may_swap)
 {
 	sys_trace_isr_enter();
+	z_sched_usage_isr_enter();
 
 	if (irq_vector_table[irq_nbr].func == NULL) { /* LCOV_EXCL_BR_LINE */
 		/* LCOV_EXCL_START */
@@ -53,6 +59,7 @@ static inline void vector_to_irq(int irq_nbr, int *may_swap)
 		}
 	}
 
+	z_sched_usage_isr_exit(irq_nbr);
 	sys_trace_isr_exit();
 }
 
@@ -86,6 +93,7 @@ void posix_irq_handler(void)
 
 	if (_kernel.cpus[0].nested == 0) {
 		may_swap = 0;
+		interrupted_frame = __builtin_frame_address(0);
 	}
 
 	_kernel.cpus[0].nested++;
@@ -312,3 +320,41 @@ void posix_irq_offload(void (*routine)(const void *), const void *parameter)
 	posix_irq_disable(OFFLOAD_SW_IRQ);
 }
 #endif /* CONFIG_IRQ_OFFLOAD */
+
+/**
+ * @brief Get the stack trace of the code interrupted by the current IRQ
+ *
+ * Interrupts are only delivered when the SW calls into the HW models, so the
+ * interrupted code is the one which unlocked interrupts, busy waited or idled.
+ * The frames are followed up to the thread entry.
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	posix_thread_status_t *thread_status;
+	uintptr_t *entry_frame = NULL;
+	uintptr_t *fp = interrupted_frame;
+	size_t n = 0;
+
+	if ((_kernel.cpus[0].nested != 1) || (size == 0)) {
+		return 0;
+	}
+
+	thread_status = _current->callee_saved.thread_status;
+	if (thread_status != NULL) {
+		entry_frame = thread_status->entry_frame;
+	}
+
+	buf[n++] = fp[1];
+	fp = (uintptr_t *)fp[0];
+
+	/* Only follow frames going up the stack of the thread */
+	while ((n < size) && (fp > interrupted_frame) && (fp < entry_frame)) {
+		buf[n++] = fp[1];
+		if ((uintptr_t *)fp[0] <= fp) {
+			break;
+		}
+		fp = (uintptr_t *)fp[0];
+	}
+
+	return n;
+}
@@ -46,6 +46,7 @@ static inline void vector_to_irq(int irq_nbr, int *may_swap)
 			  hw_irq_ctrl_get_name(CONFIG_NATIVE_SIMULATOR_MCU_N, irq_nbr));
 
 	sys_trace_isr_enter();
+	z_sched_usage_isr_enter();
 
 	if (irq_vector_table[irq_nbr].func == NULL) { /* LCOV_EXCL_BR_LINE */
 		/* LCOV_EXCL_START */
@@ -67,6 +68,7 @@ static inline void vector_to_irq(int irq_nbr, int *may_swap)
 		}
 	}
 
+	z_sched_usage_isr_exit(irq_nbr);
 	sys_trace_isr_exit();
 
 	bs_trace_raw_time(7, "Irq %i (%s) ended\n", irq_nbr,
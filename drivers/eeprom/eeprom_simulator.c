@@ -162,13 +162,13 @@ static int eeprom_sim_write(const struct device *dev, off_t offset,
 
 	bool data_part_ignored = false;
 
-	if (eeprom_sim_thresholds.max_write_calls != 0) {
-		if (eeprom_sim_stats.eeprom_write_calls >
-			eeprom_sim_thresholds.max_write_calls) {
+	if (STATS_GET(eeprom_sim_thresholds, max_write_calls) != 0) {
+		if (STATS_GET(eeprom_sim_stats, eeprom_write_calls) >
+			STATS_GET(eeprom_sim_thresholds, max_write_calls)) {
 			goto end;
-		} else if (eeprom_sim_stats.eeprom_write_calls ==
-				eeprom_sim_thresholds.max_write_calls) {
-			if (eeprom_sim_thresholds.max_len == 0) {
+		} else if (STATS_GET(eeprom_sim_stats, eeprom_write_calls) ==
+				STATS_GET(eeprom_sim_thresholds, max_write_calls)) {
+			if (STATS_GET(eeprom_sim_thresholds, max_len) == 0) {
 				goto end;
 			}
 
@@ -176,8 +176,8 @@ static int eeprom_sim_write(const struct device *dev, off_t offset,
 		}
 	}
 
-	if ((data_part_ignored) && (len > eeprom_sim_thresholds.max_len)) {
-		len = eeprom_sim_thresholds.max_len;
+	if ((data_part_ignored) && (len > STATS_GET(eeprom_sim_thresholds, max_len))) {
+		len = STATS_GET(eeprom_sim_thresholds, max_len);
 	}
 
 	memcpy(EEPROM(offset), data, len);
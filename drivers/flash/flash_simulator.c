@@ -64,7 +64,9 @@
 #define ERASE_CYCLES_INC(U)						     \
 	do {								     \
 		if (U < STATS_PAGE_COUNT_THRESHOLD) {			     \
-			(*(&flash_sim_stats.erase_cycles_unit0 + (U)) += 1); \
+			Z_STATS_CPU_UPDATE(cpu__,			     \
+				(*(&Z_STATS_ENTRY(flash_sim_stats, cpu__,    \
+						  erase_cycles_unit0) + (U)) += 1)); \
 		}							     \
 	} while (false)
 
@@ -240,13 +242,13 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 #ifdef CONFIG_FLASH_SIMULATOR_STATS
 	bool data_part_ignored = false;
 
-	if (flash_sim_thresholds.max_write_calls != 0) {
-		if (flash_sim_stats.flash_write_calls >
-			flash_sim_thresholds.max_write_calls) {
+	if (STATS_GET(flash_sim_thresholds, max_write_calls) != 0) {
+		if (STATS_GET(flash_sim_stats, flash_write_calls) >
+			STATS_GET(flash_sim_thresholds, max_write_calls)) {
 			return 0;
-		} else if (flash_sim_stats.flash_write_calls ==
-				flash_sim_thresholds.max_write_calls) {
-			if (flash_sim_thresholds.max_len == 0) {
+		} else if (STATS_GET(flash_sim_stats, flash_write_calls) ==
+				STATS_GET(flash_sim_thresholds, max_write_calls)) {
+			if (STATS_GET(flash_sim_thresholds, max_len) == 0) {
 				return 0;
 			}
 
@@ -258,7 +260,7 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 	for (uint32_t i = 0; i < len; i++) {
 #ifdef CONFIG_FLASH_SIMULATOR_STATS
 		if (data_part_ignored) {
-			if (i >= flash_sim_thresholds.max_len) {
+			if (i >= STATS_GET(flash_sim_thresholds, max_len)) {
 				return 0;
 			}
 		}
@@ -312,9 +314,9 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INC(flash_sim_stats, flash_erase_calls);
 
 #ifdef CONFIG_FLASH_SIMULATOR_STATS
-	if ((flash_sim_thresholds.max_erase_calls != 0) &&
-	    (flash_sim_stats.flash_erase_calls >=
-		flash_sim_thresholds.max_erase_calls)){
+	if ((STATS_GET(flash_sim_thresholds, max_erase_calls) != 0) &&
+	    (STATS_GET(flash_sim_stats, flash_erase_calls) >=
+		STATS_GET(flash_sim_thresholds, max_erase_calls))){
 		return 0;
 	}
 #endif
@@ -85,6 +85,98 @@ int loopback_get_num_dropped_packets(void)
 
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+/* Packets held back by the emulated link. Every packet gets the same
+ * delay, so they become due in the order they were sent.
+ */
+struct loopback_delayed_pkt {
+	struct net_pkt *pkt;
+	uint32_t due;
+};
+
+static struct loopback_delayed_pkt loopback_delayed[CONFIG_NET_PKT_RX_COUNT];
+static uint16_t loopback_delayed_head;
+static uint16_t loopback_delayed_count;
+static uint32_t loopback_delay_ms;
+static struct k_spinlock loopback_delay_lock;
+
+static void loopback_delay_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(loopback_delay_work, loopback_delay_handler);
+
+int loopback_set_packet_delay(uint32_t delay_ms)
+{
+	loopback_delay_ms = delay_ms;
+	return 0;
+}
+
+static void loopback_delay_handler(struct k_work *work)
+{
+	struct loopback_delayed_pkt *entry;
+	struct net_pkt *pkt;
+	k_spinlock_key_t key;
+	int32_t left;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		key = k_spin_lock(&loopback_delay_lock);
+
+		if (loopback_delayed_count == 0U) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			return;
+		}
+
+		entry = &loopback_delayed[loopback_delayed_head];
+		left = (int32_t)(entry->due - k_uptime_get_32());
+		if (left > 0) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			k_work_reschedule(&loopback_delay_work, K_MSEC(left));
+			return;
+		}
+
+		pkt = entry->pkt;
+		loopback_delayed_head = (loopback_delayed_head + 1U) %
+					ARRAY_SIZE(loopback_delayed);
+		loopback_delayed_count--;
+
+		k_spin_unlock(&loopback_delay_lock, key);
+
+		if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+			LOG_ERR("Data receive failed.");
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
+static int loopback_delay_pkt(struct net_pkt *pkt)
+{
+	k_spinlock_key_t key;
+	uint16_t tail;
+
+	key = k_spin_lock(&loopback_delay_lock);
+
+	if (loopback_delayed_count == ARRAY_SIZE(loopback_delayed)) {
+		/* Link queue is full, drop like a congested link would */
+		k_spin_unlock(&loopback_delay_lock, key);
+		net_pkt_unref(pkt);
+		return 0;
+	}
+
+	tail = (loopback_delayed_head + loopback_delayed_count) %
+	       ARRAY_SIZE(loopback_delayed);
+	loopback_delayed[tail].pkt = pkt;
+	loopback_delayed[tail].due = k_uptime_get_32() + loopback_delay_ms;
+	loopback_delayed_count++;
+
+	k_spin_unlock(&loopback_delay_lock, key);
+
+	/* Does nothing if the work is already waiting for an earlier packet */
+	k_work_schedule(&loopback_delay_work, K_MSEC(loopback_delay_ms));
+
+	return 0;
+}
+#endif
+
 static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct net_pkt *cloned;
@@ -136,6 +228,13 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 				       NET_IPV4_HDR(pkt)->src);
 	}
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+	if (loopback_delay_ms > 0U) {
+		res = loopback_delay_pkt(cloned);
+		goto out;
+	}
+#endif
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
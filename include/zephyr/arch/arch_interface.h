@@ -1195,6 +1195,29 @@ uint32_t arch_timing_freq_get_mhz(void);
 
 #endif /* CONFIG_TIMING_FUNCTIONS */
 
+#ifdef CONFIG_ARCH_HAS_PERF_STACK_TRACE
+
+/**
+ * @brief Get the stack trace of the interrupted context.
+ *
+ * Called from an interrupt handler, typically a timer expiry function, to
+ * sample the context that the interrupt preempted. The first entry is the
+ * program counter of the interrupted context, followed by the return
+ * addresses found by walking its frame pointers, innermost first. Frame
+ * pointers must not be omitted for the trace to go beyond the first entry.
+ * Architectures whose frames cannot be walked, such as Cortex-M, only store
+ * the program counter.
+ *
+ * @param buf Buffer to store the stack trace.
+ * @param size Maximum number of entries to store.
+ *
+ * @return Number of entries stored, 0 if the interrupted context cannot be
+ *         sampled, for example in a nested interrupt.
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
+
+#endif /* CONFIG_ARCH_HAS_PERF_STACK_TRACE */
+
 #ifdef CONFIG_PCIE_MSI_MULTI_VECTOR
 
 struct msi_vector;
@@ -136,6 +136,22 @@ struct coredump_cmd_copy_arg {
 #define	COREDUMP_MEM_HDR_ID		'M'
 #define COREDUMP_MEM_HDR_VER		1
 
+#define	COREDUMP_COMPRESSED_MEM_HDR_ID	'C'
+#define COREDUMP_COMPRESSED_MEM_HDR_VER	1
+
+/*
+ * Compressed memory blocks are made of tokens: a byte below
+ * COREDUMP_COMPRESS_TOKEN_MATCH is followed by that many literal bytes
+ * plus 1. Otherwise the lower bits of the byte give the length of a
+ * match minus COREDUMP_COMPRESS_MATCH_MIN, followed by its 16-bit
+ * distance. A length of COREDUMP_COMPRESS_MATCH_LEN_EXT is extended by
+ * the bytes following the distance, up to and including the first one
+ * which is not 255.
+ */
+#define COREDUMP_COMPRESS_TOKEN_MATCH	0x80
+#define COREDUMP_COMPRESS_MATCH_MIN	4
+#define COREDUMP_COMPRESS_MATCH_LEN_EXT	0x7f
+
 /* Target code */
 enum coredump_tgt_code {
 	COREDUMP_TGT_UNKNOWN = 0,
@@ -181,7 +197,7 @@ struct coredump_arch_hdr_t {
 
 /* Memory block header */
 struct coredump_mem_hdr_t {
-	/* COREDUMP_MEM_HDR_ID */
+	/* COREDUMP_MEM_HDR_ID or COREDUMP_COMPRESSED_MEM_HDR_ID */
 	char		id;
 
 	/* Header version */
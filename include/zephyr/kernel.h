@@ -6091,6 +6091,22 @@ void k_sys_runtime_stats_enable(void);
  */
 void k_sys_runtime_stats_disable(void);
 
+#if defined(CONFIG_SCHED_USAGE_MONITOR) || defined(__DOXYGEN__)
+/**
+ * @brief Get a window of the usage monitor history
+ *
+ * This routine copies the load over one of the most recent windows of the
+ * usage monitor. It is available when @kconfig{CONFIG_SCHED_USAGE_MONITOR}
+ * is enabled.
+ *
+ * @param age Age of the window, 0 being the last completed window.
+ * @param window Pointer to the window to fill.
+ * @retval 0 on success
+ * @retval -ENOENT if the history does not hold that window (yet)
+ */
+int k_usage_monitor_window_get(unsigned int age, struct k_usage_window *window);
+#endif /* CONFIG_SCHED_USAGE_MONITOR */
+
 #ifdef __cplusplus
 }
 #endif
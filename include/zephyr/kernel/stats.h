@@ -27,7 +27,54 @@ struct k_cycle_stats {
 	uint32_t  num_windows;  /**< \# of usage windows */
 	/** @} */
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#if defined(CONFIG_SCHED_USAGE_MONITOR) || defined(__DOXYGEN__)
+	/**
+	 * @name Fields available when CONFIG_SCHED_USAGE_MONITOR is selected.
+	 * @{
+	 */
+	uint64_t  window_start; /**< total usage at the start of the monitor window */
+	uint16_t  window_load;  /**< load over the last monitor window, in 1/1000 */
+	/** @} */
+#endif /* CONFIG_SCHED_USAGE_MONITOR */
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+#if defined(CONFIG_SCHED_USAGE_MONITOR) || defined(__DOXYGEN__)
+
+struct k_thread;
+
+/** Thread among the busiest of a usage monitor window */
+struct k_usage_window_thread {
+	/** Thread, which may no longer exist */
+	const struct k_thread *thread;
+	/** Load of the thread over the window, in 1/1000 of a CPU */
+	uint16_t load;
+};
+
+/** Interrupt among the busiest of a usage monitor window */
+struct k_usage_window_isr {
+	/** Interrupt line */
+	uint16_t irq;
+	/** Load of the interrupt over the window, in 1/1000 of a CPU */
+	uint16_t load;
+};
+
+/** Load over a window of the usage monitor */
+struct k_usage_window {
+	/** Uptime at the end of the window, in milliseconds */
+	uint32_t end_ms;
+	/** Load of each CPU over the window, in 1/1000 */
+	uint16_t cpu_load[CONFIG_MP_MAX_NUM_CPUS];
+#if defined(CONFIG_SCHED_USAGE_MONITOR_ISR) || defined(__DOXYGEN__)
+	/** Time spent in interrupts by each CPU over the window, in 1/1000 */
+	uint16_t isr_load[CONFIG_MP_MAX_NUM_CPUS];
+	/** Busiest interrupts, by decreasing load, unused entries have no load */
+	struct k_usage_window_isr isrs[CONFIG_SCHED_USAGE_MONITOR_TOP_ISRS];
+#endif
+	/** Busiest threads, by decreasing load, unused entries are NULL */
+	struct k_usage_window_thread threads[CONFIG_SCHED_USAGE_MONITOR_TOP_THREADS];
+};
+
+#endif /* CONFIG_SCHED_USAGE_MONITOR */
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_STATS_H_ */
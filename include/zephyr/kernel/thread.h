@@ -238,6 +238,15 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_USAGE_MONITOR
+	/*
+	 * Load over the last window of the usage monitor, in 1/1000 of a
+	 * CPU for threads. For CPUs, it excludes the idle thread(s).
+	 */
+
+	uint32_t window_load;
+#endif /* CONFIG_SCHED_USAGE_MONITOR */
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
 	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
@@ -123,6 +123,62 @@ struct log_backend {
 		.autostart = _autostart					       \
 	}
 
+/**
+ * @brief Backend processing thread.
+ *
+ * Messages are handed to the backend by the log processing thread and the
+ * backend processes them in its own thread, from its own cursor into the
+ * queue of messages. A message is freed once all backends have processed it.
+ */
+struct log_backend_thread {
+	const struct log_backend *backend;
+	k_thread_stack_t *stack;
+	size_t stack_size;
+	struct k_thread thread;
+	struct k_sem sem;
+
+	/* Sequence number of the next message to process. */
+	uint32_t rd;
+
+	/* Messages dropped for this backend since the last notification. */
+	uint32_t dropped;
+
+	/* Cursor position after the message being processed, when the
+	 * backend fell behind while processing it.
+	 */
+	uint32_t skip_to;
+
+	/* Message at the cursor is being processed. */
+	bool busy;
+};
+
+#if defined(CONFIG_LOG_BACKEND_THREADS) || defined(__DOXYGEN__)
+/**
+ * @brief Macro for processing backend messages in a dedicated thread.
+ *
+ * Must be used in the file where the backend is defined. The thread is
+ * created with the priority of the log processing thread. Without
+ * CONFIG_LOG_BACKEND_THREADS the backend is processed by the log processing
+ * thread.
+ *
+ * @param _name		Name of the backend instance.
+ * @param _stack_size	Stack size of the thread.
+ */
+#define LOG_BACKEND_THREAD_DEFINE(_name, _stack_size)			       \
+	static K_KERNEL_STACK_DEFINE(UTIL_CAT(_name, _thread_stack),	       \
+				     _stack_size);			       \
+	static STRUCT_SECTION_ITERABLE(log_backend_thread,		       \
+				       UTIL_CAT(_name, _thread)) =	       \
+	{								       \
+		.backend = &_name,					       \
+		.stack = UTIL_CAT(_name, _thread_stack),		       \
+		.stack_size = K_KERNEL_STACK_SIZEOF(			       \
+				UTIL_CAT(_name, _thread_stack)),	       \
+	}
+#else
+#define LOG_BACKEND_THREAD_DEFINE(_name, _stack_size)
+#endif
+
 
 /**
  * @brief Initialize or initiate the logging backend.
@@ -255,6 +255,11 @@ static inline char z_log_minimal_level_to_char(int level)
 	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER((_dsource)->filters)) { \
 		break; \
 	} \
+	if (IS_ENABLED(CONFIG_LOG_RATE_LIMIT) && !is_user_context && \
+	    Z_LOG_RATE_LIMITED((_dsource)->filters) && \
+	    !z_log_rate_limit_check(_dsource, _level)) { \
+		break; \
+	} \
 	int _mode; \
 	void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
 		(void *)_dsource : (void *)_source; \
@@ -339,6 +344,11 @@ static inline char z_log_minimal_level_to_char(int level)
 	    !is_user_context && _level > Z_LOG_RUNTIME_FILTER(filters)) { \
 		break; \
 	} \
+	if (IS_ENABLED(CONFIG_LOG_RATE_LIMIT) && !is_user_context && \
+	    Z_LOG_RATE_LIMITED(filters) && \
+	    !z_log_rate_limit_check(_dsource, _level)) { \
+		break; \
+	} \
 	int mode; \
 	void *_src = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? \
 		(void *)_dsource : (void *)_source; \
@@ -419,6 +429,17 @@ static inline char z_log_minimal_level_to_char(int level)
 #define Z_LOG_RUNTIME_FILTER(_filter) \
 	LOG_FILTER_SLOT_GET(&_filter, LOG_FILTER_AGGR_SLOT_IDX)
 
+/** @brief Flag set in the runtime filters of a source which is rate limited.
+ *
+ * It uses a bit above the filter slots.
+ */
+#define LOG_FILTER_RATE_LIMIT BIT(31)
+
+BUILD_ASSERT((LOG_FILTERS_NUM_OF_SLOTS * LOG_FILTER_SLOT_SIZE) < 31,
+	     "Rate limit flag overlaps filter slots");
+
+#define Z_LOG_RATE_LIMITED(_filter) (((_filter) & LOG_FILTER_RATE_LIMIT) != 0U)
+
 /** @brief Log level value used to indicate log entry that should not be
  *	   formatted (raw string).
  */
@@ -493,6 +514,19 @@ static inline uint32_t log_dynamic_source_id(struct log_source_dynamic_data *dat
 			sizeof(struct log_source_dynamic_data);
 }
 
+/** @brief Apply the rate limiting rules of a source to a message.
+ *
+ * Called before the message is created for a source flagged with
+ * @ref LOG_FILTER_RATE_LIMIT.
+ *
+ * @param dsource Dynamic data of the source.
+ * @param level Level of the message.
+ *
+ * @retval true if the message shall be logged.
+ * @retval false if the message is suppressed.
+ */
+bool z_log_rate_limit_check(struct log_source_dynamic_data *dsource, uint8_t level);
+
 /** @brief Dummy function to trigger log messages arguments type checking. */
 static inline __printf_like(1, 2)
 void z_log_printf_arg_checker(const char *fmt, ...)
@@ -190,6 +190,67 @@ uint32_t log_frontend_filter_get(int16_t source_id, bool runtime);
  */
 __syscall uint32_t log_frontend_filter_set(int16_t source_id, uint32_t level);
 
+/**
+ * @brief Rate limiting rule of a source.
+ */
+struct log_rate_limit {
+	/** Source (module or instance) ID. */
+	int16_t source_id;
+
+	/** Severity level the rule applies to, LOG_LEVEL_NONE for all levels. */
+	uint8_t level;
+
+	/** Messages per second, 0 for no rate limit. */
+	uint32_t rate;
+
+	/** Messages which can be logged at once. */
+	uint32_t burst;
+
+	/** One message out of this number is logged, 0 or 1 for all. */
+	uint32_t sample;
+
+	/** Number of suppressed messages. */
+	uint32_t suppressed;
+};
+
+/**
+ * @brief Set rate limiting rule on given source.
+ *
+ * Messages of the source are first sampled, then limited by a token bucket
+ * which is refilled with @p rate tokens per second and holds @p burst tokens
+ * at most. A message is suppressed before it is created, so that it does not
+ * take space in the log buffer. Messages logged from user mode are not rate
+ * limited. Requires CONFIG_LOG_RATE_LIMIT.
+ *
+ * A rule for a level takes precedence over a rule for all levels.
+ *
+ * @param source_id	Source (module or instance) ID in the local domain.
+ * @param level		Severity level, LOG_LEVEL_NONE for all levels.
+ * @param rate		Messages per second, 0 for no rate limit.
+ * @param burst		Messages which can be logged at once, 0 for @p rate.
+ * @param sample	Log one message out of @p sample, 0 or 1 for all. The
+ *			rule is removed if it is not sampling and @p rate is 0.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if an argument is invalid.
+ * @retval -ENOMEM if all rules are used.
+ * @retval -ENOTSUP if rate limiting is disabled.
+ */
+int log_rate_limit_set(int16_t source_id, uint32_t level, uint32_t rate,
+		       uint32_t burst, uint32_t sample);
+
+/**
+ * @brief Get rate limiting rule.
+ *
+ * @param idx		Index of the rule, from 0.
+ * @param[out] limit	Rule and its number of suppressed messages.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if there are less than @p idx + 1 rules.
+ * @retval -ENOTSUP if rate limiting is disabled.
+ */
+int log_rate_limit_get(uint32_t idx, struct log_rate_limit *limit);
+
 /**
  *
  * @brief Enable backend with initial maximum filtering level.
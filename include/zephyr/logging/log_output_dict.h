@@ -23,6 +23,7 @@ extern "C" {
 enum log_dict_output_msg_type {
 	MSG_NORMAL = 0,
 	MSG_DROPPED_MSG = 1,
+	MSG_NORMAL_PACKED = 2,
 };
 
 /**
@@ -38,6 +39,25 @@ struct log_dict_output_normal_msg_hdr_t {
 	log_timestamp_t timestamp;
 } __packed;
 
+/**
+ * Packed output header for one dictionary based log message.
+ *
+ * The type is followed by a descriptor byte and by the source ID, the
+ * timestamp, the package length and, when present, the data length, each
+ * encoded as an unsigned LEB128 varint.
+ */
+#define LOG_DICT_OUTPUT_PACKED_DOMAIN_MASK	BIT_MASK(3)
+#define LOG_DICT_OUTPUT_PACKED_LEVEL_SHIFT	3
+#define LOG_DICT_OUTPUT_PACKED_LEVEL_MASK	BIT_MASK(3)
+/** Timestamp is the difference with the one of the previous message. */
+#define LOG_DICT_OUTPUT_PACKED_DELTA_TIMESTAMP	BIT(6)
+/** Data length follows the package length. */
+#define LOG_DICT_OUTPUT_PACKED_HAS_DATA		BIT(7)
+
+/** Maximum length of a packed output header. */
+#define LOG_DICT_OUTPUT_PACKED_HDR_MAX_LEN \
+	(2 + 5 + DIV_ROUND_UP(sizeof(log_timestamp_t) * 8, 7) + 2 + 2)
+
 /**
  * Output for one dictionary based log message about
  * dropped messages.
@@ -59,6 +79,37 @@ struct log_dict_output_dropped_msg_t {
 void log_dict_output_msg_process(const struct log_output *log_output,
 				 struct log_msg *msg, uint32_t flags);
 
+/** @brief Process log messages v2 for packed dictionary-based logging.
+ *
+ * The message is output as with log_dict_output_msg_process() but with a
+ * packed header (see @ref MSG_NORMAL_PACKED), and the whole message is
+ * passed to the output function at once when it fits in the output buffer.
+ *
+ * @param log_output Pointer to the log output instance.
+ * @param msg Log message.
+ * @param ref_timestamp Timestamp of the previous message in the output, or
+ *	  NULL. When set, the timestamp is output as the difference with it if
+ *	  the message is not older.
+ *
+ * @return Number of bytes output.
+ */
+size_t log_dict_output_packed_msg_process(const struct log_output *log_output,
+					  struct log_msg *msg,
+					  const log_timestamp_t *ref_timestamp);
+
+/** @brief Get the maximum length of a packed dictionary-based log message.
+ *
+ * @param msg Log message.
+ *
+ * @return Maximum number of bytes output by
+ *	   log_dict_output_packed_msg_process() for the message.
+ */
+static inline size_t log_dict_output_packed_msg_len_max(struct log_msg *msg)
+{
+	return LOG_DICT_OUTPUT_PACKED_HDR_MAX_LEN + msg->hdr.desc.package_len +
+	       msg->hdr.desc.data_len;
+}
+
 /** @brief Process dropped messages indication for dictionary-based logging.
  *
  * Function prints error message indicating lost log messages.
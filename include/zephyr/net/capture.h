@@ -331,6 +331,190 @@ static inline void net_capture_data(struct net_capture_cooked *ctx,
 }
 #endif
 
+/** Capture packets received by the network interface */
+#define NET_CAPTURE_RING_RX BIT(0)
+/** Capture packets sent by the network interface */
+#define NET_CAPTURE_RING_TX BIT(1)
+
+/** Selection of the packets recorded into the capture ring */
+struct net_capture_ring_filter {
+	/** Network interface to capture, NULL captures all the interfaces */
+	struct net_if *iface;
+	/** Link layer protocol type (ETH_P_*) to capture, 0 captures all */
+	uint16_t ptype;
+	/** Number of bytes stored per packet, 0 stores
+	 * CONFIG_NET_CAPTURE_RING_SNAPLEN bytes.
+	 */
+	uint16_t snaplen;
+	/** NET_CAPTURE_RING_RX and/or NET_CAPTURE_RING_TX, 0 captures both */
+	uint8_t direction;
+};
+
+/** Capture ring statistics */
+struct net_capture_ring_stats {
+	/** Number of packets recorded since the capture was started */
+	uint32_t captured;
+	/** Number of packets not recorded, as the slot where they were to be
+	 * stored was still being written.
+	 */
+	uint32_t dropped;
+	/** Number of packets currently stored in the ring */
+	uint32_t stored;
+};
+
+/**
+ * @typedef net_capture_ring_write_cb_t
+ * @brief Callback used to output the exported capture ring
+ *
+ * @param data Next part of the pcapng data
+ * @param len Length of the data
+ * @param user_data A valid pointer to user data or NULL
+ *
+ * @return 0 if ok, <0 to stop the export
+ */
+typedef int (*net_capture_ring_write_cb_t)(const void *data, size_t len, void *user_data);
+
+/**
+ * @brief Start recording network packets into the capture ring.
+ *        If the capture is already running, the filter is replaced.
+ *
+ * @param filter Packets to record, NULL records all the packets.
+ *
+ * @return 0 if ok, <0 if the filter is invalid
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_start(const struct net_capture_ring_filter *filter);
+#else
+static inline int net_capture_ring_start(const struct net_capture_ring_filter *filter)
+{
+	ARG_UNUSED(filter);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Stop recording network packets. The recorded packets are kept.
+ *
+ * @return 0 if ok, <0 if the capture ring is not supported
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_stop(void);
+#else
+static inline int net_capture_ring_stop(void)
+{
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Is the capture ring recording packets.
+ *
+ * @return true if the capture is running, false otherwise
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+bool net_capture_ring_is_enabled(void);
+#else
+static inline bool net_capture_ring_is_enabled(void)
+{
+	return false;
+}
+#endif
+
+/**
+ * @brief Discard the recorded packets and reset the statistics.
+ *
+ * @return 0 if ok, -EBUSY if the capture is running
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_clear(void);
+#else
+static inline int net_capture_ring_clear(void)
+{
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Get the capture ring statistics.
+ *
+ * @param stats Statistics filled by the function
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+void net_capture_ring_get_stats(struct net_capture_ring_stats *stats);
+#else
+static inline void net_capture_ring_get_stats(struct net_capture_ring_stats *stats)
+{
+	*stats = (struct net_capture_ring_stats){ 0 };
+}
+#endif
+
+/**
+ * @brief Export the recorded packets in pcapng format, from the oldest to
+ *        the most recent one. The capture can be running while the packets
+ *        are exported, packets replaced while they are exported are skipped.
+ *
+ * @param cb Callback called with the successive parts of the pcapng data
+ * @param user_data User supplied data
+ *
+ * @return Number of exported packets, <0 if the export failed
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_export(net_capture_ring_write_cb_t cb, void *user_data);
+#else
+static inline int net_capture_ring_export(net_capture_ring_write_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Save the recorded packets in pcapng format into a file. The file
+ *        is created in the host file system when
+ *        CONFIG_NET_CAPTURE_RING_HOST_FILE is set, otherwise in a file system
+ *        mounted with the file system API.
+ *
+ * @param path Name of the file
+ *
+ * @return Number of saved packets, <0 if the file cannot be written
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+int net_capture_ring_save(const char *path);
+#else
+static inline int net_capture_ring_save(const char *path)
+{
+	ARG_UNUSED(path);
+
+	return -ENOTSUP;
+}
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+
+/**
+ * @brief Record a network packet into the capture ring.
+ *
+ * @param iface Network interface the packet is sent or received on
+ * @param pkt The network packet, starting with its link layer header
+ * @param outgoing True if the packet is being sent
+ */
+#if defined(CONFIG_NET_CAPTURE_RING)
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt, bool outgoing);
+#else
+static inline void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt,
+					bool outgoing)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(outgoing);
+}
+#endif
+
+/** @endcond */
+
 struct net_capture_info {
 	const struct device *capture_dev;
 	struct net_if *capture_iface;
@@ -44,6 +44,12 @@ struct coap_service_data {
 	int sock_fd;
 	struct coap_observer observers[CONFIG_COAP_SERVICE_OBSERVERS];
 	struct coap_pending pending[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+#if CONFIG_COAP_SERVER_RESOURCE_INDEX_SIZE > 0
+	/* Resource offsets + 1 hashed by path, 0 marks an empty slot */
+	uint16_t res_index[CONFIG_COAP_SERVER_RESOURCE_INDEX_SIZE];
+	uint16_t res_first_wildcard;
+	bool res_indexed;
+#endif
 };
 
 struct coap_service {
@@ -29,12 +29,55 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Bridge forwarding statistics
+ */
+struct eth_bridge_stats {
+	/** Packets received from the bridged interfaces */
+	uint32_t rx_pkts;
+	/** Packets sent to the single port their destination was learned on */
+	uint32_t unicast;
+	/** Packets sent to all ports because the destination was unknown,
+	 *  broadcast or multicast
+	 */
+	uint32_t flooded;
+	/** Packets not forwarded as the destination is on the incoming port */
+	uint32_t filtered;
+	/** Packet clones made for forwarding */
+	uint32_t clones;
+	/** Addresses learned or moved to another port */
+	uint32_t learned;
+};
+
+/**
+ * @brief Forwarding database entry of a bridge
+ */
+struct eth_bridge_fdb_entry {
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	/** @endcond */
+	/** Interface the address was last seen on */
+	struct net_if *iface;
+	/** Uptime in milliseconds when the address was last seen */
+	uint32_t last_seen;
+	/** VLAN tag of the packets, NET_VLAN_TAG_UNSPEC if untagged */
+	uint16_t vlan_tag;
+	/** Learned MAC address */
+	uint8_t addr[6];
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 struct eth_bridge {
 	struct k_mutex lock;
 	sys_slist_t interfaces;
 	sys_slist_t listeners;
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	sys_slist_t fdb_free;
+	sys_slist_t fdb[CONFIG_NET_ETHERNET_BRIDGE_FDB_BUCKETS];
+	struct eth_bridge_fdb_entry fdb_entries[CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE];
+#endif
+	struct eth_bridge_stats stats;
 	bool initialized;
 };
 
@@ -161,6 +204,44 @@ int eth_bridge_get_index(struct eth_bridge *br);
  */
 struct eth_bridge *eth_bridge_get_by_index(int index);
 
+/**
+ * @brief Get the forwarding statistics of a bridge
+ *
+ * @param br A pointer to an initialized bridge object
+ * @param stats Where to store the statistics
+ */
+void eth_bridge_get_stats(struct eth_bridge *br, struct eth_bridge_stats *stats);
+
+/**
+ * @typedef eth_bridge_fdb_cb_t
+ * @brief Callback used while iterating over forwarding database entries
+ *
+ * @param br Pointer to bridge instance
+ * @param entry Forwarding database entry
+ * @param user_data User supplied data
+ */
+typedef void (*eth_bridge_fdb_cb_t)(struct eth_bridge *br,
+				    const struct eth_bridge_fdb_entry *entry,
+				    void *user_data);
+
+/**
+ * @brief Go through the valid entries of the forwarding database of a
+ *        bridge. The bridge is locked while the callback is called.
+ *
+ * @param br A pointer to an initialized bridge object
+ * @param cb Callback to call for each entry
+ * @param user_data User supplied data
+ */
+void eth_bridge_fdb_foreach(struct eth_bridge *br, eth_bridge_fdb_cb_t cb,
+			    void *user_data);
+
+/**
+ * @brief Remove all learned addresses from the forwarding database
+ *
+ * @param br A pointer to an initialized bridge object
+ */
+void eth_bridge_fdb_flush(struct eth_bridge *br);
+
 /**
  * @typedef eth_bridge_cb_t
  * @brief Callback used while iterating over bridge instances
@@ -483,6 +483,17 @@ struct mqtt_internal {
 
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
+
+#if defined(CONFIG_MQTT_PUBLISH_INFLIGHT_WINDOW) && \
+	CONFIG_MQTT_PUBLISH_INFLIGHT_WINDOW > 0
+	/** Internal. Message IDs of the QoS 1 and QoS 2 publishes not yet
+	 *  acknowledged by the broker.
+	 */
+	uint16_t inflight[CONFIG_MQTT_PUBLISH_INFLIGHT_WINDOW];
+
+	/** Internal. Number of valid entries in @ref inflight. */
+	uint16_t inflight_count;
+#endif
 };
 
 /**
@@ -617,11 +628,45 @@ int mqtt_connect(struct mqtt_client *client);
  * @param[in] param Parameters to be used for the publish message.
  *                  Shall not be NULL.
  *
+ * @note The payload is sent directly from the buffer provided in @p param,
+ *       only the packet header is encoded into the client's tx buffer.
+ * @note If @kconfig{CONFIG_MQTT_PUBLISH_INFLIGHT_WINDOW} is non-zero, QoS 1
+ *       and QoS 2 messages are tracked until acknowledged by the broker, and
+ *       -EAGAIN is returned when the window is full. The application should
+ *       then call @ref mqtt_input to process the acknowledgments and retry.
+ *       Publishing a message ID which is already in flight (for instance a
+ *       retransmission with the DUP flag set) does not take a new slot.
+ *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to publish several messages with a single transport write.
+ *
+ * The packet headers are encoded one after the other into the client's tx
+ * buffer and sent together with the payloads in one scatter-gather write,
+ * which reduces the per-message overhead of high rate publishing. The
+ * payloads are not copied.
+ *
+ * At most @kconfig{CONFIG_MQTT_PUBLISH_BATCH_MAX} messages are sent per call.
+ * Fewer messages than requested are sent if the headers do not fit into the
+ * tx buffer or the in-flight window becomes full; the remaining messages
+ * can be passed to a subsequent call.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] params Array of parameters of the publish messages.
+ *                   Shall not be NULL.
+ * @param[in] count Number of elements in @p params.
+ *
+ * @return Number of messages sent, or a negative error code (errno.h)
+ *         indicating reason of failure if no message could be sent.
+ */
+int mqtt_publish_batch(struct mqtt_client *client,
+		       const struct mqtt_publish_param *params, size_t count);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
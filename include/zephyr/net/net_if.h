@@ -636,8 +636,13 @@ struct net_if {
 	struct net_if_dev *if_dev;
 
 #if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	/** Network statistics related to this network interface, per CPU */
+	struct net_stats_cpu stats[CONFIG_MP_MAX_NUM_CPUS];
+#else
 	/** Network statistics related to this network interface */
 	struct net_stats stats;
+#endif
 #endif /* CONFIG_NET_STATISTICS_PER_INTERFACE */
 
 	/** Network interface instance configuration */
@@ -157,6 +157,7 @@ static inline int net_l2_send(net_l2_send_t send_fn,
 			      struct net_pkt *pkt)
 {
 	net_capture_pkt(iface, pkt);
+	net_capture_ring_pkt(iface, pkt, true);
 
 	return send_fn(dev, pkt);
 }
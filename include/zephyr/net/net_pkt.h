@@ -2311,6 +2311,52 @@ bool net_pkt_is_contiguous(struct net_pkt *pkt, size_t size);
  */
 size_t net_pkt_get_contiguous_len(struct net_pkt *pkt);
 
+/**
+ * @brief Make the beginning of a packet contiguous
+ *
+ * @details Moves data from the following fragments into the first buffer
+ *          of the packet, until its first @p length bytes (or the whole
+ *          packet if it is shorter) are contiguous. The packet content is
+ *          not changed. Note that net_pkt's cursor is reset if some data
+ *          had to be moved.
+ *
+ * @param pkt    Network packet
+ * @param length Number of bytes to make contiguous
+ *
+ * @return 0 on success, -ENOBUFS if the first buffer does not have enough
+ *         tailroom, -EBUSY if the buffers are shared with another packet.
+ */
+int net_pkt_pullup(struct net_pkt *pkt, size_t length);
+
+/**
+ * @brief Get a direct pointer to a header at the cursor
+ *
+ * @details Unlike net_pkt_get_data(), the data is never copied, so the
+ *          returned pointer can be used to modify the packet. NULL is
+ *          returned if the @p size bytes at the cursor are not in the same
+ *          buffer, in which case the caller has to fall back to
+ *          net_pkt_get_data() or net_pkt_read(). Headers made contiguous
+ *          by net_pkt_pullup() can always be accessed this way. The cursor
+ *          position is not updated, and the packet needs to be in overwrite
+ *          mode.
+ *
+ * @param pkt  Network packet
+ * @param size Size of the header
+ *
+ * @return a pointer to the header, NULL otherwise.
+ */
+static inline void *net_pkt_header_ptr(struct net_pkt *pkt, size_t size)
+{
+	struct net_buf *buf = pkt->cursor.buf;
+
+	if (buf == NULL || pkt->cursor.pos == NULL ||
+	    pkt->cursor.pos + size > buf->data + buf->len) {
+		return NULL;
+	}
+
+	return pkt->cursor.pos;
+}
+
 struct net_pkt_data_access {
 #if !defined(CONFIG_NET_HEADERS_ALWAYS_CONTIGUOUS)
 	void *data;
@@ -219,6 +219,23 @@ struct net_stats_ipv4_igmp {
 	net_stats_t drop;
 };
 
+/**
+ * @brief DNS resolver cache statistics
+ */
+struct net_stats_dns {
+	/** Number of queries answered with cached addresses */
+	net_stats_t cache_hit;
+
+	/** Number of queries answered with a cached negative answer */
+	net_stats_t cache_negative_hit;
+
+	/** Number of queries that were not found in the cache */
+	net_stats_t cache_miss;
+
+	/** Number of queries sent to refresh cached entries */
+	net_stats_t cache_prefetch;
+};
+
 /**
  * @brief Network packet transfer times for calculating average TX time
  */
@@ -342,6 +359,11 @@ struct net_stats {
 	struct net_stats_ipv4_igmp ipv4_igmp;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_DNS)
+	/** DNS resolver cache statistics, only kept globally */
+	struct net_stats_dns dns;
+#endif
+
 #if NET_TC_COUNT > 1
 	/** Traffic class statistics */
 	struct net_stats_tc tc;
@@ -371,6 +393,19 @@ struct net_stats {
 #endif
 };
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/**
+ * @brief Network statistics updated by one CPU.
+ *
+ * Aligned so that the CPUs update their statistics without sharing cache
+ * lines. The statistics of all the CPUs are summed when they are read.
+ */
+struct net_stats_cpu {
+	/** Statistics updated by the CPU */
+	struct net_stats stats;
+} __aligned(CONFIG_NET_STATISTICS_PER_CPU_ALIGNMENT);
+#endif
+
 /**
  * @brief Ethernet error statistics
  */
@@ -519,6 +554,7 @@ enum net_request_stats_cmd {
 	NET_REQUEST_STATS_CMD_GET_PPP,
 	NET_REQUEST_STATS_CMD_GET_PM,
 	NET_REQUEST_STATS_CMD_GET_WIFI,
+	NET_REQUEST_STATS_CMD_GET_DNS,
 };
 
 #define NET_REQUEST_STATS_GET_ALL				\
@@ -613,6 +649,13 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_PM);
 NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_WIFI);
 #endif /* CONFIG_NET_STATISTICS_WIFI */
 
+#if defined(CONFIG_NET_STATISTICS_DNS)
+#define NET_REQUEST_STATS_GET_DNS				\
+	(_NET_STATS_BASE | NET_REQUEST_STATS_CMD_GET_DNS)
+
+NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_GET_DNS);
+#endif /* CONFIG_NET_STATISTICS_DNS */
+
 /**
  * @}
  */
@@ -30,6 +30,7 @@
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/fdtable.h>
 #include <stdlib.h>
+#include <time.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -82,8 +83,40 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_send: more data follows, TLS sockets hold the data back to send
+ *  it in one record with the data of the next call
+ */
+#define ZSOCK_MSG_MORE 0x8000
+/** zsock_recvmmsg: only block until the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
+/**
+ * @brief Message descriptor used by zsock_sendmmsg() and zsock_recvmmsg().
+ */
+struct zsock_mmsghdr {
+	struct msghdr msg_hdr;  /**< Message header */
+	unsigned int msg_len;   /**< Number of bytes transmitted for the message */
+};
+
+/**
+ * @brief Received data lent out by zsock_recv_loan().
+ */
+struct zsock_recv_loan {
+	/** Array the segments of the received data are stored in */
+	struct iovec *iov;
+	/** Number of entries in @a iov, set to the number of used entries */
+	size_t iovlen;
+	/** Buffer the data is copied to when the caller is a user thread */
+	void *buf;
+	/** Size of @a buf */
+	size_t buf_len;
+	/** Flags on the received data, e.g. ZSOCK_MSG_TRUNC */
+	int msg_flags;
+	/** Reference to the lent network buffers, internal use only */
+	void *handle;
+};
+
 /**
  * @name Options for shutdown() function
  * @{
@@ -529,6 +562,95 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Send multiple messages with a single call
+ *
+ * @details
+ * @rst
+ * Send up to ``vlen`` messages from ``msgvec``, as if calling
+ * :c:func:`zsock_sendmsg` for each of them, but with a single system call
+ * and a single socket lookup. The number of bytes sent for each message is
+ * stored in its ``msg_len`` field.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, or -1 with errno set if the first
+ * message could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive multiple messages with a single call
+ *
+ * @details
+ * @rst
+ * Receive up to ``vlen`` messages into ``msgvec``, as if calling
+ * :c:func:`zsock_recvmsg` for each of them, but with a single system call
+ * and a single socket lookup. The number of bytes received for each
+ * message is stored in its ``msg_len`` field.
+ *
+ * With :c:macro:`ZSOCK_MSG_WAITFORONE`, only the first message is waited
+ * for and the call then returns with whatever is already queued on the
+ * socket. If ``timeout`` is given, it is checked after each received
+ * message, as on Linux.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @return Number of messages received, or -1 with errno set if no message
+ * could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags,
+			     struct timespec *timeout);
+
+/**
+ * @brief Receive data without copying it out of the network buffers
+ *
+ * @details
+ * @rst
+ * Lend the data at the head of the receive queue to the caller instead of
+ * copying it: the ``iov`` entries of ``loan`` are set to point straight
+ * into the network buffers holding the data. The buffers stay allocated
+ * until the loan is returned with :c:func:`zsock_recv_loan_release`, so
+ * loans should be short lived, as the buffers are taken from the pool
+ * used for all incoming packets.
+ *
+ * For a stream socket, the data of one received segment is lent at most.
+ * For a datagram socket, one datagram is lent; if it has more segments
+ * than ``iovlen``, the rest is discarded and ``ZSOCK_MSG_TRUNC`` is set in
+ * ``msg_flags``. ``ZSOCK_MSG_DONTWAIT`` is supported, ``ZSOCK_MSG_PEEK``
+ * is not.
+ *
+ * Network buffers are not accessible to user threads. When called from
+ * user mode, the data is therefore copied once into ``buf`` and
+ * ``iov[0]`` is set to point to it, so the same code works in both modes.
+ *
+ * This is a Zephyr extension, only supported by native IP sockets.
+ * @endrst
+ *
+ * @param sock Socket to receive from
+ * @param loan Loan descriptor with the iov array and the user mode buffer
+ * @param flags Receive flags
+ *
+ * @return Number of bytes lent, 0 on end of stream, or -1 with errno set.
+ */
+__syscall ssize_t zsock_recv_loan(int sock, struct zsock_recv_loan *loan,
+				  int flags);
+
+/**
+ * @brief Return data lent out by zsock_recv_loan()
+ *
+ * @details
+ * The network buffers referenced by @a loan are freed, after which the
+ * @a iov entries of the loan must not be used anymore.
+ *
+ * @param loan Loan descriptor filled in by zsock_recv_loan()
+ */
+__syscall void zsock_recv_loan_release(struct zsock_recv_loan *loan);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -859,6 +981,7 @@ int zsock_getnameinfo(const struct sockaddr *addr, socklen_t addrlen,
 
 /** POSIX wrapper for @ref zsock_pollfd */
 #define pollfd zsock_pollfd
+#define mmsghdr zsock_mmsghdr
 
 /** POSIX wrapper for @ref zsock_socket */
 static inline int socket(int family, int type, int proto)
@@ -949,6 +1072,21 @@ static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+/** POSIX wrapper for @ref zsock_recvmmsg */
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags,
+			   struct timespec *timeout)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags, timeout);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -1055,6 +1193,10 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_MORE */
+#define MSG_MORE ZSOCK_MSG_MORE
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -1191,6 +1333,10 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm, given by name (e.g. "reno", "cubic") */
+#define TCP_CONGESTION 5
+/** Hold back written data until the option is cleared (TLS sockets only) */
+#define TCP_CORK 6
 
 /** @} */
 
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+/**
+ * @brief Socket event queue API
+ * @defgroup bsd_sockets_epoll Socket event queue API
+ * @ingroup bsd_sockets
+ * @{
+ */
+
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/net/socket_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name Event queue event flags
+ *
+ * The readiness flags have the same values as the corresponding
+ * ZSOCK_POLL* flags.
+ * @{
+ */
+/** Data is available for reading, or a connection can be accepted */
+#define ZSOCK_EPOLLIN 0x1
+/** Data can be written without blocking */
+#define ZSOCK_EPOLLOUT 0x4
+/** Error condition, always reported */
+#define ZSOCK_EPOLLERR 0x8
+/** Peer closed the connection, always reported */
+#define ZSOCK_EPOLLHUP 0x10
+/** Disable the registration after one event was reported */
+#define ZSOCK_EPOLLONESHOT BIT(30)
+/** Report readiness changes instead of readiness (edge-triggered) */
+#define ZSOCK_EPOLLET BIT(31)
+/** @} */
+
+/**
+ * @name Event queue control operations
+ * @{
+ */
+/** Register a socket */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** Unregister a socket */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** Change the events of a registered socket */
+#define ZSOCK_EPOLL_CTL_MOD 3
+/** @} */
+
+/** User data returned together with an event */
+typedef union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zsock_epoll_data_t;
+
+/** Event queue registration and event descriptor */
+struct zsock_epoll_event {
+	/** Requested events in zsock_epoll_ctl(), reported ones in
+	 *  zsock_epoll_wait().
+	 */
+	uint32_t events;
+	/** User data given in zsock_epoll_ctl() */
+	zsock_epoll_data_t data;
+};
+
+/**
+ * @brief Create a socket event queue
+ *
+ * @details
+ * The event queue is a file descriptor that sockets can be registered to
+ * with zsock_epoll_ctl(). Registered sockets signal the queue directly
+ * when their readiness changes, so zsock_epoll_wait() only inspects the
+ * sockets that have something to report instead of walking all of them
+ * like zsock_poll() does.
+ *
+ * Only native (non-offloaded, non-TLS) network sockets can be registered.
+ * The queue is closed with zsock_close().
+ * This function is also exposed as ``epoll_create1()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param flags Must be 0.
+ *
+ * @return File descriptor of the queue, -1 with errno set on error.
+ */
+__syscall int zsock_epoll_create1(int flags);
+
+/**
+ * @brief Add, modify or remove a socket registration
+ *
+ * @details
+ * ZSOCK_EPOLLERR and ZSOCK_EPOLLHUP are always reported and do not need
+ * to be requested. Without ZSOCK_EPOLLET the registration is
+ * level-triggered: the socket is reported by every zsock_epoll_wait()
+ * call for as long as it is ready. With ZSOCK_EPOLLET it is reported
+ * once each time it is signalled, e.g. on new data, and the application
+ * is expected to drain it until EAGAIN.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param epfd Event queue file descriptor.
+ * @param op ZSOCK_EPOLL_CTL_ADD, ZSOCK_EPOLL_CTL_MOD or ZSOCK_EPOLL_CTL_DEL.
+ * @param fd Socket to register.
+ * @param event Requested events and user data, ignored for
+ *        ZSOCK_EPOLL_CTL_DEL.
+ *
+ * @return 0 on success, -1 with errno set on error.
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for events on registered sockets
+ *
+ * @details
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param epfd Event queue file descriptor.
+ * @param events Array where the reported events are stored.
+ * @param maxevents Size of the events array.
+ * @param timeout Timeout in milliseconds, -1 to wait forever and 0 to
+ *        return immediately.
+ *
+ * @return Number of events stored, 0 on timeout, -1 with errno set on
+ * error.
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
+#ifdef CONFIG_NET_SOCKETS_POSIX_NAMES
+
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLONESHOT ZSOCK_EPOLLONESHOT
+#define EPOLLET ZSOCK_EPOLLET
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
+#define epoll_event zsock_epoll_event
+#define epoll_data zsock_epoll_data
+#define epoll_data_t zsock_epoll_data_t
+
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create1(flags);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#endif /* CONFIG_NET_SOCKETS_POSIX_NAMES */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <syscalls/socket_epoll.h>
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
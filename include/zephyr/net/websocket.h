@@ -151,6 +151,31 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		       enum websocket_opcode opcode, bool mask, bool final,
 		       int32_t timeout);
 
+/**
+ * @brief Send websocket msg to peer from several buffers.
+ *
+ * @details Same as websocket_send_msg(), but the payload is gathered from
+ * several buffers. An unmasked message is sent with a single sendmsg() call
+ * using the header and the buffers as they are, without copying them. A
+ * masked message is sent from a masked copy of the payload, the buffers are
+ * not modified.
+ *
+ * @param ws_sock Websocket id returned by websocket_connect().
+ * @param iov Buffers holding the websocket data to send.
+ * @param iovcnt Number of buffers, at most CONFIG_WEBSOCKET_SEND_IOV_MAX.
+ * @param opcode Operation code (text, binary, ping, pong, close)
+ * @param mask Mask the data, see RFC 6455 for details
+ * @param final Is this final message for this message send, see
+ *        websocket_send_msg().
+ * @param timeout How long to try to send the message. The value is in
+ *        milliseconds. Value SYS_FOREVER_MS means to wait forever.
+ *
+ * @return <0 if error, >=0 amount of bytes sent
+ */
+int websocket_send_msgv(int ws_sock, const struct iovec *iov, size_t iovcnt,
+			enum websocket_opcode opcode, bool mask, bool final,
+			int32_t timeout);
+
 /**
  * @brief Receive websocket msg from peer.
  *
@@ -34,7 +34,11 @@ struct zperf_upload_params {
 	struct sockaddr peer_addr;
 	uint32_t duration_ms;
 	uint32_t rate_kbps;
+	/** Packets per second, overrides rate_kbps if not zero (UDP only) */
+	uint32_t rate_pps;
 	uint16_t packet_size;
+	/** Number of parallel streams, each with its own socket */
+	uint16_t num_streams;
 	char if_name[IFNAMSIZ];
 	struct {
 		uint8_t tos;
@@ -60,6 +64,14 @@ struct zperf_results {
 	uint64_t client_time_in_us;
 	uint32_t packet_size;
 	uint32_t nb_packets_errors;
+	/** One-way latency percentiles, from the UDP receiver */
+	uint32_t latency_p50_us;
+	uint32_t latency_p99_us;
+	uint32_t latency_p999_us;
+	/** CPU load during the upload in permille, 0 if not measured */
+	uint16_t cpu_load;
+	/** Number of streams aggregated in the upload results */
+	uint16_t num_streams;
 };
 
 /**
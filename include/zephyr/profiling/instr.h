@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_INSTR_H_
+#define ZEPHYR_INCLUDE_PROFILING_INSTR_H_
+
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Function instrumentation
+ * @defgroup profiling_instr Function instrumentation
+ * @ingroup os_services
+ *
+ * The code is built with -finstrument-functions and the entry and exit of
+ * the functions are recorded to a trace buffer while capture is started.
+ * @{
+ */
+
+/** @brief Type of a function instrumentation event. */
+enum instr_event_type {
+	/** Function entry. */
+	INSTR_EVENT_ENTRY,
+	/** Function exit. */
+	INSTR_EVENT_EXIT,
+};
+
+/** @brief Function instrumentation event. */
+struct instr_event {
+	/** Address of the function entered or exited. */
+	uintptr_t func;
+	/** Address the function was called from. */
+	uintptr_t call_site;
+	/** Thread running the function. */
+	const struct k_thread *thread;
+	/** Hardware cycle counter at the time of the event. */
+	uint32_t timestamp;
+	/** Event type. */
+	enum instr_event_type type;
+};
+
+/**
+ * @brief Function instrumentation event callback.
+ *
+ * @param event Event.
+ * @param user_data User data.
+ */
+typedef void (*instr_event_cb_t)(const struct instr_event *event, void *user_data);
+
+/**
+ * @brief Start capture.
+ *
+ * The events of a previous capture are discarded. Placed with instr_stop()
+ * around a region of interest, only the functions called in it are
+ * recorded, by all threads and interrupts.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if capture is already started.
+ */
+int instr_start(void);
+
+/**
+ * @brief Stop capture.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if capture is not started.
+ */
+int instr_stop(void);
+
+/**
+ * @brief Iterate over the events, in the order they were recorded.
+ *
+ * The events still being recorded by other contexts when capture was
+ * stopped are skipped.
+ *
+ * @param cb Callback called for each event.
+ * @param user_data User data given to the callback.
+ *
+ * @retval -EBUSY if capture is started.
+ * @return Number of events otherwise.
+ */
+int instr_events_foreach(instr_event_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the number of events lost because the trace buffer was full.
+ *
+ * @return Number of events lost since capture was started.
+ */
+uint32_t instr_lost_get(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_INSTR_H_ */
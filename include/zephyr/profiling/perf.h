@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_PERF_H_
+#define ZEPHYR_INCLUDE_PROFILING_PERF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sampling profiler
+ * @defgroup profiling_perf Sampling profiler
+ * @ingroup os_services
+ *
+ * A timer periodically records the stack trace of the code it interrupts
+ * to a buffer of the CPU handling it.
+ * @{
+ */
+
+/** @brief Profiling sample. */
+struct perf_sample {
+	/** CPU which took the sample. */
+	unsigned int cpu;
+	/** Thread interrupted by the sampling timer. */
+	const struct k_thread *thread;
+	/** Interrupted program counter followed by the return addresses of
+	 * its callers, innermost first.
+	 */
+	const uintptr_t *trace;
+	/** Number of entries of the stack trace. */
+	size_t len;
+};
+
+/**
+ * @brief Profiling sample callback.
+ *
+ * @param sample Sample.
+ * @param user_data User data.
+ */
+typedef void (*perf_sample_cb_t)(const struct perf_sample *sample, void *user_data);
+
+/**
+ * @brief Start sampling.
+ *
+ * The samples of a previous run are discarded. The sampling period is
+ * rounded to the system tick.
+ *
+ * @param frequency Sampling frequency in Hz.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the frequency is 0 or above 1 MHz.
+ * @retval -EALREADY if sampling is already started.
+ */
+int perf_start(uint32_t frequency);
+
+/**
+ * @brief Stop sampling.
+ *
+ * @retval 0 on success.
+ * @retval -EALREADY if sampling is not started.
+ */
+int perf_stop(void);
+
+/**
+ * @brief Iterate over the samples.
+ *
+ * @param cb Callback called for each sample, CPU by CPU.
+ * @param user_data User data given to the callback.
+ *
+ * @retval -EBUSY if sampling is started.
+ * @return Number of samples otherwise.
+ */
+int perf_samples_foreach(perf_sample_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the number of samples lost.
+ *
+ * Samples are lost when the buffer of the CPU is full, or when the timer
+ * interrupts another interrupt.
+ *
+ * @return Number of samples lost since sampling was started.
+ */
+uint32_t perf_lost_get(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_PERF_H_ */
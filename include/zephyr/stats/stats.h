@@ -46,6 +46,11 @@
  *     s<stat-idx>
  *
  * E.g., "s0", "s1", etc.
+ *
+ * When CONFIG_STATS_PER_CPU is defined, each CPU increments its own copy of
+ * the entries, on a cache line of its own, and the copies are summed when the
+ * statistics are read with STATS_GET() or stats_value_get().  The entries
+ * must then only be accessed through the macros below.
  */
 
 #ifndef ZEPHYR_INCLUDE_STATS_STATS_H_
@@ -54,6 +59,12 @@
 #include <stddef.h>
 #include <zephyr/types.h>
 
+#ifdef CONFIG_STATS_PER_CPU
+#include <zephyr/arch/cpu.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/util.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -86,7 +97,14 @@ struct stats_hdr {
 /**
  * @brief Ends a stats group struct definition.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_SECT_END							\
+		} s_entries;						\
+	} __aligned(CONFIG_STATS_PER_CPU_ALIGNMENT) s_cpu[CONFIG_MP_MAX_NUM_CPUS]; \
+	}
+#else
 #define STATS_SECT_END }
+#endif
 
 /* The following macros depend on whether CONFIG_STATS is defined.  If it is
  * not defined, then invocations of these macros get compiled out.
@@ -98,10 +116,52 @@ struct stats_hdr {
  *
  * @param group__               The stats group struct name.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_SECT_START(group__)  \
+	STATS_SECT_DECL(group__) { \
+		struct stats_hdr s_hdr; \
+		struct {		\
+			struct {
+
+/* Entries of a CPU, and offset and size of the entries of the first CPU. */
+#define Z_STATS_ENTRY(group__, cpu__, var__) \
+	((group__).s_cpu[(cpu__)].s_entries.var__)
+#define Z_STATS_ENTRY_OFF(sectname__, var__) \
+	offsetof(STATS_SECT_DECL(sectname__), s_cpu[0].s_entries.var__)
+#define Z_STATS_ENTRIES_SIZE(group__) sizeof((group__).s_cpu[0].s_entries)
+
+/* Update the entries of the current CPU, whose index is given in cpu__.
+ * Interrupts are locked so that a preemptible thread cannot move to another
+ * CPU between reading the index and writing the entry, which also makes
+ * _current_cpu valid from such a thread.
+ */
+#define Z_STATS_CPU_UPDATE(cpu__, update__)			\
+	do {							\
+		unsigned int key__ = arch_irq_lock();		\
+		unsigned int cpu__ = _current_cpu->id;		\
+								\
+		update__;					\
+		arch_irq_unlock(key__);				\
+	} while (false)
+#else
 #define STATS_SECT_START(group__)  \
 	STATS_SECT_DECL(group__) { \
 		struct stats_hdr s_hdr;
 
+#define Z_STATS_ENTRY(group__, cpu__, var__) ((group__).var__)
+#define Z_STATS_ENTRY_OFF(sectname__, var__) \
+	offsetof(STATS_SECT_DECL(sectname__), var__)
+#define Z_STATS_ENTRIES_SIZE(group__) \
+	(sizeof(group__) - sizeof(struct stats_hdr))
+#define Z_STATS_CPU_UPDATE(cpu__, update__)	\
+	do {					\
+		unsigned int cpu__ = 0;		\
+						\
+		(void)cpu__;			\
+		update__;			\
+	} while (false)
+#endif
+
 /**
  * @brief Declares a 32-bit stat entry inside a group struct.
  *
@@ -140,8 +200,13 @@ struct stats_hdr {
  * @param var__                 The statistic entry to increase.
  * @param n__                   The amount to increase the statistic entry by.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_INCN(group__, var__, n__)					\
+	Z_STATS_CPU_UPDATE(cpu__, Z_STATS_ENTRY(group__, cpu__, var__) += (n__))
+#else
 #define STATS_INCN(group__, var__, n__)	\
 	((group__).var__ += (n__))
+#endif
 
 /**
  * @brief Increments a statistic entry.
@@ -165,8 +230,16 @@ struct stats_hdr {
  * @param var__                 The statistic entry to increase.
  * @param n__                   The amount to set the statistic entry to.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_SET(group__, var__, n__)			\
+	do {						\
+		STATS_CLEAR(group__, var__);		\
+		Z_STATS_ENTRY(group__, 0, var__) = (n__); \
+	} while (false)
+#else
 #define STATS_SET(group__, var__, n__)	\
 	((group__).var__ = (n__))
+#endif
 
 /**
  * @brief Sets a statistic entry to zero.
@@ -177,8 +250,40 @@ struct stats_hdr {
  * @param group__               The group containing the entry to clear.
  * @param var__                 The statistic entry to clear.
  */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_CLEAR(group__, var__)						\
+	do {									\
+		for (int cpu__ = 0; cpu__ < CONFIG_MP_MAX_NUM_CPUS; cpu__++) {	\
+			Z_STATS_ENTRY(group__, cpu__, var__) = 0;		\
+		}								\
+	} while (false)
+#else
 #define STATS_CLEAR(group__, var__) \
 	((group__).var__ = 0)
+#endif
+
+/**
+ * @brief Gets the value of a statistic entry.
+ *
+ * Returns 0 if CONFIG_STATS is not defined.
+ *
+ * @param group__               The group containing the entry to get.
+ * @param var__                 The statistic entry to get.
+ */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_GET(group__, var__)						\
+	({									\
+		__typeof__(Z_STATS_ENTRY(group__, 0, var__)) sum__ = 0;	\
+										\
+		for (int cpu__ = 0; cpu__ < CONFIG_MP_MAX_NUM_CPUS; cpu__++) {	\
+			sum__ += Z_STATS_ENTRY(group__, cpu__, var__);		\
+		}								\
+		sum__;								\
+	})
+#else
+#define STATS_GET(group__, var__) \
+	((group__).var__)
+#endif
 
 #define STATS_SIZE_16 (sizeof(uint16_t))
 #define STATS_SIZE_32 (sizeof(uint32_t))
@@ -186,7 +291,7 @@ struct stats_hdr {
 
 #define STATS_SIZE_INIT_PARMS(group__, size__) \
 	(size__),			       \
-	((sizeof(group__)) - sizeof(struct stats_hdr)) / (size__)
+	Z_STATS_ENTRIES_SIZE(group__) / (size__)
 
 /**
  * @brief Initializes and registers a statistics group.
@@ -206,7 +311,7 @@ struct stats_hdr {
 	stats_init_and_reg(						 \
 		&(group__).s_hdr,					 \
 		(size__),						 \
-		(sizeof(group__) - sizeof(struct stats_hdr)) / (size__), \
+		Z_STATS_ENTRIES_SIZE(group__) / (size__),		 \
 		STATS_NAME_INIT_PARMS(group__),				 \
 		(name__))
 
@@ -306,6 +411,19 @@ typedef int stats_walk_fn(struct stats_hdr *hdr, void *arg,
  */
 int stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_cb, void *arg);
 
+/**
+ * @brief Gets the value of a stat entry.
+ *
+ * Reads the entry at the offset given to a walk function, summing the copies
+ * of the CPUs when CONFIG_STATS_PER_CPU is defined.
+ *
+ * @param hdr                   The group containing the stat entry.
+ * @param off                   The offset of the entry, from `hdr`.
+ *
+ * @return                      The value of the entry.
+ */
+uint64_t stats_value_get(const struct stats_hdr *hdr, uint16_t off);
+
 /** @typedef stats_group_walk_fn
  * @brief Function that gets applied to every registered stats group.
  *
@@ -364,6 +482,7 @@ struct stats_hdr *stats_group_find(const char *name);
 #define STATS_INC(group__, var__)
 #define STATS_SET(group__, var__)
 #define STATS_CLEAR(group__, var__)
+#define STATS_GET(group__, var__) 0
 #define STATS_INIT_AND_REG(group__, size__, name__) (0)
 
 #endif /* !CONFIG_STATS */
@@ -376,7 +495,7 @@ struct stats_hdr *stats_group_find(const char *name);
 	static const struct stats_name_map STATS_NAME_MAP_NAME(sectname__)[] = {
 
 #define STATS_NAME(sectname__, entry__)	\
-	{ offsetof(STATS_SECT_DECL(sectname__), entry__), #entry__ },
+	{ Z_STATS_ENTRY_OFF(sectname__, entry__), #entry__ },
 
 #define STATS_NAME_END(sectname__) }
 
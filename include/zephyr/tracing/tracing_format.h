@@ -82,6 +82,19 @@ void tracing_format_raw_data(uint8_t *data, uint32_t length);
  */
 void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count);
 
+/**
+ * @brief Dump the flight recorder.
+ *
+ * Give the packets held in the per-CPU buffers to the backend, merged in
+ * timestamp order, and empty the buffers. Packets traced during the dump
+ * are discarded. May be called from a fatal error handler. Requires
+ * CONFIG_TRACING_FLIGHT_RECORDER.
+ *
+ * @retval -EBUSY if the flight recorder is already being dumped.
+ * @return Number of packets dumped otherwise.
+ */
+int tracing_flight_recorder_dump(void);
+
 /** @} */ /* end of subsys_tracing_format_apis */
 
 #ifdef __cplusplus
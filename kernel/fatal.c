@@ -14,6 +14,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/fatal.h>
 #include <zephyr/debug/coredump.h>
+#include <zephyr/tracing/tracing_format.h>
 
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 
@@ -115,6 +116,10 @@ void z_fatal_error(unsigned int reason, const z_arch_esf_t *esf)
 
 	coredump(reason, esf, thread);
 
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER_DUMP_ON_FATAL
+	(void)tracing_flight_recorder_dump();
+#endif
+
 	k_sys_fatal_error_handler(reason, esf);
 
 	/* If the system fatal error handler returns, then kill the faulting
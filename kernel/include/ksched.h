@@ -293,6 +293,33 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_SCHED_USAGE_MONITOR_ISR
+/**
+ * @brief Mark the entry of an interrupt handler for the usage monitor
+ *
+ * Called by architectures selecting CONFIG_ARCH_HAS_ISR_USAGE before
+ * calling the handler of an interrupt, with the matching call to
+ * z_sched_usage_isr_exit() after it returns.
+ */
+void z_sched_usage_isr_enter(void);
+
+/**
+ * @brief Mark the exit of an interrupt handler for the usage monitor
+ *
+ * @param irq Interrupt line of the handler
+ */
+void z_sched_usage_isr_exit(unsigned int irq);
+#else
+static inline void z_sched_usage_isr_enter(void)
+{
+}
+
+static inline void z_sched_usage_isr_exit(unsigned int irq)
+{
+	ARG_UNUSED(irq);
+}
+#endif /* CONFIG_SCHED_USAGE_MONITOR_ISR */
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
@@ -991,7 +991,14 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->average_cycles   += tmp_stats.average_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 		stats->idle_cycles      += tmp_stats.idle_cycles;
+#ifdef CONFIG_SCHED_USAGE_MONITOR
+		stats->window_load      += tmp_stats.window_load;
+#endif /* CONFIG_SCHED_USAGE_MONITOR */
 	}
+
+#ifdef CONFIG_SCHED_USAGE_MONITOR
+	stats->window_load /= num_cpus;
+#endif /* CONFIG_SCHED_USAGE_MONITOR */
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
 	return 0;
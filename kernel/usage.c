@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <zephyr/kernel.h>
 
 #include <zephyr/timing/timing.h>
@@ -148,6 +149,15 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 		cpu->usage0 = now;
 	}
 
+	cpu = &_kernel.cpus[cpu_id];
+
+	if (cpu->usage == NULL) {
+		/* The CPU has not been started */
+		memset(stats, 0, sizeof(*stats));
+		k_spin_unlock(&usage_lock, key);
+		return;
+	}
+
 	stats->total_cycles     = cpu->usage->total;
 #ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
 	stats->current_cycles   = cpu->usage->current;
@@ -161,11 +171,14 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 	}
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 
-	stats->idle_cycles =
-		_kernel.cpus[cpu_id].idle_thread->base.usage.total;
+	stats->idle_cycles = cpu->idle_thread->base.usage.total;
 
 	stats->execution_cycles = stats->total_cycles + stats->idle_cycles;
 
+#ifdef CONFIG_SCHED_USAGE_MONITOR
+	stats->window_load = cpu->usage->window_load;
+#endif /* CONFIG_SCHED_USAGE_MONITOR */
+
 	k_spin_unlock(&usage_lock, key);
 }
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
@@ -222,6 +235,10 @@ void z_sched_thread_usage(struct k_thread *thread,
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 	stats->execution_cycles = thread->base.usage.total;
 
+#ifdef CONFIG_SCHED_USAGE_MONITOR
+	stats->window_load = thread->base.usage.window_load;
+#endif /* CONFIG_SCHED_USAGE_MONITOR */
+
 	k_spin_unlock(&usage_lock, key);
 }
 
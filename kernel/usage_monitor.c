@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <ksched.h>
+#include <kernel_internal.h>
+
+#define LOAD_MAX 1000U
+
+#define HISTORY_LEN CONFIG_SCHED_USAGE_MONITOR_HISTORY
+
+static struct k_spinlock monitor_lock;
+static struct k_usage_window history[HISTORY_LEN];
+static size_t history_next;
+static size_t history_len;
+
+struct thread_sample {
+	struct k_usage_window *window;
+	uint64_t cycles;
+};
+
+#ifdef CONFIG_SCHED_USAGE_MONITOR_ISR
+struct isr_cpu_usage {
+	uint32_t start;
+	uint32_t nested;
+	atomic_t cycles;
+};
+
+static struct isr_cpu_usage isr_cpus[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t isr_cycles[CONFIG_SCHED_USAGE_MONITOR_NUM_IRQS];
+static int64_t isr_window_start;
+
+void z_sched_usage_isr_enter(void)
+{
+	struct isr_cpu_usage *usage = &isr_cpus[_current_cpu->id];
+
+	if (usage->nested++ == 0U) {
+		usage->start = k_cycle_get_32();
+	}
+}
+
+void z_sched_usage_isr_exit(unsigned int irq)
+{
+	struct isr_cpu_usage *usage = &isr_cpus[_current_cpu->id];
+	uint32_t cycles;
+
+	if (--usage->nested != 0U) {
+		return;
+	}
+
+	cycles = k_cycle_get_32() - usage->start;
+
+	atomic_add(&usage->cycles, (atomic_val_t)cycles);
+
+	if (irq < ARRAY_SIZE(isr_cycles)) {
+		atomic_add(&isr_cycles[irq], (atomic_val_t)cycles);
+	}
+}
+#endif /* CONFIG_SCHED_USAGE_MONITOR_ISR */
+
+static uint16_t usage_load(uint64_t used, uint64_t cycles)
+{
+	if (cycles == 0U) {
+		return 0;
+	}
+
+	return (uint16_t)MIN(used * LOAD_MAX / cycles, LOAD_MAX);
+}
+
+/* Usage since the start of the window, restarting the window. The totals
+ * may have been reset through the object core statistics.
+ */
+static uint64_t usage_window_update(struct k_cycle_stats *usage, uint64_t total)
+{
+	uint64_t used = (total >= usage->window_start) ? total - usage->window_start : total;
+
+	usage->window_start = total;
+
+	return used;
+}
+
+static void thread_sample(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	struct thread_sample *sample = user_data;
+	struct k_usage_window_thread *top = sample->window->threads;
+	k_thread_runtime_stats_t stats;
+	uint16_t load;
+	size_t i;
+
+	if (z_is_idle_thread_object(thread)) {
+		return;
+	}
+
+	z_sched_thread_usage(thread, &stats);
+
+	load = usage_load(usage_window_update(&thread->base.usage, stats.total_cycles),
+			  sample->cycles);
+	thread->base.usage.window_load = load;
+
+	/* Insert in the busiest threads, sorted by decreasing load. */
+	for (i = CONFIG_SCHED_USAGE_MONITOR_TOP_THREADS; i > 0; i--) {
+		if ((top[i - 1].thread != NULL) && (top[i - 1].load >= load)) {
+			break;
+		}
+
+		if (i < CONFIG_SCHED_USAGE_MONITOR_TOP_THREADS) {
+			top[i] = top[i - 1];
+		}
+	}
+
+	if ((i < CONFIG_SCHED_USAGE_MONITOR_TOP_THREADS) && (load > 0U)) {
+		top[i].thread = thread;
+		top[i].load = load;
+	}
+}
+
+#ifdef CONFIG_SCHED_USAGE_MONITOR_ISR
+static void isr_sample(struct k_usage_window *window)
+{
+	struct k_usage_window_isr *top = window->isrs;
+	int64_t now = k_uptime_ticks();
+	uint64_t cycles = k_ticks_to_cyc_floor64(now - isr_window_start);
+	unsigned int num_cpus = arch_num_cpus();
+
+	isr_window_start = now;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		window->isr_load[i] = usage_load((uint32_t)atomic_clear(&isr_cpus[i].cycles),
+						 cycles);
+	}
+
+	for (unsigned int irq = 0; irq < ARRAY_SIZE(isr_cycles); irq++) {
+		uint16_t load = usage_load((uint32_t)atomic_clear(&isr_cycles[irq]), cycles);
+		size_t i;
+
+		if (load == 0U) {
+			continue;
+		}
+
+		for (i = CONFIG_SCHED_USAGE_MONITOR_TOP_ISRS; i > 0; i--) {
+			if (top[i - 1].load >= load) {
+				break;
+			}
+
+			if (i < CONFIG_SCHED_USAGE_MONITOR_TOP_ISRS) {
+				top[i] = top[i - 1];
+			}
+		}
+
+		if (i < CONFIG_SCHED_USAGE_MONITOR_TOP_ISRS) {
+			top[i].irq = irq;
+			top[i].load = load;
+		}
+	}
+}
+#endif /* CONFIG_SCHED_USAGE_MONITOR_ISR */
+
+/*
+ * Windows are computed by a work item rather than from the timer interrupt,
+ * as the time taken is linear in the number of threads. The thread list is
+ * walked unlocked, so that interrupts are only locked for one thread at a
+ * time, and the window is built aside to only lock the history to store it.
+ */
+static void usage_monitor_sample(struct k_work *work)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int started_cpus = 0;
+	struct k_usage_window window = {0};
+	struct thread_sample sample = { .window = &window };
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(work);
+
+	window.end_ms = k_uptime_get_32();
+
+	/*
+	 * The load of a CPU is the share of its time not spent in its idle
+	 * thread. Only the usage of the current CPU is up to date, the usage
+	 * of the others is as of their last context switch.
+	 */
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct _cpu *cpu = &_kernel.cpus[i];
+		k_thread_runtime_stats_t stats;
+		uint64_t busy;
+		uint64_t idle;
+
+		if (cpu->usage == NULL) {
+			/* The CPU has not been started */
+			continue;
+		}
+
+		z_sched_cpu_usage(i, &stats);
+
+		busy = usage_window_update(cpu->usage, stats.total_cycles);
+		idle = usage_window_update(&cpu->idle_thread->base.usage, stats.idle_cycles);
+
+		cpu->usage->window_load = usage_load(busy, busy + idle);
+		cpu->idle_thread->base.usage.window_load = usage_load(idle, busy + idle);
+		window.cpu_load[i] = cpu->usage->window_load;
+		sample.cycles += busy + idle;
+		started_cpus++;
+	}
+
+	/* Thread loads are relative to the time of a single CPU. */
+	sample.cycles /= started_cpus;
+
+	k_thread_foreach_unlocked(thread_sample, &sample);
+
+#ifdef CONFIG_SCHED_USAGE_MONITOR_ISR
+	isr_sample(&window);
+#endif
+
+	key = k_spin_lock(&monitor_lock);
+
+	history[history_next] = window;
+	history_next = (history_next + 1) % HISTORY_LEN;
+	history_len = MIN(history_len + 1, HISTORY_LEN);
+
+	k_spin_unlock(&monitor_lock, key);
+}
+
+static K_WORK_DEFINE(usage_monitor_work, usage_monitor_sample);
+
+static void usage_monitor_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	k_work_submit(&usage_monitor_work);
+}
+
+static K_TIMER_DEFINE(usage_monitor_timer, usage_monitor_expiry, NULL);
+
+int k_usage_monitor_window_get(unsigned int age, struct k_usage_window *window)
+{
+	k_spinlock_key_t key;
+	int ret = -ENOENT;
+
+	key = k_spin_lock(&monitor_lock);
+
+	if (age < history_len) {
+		*window = history[(history_next + HISTORY_LEN - 1 - age) % HISTORY_LEN];
+		ret = 0;
+	}
+
+	k_spin_unlock(&monitor_lock, key);
+
+	return ret;
+}
+
+static int usage_monitor_init(void)
+{
+	k_timeout_t period = K_MSEC(CONFIG_SCHED_USAGE_MONITOR_WINDOW_MS);
+
+#ifdef CONFIG_SCHED_USAGE_MONITOR_ISR
+	isr_window_start = k_uptime_ticks();
+#endif
+
+	k_timer_start(&usage_monitor_timer, period, period);
+
+	return 0;
+}
+
+SYS_INIT(usage_monitor_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
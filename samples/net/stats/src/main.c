@@ -16,11 +16,10 @@ LOG_MODULE_REGISTER(net_stats_sample, LOG_LEVEL_DBG);
 
 static struct k_work_delayable stats_timer;
 
-#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
-#define GET_STAT(iface, s) (iface ? iface->stats.s : data->s)
-#else
+/* The statistics are read with net_mgmt(), which also sums them when they
+ * are collected per CPU.
+ */
 #define GET_STAT(iface, s) data->s
-#endif
 
 static void print_stats(struct net_if *iface, struct net_stats *data)
 {
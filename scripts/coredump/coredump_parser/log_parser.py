@@ -23,6 +23,13 @@ COREDUMP_MEM_HDR_VER = 1
 LOG_MEM_HDR_STRUCT = "<cH"
 LOG_MEM_HDR_SIZE = struct.calcsize(LOG_MEM_HDR_STRUCT)
 
+COREDUMP_COMPRESSED_MEM_HDR_ID = b'C'
+COREDUMP_COMPRESSED_MEM_HDR_VER = 1
+
+COREDUMP_COMPRESS_TOKEN_MATCH = 0x80
+COREDUMP_COMPRESS_MATCH_MIN = 4
+COREDUMP_COMPRESS_MATCH_LEN_EXT = 0x7f
+
 
 logger = logging.getLogger("parser")
 
@@ -45,6 +52,60 @@ def reason_string(reason):
     return ret
 
 
+def decompress(fd, size):
+    """
+    Decompress the content of a compressed memory block
+    of the given size, see COREDUMP_COMPRESS_* in coredump.h.
+    """
+    data = bytearray()
+
+    while len(data) < size:
+        token = fd.read(1)
+        if not token:
+            raise ValueError("truncated block")
+
+        token = token[0]
+        if token < COREDUMP_COMPRESS_TOKEN_MATCH:
+            literals = fd.read(token + 1)
+            if len(literals) != token + 1:
+                raise ValueError("truncated literals")
+
+            data += literals
+            continue
+
+        dist = fd.read(2)
+        if len(dist) != 2:
+            raise ValueError("truncated match")
+
+        dist = struct.unpack("<H", dist)[0]
+        length = token & COREDUMP_COMPRESS_MATCH_LEN_EXT
+        if length == COREDUMP_COMPRESS_MATCH_LEN_EXT:
+            while True:
+                ext = fd.read(1)
+                if not ext:
+                    raise ValueError("truncated match length")
+
+                length += ext[0]
+                if ext[0] != 0xff:
+                    break
+
+        length += COREDUMP_COMPRESS_MATCH_MIN
+
+        if dist == 0 or dist > len(data):
+            raise ValueError(f"match distance {dist} out of block")
+
+        # Matches may overlap the bytes they produce.
+        while length > 0:
+            chunk = data[-dist:len(data) - dist + min(length, dist)]
+            data += chunk
+            length -= len(chunk)
+
+    if len(data) != size:
+        raise ValueError("data past end of block")
+
+    return bytes(data)
+
+
 class CoredumpLogFile:
     """
     Process the binary coredump file for register block
@@ -58,6 +119,7 @@ class CoredumpLogFile:
         self.log_hdr = None
         self.arch_data = list()
         self.memory_regions = list()
+        self.memory_size = 0
 
     def open(self):
         self.fd = open(self.logfile, "rb")
@@ -81,12 +143,13 @@ class CoredumpLogFile:
 
         return True
 
-    def parse_memory_section(self):
+    def parse_memory_section(self, compressed=False):
         hdr = self.fd.read(LOG_MEM_HDR_SIZE)
         _, hdr_ver = struct.unpack(LOG_MEM_HDR_STRUCT, hdr)
 
-        if hdr_ver != COREDUMP_MEM_HDR_VER:
-            logger.error(f"Memory block version: {hdr_ver}, expected {COREDUMP_MEM_HDR_VER}!")
+        expected_ver = COREDUMP_COMPRESSED_MEM_HDR_VER if compressed else COREDUMP_MEM_HDR_VER
+        if hdr_ver != expected_ver:
+            logger.error(f"Memory block version: {hdr_ver}, expected {expected_ver}!")
             return False
 
         # Figure out how to read the start and end addresses
@@ -103,13 +166,25 @@ class CoredumpLogFile:
 
         size = eaddr - saddr
 
-        data = self.fd.read(size)
+        if compressed:
+            offset = self.fd.tell()
+            try:
+                data = decompress(self.fd, size)
+            except ValueError as e:
+                logger.error(f"Cannot decompress memory block: {e}")
+                return False
+
+            logger.info("Memory: 0x%x to 0x%x of size %d, compressed to %d" %
+                        (saddr, eaddr, size, self.fd.tell() - offset))
+        else:
+            data = self.fd.read(size)
+
+            logger.info("Memory: 0x%x to 0x%x of size %d" %
+                        (saddr, eaddr, size))
 
         mem = {"start": saddr, "end": eaddr, "data": data}
         self.memory_regions.append(mem)
-
-        logger.info("Memory: 0x%x to 0x%x of size %d" %
-                    (saddr, eaddr, size))
+        self.memory_size += size
 
         return True
 
@@ -159,9 +234,15 @@ class CoredumpLogFile:
                 if not self.parse_memory_section():
                     logger.error("Cannot parse memory section")
                     return False
+            elif section_id == COREDUMP_COMPRESSED_MEM_HDR_ID:
+                if not self.parse_memory_section(compressed=True):
+                    logger.error("Cannot parse compressed memory section")
+                    return False
             else:
                 # Unknown section in log file
                 logger.error(f"Unknown section in log file with ID {section_id}")
                 return False
 
+        logger.info(f"Dump size {self.fd.tell()}, memory size {self.memory_size}")
+
         return True
@@ -50,6 +50,7 @@ FMT_MSG_HDR_64 = "IQ"
 # Message type
 # 0: normal message
 # 1: number of dropped messages
+# 2: normal message with packed header
 FMT_MSG_TYPE = "B"
 
 # Depends on CONFIG_LOG_TIMESTAMP_64BIT
@@ -59,6 +60,20 @@ FMT_MSG_TIMESTAMP_64 = "Q"
 # Keep message types in sync with include/logging/log_output_dict.h
 MSG_TYPE_NORMAL = 0
 MSG_TYPE_DROPPED = 1
+MSG_TYPE_NORMAL_PACKED = 2
+
+# Packed message header, see log_dict_output_packed_msg_process():
+#
+#     uint8_t type;
+#     uint8_t desc; /* domain:3, level:3, delta timestamp:1, has data:1 */
+#     varint source_id;
+#     varint timestamp;
+#     varint package_len;
+#     varint data_len; /* only if desc has data */
+#
+# Varints are little endian base 128 (LEB128).
+PACKED_DESC_DELTA_TIMESTAMP = 0x40
+PACKED_DESC_HAS_DATA = 0x80
 
 # Number of dropped messages
 FMT_DROPPED_CNT = "H"
@@ -67,6 +82,22 @@ FMT_DROPPED_CNT = "H"
 logger = logging.getLogger("parser")
 
 
+def decode_varint(logdata, offset):
+    """Decode a LEB128 value, returning the value and the offset past it"""
+    value = 0
+    shift = 0
+
+    while True:
+        one_byte = logdata[offset]
+        offset += 1
+
+        value |= (one_byte & 0x7f) << shift
+        shift += 7
+
+        if (one_byte & 0x80) == 0:
+            return (value, offset)
+
+
 def get_log_level_str_color(lvl):
     """Convert numeric log level to string"""
     if lvl < 0 or lvl >= len(LOG_LEVELS):
@@ -192,6 +223,9 @@ class LogParserV1(LogParser):
 
         self.data_types = DataTypes(self.database)
 
+        # Timestamp of the last packed message, reference of delta timestamps
+        self.packed_timestamp = None
+
 
     def __get_string(self, arg, arg_offset, string_tbl):
         one_str = self.database.find_string(arg)
@@ -374,12 +408,55 @@ class LogParserV1(LogParser):
         pkg_len = (log_desc >> 6) & int(math.pow(2, 10) - 1)
         data_len = (log_desc >> 16) & int(math.pow(2, 12) - 1)
 
+        return self.print_one_msg(logdata, offset, domain_id, level, source_id,
+                                  timestamp, pkg_len, data_len)
+
+
+    def parse_one_packed_msg(self, logdata, offset):
+        """Parse one normal log message with packed header and print
+        the encoded message"""
+        log_desc = logdata[offset]
+        offset += 1
+
+        source_id, offset = decode_varint(logdata, offset)
+        timestamp, offset = decode_varint(logdata, offset)
+        pkg_len, offset = decode_varint(logdata, offset)
+
+        if log_desc & PACKED_DESC_HAS_DATA:
+            data_len, offset = decode_varint(logdata, offset)
+        else:
+            data_len = 0
+
+        if log_desc & PACKED_DESC_DELTA_TIMESTAMP:
+            if self.packed_timestamp is None:
+                logger.warning("------ Delta timestamp without reference")
+                self.packed_timestamp = 0
+
+            timestamp += self.packed_timestamp
+
+        self.packed_timestamp = timestamp
+
+        domain_id = log_desc & 0x07
+        level = (log_desc >> 3) & 0x07
+
+        return self.print_one_msg(logdata, offset, domain_id, level, source_id,
+                                  timestamp, pkg_len, data_len)
+
+
+    def print_one_msg(self, logdata, offset, domain_id, level, source_id,
+                      timestamp, pkg_len, data_len):
+        """Print one normal log message whose package starts at offset"""
         level_str, color = get_log_level_str_color(level)
         source_id_str = self.database.get_log_source_string(domain_id, source_id)
 
         # Skip over data to point to next message (save as return value)
         next_msg_offset = offset + pkg_len + data_len
 
+        if next_msg_offset > len(logdata):
+            # Log files may end with a partially written message
+            logger.warning("------ Truncated message at end of log data")
+            return len(logdata)
+
         # Offset from beginning of cbprintf_packaged data to end of va_list arguments
         offset_end_of_args = struct.unpack_from("B", logdata, offset)[0]
         offset_end_of_args *= self.data_types.get_sizeof(DataTypes.INT)
@@ -460,8 +537,17 @@ class LogParserV1(LogParser):
 
                 print(f"--- {num_dropped} messages dropped ---")
 
-            elif msg_type == MSG_TYPE_NORMAL:
-                ret = self.parse_one_normal_msg(logdata, offset)
+            elif msg_type in (MSG_TYPE_NORMAL, MSG_TYPE_NORMAL_PACKED):
+                try:
+                    if msg_type == MSG_TYPE_NORMAL:
+                        ret = self.parse_one_normal_msg(logdata, offset)
+                    else:
+                        ret = self.parse_one_packed_msg(logdata, offset)
+                except (IndexError, struct.error):
+                    # Log files may end with a partially written header
+                    logger.warning("------ Truncated message at end of log data")
+                    break
+
                 if ret is None:
                     return False
 
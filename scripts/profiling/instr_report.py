@@ -0,0 +1,261 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Zephyr Project
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Report the time spent in functions from a function instrumentation trace
+
+Reads the output of the ``instr dump`` shell command, rebuilds the call
+stacks of each thread from the function entry and exit events, and prints
+for each function the number of calls and the time spent in it, including
+(inclusive) and excluding (exclusive) the functions it called::
+
+    instr_report.py zephyr.elf instr.log
+
+Times are wall clock: they include the time the thread was preempted.
+Functions entered before or still running after the capture are not
+accounted. With ``--callgraph``, the calls between functions are reported
+instead, and with ``--folded`` the exclusive time of each call stack is
+printed as folded stacks for flamegraph.pl.
+
+Lines of the log other than the ones printed by ``instr dump`` are ignored,
+so a capture of the whole console can be given. On native_sim, use
+zephyr.exe as the ELF file.
+"""
+
+import argparse
+import collections
+import re
+import sys
+
+from stackcollapse import Symbols
+
+CYCLES_RE = re.compile(r"cycles (\d+)$")
+THREAD_RE = re.compile(r"thread (0x[0-9a-fA-F]+) (.+)$")
+EVENT_RE = re.compile(r"(entry|exit) (\d+) (0x[0-9a-fA-F]+) (0x[0-9a-fA-F]+) "
+                      r"(0x[0-9a-fA-F]+|0)$")
+
+TIMESTAMP_MASK = 0xffffffff
+
+
+class Stats:
+    def __init__(self):
+        self.calls = 0
+        self.inclusive = 0
+        self.exclusive = 0
+
+
+class Frame:
+    def __init__(self, func, start):
+        self.func = func
+        self.start = start
+        self.children = 0
+
+
+def parse_log(log):
+    cycles = None
+    threads = {}
+    events = []
+
+    for line in log:
+        line = line.strip()
+
+        match = CYCLES_RE.search(line)
+        if match:
+            cycles = int(match.group(1))
+            continue
+
+        match = THREAD_RE.search(line)
+        if match:
+            threads[int(match.group(1), 16)] = match.group(2)
+            continue
+
+        match = EVENT_RE.search(line)
+        if match:
+            events.append((match.group(1) == "entry", int(match.group(2)),
+                           int(match.group(3), 16), int(match.group(4), 16)))
+
+    return cycles, threads, events
+
+
+def unwrap(events):
+    """Extend the 32-bit timestamps, allowing them to go slightly backwards
+    between events recorded concurrently by several CPUs."""
+    last = None
+    now = 0
+
+    for entry, timestamp, thread, func in events:
+        if last is not None:
+            delta = (timestamp - last) & TIMESTAMP_MASK
+            if delta > TIMESTAMP_MASK // 2:
+                delta -= TIMESTAMP_MASK + 1
+            now += delta
+        last = timestamp
+        yield entry, now, thread, func
+
+
+def analyze(events, thread_filter):
+    funcs = collections.defaultdict(Stats)
+    edges = collections.defaultdict(Stats)
+    stacks = collections.Counter()
+    threads = collections.defaultdict(list)
+
+    for entry, now, thread, func in unwrap(events):
+        if thread_filter is not None and thread not in thread_filter:
+            continue
+
+        stack = threads[thread]
+
+        if entry:
+            stack.append(Frame(func, now))
+            continue
+
+        # Exits of functions entered before the capture was started.
+        if not any(frame.func == func for frame in stack):
+            continue
+
+        # Unwind the functions which did not record their exit, such as
+        # the ones leaving with a long jump.
+        while stack[-1].func != func:
+            stack.pop()
+
+        frame = stack.pop()
+        duration = now - frame.start
+        caller = stack[-1].func if stack else None
+
+        stats = funcs[func]
+        stats.calls += 1
+        stats.exclusive += duration - frame.children
+        # Recursive calls are already included in the outermost one.
+        if not any(f.func == func for f in stack):
+            stats.inclusive += duration
+
+        edge = edges[(caller, func)]
+        edge.calls += 1
+        edge.inclusive += duration
+        edge.exclusive += duration - frame.children
+
+        path = tuple(f.func for f in stack) + (func,)
+        stacks[(thread, path)] += duration - frame.children
+
+        if stack:
+            stack[-1].children += duration
+
+    return funcs, edges, stacks
+
+
+def time_str(value, cycles):
+    if cycles:
+        return f"{value * 1000000 / cycles:.1f}"
+    return str(value)
+
+
+def print_funcs(symbols, funcs, cycles, sort):
+    unit = "us" if cycles else "cycles"
+    print(f"{'calls':>10} {'incl ' + unit:>14} {'excl ' + unit:>14}  function")
+
+    for func, stats in sorted(funcs.items(),
+                              key=lambda item: getattr(item[1], sort),
+                              reverse=True):
+        print(f"{stats.calls:>10} {time_str(stats.inclusive, cycles):>14} "
+              f"{time_str(stats.exclusive, cycles):>14}  "
+              f"{symbols.lookup(func)}")
+
+
+def print_callgraph(symbols, edges, cycles, sort):
+    unit = "us" if cycles else "cycles"
+    print(f"{'calls':>10} {'incl ' + unit:>14} {'excl ' + unit:>14}  caller -> callee")
+
+    for (caller, func), stats in sorted(edges.items(),
+                                        key=lambda item: getattr(item[1], sort),
+                                        reverse=True):
+        caller = symbols.lookup(caller) if caller is not None else "-"
+        print(f"{stats.calls:>10} {time_str(stats.inclusive, cycles):>14} "
+              f"{time_str(stats.exclusive, cycles):>14}  "
+              f"{caller} -> {symbols.lookup(func)}")
+
+
+def print_folded(symbols, threads, stacks, per_thread):
+    folded = collections.Counter()
+
+    for (thread, path), value in stacks.items():
+        frames = [symbols.lookup(func) for func in path]
+        if per_thread:
+            frames.insert(0, threads.get(thread, hex(thread)))
+        folded[";".join(frames)] += value
+
+    for stack, value in sorted(folded.items()):
+        if value > 0:
+            print(f"{stack} {value}")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        allow_abbrev=False)
+
+    parser.add_argument("elffile", help="ELF file of the application")
+    parser.add_argument("logfile", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="Output of instr dump, standard input if omitted")
+    parser.add_argument("--thread", action="append",
+                        help="Only account the given thread, by name or "
+                        "address (may be given several times)")
+    parser.add_argument("--sort", choices=["calls", "inclusive", "exclusive"],
+                        default="exclusive",
+                        help="Sort key of the report (default: exclusive)")
+
+    output = parser.add_mutually_exclusive_group()
+    output.add_argument("--callgraph", action="store_true",
+                        help="Report the calls between functions")
+    output.add_argument("--folded", action="store_true",
+                        help="Print folded stacks weighted by exclusive "
+                        "time, in cycles, for flamegraph.pl")
+    parser.add_argument("--no-threads", action="store_true",
+                        help="Do not start the folded stacks with the "
+                        "thread name")
+
+    return parser.parse_args()
+
+
+def thread_filter(names, threads):
+    if names is None:
+        return None
+
+    selected = set()
+    for name in names:
+        matches = [addr for addr, thread in threads.items() if thread == name]
+        if not matches:
+            try:
+                matches = [int(name, 16)]
+            except ValueError:
+                sys.exit(f"Unknown thread {name}")
+        selected.update(matches)
+
+    return selected
+
+
+def main():
+    args = parse_args()
+
+    symbols = Symbols(args.elffile)
+    cycles, threads, events = parse_log(args.logfile)
+
+    if not events:
+        sys.exit("No events found in the log")
+
+    funcs, edges, stacks = analyze(events, thread_filter(args.thread, threads))
+
+    if args.folded:
+        print_folded(symbols, threads, stacks, not args.no_threads)
+    elif args.callgraph:
+        print_callgraph(symbols, edges, cycles, args.sort)
+    else:
+        print_funcs(symbols, funcs, cycles, args.sort)
+
+
+if __name__ == "__main__":
+    main()
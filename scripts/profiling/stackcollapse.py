@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Zephyr Project
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Convert the samples of the sampling profiler to folded stacks
+
+Reads the output of the ``perf dump`` shell command, symbolizes the stack
+traces against the ELF file of the application and prints one line per
+distinct stack, outermost frame first, followed by the number of samples,
+as expected by flamegraph.pl::
+
+    stackcollapse.py zephyr.elf perf.log | flamegraph.pl > perf.svg
+
+Lines of the log other than the ones printed by ``perf dump`` are ignored,
+so a capture of the whole console can be given. On native_sim, use
+zephyr.exe as the ELF file.
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+THREAD_RE = re.compile(r"thread (0x[0-9a-fA-F]+) (.+)$")
+SAMPLE_RE = re.compile(r"sample (\d+) (0x[0-9a-fA-F]+)((?: 0x[0-9a-fA-F]+)+)$")
+
+
+class Symbols:
+    """Function symbols of an ELF file, looked up by address"""
+
+    def __init__(self, elf_path):
+        funcs = {}
+
+        with open(elf_path, "rb") as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+
+                for sym in section.iter_symbols():
+                    if (sym["st_info"]["type"] != "STT_FUNC" or
+                            sym["st_size"] == 0):
+                        continue
+                    funcs[sym["st_value"]] = (sym["st_size"], sym.name)
+
+        self.addrs = sorted(funcs)
+        self.funcs = [funcs[addr] for addr in self.addrs]
+
+    def lookup(self, addr):
+        idx = bisect.bisect_right(self.addrs, addr) - 1
+        if idx >= 0:
+            size, name = self.funcs[idx]
+            if addr < self.addrs[idx] + size:
+                return name
+
+        return hex(addr)
+
+
+def parse_log(log):
+    threads = {}
+    samples = []
+
+    for line in log:
+        line = line.strip()
+
+        match = THREAD_RE.search(line)
+        if match:
+            threads[int(match.group(1), 16)] = match.group(2)
+            continue
+
+        match = SAMPLE_RE.search(line)
+        if match:
+            thread = int(match.group(2), 16)
+            trace = [int(addr, 16) for addr in match.group(3).split()]
+            samples.append((thread, trace))
+
+    return threads, samples
+
+
+def collapse(symbols, threads, samples, per_thread):
+    stacks = collections.Counter()
+
+    for thread, trace in samples:
+        # The first entry is where the code was interrupted, the others
+        # are return addresses, which may be just past the end of the
+        # calling function if the call does not return.
+        frames = [symbols.lookup(trace[0])]
+        frames += [symbols.lookup(addr - 1) for addr in trace[1:]]
+        frames.reverse()
+
+        if per_thread:
+            frames.insert(0, threads.get(thread, hex(thread)))
+
+        stacks[";".join(frames)] += 1
+
+    return stacks
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        allow_abbrev=False)
+
+    parser.add_argument("elffile", help="ELF file of the application")
+    parser.add_argument("logfile", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="Output of perf dump, standard input if omitted")
+    parser.add_argument("--no-threads", action="store_true",
+                        help="Do not start the stacks with the thread name")
+
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    symbols = Symbols(args.elffile)
+    threads, samples = parse_log(args.logfile)
+
+    if not samples:
+        sys.exit("No samples found in the log")
+
+    stacks = collapse(symbols, threads, samples, not args.no_threads)
+
+    for stack, count in sorted(stacks.items()):
+        print(f"{stack} {count}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/debug/coredump.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "coredump_internal.h"
+
+/*
+ * Byte oriented LZ77 compression of memory blocks, see the description of
+ * the compressed memory block in the core dump documentation.
+ *
+ * The memory being compressed is used as the window, so only a table of
+ * recent positions is needed. Each block is compressed independently:
+ * positions left in the table by previous blocks are ignored unless they
+ * fall within the current block before the current position. Matches are
+ * found by hashing the next 4 bytes and are always verified against the
+ * memory, so collisions only cost compression ratio.
+ *
+ * The memory used here is part of what is being dumped when the RAM of
+ * the image is dumped. Its content as decompressed may not reflect any
+ * single point in time, same as the stack of the dumping thread.
+ */
+
+#define HASH_BITS	CONFIG_DEBUG_COREDUMP_COMPRESS_HASH_BITS
+
+/* Literal runs are encoded as their length minus 1 in tokens below 0x80. */
+#define LITERALS_MAX	128
+#define MATCH_DIST_MAX	UINT16_MAX
+
+static uintptr_t hash_table[BIT(HASH_BITS)];
+
+/* Output is buffered to keep the number of backend calls low. */
+static uint8_t out_buf[64];
+static size_t out_len;
+
+static inline uint32_t hash(const uint8_t *pos)
+{
+	/* Fibonacci hashing of the next 4 bytes. */
+	return (sys_get_le32(pos) * 2654435761U) >> (32 - HASH_BITS);
+}
+
+static void out_flush(void)
+{
+	if (out_len > 0) {
+		coredump_buffer_output(out_buf, out_len);
+		out_len = 0;
+	}
+}
+
+static void out_byte(uint8_t byte)
+{
+	out_buf[out_len++] = byte;
+
+	if (out_len == sizeof(out_buf)) {
+		out_flush();
+	}
+}
+
+static void out_literals(const uint8_t *pos, size_t len)
+{
+	while (len > 0) {
+		size_t run = MIN(len, LITERALS_MAX);
+
+		out_byte(run - 1);
+
+		for (size_t i = 0; i < run; i++) {
+			out_byte(pos[i]);
+		}
+
+		pos += run;
+		len -= run;
+	}
+}
+
+static void out_match(size_t dist, size_t len)
+{
+	size_t code = len - COREDUMP_COMPRESS_MATCH_MIN;
+
+	out_byte(COREDUMP_COMPRESS_TOKEN_MATCH |
+		 MIN(code, COREDUMP_COMPRESS_MATCH_LEN_EXT));
+	out_byte(dist & 0xff);
+	out_byte(dist >> 8);
+
+	if (code < COREDUMP_COMPRESS_MATCH_LEN_EXT) {
+		return;
+	}
+
+	code -= COREDUMP_COMPRESS_MATCH_LEN_EXT;
+
+	while (code >= UINT8_MAX) {
+		out_byte(UINT8_MAX);
+		code -= UINT8_MAX;
+	}
+
+	out_byte(code);
+}
+
+void z_coredump_compress(const uint8_t *buf, size_t len)
+{
+	const uint8_t *end = buf + len;
+	const uint8_t *literals = buf;
+	const uint8_t *pos = buf;
+
+	while ((end - pos) >= COREDUMP_COMPRESS_MATCH_MIN) {
+		uint32_t h = hash(pos);
+		uintptr_t cand = hash_table[h];
+		size_t match = 0;
+
+		hash_table[h] = POINTER_TO_UINT(pos);
+
+		if ((cand >= POINTER_TO_UINT(buf)) && (cand < POINTER_TO_UINT(pos)) &&
+		    ((POINTER_TO_UINT(pos) - cand) <= MATCH_DIST_MAX)) {
+			const uint8_t *prev = UINT_TO_POINTER(cand);
+
+			/* Overlapping matches are fine, the decompressor
+			 * copies byte by byte.
+			 */
+			while ((pos + match < end) && (prev[match] == pos[match])) {
+				match++;
+			}
+		}
+
+		if (match < COREDUMP_COMPRESS_MATCH_MIN) {
+			pos++;
+			continue;
+		}
+
+		out_literals(literals, pos - literals);
+		out_match(POINTER_TO_UINT(pos) - cand, match);
+
+		pos += match;
+		literals = pos;
+	}
+
+	out_literals(literals, end - literals);
+	out_flush();
+}
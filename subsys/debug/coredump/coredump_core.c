@@ -10,8 +10,12 @@
 #include <zephyr/debug/coredump.h>
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
 
 #include "coredump_internal.h"
+
+LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
+
 #if defined(CONFIG_DEBUG_COREDUMP_BACKEND_LOGGING)
 extern struct coredump_backend_api coredump_backend_logging;
 static struct coredump_backend_api
@@ -37,6 +41,10 @@ static struct coredump_backend_api
 #define DT_DRV_COMPAT zephyr_coredump
 #endif
 
+/* Bytes of memory dumped and bytes output for the current dump. */
+static size_t mem_size;
+static size_t dump_size;
+
 static void dump_header(unsigned int reason)
 {
 	struct coredump_hdr_t hdr = {
@@ -55,12 +63,13 @@ static void dump_header(unsigned int reason)
 
 	hdr.tgt_code = sys_cpu_to_le16(arch_coredump_tgt_code_get());
 
-	backend_api->buffer_output((uint8_t *)&hdr, sizeof(hdr));
+	coredump_buffer_output((uint8_t *)&hdr, sizeof(hdr));
 }
 
 static void dump_thread(struct k_thread *thread)
 {
-#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN
+#if defined(CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_MIN) || \
+	defined(CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_KERNEL)
 	uintptr_t end_addr;
 
 	/*
@@ -83,6 +92,33 @@ static void dump_thread(struct k_thread *thread)
 #endif
 }
 
+static void dump_kernel(struct k_thread *thread)
+{
+#ifdef CONFIG_DEBUG_COREDUMP_MEMORY_DUMP_KERNEL
+	/*
+	 * The kernel structure holds the current thread of each CPU
+	 * and the ready queue, and the thread structs hold the state
+	 * and the saved registers of the other threads.
+	 */
+	coredump_memory_dump(POINTER_TO_UINT(&_kernel),
+			     POINTER_TO_UINT(&_kernel) + sizeof(_kernel));
+
+#ifdef CONFIG_THREAD_MONITOR
+	for (struct k_thread *t = _kernel.threads; t != NULL; t = t->next_thread) {
+		if (t == thread) {
+			/* Already dumped with its stack */
+			continue;
+		}
+
+		coredump_memory_dump(POINTER_TO_UINT(t),
+				     POINTER_TO_UINT(t) + sizeof(*t));
+	}
+#endif
+#endif
+
+	ARG_UNUSED(thread);
+}
+
 #if defined(CONFIG_COREDUMP_DEVICE)
 static void process_coredump_dev_memory(const struct device *dev)
 {
@@ -120,6 +156,11 @@ void process_memory_region_list(void)
 void coredump(unsigned int reason, const z_arch_esf_t *esf,
 	      struct k_thread *thread)
 {
+	uint32_t start_cycles = k_cycle_get_32();
+
+	mem_size = 0;
+	dump_size = 0;
+
 	z_coredump_start();
 
 	dump_header(reason);
@@ -132,9 +173,15 @@ void coredump(unsigned int reason, const z_arch_esf_t *esf,
 		dump_thread(thread);
 	}
 
+	dump_kernel(thread);
+
 	process_memory_region_list();
 
 	z_coredump_end();
+
+	LOG_INF("Coredump: %zu bytes of memory dumped in %zu bytes, %u us",
+		mem_size, dump_size,
+		k_cyc_to_us_floor32(k_cycle_get_32() - start_cycles));
 }
 
 void z_coredump_start(void)
@@ -154,6 +201,8 @@ void coredump_buffer_output(uint8_t *buf, size_t buflen)
 		return;
 	}
 
+	dump_size += buflen;
+
 	backend_api->buffer_output(buf, buflen);
 }
 
@@ -173,8 +222,13 @@ void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 
 	len = end_addr - start_addr;
 
-	m.id = COREDUMP_MEM_HDR_ID;
-	m.hdr_version = COREDUMP_MEM_HDR_VER;
+	if (IS_ENABLED(CONFIG_DEBUG_COREDUMP_COMPRESS)) {
+		m.id = COREDUMP_COMPRESSED_MEM_HDR_ID;
+		m.hdr_version = COREDUMP_COMPRESSED_MEM_HDR_VER;
+	} else {
+		m.id = COREDUMP_MEM_HDR_ID;
+		m.hdr_version = COREDUMP_MEM_HDR_VER;
+	}
 
 	if (sizeof(uintptr_t) == 8) {
 		m.start	= sys_cpu_to_le64(start_addr);
@@ -186,7 +240,13 @@ void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 
 	coredump_buffer_output((uint8_t *)&m, sizeof(m));
 
+	mem_size += len;
+
+#ifdef CONFIG_DEBUG_COREDUMP_COMPRESS
+	z_coredump_compress((const uint8_t *)start_addr, len);
+#else
 	coredump_buffer_output((uint8_t *)start_addr, len);
+#endif
 }
 
 int coredump_query(enum coredump_query_id query_id, void *arg)
@@ -53,6 +53,17 @@ void z_coredump_start(void);
  */
 void z_coredump_end(void);
 
+/**
+ * @brief Compress a memory region to the coredump output
+ *
+ * Outputs the content of a compressed memory block, which must be
+ * preceded by its header.
+ *
+ * @param buf Start of the memory region
+ * @param len Length of the memory region
+ */
+void z_coredump_compress(const uint8_t *buf, size_t len);
+
 /**
  * @endcond
  */
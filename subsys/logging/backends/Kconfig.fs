@@ -17,6 +17,24 @@ backend = FS
 backend-str = fs
 source "subsys/logging/Kconfig.template.log_format_config"
 
+config LOG_BACKEND_FS_OUTPUT_DICTIONARY_PACKED
+	bool "Packed dictionary records"
+	depends on LOG_BACKEND_FS_OUTPUT_DICTIONARY
+	help
+	  Store dictionary-based log messages with a packed header, where the
+	  source ID, the timestamp and the lengths are varint encoded. Each
+	  message is kept within one log file, so that every file can be
+	  decoded on its own with scripts/logging/dictionary/log_parser.py.
+
+config LOG_BACKEND_FS_OUTPUT_DICTIONARY_DELTA_TIMESTAMP
+	bool "Delta timestamps"
+	default y
+	depends on LOG_BACKEND_FS_OUTPUT_DICTIONARY_PACKED
+	help
+	  Store the timestamp of a message as the difference with the one of
+	  the previous message in the file. The first message of a file and
+	  the first one after a reset have an absolute timestamp.
+
 config LOG_BACKEND_FS_AUTOSTART
 	bool "Automatically start fs backend"
 	default y
@@ -24,6 +42,13 @@ config LOG_BACKEND_FS_AUTOSTART
 	  When enabled automatically start the file system backend on
 	  application start.
 
+config LOG_BACKEND_FS_THREAD
+	bool "Process messages in a dedicated thread"
+	depends on LOG_BACKEND_THREADS
+	help
+	  When enabled, the file system backend processes messages in its own
+	  thread, so that other backends are not held back by flash writes.
+
 config LOG_BACKEND_FS_OVERWRITE
 	bool "Old log files overwrite"
 	default y
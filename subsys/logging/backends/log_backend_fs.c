@@ -28,6 +28,12 @@ static struct fs_file_t fs_file;
 static enum backend_fs_state backend_state = BACKEND_FS_NOT_INITIALIZED;
 static int file_ctr, newest, oldest;
 
+/* Timestamp of the last packed dictionary message written to the current
+ * file, from which the next one is delta encoded.
+ */
+static log_timestamp_t dict_timestamp;
+static bool dict_timestamp_valid;
+
 static int allocate_new_file(struct fs_file_t *file);
 static int del_oldest_log(void);
 static int get_log_file_id(struct fs_dirent *ent);
@@ -413,6 +419,9 @@ static int allocate_new_file(struct fs_file_t *file)
 	++file_ctr;
 	newest = curr_file_num;
 
+	/* Each file starts with an absolute timestamp. */
+	dict_timestamp_valid = false;
+
 out:
 	return rc;
 }
@@ -477,11 +486,52 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 	}
 }
 
+/* Start a new file if the current one cannot hold length more bytes. */
+static void reserve_file_space(size_t length)
+{
+	int size;
+
+	if (backend_state != BACKEND_FS_OK) {
+		/* The file is opened on the first write. */
+		return;
+	}
+
+	size = fs_tell(&fs_file);
+	if ((size > 0) && ((size + length) > CONFIG_LOG_BACKEND_FS_FILE_SIZE)) {
+		if (allocate_new_file(&fs_file) < 0) {
+			backend_state = BACKEND_FS_CORRUPTED;
+		}
+	}
+}
+
+static void dict_packed_process(struct log_msg *msg)
+{
+	bool delta = IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY_DELTA_TIMESTAMP) &&
+		     dict_timestamp_valid;
+
+	/* Messages are not split between files, so that every file can be
+	 * decoded on its own.
+	 */
+	reserve_file_space(log_dict_output_packed_msg_len_max(msg));
+
+	(void)log_dict_output_packed_msg_process(&log_output, msg,
+						 delta ? &dict_timestamp : NULL);
+
+	dict_timestamp = log_msg_get_timestamp(msg);
+	dict_timestamp_valid = true;
+}
+
 static void process(const struct log_backend *const backend,
 		union log_msg_generic *msg)
 {
 	uint32_t flags = log_backend_std_get_flags();
 
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY_PACKED) &&
+	    (log_format_current == LOG_OUTPUT_DICT)) {
+		dict_packed_process(&msg->log);
+		return;
+	}
+
 	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
 
 	log_output_func(&log_output, &msg->log, flags);
@@ -503,4 +553,8 @@ static const struct log_backend_api log_backend_fs_api = {
 
 LOG_BACKEND_DEFINE(log_backend_fs, log_backend_fs_api,
 		   IS_ENABLED(CONFIG_LOG_BACKEND_FS_AUTOSTART));
+
+#ifdef CONFIG_LOG_BACKEND_FS_THREAD
+LOG_BACKEND_THREAD_DEFINE(log_backend_fs, CONFIG_LOG_BACKEND_THREAD_STACK_SIZE);
+#endif
 #endif
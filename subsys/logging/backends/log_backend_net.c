@@ -40,18 +40,116 @@ static struct log_backend_net_ctx {
 	.sock = -1,
 };
 
-static int line_out(uint8_t *data, size_t length, void *output_ctx)
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+/* Room for the octet count and the space in front of a message. */
+#define BATCH_PREFIX_LEN (sizeof("65535 ") - 1)
+
+BUILD_ASSERT(CONFIG_LOG_BACKEND_NET_BATCH_SIZE >=
+	     CONFIG_LOG_BACKEND_NET_MAX_BUF_SIZE + BATCH_PREFIX_LEN,
+	     "Batch cannot hold a message");
+
+/* Messages framed with their octet count are stored in batch_buf, and the
+ * message being formatted is stored after them, leaving room for its octet
+ * count.
+ */
+static uint8_t batch_buf[CONFIG_LOG_BACKEND_NET_BATCH_SIZE];
+static size_t batch_len;
+static size_t batch_msg_len;
+static K_MUTEX_DEFINE(batch_lock);
+static struct k_work_delayable batch_work;
+
+static void batch_send(struct log_backend_net_ctx *ctx)
+{
+	int ret;
+
+	if ((batch_len == 0U) || (ctx->sock < 0)) {
+		return;
+	}
+
+	/* Do not block when flushing from the panic handler. */
+	ret = zsock_send(ctx->sock, batch_buf, batch_len,
+			 (ctx->is_tcp && !panic_mode) ? 0 : ZSOCK_MSG_DONTWAIT);
+	if (ret >= 0) {
+		DBG("%.*s\n", (int)batch_len, batch_buf);
+	}
+
+	batch_len = 0U;
+}
+
+static void batch_flush(void)
+{
+	(void)k_work_cancel_delayable(&batch_work);
+
+	batch_send(&ctx);
+}
+
+static void batch_out(uint8_t *data, size_t length)
+{
+	size_t msg_offset = batch_len + BATCH_PREFIX_LEN;
+
+	if ((batch_len > 0U) && (msg_offset + batch_msg_len + length > sizeof(batch_buf))) {
+		/* Send the batch and start a new one with the message being
+		 * formatted.
+		 */
+		batch_flush();
+		memmove(&batch_buf[BATCH_PREFIX_LEN], &batch_buf[msg_offset], batch_msg_len);
+		msg_offset = BATCH_PREFIX_LEN;
+	}
+
+	/* A message longer than the batch is truncated. */
+	length = MIN(length, sizeof(batch_buf) - msg_offset - batch_msg_len);
+
+	memcpy(&batch_buf[msg_offset + batch_msg_len], data, length);
+	batch_msg_len += length;
+}
+
+/* Frame the message which was just formatted and add it to the batch. */
+static void batch_commit(void)
+{
+	char prefix[BATCH_PREFIX_LEN + 1];
+	int prefix_len;
+
+	if (batch_msg_len == 0U) {
+		return;
+	}
+
+	prefix_len = snprintk(prefix, sizeof(prefix), "%zu ", batch_msg_len);
+	memmove(&batch_buf[batch_len + prefix_len],
+		&batch_buf[batch_len + BATCH_PREFIX_LEN], batch_msg_len);
+	memcpy(&batch_buf[batch_len], prefix, prefix_len);
+
+	if (batch_len == 0U) {
+		(void)k_work_schedule(&batch_work,
+				      K_MSEC(CONFIG_LOG_BACKEND_NET_BATCH_INTERVAL_MS));
+	}
+
+	batch_len += prefix_len + batch_msg_len;
+	batch_msg_len = 0U;
+
+	if (sizeof(batch_buf) - batch_len < BATCH_PREFIX_LEN + sizeof(output_buf)) {
+		/* Next message might not fit. */
+		batch_flush();
+	}
+}
+
+static void batch_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)k_mutex_lock(&batch_lock, K_FOREVER);
+	batch_send(&ctx);
+	(void)k_mutex_unlock(&batch_lock);
+}
+#endif /* CONFIG_LOG_BACKEND_NET_BATCH */
+
+#if !defined(CONFIG_LOG_BACKEND_NET_BATCH)
+static int line_send(struct log_backend_net_ctx *ctx, uint8_t *data, size_t length)
 {
-	struct log_backend_net_ctx *ctx = (struct log_backend_net_ctx *)output_ctx;
 	int ret = -ENOMEM;
 	struct msghdr msg = { 0 };
 	struct iovec io_vector[2];
 	int pos = 0;
 
-	if (ctx == NULL) {
-		return length;
-	}
-
 #if defined(CONFIG_NET_TCP)
 	char len[sizeof("123456789")];
 
@@ -83,6 +181,24 @@ static int line_out(uint8_t *data, size_t length, void *output_ctx)
 fail:
 	return length;
 }
+#endif /* !CONFIG_LOG_BACKEND_NET_BATCH */
+
+static int line_out(uint8_t *data, size_t length, void *output_ctx)
+{
+	struct log_backend_net_ctx *ctx = (struct log_backend_net_ctx *)output_ctx;
+
+	if (ctx == NULL) {
+		return length;
+	}
+
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+	batch_out(data, length);
+
+	return length;
+#else
+	return line_send(ctx, data, length);
+#endif
+}
 
 LOG_OUTPUT_DEFINE(log_output_net, line_out, output_buf, sizeof(output_buf));
 
@@ -211,7 +327,14 @@ static void process(const struct log_backend *const backend,
 
 	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
 
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+	(void)k_mutex_lock(&batch_lock, K_FOREVER);
 	log_output_func(&log_output_net, &msg->log, flags);
+	batch_commit();
+	(void)k_mutex_unlock(&batch_lock);
+#else
+	log_output_func(&log_output_net, &msg->log, flags);
+#endif
 }
 
 static int format_set(const struct log_backend *const backend, uint32_t log_type)
@@ -231,6 +354,13 @@ static bool check_net_init_done(void)
 		struct log_backend_net_ctx *ctx = log_output_net.control_block->ctx;
 		int released;
 
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+		/* Send pending messages to the previous server. */
+		(void)k_mutex_lock(&batch_lock, K_FOREVER);
+		batch_flush();
+		(void)k_mutex_unlock(&batch_lock);
+#endif
+
 		released = zsock_close(ctx->sock);
 		if (released < 0) {
 			LOG_ERR("Cannot release socket (%d)", ret);
@@ -312,6 +442,10 @@ static void init_net(struct log_backend const *const backend)
 {
 	ARG_UNUSED(backend);
 
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+	k_work_init_delayable(&batch_work, batch_work_handler);
+#endif
+
 	if (strlen(CONFIG_LOG_BACKEND_NET_SERVER) != 0) {
 		const char *server = CONFIG_LOG_BACKEND_NET_SERVER;
 		bool ret;
@@ -333,6 +467,11 @@ static void init_net(struct log_backend const *const backend)
 static void panic(struct log_backend const *const backend)
 {
 	panic_mode = true;
+
+#if defined(CONFIG_LOG_BACKEND_NET_BATCH)
+	/* Send the pending messages, as no more will be processed. */
+	batch_flush();
+#endif
 }
 
 const struct log_backend_api log_backend_net_api = {
@@ -243,7 +243,10 @@ const struct log_backend_api log_backend_uart_api = {
                                                                                                    \
 	LOG_BACKEND_DEFINE(log_backend_uart##__VA_ARGS__, log_backend_uart_api,                    \
 			   IS_ENABLED(CONFIG_LOG_BACKEND_UART_AUTOSTART),                          \
-			   (void *)&lbu_cb_ctx##__VA_ARGS__);
+			   (void *)&lbu_cb_ctx##__VA_ARGS__);                                      \
+	IF_ENABLED(CONFIG_LOG_BACKEND_UART_THREAD,                                                 \
+		   (LOG_BACKEND_THREAD_DEFINE(log_backend_uart##__VA_ARGS__,                       \
+					      CONFIG_LOG_BACKEND_THREAD_STACK_SIZE);))
 
 #if DT_HAS_CHOSEN(zephyr_log_uart)
 #define LBU_PHA_FN(node_id, prop, idx) LBU_DEFINE(DT_PHANDLE_BY_IDX(node_id, prop, idx), idx)
@@ -5,6 +5,7 @@
  */
 
 #include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_string_conv.h>
 #include <zephyr/logging/log_ctrl.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/logging/log_internal.h>
@@ -418,6 +419,118 @@ static int cmd_log_mem(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+static int rate_limit_level_get(const char *str)
+{
+	if (strcmp(str, "all") == 0) {
+		return LOG_LEVEL_NONE;
+	}
+
+	return (strcmp(str, "none") == 0) ? -1 : severity_level_get(str);
+}
+
+static int cmd_log_rate_limit_set(const struct shell *sh, size_t argc, char **argv)
+{
+	unsigned long args[3] = { 0 };
+	int err = 0;
+	int level;
+	int id;
+	int ret;
+
+	id = module_id_get(argv[1]);
+	if (id < 0) {
+		shell_error(sh, "%s: unknown source name.", argv[1]);
+		return -ENOEXEC;
+	}
+
+	level = rate_limit_level_get(argv[2]);
+	if (level < 0) {
+		shell_error(sh, "Invalid severity: %s", argv[2]);
+		return -ENOEXEC;
+	}
+
+	/* Rate, and optional burst and sample. */
+	for (size_t i = 3; i < argc; i++) {
+		args[i - 3] = shell_strtoul(argv[i], 10, &err);
+		if (err != 0) {
+			shell_error(sh, "Invalid number: %s", argv[i]);
+			return -ENOEXEC;
+		}
+	}
+
+	ret = log_rate_limit_set(id, level, args[0], args[1], args[2]);
+	if (ret < 0) {
+		shell_error(sh, "Cannot set rate limit (%d)", ret);
+		return -ENOEXEC;
+	}
+
+	return 0;
+}
+
+static int cmd_log_rate_limit_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	int level = LOG_LEVEL_NONE;
+	int id;
+
+	id = module_id_get(argv[1]);
+	if (id < 0) {
+		shell_error(sh, "%s: unknown source name.", argv[1]);
+		return -ENOEXEC;
+	}
+
+	if (argc > 2) {
+		level = rate_limit_level_get(argv[2]);
+		if (level < 0) {
+			shell_error(sh, "Invalid severity: %s", argv[2]);
+			return -ENOEXEC;
+		}
+
+		(void)log_rate_limit_set(id, level, 0, 0, 0);
+		return 0;
+	}
+
+	/* Clear the rules of all levels. */
+	for (level = LOG_LEVEL_NONE; level <= LOG_LEVEL_DBG; level++) {
+		(void)log_rate_limit_set(id, level, 0, 0, 0);
+	}
+
+	return 0;
+}
+
+static int cmd_log_rate_limit_status(const struct shell *sh, size_t argc, char **argv)
+{
+	struct log_rate_limit limit;
+
+	shell_fprintf(sh, SHELL_NORMAL, "%-40s | level | rate  | burst | sample | suppressed\r\n",
+		      "module_name");
+	shell_fprintf(sh, SHELL_NORMAL,
+	      "------------------------------------------------------------------------------\r\n");
+
+	for (uint32_t i = 0; log_rate_limit_get(i, &limit) == 0; i++) {
+		shell_fprintf(sh, SHELL_NORMAL, "%-40s | %-5s | %-5u | %-5u | %-6u | %u\r\n",
+			      log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, limit.source_id),
+			      (limit.level == LOG_LEVEL_NONE) ? "all" : severity_lvls[limit.level],
+			      limit.rate, limit.burst, limit.sample, limit.suppressed);
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_rate_limit,
+	SHELL_CMD_ARG(clear, &dsub_module_name,
+		  "'log rate_limit clear <module> [<level>]' removes the rate limits "
+		  "of the module for the level (all if no level specified).",
+		  cmd_log_rate_limit_clear, 2, 1),
+	SHELL_CMD_ARG(set, &dsub_module_name,
+		  "'log rate_limit set <module> <level> <rate> [<burst> [<sample>]]' "
+		  "limits the messages of the module at the level ('all' for any "
+		  "level) to rate per second, at most burst at once, and logs one "
+		  "in sample.",
+		  cmd_log_rate_limit_set, 4, 2),
+	SHELL_CMD(status, NULL, "Rate limits and suppressed messages",
+		  cmd_log_rate_limit_status),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_backend,
 	SHELL_CMD_ARG(disable, &dsub_module_name,
 		  "'log disable <module_0> .. <module_n>' disables logs in "
@@ -477,6 +590,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		       cmd_log_self_status),
 	SHELL_COND_CMD(CONFIG_LOG_MODE_DEFERRED, mem, NULL, "Logger memory usage",
 		       cmd_log_mem),
+	SHELL_COND_CMD(CONFIG_LOG_RATE_LIMIT, rate_limit, &sub_log_rate_limit,
+		       "Rate limiting and sampling of modules", NULL),
 	SHELL_COND_CMD(CONFIG_LOG_FRONTEND, FRONTEND_NAME, &sub_log_backend,
 		"Frontend control", NULL),
 	SHELL_SUBCMD_SET_END);
@@ -147,6 +147,277 @@ static char tag[CONFIG_LOG_TAG_MAX_LEN + 1] =
 	COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, ({}), (CONFIG_LOG_TAG_DEFAULT));
 
 static void msg_process(union log_msg_generic *msg);
+static bool msg_filter_check(struct log_backend const *backend,
+			     union log_msg_generic *msg);
+
+#ifdef CONFIG_LOG_BACKEND_THREADS
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_LOG_BACKEND_THREAD_QUEUE_LEN),
+	     "CONFIG_LOG_BACKEND_THREAD_QUEUE_LEN must be a power of two");
+
+/* Messages handed to the backend threads, indexed by sequence number. Each
+ * backend thread has its own cursor, and messages are freed in order once
+ * all cursors have moved past them.
+ */
+static union log_msg_generic *bt_queue[CONFIG_LOG_BACKEND_THREAD_QUEUE_LEN];
+static uint32_t bt_head;
+static uint32_t bt_tail;
+static bool bt_stopped;
+static struct k_spinlock bt_lock;
+static K_SEM_DEFINE(bt_space, 0, 1);
+
+static struct log_backend_thread *backend_thread_get(const struct log_backend *backend)
+{
+	STRUCT_SECTION_FOREACH(log_backend_thread, bt) {
+		if (bt->backend == backend) {
+			return bt;
+		}
+	}
+
+	return NULL;
+}
+
+static bool backend_threads_active(void)
+{
+	size_t cnt;
+
+	STRUCT_SECTION_COUNT(log_backend_thread, &cnt);
+
+	return (cnt > 0) && !bt_stopped;
+}
+
+/* Free the messages which all backend threads have processed. Called with
+ * bt_lock held.
+ */
+static void backend_threads_release(void)
+{
+	uint32_t min_rd = bt_head;
+
+	STRUCT_SECTION_FOREACH(log_backend_thread, bt) {
+		if ((int32_t)(bt->rd - min_rd) < 0) {
+			min_rd = bt->rd;
+		}
+	}
+
+	while (bt_tail != min_rd) {
+		z_log_msg_free(bt_queue[bt_tail % CONFIG_LOG_BACKEND_THREAD_QUEUE_LEN]);
+		bt_tail++;
+	}
+}
+
+static void backend_threads_publish(union log_msg_generic *msg)
+{
+	k_spinlock_key_t key;
+
+	while (true) {
+		key = k_spin_lock(&bt_lock);
+
+		if ((bt_head - bt_tail) == CONFIG_LOG_BACKEND_THREAD_QUEUE_LEN) {
+			/* Drop the oldest message for the backends which did
+			 * not start processing it. A backend processing it
+			 * drops the messages queued after it once done.
+			 */
+			STRUCT_SECTION_FOREACH(log_backend_thread, bt) {
+				if (bt->rd != bt_tail) {
+					continue;
+				}
+
+				if (bt->busy) {
+					bt->skip_to = bt_head;
+				} else {
+					bt->rd++;
+					bt->dropped++;
+				}
+			}
+
+			backend_threads_release();
+		}
+
+		if ((bt_head - bt_tail) < CONFIG_LOG_BACKEND_THREAD_QUEUE_LEN) {
+			break;
+		}
+
+		k_spin_unlock(&bt_lock, key);
+
+		/* A backend is still processing the oldest message. */
+		(void)k_sem_take(&bt_space, K_FOREVER);
+	}
+
+	bt_queue[bt_head % CONFIG_LOG_BACKEND_THREAD_QUEUE_LEN] = msg;
+	bt_head++;
+
+	k_spin_unlock(&bt_lock, key);
+
+	STRUCT_SECTION_FOREACH(log_backend_thread, bt) {
+		k_sem_give(&bt->sem);
+	}
+}
+
+static void backend_threads_dropped(uint32_t cnt)
+{
+	k_spinlock_key_t key = k_spin_lock(&bt_lock);
+
+	STRUCT_SECTION_FOREACH(log_backend_thread, bt) {
+		bt->dropped += cnt;
+	}
+
+	k_spin_unlock(&bt_lock, key);
+
+	STRUCT_SECTION_FOREACH(log_backend_thread, bt) {
+		k_sem_give(&bt->sem);
+	}
+}
+
+/* Process the queued messages in the calling context and stop handing
+ * messages to the backend threads. Used when entering panic mode.
+ */
+static void backend_threads_stop(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&bt_lock);
+	uint32_t head = bt_head;
+
+	bt_stopped = true;
+	k_spin_unlock(&bt_lock, key);
+
+	STRUCT_SECTION_FOREACH(log_backend_thread, bt) {
+		const struct log_backend *backend = bt->backend;
+
+		if (!log_backend_is_active(backend)) {
+			continue;
+		}
+
+		if (bt->dropped) {
+			log_backend_dropped(backend, bt->dropped);
+			bt->dropped = 0;
+		}
+
+		/* A message being processed by the thread is not processed
+		 * again.
+		 */
+		for (uint32_t i = bt->rd + (bt->busy ? 1 : 0); i != head; i++) {
+			union log_msg_generic *msg =
+				bt_queue[i % CONFIG_LOG_BACKEND_THREAD_QUEUE_LEN];
+
+			if (msg_filter_check(backend, msg)) {
+				log_backend_msg_process(backend, msg);
+			}
+		}
+	}
+
+	key = k_spin_lock(&bt_lock);
+
+	STRUCT_SECTION_FOREACH(log_backend_thread, bt) {
+		bt->rd = head;
+		bt->skip_to = head;
+		bt->busy = false;
+	}
+
+	backend_threads_release();
+	k_spin_unlock(&bt_lock, key);
+}
+
+static void backend_thread_func(void *p1, void *p2, void *p3)
+{
+	struct log_backend_thread *bt = p1;
+	const struct log_backend *backend = bt->backend;
+	bool processed_any = false;
+
+	while (true) {
+		union log_msg_generic *msg = NULL;
+		k_spinlock_key_t key;
+		uint32_t dropped;
+
+		key = k_spin_lock(&bt_lock);
+
+		dropped = bt->dropped;
+		bt->dropped = 0;
+
+		if (!bt_stopped && bt->rd != bt_head) {
+			msg = bt_queue[bt->rd % CONFIG_LOG_BACKEND_THREAD_QUEUE_LEN];
+			bt->busy = true;
+		}
+
+		k_spin_unlock(&bt_lock, key);
+
+		if (dropped && log_backend_is_active(backend)) {
+			log_backend_dropped(backend, dropped);
+		}
+
+		if (msg == NULL) {
+			if (processed_any) {
+				processed_any = false;
+				log_backend_notify(backend,
+						   LOG_BACKEND_EVT_PROCESS_THREAD_DONE,
+						   NULL);
+			}
+
+			(void)k_sem_take(&bt->sem, K_FOREVER);
+			continue;
+		}
+
+		if (log_backend_is_active(backend) &&
+		    msg_filter_check(backend, msg)) {
+			log_backend_msg_process(backend, msg);
+		}
+
+		processed_any = true;
+
+		key = k_spin_lock(&bt_lock);
+
+		if (!bt_stopped) {
+			bt->busy = false;
+			bt->rd++;
+
+			if ((int32_t)(bt->skip_to - bt->rd) > 0) {
+				bt->dropped += bt->skip_to - bt->rd;
+				bt->rd = bt->skip_to;
+			}
+
+			/* The cursor is compared with skip_to modulo 2^32, so
+			 * it must not be left behind.
+			 */
+			bt->skip_to = bt->rd;
+
+			backend_threads_release();
+		}
+
+		k_spin_unlock(&bt_lock, key);
+
+		k_sem_give(&bt_space);
+	}
+}
+
+static void backend_threads_start(void)
+{
+	STRUCT_SECTION_FOREACH(log_backend_thread, bt) {
+		k_sem_init(&bt->sem, 0, 1);
+		k_thread_create(&bt->thread, bt->stack, bt->stack_size,
+				backend_thread_func, bt, NULL, NULL,
+				LOG_PROCESS_THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&bt->thread, bt->backend->name);
+	}
+}
+#else
+static inline struct log_backend_thread *backend_thread_get(const struct log_backend *backend)
+{
+	return NULL;
+}
+
+static inline bool backend_threads_active(void)
+{
+	return false;
+}
+
+static inline void backend_threads_publish(union log_msg_generic *msg) {}
+static inline void backend_threads_dropped(uint32_t cnt) {}
+static inline void backend_threads_stop(void) {}
+static inline void backend_threads_start(void) {}
+#endif /* CONFIG_LOG_BACKEND_THREADS */
+
+/* Backend is processed by its own thread. */
+static bool backend_threaded(const struct log_backend *backend)
+{
+	return backend_threads_active() && (backend_thread_get(backend) != NULL);
+}
 
 static log_timestamp_t dummy_timestamp(void)
 {
@@ -433,6 +704,9 @@ void z_impl_log_panic(void)
 		}
 	}
 
+	/* Messages are processed in the panic context from now on. */
+	backend_threads_stop();
+
 	if (!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
 		/* Flush */
 		while (log_process() == true) {
@@ -487,7 +761,7 @@ static bool msg_filter_check(struct log_backend const *backend,
 static void msg_process(union log_msg_generic *msg)
 {
 	STRUCT_SECTION_FOREACH(log_backend, backend) {
-		if (log_backend_is_active(backend) &&
+		if (log_backend_is_active(backend) && !backend_threaded(backend) &&
 		    msg_filter_check(backend, msg)) {
 			log_backend_msg_process(backend, msg);
 		}
@@ -499,10 +773,14 @@ void dropped_notify(void)
 	uint32_t dropped = z_log_dropped_read_and_clear();
 
 	STRUCT_SECTION_FOREACH(log_backend, backend) {
-		if (log_backend_is_active(backend)) {
+		if (log_backend_is_active(backend) && !backend_threaded(backend)) {
 			log_backend_dropped(backend, dropped);
 		}
 	}
+
+	if (backend_threads_active()) {
+		backend_threads_dropped(dropped);
+	}
 }
 
 void unordered_notify(void)
@@ -547,7 +825,12 @@ bool z_impl_log_process(void)
 	if (msg) {
 		atomic_dec(&buffered_cnt);
 		msg_process(msg);
-		z_log_msg_free(msg);
+
+		if (backend_threads_active()) {
+			backend_threads_publish(msg);
+		} else {
+			z_log_msg_free(msg);
+		}
 	} else if (CONFIG_LOG_PROCESSING_LATENCY_US > 0 && !K_TIMEOUT_EQ(backoff, K_NO_WAIT)) {
 		/* If backoff is requested, it means that there are pending
 		 * messages but they are too new and processing shall back off
@@ -885,7 +1168,9 @@ static void log_backend_notify_all(enum log_backend_evt event,
 				   union log_backend_evt_arg *arg)
 {
 	STRUCT_SECTION_FOREACH(log_backend, backend) {
-		log_backend_notify(backend, event, arg);
+		if (!backend_threaded(backend)) {
+			log_backend_notify(backend, event, arg);
+		}
 	}
 }
 
@@ -958,6 +1243,8 @@ static int enable_logger(void)
 					K_MSEC(CONFIG_LOG_PROCESS_THREAD_STARTUP_DELAY_MS),
 					K_NO_WAIT));
 		k_thread_name_set(&logging_thread, "logging");
+
+		backend_threads_start();
 	} else {
 		(void)z_log_init(false, false);
 	}
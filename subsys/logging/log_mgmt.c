@@ -389,12 +389,20 @@ static uint32_t max_filter_get(uint32_t filters)
 	return max_filter;
 }
 
+/* Serializes the read-modify-write updates of a source's filter word, which
+ * holds both the backend levels and the rate limit flag.
+ */
+static struct k_spinlock filters_lock;
+
 static void set_runtime_filter(uint8_t backend_id, uint8_t domain_id,
 			       uint32_t source_id, uint32_t level)
 {
 	uint32_t prev_max;
 	uint32_t new_max;
 	uint32_t *filters = get_dynamic_filter(domain_id, source_id);
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&filters_lock);
 
 	prev_max = LOG_FILTER_SLOT_GET(filters, LOG_FILTER_AGGR_SLOT_IDX);
 
@@ -407,6 +415,8 @@ static void set_runtime_filter(uint8_t backend_id, uint8_t domain_id,
 
 	LOG_FILTER_SLOT_SET(filters, LOG_FILTER_AGGR_SLOT_IDX, new_max);
 
+	k_spin_unlock(&filters_lock, key);
+
 	if (!z_log_is_local_domain(domain_id) && (new_max != prev_max)) {
 		(void)z_log_link_set_runtime_level(domain_id, source_id, level);
 	}
@@ -480,6 +490,203 @@ uint32_t z_impl_log_frontend_filter_set(int16_t source_id, uint32_t level)
 	return filter_set(LOG_FRONTEND_SLOT_ID, Z_LOG_LOCAL_DOMAIN_ID, source_id, level);
 }
 
+#ifdef CONFIG_LOG_RATE_LIMIT
+struct rate_limit_rule {
+	/* NULL for an unused rule. */
+	struct log_source_dynamic_data *dsource;
+	uint8_t level;
+	uint16_t rate;
+	uint16_t burst;
+	uint32_t sample;
+	uint32_t sample_cnt;
+	uint32_t suppressed;
+
+	/* Tokens, scaled by the number of ticks per second. */
+	uint64_t credit;
+	int64_t last;
+};
+
+static struct rate_limit_rule rate_limits[CONFIG_LOG_RATE_LIMIT_RULES];
+static struct k_spinlock rate_limit_lock;
+
+static struct rate_limit_rule *rate_limit_find(struct log_source_dynamic_data *dsource,
+					       uint8_t level)
+{
+	for (int i = 0; i < ARRAY_SIZE(rate_limits); i++) {
+		if ((rate_limits[i].dsource == dsource) &&
+		    (rate_limits[i].level == level)) {
+			return &rate_limits[i];
+		}
+	}
+
+	return NULL;
+}
+
+static bool rate_limit_pass(struct rate_limit_rule *rule)
+{
+	const uint64_t token = CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+
+	if (rule->sample > 1U) {
+		bool pass = (rule->sample_cnt == 0U);
+
+		rule->sample_cnt = (rule->sample_cnt + 1U) % rule->sample;
+		if (!pass) {
+			return false;
+		}
+	}
+
+	if (rule->rate > 0U) {
+		int64_t now = sys_clock_tick_get();
+		uint64_t max = token * rule->burst;
+		uint64_t elapsed = MIN((uint64_t)(now - rule->last), max);
+
+		rule->last = now;
+		rule->credit = MIN(rule->credit + elapsed * rule->rate, max);
+
+		if (rule->credit < token) {
+			return false;
+		}
+
+		rule->credit -= token;
+	}
+
+	return true;
+}
+
+bool z_log_rate_limit_check(struct log_source_dynamic_data *dsource, uint8_t level)
+{
+	struct rate_limit_rule *rule;
+	k_spinlock_key_t key;
+	bool pass = true;
+
+	key = k_spin_lock(&rate_limit_lock);
+
+	rule = rate_limit_find(dsource, level);
+	if (rule == NULL) {
+		rule = rate_limit_find(dsource, LOG_LEVEL_NONE);
+	}
+
+	if (rule != NULL) {
+		pass = rate_limit_pass(rule);
+		if (!pass) {
+			rule->suppressed++;
+		}
+	}
+
+	k_spin_unlock(&rate_limit_lock, key);
+
+	return pass;
+}
+
+int log_rate_limit_set(int16_t source_id, uint32_t level, uint32_t rate,
+		       uint32_t burst, uint32_t sample)
+{
+	struct log_source_dynamic_data *dsource;
+	struct rate_limit_rule *rule;
+	k_spinlock_key_t filters_key;
+	k_spinlock_key_t key;
+	bool limited = false;
+	int ret = 0;
+
+	if ((source_id < 0) || (source_id >= z_log_sources_count()) ||
+	    (level > LOG_LEVEL_DBG) || (rate > UINT16_MAX) || (burst > UINT16_MAX)) {
+		return -EINVAL;
+	}
+
+	dsource = &TYPE_SECTION_START(log_dynamic)[source_id];
+
+	key = k_spin_lock(&rate_limit_lock);
+
+	rule = rate_limit_find(dsource, level);
+
+	if ((rate == 0U) && (sample <= 1U)) {
+		if (rule != NULL) {
+			rule->dsource = NULL;
+		}
+	} else {
+		for (int i = 0; (rule == NULL) && (i < ARRAY_SIZE(rate_limits)); i++) {
+			if (rate_limits[i].dsource == NULL) {
+				rule = &rate_limits[i];
+			}
+		}
+
+		if (rule == NULL) {
+			ret = -ENOMEM;
+		} else {
+			*rule = (struct rate_limit_rule) {
+				.dsource = dsource,
+				.level = level,
+				.rate = rate,
+				.burst = (burst == 0U) ? MAX(rate, 1U) : burst,
+				.sample = sample,
+				.suppressed = (rule->dsource == dsource) ? rule->suppressed : 0U,
+				.last = sys_clock_tick_get(),
+			};
+			rule->credit = (uint64_t)rule->burst * CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(rate_limits); i++) {
+		limited |= (rate_limits[i].dsource == dsource);
+	}
+
+	filters_key = k_spin_lock(&filters_lock);
+
+	if (limited) {
+		dsource->filters |= LOG_FILTER_RATE_LIMIT;
+	} else {
+		dsource->filters &= ~LOG_FILTER_RATE_LIMIT;
+	}
+
+	k_spin_unlock(&filters_lock, filters_key);
+	k_spin_unlock(&rate_limit_lock, key);
+
+	return ret;
+}
+
+int log_rate_limit_get(uint32_t idx, struct log_rate_limit *limit)
+{
+	k_spinlock_key_t key;
+	int ret = -ENOENT;
+
+	key = k_spin_lock(&rate_limit_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(rate_limits); i++) {
+		struct rate_limit_rule *rule = &rate_limits[i];
+
+		if ((rule->dsource == NULL) || (idx-- > 0U)) {
+			continue;
+		}
+
+		*limit = (struct log_rate_limit) {
+			.source_id = log_dynamic_source_id(rule->dsource),
+			.level = rule->level,
+			.rate = rule->rate,
+			.burst = rule->burst,
+			.sample = rule->sample,
+			.suppressed = rule->suppressed,
+		};
+		ret = 0;
+		break;
+	}
+
+	k_spin_unlock(&rate_limit_lock, key);
+
+	return ret;
+}
+#else
+int log_rate_limit_set(int16_t source_id, uint32_t level, uint32_t rate,
+		       uint32_t burst, uint32_t sample)
+{
+	return -ENOTSUP;
+}
+
+int log_rate_limit_get(uint32_t idx, struct log_rate_limit *limit)
+{
+	return -ENOTSUP;
+}
+#endif /* CONFIG_LOG_RATE_LIMIT */
+
 #ifdef CONFIG_USERSPACE
 uint32_t z_vrfy_log_filter_set(struct log_backend const *const backend,
 			    uint32_t domain_id,
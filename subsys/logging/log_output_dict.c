@@ -62,6 +62,91 @@ void log_dict_output_msg_process(const struct log_output *output,
 	log_output_flush(output);
 }
 
+static size_t varint_encode(uint8_t *buf, uint64_t value)
+{
+	size_t len = 0;
+
+	while (value > 0x7f) {
+		buf[len++] = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+
+	buf[len++] = value;
+
+	return len;
+}
+
+size_t log_dict_output_packed_msg_process(const struct log_output *output,
+					  struct log_msg *msg,
+					  const log_timestamp_t *ref_timestamp)
+{
+	void *source = (void *)log_msg_get_source(msg);
+	log_timestamp_t timestamp = msg->hdr.timestamp;
+	uint8_t hdr[LOG_DICT_OUTPUT_PACKED_HDR_MAX_LEN];
+	size_t package_len, data_len, hdr_len;
+	uint8_t *package, *data;
+	uint32_t source_id;
+
+	source_id = (source != NULL) ?
+			(IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
+				log_dynamic_source_id(source) :
+				log_const_source_id(source)) :
+			0U;
+
+	package = log_msg_get_package(msg, &package_len);
+	data = log_msg_get_data(msg, &data_len);
+
+	hdr[0] = MSG_NORMAL_PACKED;
+	hdr[1] = msg->hdr.desc.domain |
+		 (msg->hdr.desc.level << LOG_DICT_OUTPUT_PACKED_LEVEL_SHIFT);
+
+	if ((ref_timestamp != NULL) && (timestamp >= *ref_timestamp)) {
+		hdr[1] |= LOG_DICT_OUTPUT_PACKED_DELTA_TIMESTAMP;
+		timestamp -= *ref_timestamp;
+	}
+
+	if (data_len > 0U) {
+		hdr[1] |= LOG_DICT_OUTPUT_PACKED_HAS_DATA;
+	}
+
+	hdr_len = 2;
+	hdr_len += varint_encode(&hdr[hdr_len], source_id);
+	hdr_len += varint_encode(&hdr[hdr_len], timestamp);
+	hdr_len += varint_encode(&hdr[hdr_len], package_len);
+
+	if (data_len > 0U) {
+		hdr_len += varint_encode(&hdr[hdr_len], data_len);
+	}
+
+	if ((hdr_len + package_len + data_len) <= output->size) {
+		/* Let the output write the whole message at once. */
+		log_output_flush(output);
+
+		memcpy(output->buf, hdr, hdr_len);
+		memcpy(output->buf + hdr_len, package, package_len);
+		memcpy(output->buf + hdr_len + package_len, data, data_len);
+
+		buffer_write(output->func, output->buf,
+			     hdr_len + package_len + data_len,
+			     (void *)output->control_block->ctx);
+	} else {
+		buffer_write(output->func, hdr, hdr_len,
+			     (void *)output->control_block->ctx);
+
+		if (package_len > 0U) {
+			buffer_write(output->func, package, package_len,
+				     (void *)output->control_block->ctx);
+		}
+
+		if (data_len > 0U) {
+			buffer_write(output->func, data, data_len,
+				     (void *)output->control_block->ctx);
+		}
+	}
+
+	return hdr_len + package_len + data_len;
+}
+
 void log_dict_output_dropped_process(const struct log_output *output, uint32_t cnt)
 {
 	struct log_dict_output_dropped_msg_t msg;
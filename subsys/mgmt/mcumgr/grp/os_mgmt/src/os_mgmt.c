@@ -254,6 +254,11 @@ os_mgmt_taskstat_encode_runtime_info(zcbor_state_t *zse,
 
 	ok = zcbor_tstr_put_lit(zse, "runtime") &&
 	zcbor_uint64_put(zse, thread_stats.execution_cycles);
+
+#if defined(CONFIG_SCHED_USAGE_MONITOR)
+	ok = ok && zcbor_tstr_put_lit(zse, "load") &&
+	zcbor_uint32_put(zse, thread_stats.window_load);
+#endif
 #elif !defined(CONFIG_MCUMGR_GRP_OS_TASKSTAT_ONLY_SUPPORTED_STATS)
 	ok = zcbor_tstr_put_lit(zse, "runtime") &&
 	zcbor_uint32_put(zse, 0);
@@ -254,7 +254,11 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt, bool is_loopback)
 
 	net_stats_update_ipv4_recv(net_pkt_iface(pkt));
 
-	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	hdr = net_pkt_header_ptr(pkt, sizeof(struct net_ipv4_hdr));
+	if (!hdr) {
+		hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	}
+
 	if (!hdr) {
 		NET_DBG("DROP: no buffer");
 		goto drop;
@@ -474,7 +474,11 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 
 	net_stats_update_ipv6_recv(pkt_iface);
 
-	hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt, &ipv6_access);
+	hdr = net_pkt_header_ptr(pkt, sizeof(struct net_ipv6_hdr));
+	if (!hdr) {
+		hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt, &ipv6_access);
+	}
+
 	if (!hdr) {
 		NET_DBG("DROP: no buffer");
 		goto drop;
@@ -88,6 +88,13 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 		return NET_DROP;
 	}
 
+	/* Let L2 and the upper layers access the headers in place. If the
+	 * pull up is not possible, they are read from the fragments.
+	 */
+	if (CONFIG_NET_PKT_PULLUP_LEN > 0) {
+		(void)net_pkt_pullup(pkt, CONFIG_NET_PKT_PULLUP_LEN);
+	}
+
 	if (!is_loopback && !locally_routed) {
 		ret = net_if_recv_data(net_pkt_iface(pkt), pkt);
 		if (ret != NET_CONTINUE) {
@@ -459,6 +466,7 @@ void net_process_rx_packet(struct net_pkt *pkt)
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
 	net_capture_pkt(net_pkt_iface(pkt), pkt);
+	net_capture_ring_pkt(net_pkt_iface(pkt), pkt, false);
 
 	net_rx(net_pkt_iface(pkt), pkt);
 }
@@ -2138,6 +2138,61 @@ size_t net_pkt_get_contiguous_len(struct net_pkt *pkt)
 	return 0;
 }
 
+int net_pkt_pullup(struct net_pkt *pkt, size_t length)
+{
+	struct net_buf *buf = pkt->buffer;
+	struct net_buf *frag;
+	size_t needed;
+	size_t len;
+
+	if (!buf || buf->len >= length) {
+		return 0;
+	}
+
+	/* Check everything first so that the packet is left untouched */
+	needed = length - buf->len;
+
+	for (frag = buf->frags, len = 0; frag && len < needed;
+	     frag = frag->frags) {
+		if (frag->ref > 1) {
+			return -EBUSY;
+		}
+
+		len += frag->len;
+	}
+
+	needed = MIN(needed, len);
+	if (!needed) {
+		return 0;
+	}
+
+	if (buf->ref > 1) {
+		return -EBUSY;
+	}
+
+	if (net_buf_tailroom(buf) < needed) {
+		NET_DBG("No room to pull up %zu bytes in pkt %p", needed, pkt);
+		return -ENOBUFS;
+	}
+
+	frag = buf->frags;
+	while (needed) {
+		len = MIN(needed, frag->len);
+
+		net_buf_add_mem(buf, frag->data, len);
+		net_buf_pull(frag, len);
+		needed -= len;
+
+		if (!frag->len) {
+			frag = net_buf_frag_del(buf, frag);
+		}
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return 0;
+}
+
 void *net_pkt_get_data(struct net_pkt *pkt,
 		       struct net_pkt_data_access *access)
 {
@@ -27,7 +27,75 @@ LOG_MODULE_REGISTER(net_stats, NET_LOG_LEVEL);
  * The variable needs to be global so that the GET_STAT() macro can access it
  * from net_shell.c
  */
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+struct net_stats_cpu net_stats[CONFIG_MP_MAX_NUM_CPUS];
+
+#define SUM_STAT64(sum, cpus, s)					\
+	do {								\
+		(sum)->s = 0;						\
+		for (int _i = 0; _i < CONFIG_MP_MAX_NUM_CPUS; _i++) {	\
+			(sum)->s += (cpus)[_i].stats.s;			\
+		}							\
+	} while (false)
+
+void net_stats_sum(struct net_stats *sum, const struct net_stats_cpu *cpus)
+{
+	net_stats_t *dst = (net_stats_t *)sum;
+
+	/* All the statistics are counters of type net_stats_t, or are only
+	 * set in the statistics of the first CPU, except for the 64-bit sums
+	 * which are added again below with their carry.
+	 */
+	BUILD_ASSERT(sizeof(struct net_stats) % sizeof(net_stats_t) == 0);
+
+	for (size_t i = 0; i < sizeof(*sum) / sizeof(net_stats_t); i++) {
+		dst[i] = 0;
+		for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+			dst[i] += ((const net_stats_t *)&cpus[cpu].stats)[i];
+		}
+	}
+
+#if defined(CONFIG_NET_PKT_TXTIME_STATS)
+	SUM_STAT64(sum, cpus, tx_time.sum);
+#endif
+#if defined(CONFIG_NET_PKT_RXTIME_STATS)
+	SUM_STAT64(sum, cpus, rx_time.sum);
+#endif
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)
+	for (int i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
+		SUM_STAT64(sum, cpus, tx_time_detail[i].sum);
+	}
+#endif
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+	for (int i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
+		SUM_STAT64(sum, cpus, rx_time_detail[i].sum);
+	}
+#endif
+#if NET_TC_COUNT > 1
+	for (int tc = 0; tc < NET_TC_TX_STATS_COUNT; tc++) {
+		SUM_STAT64(sum, cpus, tc.sent[tc].tx_time.sum);
+#if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL)
+		for (int i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
+			SUM_STAT64(sum, cpus, tc.sent[tc].tx_time_detail[i].sum);
+		}
+#endif
+	}
+	for (int tc = 0; tc < NET_TC_RX_STATS_COUNT; tc++) {
+		SUM_STAT64(sum, cpus, tc.recv[tc].rx_time.sum);
+#if defined(CONFIG_NET_PKT_RXTIME_STATS_DETAIL)
+		for (int i = 0; i < NET_PKT_DETAIL_STATS_COUNT; i++) {
+			SUM_STAT64(sum, cpus, tc.recv[tc].rx_time_detail[i].sum);
+		}
+#endif
+	}
+#endif
+#if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
+	SUM_STAT64(sum, cpus, pm.overall_suspend_time);
+#endif
+}
+#else
 struct net_stats net_stats = { 0 };
+#endif
 
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT)
 
@@ -133,6 +201,16 @@ static inline void stats(struct net_if *iface)
 			 GET_STAT(iface, udp.chkerr));
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_DNS)
+		if (!iface) {
+			NET_INFO("DNS cache hit  %d\tneghit\t%d\tmiss\t%d\tprefetch\t%d",
+				 GET_STAT(iface, dns.cache_hit),
+				 GET_STAT(iface, dns.cache_negative_hit),
+				 GET_STAT(iface, dns.cache_miss),
+				 GET_STAT(iface, dns.cache_prefetch));
+		}
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_TCP)
 		NET_INFO("TCP bytes recv %u\tsent\t%d",
 			 GET_STAT(iface, tcp.bytes.received),
@@ -237,81 +315,107 @@ void net_print_statistics(void)
 static int net_stats_get(uint32_t mgmt_request, struct net_if *iface,
 			 void *data, size_t len)
 {
+	const struct net_stats *stats;
+	const void *src = NULL;
 	size_t len_chk = 0;
-	void *src = NULL;
+	int ret = 0;
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	static K_MUTEX_DEFINE(sum_lock);
+	static struct net_stats sum;
+
+	k_mutex_lock(&sum_lock, K_FOREVER);
+	net_stats_sum(&sum, NET_STATS_CPUS(iface));
+	stats = &sum;
+#elif defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+	stats = iface ? &iface->stats : &net_stats;
+#else
+	stats = &net_stats;
+#endif
 
 	switch (NET_MGMT_GET_COMMAND(mgmt_request)) {
 	case NET_REQUEST_STATS_CMD_GET_ALL:
 		len_chk = sizeof(struct net_stats);
-#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
-		src = iface ? &iface->stats : &net_stats;
-#else
-		src = &net_stats;
-#endif
+		src = stats;
 		break;
 	case NET_REQUEST_STATS_CMD_GET_PROCESSING_ERROR:
 		len_chk = sizeof(net_stats_t);
-		src = GET_STAT_ADDR(iface, processing_error);
+		src = &stats->processing_error;
 		break;
 	case NET_REQUEST_STATS_CMD_GET_BYTES:
 		len_chk = sizeof(struct net_stats_bytes);
-		src = GET_STAT_ADDR(iface, bytes);
+		src = &stats->bytes;
 		break;
 	case NET_REQUEST_STATS_CMD_GET_IP_ERRORS:
 		len_chk = sizeof(struct net_stats_ip_errors);
-		src = GET_STAT_ADDR(iface, ip_errors);
+		src = &stats->ip_errors;
 		break;
 #if defined(CONFIG_NET_STATISTICS_IPV4)
 	case NET_REQUEST_STATS_CMD_GET_IPV4:
 		len_chk = sizeof(struct net_stats_ip);
-		src = GET_STAT_ADDR(iface, ipv4);
+		src = &stats->ipv4;
 		break;
 #endif
 #if defined(CONFIG_NET_STATISTICS_IPV6)
 	case NET_REQUEST_STATS_CMD_GET_IPV6:
 		len_chk = sizeof(struct net_stats_ip);
-		src = GET_STAT_ADDR(iface, ipv6);
+		src = &stats->ipv6;
 		break;
 #endif
 #if defined(CONFIG_NET_STATISTICS_IPV6_ND)
 	case NET_REQUEST_STATS_CMD_GET_IPV6_ND:
 		len_chk = sizeof(struct net_stats_ipv6_nd);
-		src = GET_STAT_ADDR(iface, ipv6_nd);
+		src = &stats->ipv6_nd;
 		break;
 #endif
 #if defined(CONFIG_NET_STATISTICS_ICMP)
 	case NET_REQUEST_STATS_CMD_GET_ICMP:
 		len_chk = sizeof(struct net_stats_icmp);
-		src = GET_STAT_ADDR(iface, icmp);
+		src = &stats->icmp;
 		break;
 #endif
 #if defined(CONFIG_NET_STATISTICS_UDP)
 	case NET_REQUEST_STATS_CMD_GET_UDP:
 		len_chk = sizeof(struct net_stats_udp);
-		src = GET_STAT_ADDR(iface, udp);
+		src = &stats->udp;
 		break;
 #endif
 #if defined(CONFIG_NET_STATISTICS_TCP)
 	case NET_REQUEST_STATS_CMD_GET_TCP:
 		len_chk = sizeof(struct net_stats_tcp);
-		src = GET_STAT_ADDR(iface, tcp);
+		src = &stats->tcp;
+		break;
+#endif
+#if defined(CONFIG_NET_STATISTICS_DNS)
+	case NET_REQUEST_STATS_CMD_GET_DNS:
+		/* The DNS resolver is not bound to an interface */
+		len_chk = sizeof(struct net_stats_dns);
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+		net_stats_sum(&sum, net_stats);
+		src = &sum.dns;
+#else
+		src = &net_stats.dns;
+#endif
 		break;
 #endif
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
 	case NET_REQUEST_STATS_GET_PM:
 		len_chk = sizeof(struct net_stats_pm);
-		src = GET_STAT_ADDR(iface, pm);
+		src = &stats->pm;
 		break;
 #endif
 	}
 
 	if (len != len_chk || !src) {
-		return -EINVAL;
+		ret = -EINVAL;
+	} else {
+		memcpy(data, src, len);
 	}
 
-	memcpy(data, src, len);
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	k_mutex_unlock(&sum_lock);
+#endif
 
-	return 0;
+	return ret;
 }
 
 NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_ALL,
@@ -361,6 +465,11 @@ NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_PM,
 				  net_stats_get);
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_DNS)
+NET_MGMT_REGISTER_REQUEST_HANDLER(NET_REQUEST_STATS_GET_DNS,
+				  net_stats_get);
+#endif
+
 #endif /* CONFIG_NET_STATISTICS_USER_API */
 
 void net_stats_reset(struct net_if *iface)
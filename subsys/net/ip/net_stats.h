@@ -15,22 +15,73 @@
 #include <zephyr/net/net_stats.h>
 #include <zephyr/net/net_if.h>
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* Counters are updated in the statistics of the current CPU and summed when
+ * read. The other statistics are kept in the ones of the first CPU, so that
+ * the sum gives them back, the ones of the other CPUs staying zero.
+ */
+extern struct net_stats_cpu net_stats[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Update the statistics of the current CPU, whose index is given in _cpu.
+ * Interrupts are locked so that a preemptible thread cannot move to another
+ * CPU between reading the index and updating the statistics, which also
+ * makes _current_cpu valid from such a thread.
+ */
+#define UPDATE_STAT_CURRENT_CPU(_update)				\
+	do {								\
+		unsigned int _key = arch_irq_lock();			\
+		unsigned int _cpu = _current_cpu->id;			\
+									\
+		_update;						\
+		arch_irq_unlock(_key);					\
+	} while (false)
+
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+#define SET_STAT(cmd) (cmd)
+#define NET_STATS_CPUS(iface) (iface ? iface->stats : net_stats)
+#else
+#define SET_STAT(cmd)
+#define NET_STATS_CPUS(iface) (net_stats)
+#endif
+
+#define GET_STAT(iface, s) ({						\
+	const struct net_stats_cpu *_cpus = NET_STATS_CPUS(iface);	\
+	__typeof__(net_stats[0].stats.s) _sum = 0;			\
+									\
+	for (int _i = 0; _i < CONFIG_MP_MAX_NUM_CPUS; _i++) {		\
+		_sum += _cpus[_i].stats.s;				\
+	}								\
+	_sum;								\
+})
+
+#define UPDATE_STAT_CPU(_iface, _cpu, _cmd) \
+	{ NET_ASSERT(_iface); (net_stats[_cpu]._cmd); \
+	  SET_STAT(_iface->stats[_cpu]._cmd); }
+#define UPDATE_STAT_GLOBAL(cmd) UPDATE_STAT_CURRENT_CPU(net_stats[_cpu].cmd)
+#define UPDATE_STAT(_iface, _cmd) \
+	UPDATE_STAT_CURRENT_CPU(UPDATE_STAT_CPU(_iface, _cpu, _cmd))
+#define UPDATE_STAT_VALUE(_iface, _cmd) UPDATE_STAT_CPU(_iface, 0, _cmd)
+
+/* Sum the statistics of the CPUs. */
+void net_stats_sum(struct net_stats *sum, const struct net_stats_cpu *cpus);
+#else
 extern struct net_stats net_stats;
 
 #if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
 #define SET_STAT(cmd) (cmd)
 #define GET_STAT(iface, s) (iface ? iface->stats.s : net_stats.s)
-#define GET_STAT_ADDR(iface, s) (iface ? &iface->stats.s : &net_stats.s)
 #else
 #define SET_STAT(cmd)
 #define GET_STAT(iface, s) (net_stats.s)
-#define GET_STAT_ADDR(iface, s) (&GET_STAT(iface, s))
 #endif
 
 #define UPDATE_STAT_GLOBAL(cmd) (net_##cmd)
 #define UPDATE_STAT(_iface, _cmd) \
 	{ NET_ASSERT(_iface); (UPDATE_STAT_GLOBAL(_cmd)); \
 	  SET_STAT(_iface->_cmd); }
+#define UPDATE_STAT_VALUE(_iface, _cmd) UPDATE_STAT(_iface, _cmd)
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
 /* Core stats */
 
 static inline void net_stats_update_processing_error(struct net_if *iface)
@@ -345,6 +396,34 @@ static inline void net_stats_update_ipv4_igmp_drop(struct net_if *iface)
 #define net_stats_update_ipv4_igmp_drop(iface)
 #endif /* CONFIG_NET_STATISTICS_IGMP */
 
+#if defined(CONFIG_NET_STATISTICS_DNS) && defined(CONFIG_NET_NATIVE)
+/* DNS stats are global only, the resolver is not bound to an interface */
+static inline void net_stats_update_dns_cache_hit(void)
+{
+	UPDATE_STAT_GLOBAL(stats.dns.cache_hit++);
+}
+
+static inline void net_stats_update_dns_cache_negative_hit(void)
+{
+	UPDATE_STAT_GLOBAL(stats.dns.cache_negative_hit++);
+}
+
+static inline void net_stats_update_dns_cache_miss(void)
+{
+	UPDATE_STAT_GLOBAL(stats.dns.cache_miss++);
+}
+
+static inline void net_stats_update_dns_cache_prefetch(void)
+{
+	UPDATE_STAT_GLOBAL(stats.dns.cache_prefetch++);
+}
+#else
+#define net_stats_update_dns_cache_hit()
+#define net_stats_update_dns_cache_negative_hit()
+#define net_stats_update_dns_cache_miss()
+#define net_stats_update_dns_cache_prefetch()
+#endif /* CONFIG_NET_STATISTICS_DNS */
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS) && defined(CONFIG_NET_STATISTICS)
 static inline void net_stats_update_tx_time(struct net_if *iface,
 					    uint32_t start_time,
@@ -427,7 +506,7 @@ static inline void net_stats_update_tc_sent_bytes(struct net_if *iface,
 static inline void net_stats_update_tc_sent_priority(struct net_if *iface,
 						     uint8_t tc, uint8_t priority)
 {
-	UPDATE_STAT(iface, stats.tc.sent[tc].priority = priority);
+	UPDATE_STAT_VALUE(iface, stats.tc.sent[tc].priority = priority);
 }
 
 #if defined(CONFIG_NET_PKT_TXTIME_STATS) && \
@@ -528,7 +607,7 @@ static inline void net_stats_update_tc_recv_bytes(struct net_if *iface,
 static inline void net_stats_update_tc_recv_priority(struct net_if *iface,
 						     uint8_t tc, uint8_t priority)
 {
-	UPDATE_STAT(iface, stats.tc.recv[tc].priority = priority);
+	UPDATE_STAT_VALUE(iface, stats.tc.recv[tc].priority = priority);
 }
 #else
 #define net_stats_update_tc_sent_pkt(iface, tc)
@@ -600,7 +679,7 @@ static inline void net_stats_update_tc_rx_time_detail(struct net_if *iface,
 static inline void net_stats_add_suspend_start_time(struct net_if *iface,
 						    uint32_t time)
 {
-	UPDATE_STAT(iface, stats.pm.start_time = time);
+	UPDATE_STAT_VALUE(iface, stats.pm.start_time = time);
 }
 
 static inline void net_stats_add_suspend_end_time(struct net_if *iface,
@@ -609,8 +688,8 @@ static inline void net_stats_add_suspend_end_time(struct net_if *iface,
 	uint32_t diff_time =
 		k_cyc_to_ms_floor32(time - GET_STAT(iface, pm.start_time));
 
-	UPDATE_STAT(iface, stats.pm.start_time = 0);
-	UPDATE_STAT(iface, stats.pm.last_suspend_time = diff_time);
+	UPDATE_STAT_VALUE(iface, stats.pm.start_time = 0);
+	UPDATE_STAT_VALUE(iface, stats.pm.last_suspend_time = diff_time);
 	UPDATE_STAT(iface, stats.pm.suspend_count++);
 	UPDATE_STAT(iface, stats.pm.overall_suspend_time += diff_time);
 }
@@ -28,11 +28,33 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include "icmpv6.h"
 #include "nbr.h"
 #include "route.h"
+#include "route_lpm.h"
 
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+/* Longest prefix match trie indexing the routing table. Each distinct
+ * prefix needs at most two trie nodes.
+ */
+static struct net_route_lpm_node route_lpm_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct net_route_lpm route_lpm;
+#endif
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Small direct mapped cache of the latest lookup results. It is flushed
+ * whenever the routing table changes.
+ */
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+#endif
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -128,27 +150,28 @@ static inline struct net_route_entry *net_route_data(struct net_nbr *nbr)
 struct net_nbr *net_route_get_nbr(struct net_route_entry *route)
 {
 	struct net_nbr *ret = NULL;
-	int i;
+	uintptr_t offset;
+	size_t i;
 
 	NET_ASSERT(route);
 
-	net_ipv6_nbr_lock();
-
-	for (i = 0; i < CONFIG_NET_MAX_ROUTES; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	/* The route data is stored inside the pool entry, so the owning
+	 * neighbor can be found directly from the route address.
+	 */
+	offset = (uintptr_t)route - (uintptr_t)net_route_entries_pool[0].data;
+	if (offset % sizeof(net_route_entries_pool[0]) != 0U) {
+		return NULL;
+	}
 
-		if (!nbr->ref) {
-			continue;
-		}
+	i = offset / sizeof(net_route_entries_pool[0]);
+	if (i >= CONFIG_NET_MAX_ROUTES) {
+		return NULL;
+	}
 
-		if (nbr->data == (uint8_t *)route) {
-			if (!nbr->ref) {
-				break;
-			}
+	net_ipv6_nbr_lock();
 
-			ret = nbr;
-			break;
-		}
+	if (get_nbr(i)->ref) {
+		ret = get_nbr(i);
 	}
 
 	net_ipv6_nbr_unlock();
@@ -263,19 +286,83 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
+
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+static inline struct route_cache_entry *route_cache_get(struct net_if *iface,
+							struct in6_addr *dst)
+{
+	uint32_t hash = UNALIGNED_GET(&dst->s6_addr32[0]) ^
+			UNALIGNED_GET(&dst->s6_addr32[1]) ^
+			UNALIGNED_GET(&dst->s6_addr32[2]) ^
+			UNALIGNED_GET(&dst->s6_addr32[3]) ^
+			(uint32_t)(uintptr_t)iface;
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static inline void route_cache_flush(void)
+{
+	memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+#define route_cache_flush(...)
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+static bool route_lpm_iface_match(sys_snode_t *entry, void *user_data)
+{
+	struct net_route_entry *route =
+		CONTAINER_OF(entry, struct net_route_entry, lpm_node);
+
+	return route->iface == user_data;
+}
+
+static struct net_route_entry *route_lookup(struct net_if *iface,
+					    struct in6_addr *dst)
+{
+	sys_snode_t *entry;
+
+	entry = net_route_lpm_lookup(&route_lpm, dst->s6_addr,
+				     iface ? route_lpm_iface_match : NULL,
+				     iface);
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(entry, struct net_route_entry, lpm_node);
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *addr,
+					  uint8_t prefix_len)
+{
+	sys_snode_t *entry;
+
+	entry = net_route_lpm_get(&route_lpm, addr->s6_addr, prefix_len,
+				  route_lpm_iface_match, iface);
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(entry, struct net_route_entry, lpm_node);
+}
+#else
+static struct net_route_entry *route_lookup(struct net_if *iface,
+					    struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +385,63 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *addr,
+					  uint8_t prefix_len)
+{
+	struct net_route_entry *route;
+	int i;
+
+	for (i = 0; i < CONFIG_NET_MAX_ROUTES; i++) {
+		struct net_nbr *nbr = get_nbr(i);
+
+		if (!nbr->ref || nbr->iface != iface) {
+			continue;
+		}
+
+		route = net_route_data(nbr);
+
+		if (route->prefix_len == prefix_len &&
+		    net_ipv6_is_prefix(addr->s6_addr, route->addr.s6_addr,
+				       prefix_len)) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	struct route_cache_entry *cache;
+#endif
+
+	net_ipv6_nbr_lock();
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	cache = route_cache_get(iface, dst);
+	if (cache->route != NULL && cache->iface == iface &&
+	    net_ipv6_addr_cmp(&cache->dst, dst)) {
+		found = cache->route;
+	} else {
+		found = route_lookup(iface, dst);
+		if (found) {
+			net_ipaddr_copy(&cache->dst, dst);
+			cache->iface = iface;
+			cache->route = found;
+		}
+	}
+#else
+	found = route_lookup(iface, dst);
+#endif
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -361,7 +505,10 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 			net_sprint_ll_addr(nexthop_lladdr->addr, nexthop_lladdr->len));
 	}
 
-	route = net_route_lookup(iface, addr);
+	/* Only a route with the very same prefix is replaced, a more
+	 * specific route can coexist with the one covering it.
+	 */
+	route = route_find(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
@@ -393,9 +540,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
-		sys_slist_find_and_remove(&routes, last);
+		sys_dlist_remove(last);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -444,7 +591,17 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	if (net_route_lpm_add(&route_lpm, addr->s6_addr, prefix_len,
+			      &route->lpm_node) < 0) {
+		NET_ERR("Cannot index route to %s/%d",
+			net_sprint_ipv6_addr(addr), prefix_len);
+	}
+#endif
+
+	route_cache_flush();
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -586,7 +743,9 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -594,6 +753,13 @@ int net_route_del(struct net_route_entry *route)
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	(void)net_route_lpm_del(&route_lpm, route->addr.s6_addr,
+				route->prefix_len, &route->lpm_node);
+#endif
+
+	route_cache_flush();
+
 	net_route_info("Deleted", route, &route->addr);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
@@ -1069,6 +1235,11 @@ void net_route_init(void)
 	NET_DBG("Allocated %d nexthop entries (%zu bytes)",
 		CONFIG_NET_MAX_NEXTHOPS, sizeof(net_route_nexthop_pool));
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	net_route_lpm_init(&route_lpm, route_lpm_nodes,
+			   ARRAY_SIZE(route_lpm_nodes), 128);
+#endif
+
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
 #endif
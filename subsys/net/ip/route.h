@@ -15,6 +15,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/net_timeout.h>
@@ -47,7 +48,14 @@ struct net_route_entry {
 	 * we can remove it if we run out of available routes.
 	 * The oldest one is the last entry in the list.
 	 */
-	sys_snode_t node;
+	sys_dnode_t node;
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	/** Node in the longest prefix match trie. Routes having the same
+	 * prefix on different interfaces share one trie node.
+	 */
+	sys_snode_t lpm_node;
+#endif
 
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
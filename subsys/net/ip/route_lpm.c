@@ -0,0 +1,330 @@
+/** @file
+ * @brief Longest prefix match trie used by the routing code.
+ *
+ * The trie is a path compressed binary trie. Each node stores the full
+ * prefix leading to it, so a lookup only compares the key against the
+ * nodes on its path and descends using the first bit after the node
+ * prefix. Lookup, insertion and removal therefore cost at most one
+ * node visit per key bit, independently of how many prefixes are stored.
+ */
+
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#include "route_lpm.h"
+
+static inline uint8_t key_bit(const uint8_t *key, uint8_t bit)
+{
+	return (key[bit / 8] >> (7 - (bit % 8))) & 0x01;
+}
+
+/* Return the number of leading bits that a and b have in common, at most
+ * max_len bits are compared.
+ */
+static uint8_t common_prefix_len(const uint8_t *a, const uint8_t *b,
+				 uint8_t max_len)
+{
+	uint8_t len = 0U;
+	int i;
+
+	for (i = 0; len < max_len; i++) {
+		uint8_t diff = a[i] ^ b[i];
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - (32 - 8);
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max_len);
+}
+
+static void prefix_copy(uint8_t *dst, const uint8_t *src, uint8_t prefix_len)
+{
+	uint8_t bytes = prefix_len / 8;
+	uint8_t bits = prefix_len % 8;
+
+	memset(dst, 0, NET_ROUTE_LPM_KEY_MAX_LEN);
+	memcpy(dst, src, bytes);
+
+	if (bits != 0U) {
+		dst[bytes] = src[bytes] & (uint8_t)(0xff << (8 - bits));
+	}
+}
+
+static struct net_route_lpm_node *node_alloc(struct net_route_lpm *lpm)
+{
+	struct net_route_lpm_node *node = lpm->free;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	lpm->free = node->child[0];
+
+	node->child[0] = NULL;
+	node->child[1] = NULL;
+	node->parent = NULL;
+	sys_slist_init(&node->entries);
+
+	return node;
+}
+
+static void node_free(struct net_route_lpm *lpm,
+		      struct net_route_lpm_node *node)
+{
+	node->child[0] = lpm->free;
+	lpm->free = node;
+}
+
+static struct net_route_lpm_node **node_slot(struct net_route_lpm *lpm,
+					     struct net_route_lpm_node *node)
+{
+	struct net_route_lpm_node *parent = node->parent;
+
+	if (parent == NULL) {
+		return &lpm->root;
+	}
+
+	return parent->child[0] == node ? &parent->child[0] : &parent->child[1];
+}
+
+/* Put child in the place that node currently has in the trie */
+static void node_replace(struct net_route_lpm *lpm,
+			 struct net_route_lpm_node *node,
+			 struct net_route_lpm_node *child)
+{
+	*node_slot(lpm, node) = child;
+
+	if (child != NULL) {
+		child->parent = node->parent;
+	}
+}
+
+static struct net_route_lpm_node *node_find(const struct net_route_lpm *lpm,
+					    const uint8_t *prefix,
+					    uint8_t prefix_len)
+{
+	struct net_route_lpm_node *node = lpm->root;
+
+	while (node != NULL && node->prefix_len <= prefix_len) {
+		if (common_prefix_len(node->prefix, prefix,
+				      node->prefix_len) < node->prefix_len) {
+			return NULL;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			return node;
+		}
+
+		node = node->child[key_bit(prefix, node->prefix_len)];
+	}
+
+	return NULL;
+}
+
+void net_route_lpm_init(struct net_route_lpm *lpm,
+			struct net_route_lpm_node *pool, size_t count,
+			uint8_t key_bits)
+{
+	size_t i;
+
+	__ASSERT_NO_MSG(key_bits <= NET_ROUTE_LPM_KEY_MAX_BITS);
+
+	lpm->root = NULL;
+	lpm->free = NULL;
+	lpm->key_bits = key_bits;
+
+	for (i = 0; i < count; i++) {
+		node_free(lpm, &pool[i]);
+	}
+}
+
+int net_route_lpm_add(struct net_route_lpm *lpm, const uint8_t *prefix,
+		      uint8_t prefix_len, sys_snode_t *entry)
+{
+	struct net_route_lpm_node **slot = &lpm->root;
+	struct net_route_lpm_node *parent = NULL;
+	struct net_route_lpm_node *node, *new_node, *im_node;
+	uint8_t match_len = 0U;
+
+	if (prefix_len > lpm->key_bits) {
+		return -EINVAL;
+	}
+
+	while ((node = *slot) != NULL) {
+		match_len = common_prefix_len(node->prefix, prefix,
+					      MIN(node->prefix_len,
+						  prefix_len));
+
+		if (match_len != node->prefix_len ||
+		    node->prefix_len == prefix_len) {
+			break;
+		}
+
+		parent = node;
+		slot = &node->child[key_bit(prefix, node->prefix_len)];
+	}
+
+	if (node != NULL && node->prefix_len == prefix_len &&
+	    match_len == prefix_len) {
+		/* Exact match, the prefix is already in the trie */
+		sys_slist_append(&node->entries, entry);
+		return 0;
+	}
+
+	new_node = node_alloc(lpm);
+	if (new_node == NULL) {
+		return -ENOMEM;
+	}
+
+	prefix_copy(new_node->prefix, prefix, prefix_len);
+	new_node->prefix_len = prefix_len;
+	new_node->parent = parent;
+	sys_slist_append(&new_node->entries, entry);
+
+	if (node == NULL) {
+		*slot = new_node;
+		return 0;
+	}
+
+	if (match_len == prefix_len) {
+		/* The new prefix covers the existing node, so insert the new
+		 * node above it.
+		 */
+		new_node->child[key_bit(node->prefix, prefix_len)] = node;
+		node->parent = new_node;
+		*slot = new_node;
+		return 0;
+	}
+
+	/* The prefixes diverge at match_len, branch with an intermediate
+	 * node there.
+	 */
+	im_node = node_alloc(lpm);
+	if (im_node == NULL) {
+		node_free(lpm, new_node);
+		return -ENOMEM;
+	}
+
+	prefix_copy(im_node->prefix, prefix, match_len);
+	im_node->prefix_len = match_len;
+	im_node->parent = parent;
+
+	if (key_bit(prefix, match_len)) {
+		im_node->child[0] = node;
+		im_node->child[1] = new_node;
+	} else {
+		im_node->child[0] = new_node;
+		im_node->child[1] = node;
+	}
+
+	node->parent = im_node;
+	new_node->parent = im_node;
+	*slot = im_node;
+
+	return 0;
+}
+
+int net_route_lpm_del(struct net_route_lpm *lpm, const uint8_t *prefix,
+		      uint8_t prefix_len, sys_snode_t *entry)
+{
+	struct net_route_lpm_node *node, *parent;
+
+	node = node_find(lpm, prefix, prefix_len);
+	if (node == NULL || !sys_slist_find_and_remove(&node->entries, entry)) {
+		return -ENOENT;
+	}
+
+	if (!sys_slist_is_empty(&node->entries)) {
+		return 0;
+	}
+
+	if (node->child[0] != NULL && node->child[1] != NULL) {
+		/* Still needed as a branching point */
+		return 0;
+	}
+
+	parent = node->parent;
+
+	node_replace(lpm, node, node->child[0] != NULL ? node->child[0] :
+							  node->child[1]);
+	node_free(lpm, node);
+
+	/* An intermediate parent that is left with a single child is not
+	 * needed anymore.
+	 */
+	if (parent != NULL && sys_slist_is_empty(&parent->entries) &&
+	    (parent->child[0] == NULL || parent->child[1] == NULL)) {
+		node_replace(lpm, parent, parent->child[0] != NULL ?
+					  parent->child[0] : parent->child[1]);
+		node_free(lpm, parent);
+	}
+
+	return 0;
+}
+
+sys_snode_t *net_route_lpm_get(const struct net_route_lpm *lpm,
+			       const uint8_t *prefix, uint8_t prefix_len,
+			       net_route_lpm_match_cb_t cb,
+			       void *user_data)
+{
+	struct net_route_lpm_node *node;
+	sys_snode_t *entry;
+
+	node = node_find(lpm, prefix, prefix_len);
+	if (node == NULL) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_NODE(&node->entries, entry) {
+		if (cb == NULL || cb(entry, user_data)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+sys_snode_t *net_route_lpm_lookup(const struct net_route_lpm *lpm,
+				  const uint8_t *key,
+				  net_route_lpm_match_cb_t cb,
+				  void *user_data)
+{
+	struct net_route_lpm_node *node = lpm->root;
+	sys_snode_t *found = NULL;
+	sys_snode_t *entry;
+
+	while (node != NULL) {
+		if (common_prefix_len(node->prefix, key,
+				      node->prefix_len) < node->prefix_len) {
+			break;
+		}
+
+		SYS_SLIST_FOR_EACH_NODE(&node->entries, entry) {
+			if (cb == NULL || cb(entry, user_data)) {
+				found = entry;
+				break;
+			}
+		}
+
+		if (node->prefix_len >= lpm->key_bits) {
+			break;
+		}
+
+		node = node->child[key_bit(key, node->prefix_len)];
+	}
+
+	return found;
+}
@@ -0,0 +1,166 @@
+/** @file
+ * @brief Longest prefix match trie used by the routing code.
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ROUTE_LPM_H
+#define __ROUTE_LPM_H
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Longest key (in bytes) that the trie can store, i.e. an IPv6 address */
+#define NET_ROUTE_LPM_KEY_MAX_LEN 16
+
+/** Longest key (in bits) that the trie can store */
+#define NET_ROUTE_LPM_KEY_MAX_BITS (NET_ROUTE_LPM_KEY_MAX_LEN * 8)
+
+/**
+ * @brief Node of a path compressed binary (Patricia) trie.
+ *
+ * A node is either a prefix node that has a non empty list of entries
+ * attached to it, or an intermediate node that only exists to branch
+ * the trie at a bit where two stored prefixes differ. Such an
+ * intermediate node always has two children.
+ */
+struct net_route_lpm_node {
+	/** Children of this node, indexed by the bit following the prefix. */
+	struct net_route_lpm_node *child[2];
+
+	/** Parent node, NULL for the root node. */
+	struct net_route_lpm_node *parent;
+
+	/** Entries using this exact prefix. Empty for intermediate nodes. */
+	sys_slist_t entries;
+
+	/** Prefix bits. Bits after prefix_len are always zero. */
+	uint8_t prefix[NET_ROUTE_LPM_KEY_MAX_LEN];
+
+	/** Prefix length in bits. */
+	uint8_t prefix_len;
+};
+
+/**
+ * @brief Longest prefix match table.
+ *
+ * The table does not allocate memory itself, the nodes are taken from
+ * the pool given in net_route_lpm_init(). A table holding N distinct
+ * prefixes needs at most 2 * N - 1 nodes. The table does no locking,
+ * the caller is expected to serialize access to it.
+ */
+struct net_route_lpm {
+	/** Root of the trie. */
+	struct net_route_lpm_node *root;
+
+	/** Unused nodes, linked through child[0]. */
+	struct net_route_lpm_node *free;
+
+	/** Key length in bits, 32 for IPv4 and 128 for IPv6 tables. */
+	uint8_t key_bits;
+};
+
+/**
+ * @brief Callback used to filter the entries of a prefix during lookup.
+ *
+ * @param entry Entry attached to a matching prefix.
+ * @param user_data User specified data.
+ *
+ * @return True if the entry is acceptable, false otherwise.
+ */
+typedef bool (*net_route_lpm_match_cb_t)(sys_snode_t *entry,
+					 void *user_data);
+
+/**
+ * @brief Initialize a longest prefix match table.
+ *
+ * @param lpm Table to initialize.
+ * @param pool Node storage for the table.
+ * @param count Number of nodes in the pool.
+ * @param key_bits Length of the lookup keys in bits.
+ */
+void net_route_lpm_init(struct net_route_lpm *lpm,
+			struct net_route_lpm_node *pool, size_t count,
+			uint8_t key_bits);
+
+/**
+ * @brief Attach an entry to a prefix, creating the prefix if needed.
+ *
+ * @param lpm Table to use.
+ * @param prefix Prefix bytes in network byte order.
+ * @param prefix_len Prefix length in bits.
+ * @param entry Entry to attach. It must not be attached to any prefix.
+ *
+ * @return 0 if ok, -EINVAL if the prefix is too long, -ENOMEM if the node
+ * pool is exhausted.
+ */
+int net_route_lpm_add(struct net_route_lpm *lpm, const uint8_t *prefix,
+		      uint8_t prefix_len, sys_snode_t *entry);
+
+/**
+ * @brief Detach an entry from a prefix, removing the prefix if it becomes
+ * unused.
+ *
+ * @param lpm Table to use.
+ * @param prefix Prefix bytes in network byte order.
+ * @param prefix_len Prefix length in bits.
+ * @param entry Entry to detach.
+ *
+ * @return 0 if ok, -ENOENT if the entry was not attached to the prefix.
+ */
+int net_route_lpm_del(struct net_route_lpm *lpm, const uint8_t *prefix,
+		      uint8_t prefix_len, sys_snode_t *entry);
+
+/**
+ * @brief Find the entry with the longest prefix matching a key.
+ *
+ * Only the prefixes along the path of the key are visited, so the cost
+ * is bounded by the key length and not by the number of stored prefixes.
+ *
+ * @param lpm Table to use.
+ * @param key Key bytes in network byte order, key_bits long.
+ * @param cb Optional filter, if NULL the first entry of the longest
+ *        matching prefix is returned.
+ * @param user_data User data passed to the filter.
+ *
+ * @return Matching entry, NULL if there is none.
+ */
+sys_snode_t *net_route_lpm_lookup(const struct net_route_lpm *lpm,
+				  const uint8_t *key,
+				  net_route_lpm_match_cb_t cb,
+				  void *user_data);
+
+/**
+ * @brief Find an entry attached to exactly the given prefix.
+ *
+ * @param lpm Table to use.
+ * @param prefix Prefix bytes in network byte order.
+ * @param prefix_len Prefix length in bits.
+ * @param cb Optional filter, if NULL the first entry of the prefix is
+ *        returned.
+ * @param user_data User data passed to the filter.
+ *
+ * @return Matching entry, NULL if there is none.
+ */
+sys_snode_t *net_route_lpm_get(const struct net_route_lpm *lpm,
+			       const uint8_t *prefix, uint8_t prefix_len,
+			       net_route_lpm_match_cb_t cb,
+			       void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROUTE_LPM_H */
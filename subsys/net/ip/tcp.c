@@ -468,29 +468,254 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
-static void tcp_ca_init(struct tcp *conn)
+static const struct tcp_ca_ops tcp_new_reno_ops = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+
+/* Implementation according to RFC9438. Windows are in bytes and times in
+ * milliseconds, so C = 0.4 segments/s^3 becomes 4 * mss / 10^10 bytes/ms^3.
+ */
+#define CUBIC_SCALE 1024
+#define CUBIC_BETA 717		/* 0.7 */
+#define CUBIC_ALPHA 542		/* 3 * (1 - beta) / (1 + beta) */
+#define CUBIC_C_NUM 4ULL
+#define CUBIC_C_DEN 10000000000ULL
+/* CUBIC_C_DEN split in two steps to keep the cubic term within 64 bits */
+#define CUBIC_C_DEN1 10000LL
+#define CUBIC_C_DEN2 1000000LL
+/* Bound for t - K so that the cubic term cannot overflow */
+#define CUBIC_MAX_DELTA_MS 100000
+
+static uint32_t tcp_cubic_cbrt(uint64_t val)
 {
+	uint64_t root = 0;
+	int shift;
+
+	for (shift = 63; shift >= 0; shift -= 3) {
+		uint64_t b;
+
+		root <<= 1;
+		b = 3 * root * (root + 1) + 1;
+
+		if ((val >> shift) >= b) {
+			val -= b << shift;
+			root++;
+		}
+	}
+
+	return (uint32_t)root;
+}
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, w_max=%d, k=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.cubic.w_max, conn->ca.cubic.k);
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
 	tcp_new_reno_init(conn);
 }
 
+/* Multiplicative decrease on congestion, with fast convergence */
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+
+	cubic->epoch_start = 0;
+
+	if (cwnd < cubic->w_last_max) {
+		cubic->w_last_max = cwnd;
+		cubic->w_max = cwnd * (CUBIC_SCALE + CUBIC_BETA) /
+			       (2 * CUBIC_SCALE);
+	} else {
+		cubic->w_last_max = cwnd;
+		cubic->w_max = cwnd;
+	}
+
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2,
+				conn->unacked_len * CUBIC_BETA / CUBIC_SCALE);
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = MIN(conn_mss(conn) * 3 + conn->ca.ssthresh,
+				    UINT16_MAX);
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_cubic_log(conn, "timeout");
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t now = k_uptime_get_32();
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t mss = conn_mss(conn);
+	uint32_t acked = MIN(acked_len, mss);
+	int64_t w_cubic;
+	int64_t target;
+	int64_t t;
+
+	/* Slow start and fast recovery are the same as with NewReno */
+	if (conn->ca.pending_fast_retransmit_bytes != 0 ||
+	    cwnd < conn->ca.ssthresh) {
+		tcp_new_reno_pkts_acked(conn, acked_len);
+		return;
+	}
+
+	if (cubic->epoch_start == 0) {
+		cubic->epoch_start = MAX(now, 1);
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			cubic->k = tcp_cubic_cbrt((cubic->w_max - cwnd) *
+						  CUBIC_C_DEN /
+						  (CUBIC_C_NUM * mss));
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0;
+			cubic->origin = cwnd;
+		}
+	}
+
+	t = (int32_t)(now - cubic->epoch_start) - (int32_t)cubic->k;
+	t = CLAMP(t, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+
+	w_cubic = t * t * t * (int64_t)CUBIC_C_NUM / CUBIC_C_DEN1;
+	w_cubic = cubic->origin + w_cubic * mss / CUBIC_C_DEN2;
+	target = CLAMP(w_cubic, (int64_t)cwnd, (int64_t)(cwnd + cwnd / 2));
+
+	/* Grow at least as fast as NewReno would. The TCP-friendly region is
+	 * where the estimate is above the cubic function itself, not above
+	 * the growth limited target (RFC 8312 section 4.2).
+	 */
+	cubic->w_est += DIV_ROUND_UP((uint64_t)CUBIC_ALPHA * mss * acked,
+				     (uint64_t)CUBIC_SCALE * cwnd);
+
+	if (cubic->w_est > w_cubic) {
+		cwnd = MAX(cwnd, cubic->w_est);
+	} else {
+		cwnd += DIV_ROUND_UP((uint64_t)(target - cwnd) * acked, cwnd);
+	}
+
+	conn->ca.cwnd = MIN(cwnd, UINT16_MAX);
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_cubic_ops = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_CUBIC */
+
+static const struct tcp_ca_ops *const tcp_ca_algorithms[] = {
+	&tcp_new_reno_ops,
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	&tcp_cubic_ops,
+#endif
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CA_DEFAULT (&tcp_cubic_ops)
+#else
+#define TCP_CA_DEFAULT (&tcp_new_reno_ops)
+#endif
+
+static void tcp_ca_init(struct tcp *conn)
+{
+	conn->ca.ops->init(conn);
+}
+
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca.ops->pkts_acked(conn, acked_len);
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const char *end = memchr(value, '\0', len);
+	size_t name_len = end != NULL ? end - (const char *)value : len;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(tcp_ca_algorithms); i++) {
+		const struct tcp_ca_ops *ops = tcp_ca_algorithms[i];
+
+		if (strlen(ops->name) != name_len ||
+		    strncmp(ops->name, value, name_len) != 0) {
+			continue;
+		}
+
+		if (ops != conn->ca.ops) {
+			conn->ca.ops = ops;
+
+			/* Keep the current window of an established connection
+			 * and only start the new algorithm from a clean state.
+			 */
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+			memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+#endif
+		}
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca.ops->name) + 1;
+
+	if (len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	name_len = MIN(name_len, *len);
+	memcpy(value, conn->ca.ops->name, name_len);
+	((char *)value)[name_len - 1] = '\0';
+	*len = name_len;
+
+	return 0;
 }
 #else
 
@@ -504,6 +729,16 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	return -ENOTSUP;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	return -ENOTSUP;
+}
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -2068,6 +2303,7 @@ static struct tcp *tcp_conn_alloc(void)
 	 * is available as soon as the connection is established
 	 */
 	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.ops = TCP_CA_DEFAULT;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2195,6 +2431,10 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 		}
 
 		conn->accepted_conn = conn_old;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		/* Accepted connections use the algorithm of the listener */
+		conn->ca.ops = conn_old->ca.ops;
+#endif
 	}
 in:
 	if (conn) {
@@ -3997,9 +4237,17 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 		goto drop;
 	}
 
-	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, tcp_access);
-	if (tcp_hdr && !net_pkt_set_data(pkt, tcp_access)) {
-		return tcp_hdr;
+	tcp_hdr = net_pkt_header_ptr(pkt, tcp_access->size);
+	if (tcp_hdr) {
+		/* The header is used in place, only move past it */
+		if (!net_pkt_skip(pkt, tcp_access->size)) {
+			return tcp_hdr;
+		}
+	} else {
+		tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, tcp_access);
+		if (tcp_hdr && !net_pkt_set_data(pkt, tcp_access)) {
+			return tcp_hdr;
+		}
 	}
 
 drop:
@@ -4352,6 +4600,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4389,6 +4640,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -242,11 +242,37 @@ struct tcp_options {
 };
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+struct tcp;
+
+/* Congestion control algorithm, selected per connection */
+struct tcp_ca_ops {
+	const char *name;
+	void (*init)(struct tcp *conn);
+	void (*fast_retransmit)(struct tcp *conn);
+	void (*timeout)(struct tcp *conn);
+	void (*dup_ack)(struct tcp *conn);
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
 
-struct tcp_collision_avoidance_reno {
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+struct tcp_ca_cubic {
+	uint32_t epoch_start; /* ms, 0 when no epoch is running */
+	uint32_t k;           /* ms until the window is back at origin */
+	uint32_t w_est;       /* Reno-friendly window estimate */
+	uint16_t w_max;       /* Window before the last reduction */
+	uint16_t w_last_max;  /* Previous w_max, for fast convergence */
+	uint16_t origin;      /* Plateau of the cubic function */
+};
+#endif
+
+struct tcp_congestion_avoidance {
+	const struct tcp_ca_ops *ops;
 	uint16_t cwnd;
 	uint16_t ssthresh;
 	uint16_t pending_fast_retransmit_bytes;
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	struct tcp_ca_cubic cubic;
+#endif
 };
 #endif
 
@@ -322,7 +348,7 @@ struct tcp { /* TCP connection */
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_congestion_avoidance ca;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
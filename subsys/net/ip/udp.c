@@ -150,10 +150,19 @@ struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
 {
 	struct net_udp_hdr *udp_hdr;
 
-	udp_hdr = (struct net_udp_hdr *)net_pkt_get_data(pkt, udp_access);
-	if (!udp_hdr || net_pkt_set_data(pkt, udp_access)) {
-		NET_DBG("DROP: corrupted header");
-		goto drop;
+	udp_hdr = net_pkt_header_ptr(pkt, udp_access->size);
+	if (udp_hdr) {
+		/* The header is used in place, only move past it */
+		if (net_pkt_skip(pkt, udp_access->size)) {
+			NET_DBG("DROP: corrupted header");
+			goto drop;
+		}
+	} else {
+		udp_hdr = (struct net_udp_hdr *)net_pkt_get_data(pkt, udp_access);
+		if (!udp_hdr || net_pkt_set_data(pkt, udp_access)) {
+			NET_DBG("DROP: corrupted header");
+			goto drop;
+		}
 	}
 
 	if (ntohs(udp_hdr->len) != (net_pkt_get_len(pkt) -
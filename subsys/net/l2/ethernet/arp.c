@@ -22,13 +22,26 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 #define ARP_REQUEST_TIMEOUT (2 * MSEC_PER_SEC)
+#define ARP_ENTRY_LIFETIME (CONFIG_NET_ARP_ENTRY_LIFETIME * MSEC_PER_SEC)
+
+#if defined(CONFIG_NET_ARP_REFRESH)
+#define ARP_REFRESH_TIME MIN(CONFIG_NET_ARP_REFRESH_TIME * MSEC_PER_SEC, \
+			     ARP_ENTRY_LIFETIME / 2)
+#endif
+
+#define ARP_HASH_BUCKETS CONFIG_NET_ARP_TABLE_SIZE
 
 static bool arp_cache_initialized;
 static struct arp_entry arp_entries[CONFIG_NET_ARP_TABLE_SIZE];
 
 static sys_slist_t arp_free_entries;
 static sys_slist_t arp_pending_entries;
-static sys_slist_t arp_table;
+
+/* Resolved entries, hashed by IP address for lookups and kept in least
+ * recently used order for eviction.
+ */
+static sys_slist_t arp_hash[ARP_HASH_BUCKETS];
+static sys_dlist_t arp_table;
 
 static struct k_work_delayable arp_request_timer;
 
@@ -48,14 +61,27 @@ static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 				atomic_get(&pkt->atomic_ref) - 1);
 			net_pkt_unref(pkt);
 		}
+
+		entry->pending_count = 0U;
 	}
 
 	entry->iface = NULL;
+	entry->refresh_sent = false;
 
 	(void)memset(&entry->ip, 0, sizeof(struct in_addr));
 	(void)memset(&entry->eth, 0, sizeof(struct net_eth_addr));
 }
 
+static inline sys_slist_t *arp_hash_bucket(const struct in_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s_addr);
+
+	/* Mix the host part, which is in the last octet, into all bits */
+	hash *= 2654435761U;
+
+	return &arp_hash[(hash >> 16) % ARP_HASH_BUCKETS];
+}
+
 static struct arp_entry *arp_entry_find(sys_slist_t *list,
 					struct net_if *iface,
 					struct in_addr *dst,
@@ -81,24 +107,44 @@ static struct arp_entry *arp_entry_find(sys_slist_t *list,
 	return NULL;
 }
 
+static inline struct arp_entry *arp_entry_find_table(struct net_if *iface,
+						     struct in_addr *dst)
+{
+	return arp_entry_find(arp_hash_bucket(dst), iface, dst, NULL);
+}
+
+static void arp_entry_table_add(struct arp_entry *entry)
+{
+	entry->updated = k_uptime_get_32();
+	entry->refresh_sent = false;
+
+	sys_slist_prepend(arp_hash_bucket(&entry->ip), &entry->node);
+	sys_dlist_prepend(&arp_table, &entry->lru_node);
+}
+
+static void arp_entry_table_remove(struct arp_entry *entry)
+{
+	sys_slist_find_and_remove(arp_hash_bucket(&entry->ip), &entry->node);
+	sys_dlist_remove(&entry->lru_node);
+}
+
 static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
 							  struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", net_sprint_ipv4_addr(dst));
 
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
+	entry = arp_entry_find_table(iface, dst);
 	if (entry) {
 		/* Let's assume the target is going to be accessed
 		 * more than once here in a short time frame. So we
-		 * place the entry first in position into the table
-		 * in order to reduce subsequent find.
+		 * place the entry first in the LRU order so that it
+		 * is the last one to be evicted.
 		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
+		if (!sys_dlist_is_head(&arp_table, &entry->lru_node)) {
+			sys_dlist_remove(&entry->lru_node);
+			sys_dlist_prepend(&arp_table, &entry->lru_node);
 		}
 	}
 
@@ -152,22 +198,63 @@ static struct arp_entry *arp_entry_get_free(void)
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	struct arp_entry *entry;
+	sys_dnode_t *node;
 
-	/* We assume last entry is the oldest one,
+	/* The tail of the table is the least recently used entry,
 	 * so is the preferred one to be taken out.
 	 */
 
-	node = sys_slist_peek_tail(&arp_table);
+	node = sys_dlist_peek_tail(&arp_table);
 	if (!node) {
 		return NULL;
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	entry = CONTAINER_OF(node, struct arp_entry, lru_node);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	arp_entry_table_remove(entry);
+
+	return entry;
 }
 
+#if CONFIG_NET_ARP_ENTRY_LIFETIME > 0
+/* Return false if the entry has expired, in which case it is released.
+ * Set refresh if the entry should be refreshed before it expires.
+ */
+static bool arp_entry_check_lifetime(struct arp_entry *entry, bool *refresh)
+{
+	uint32_t age = k_uptime_get_32() - entry->updated;
+
+	if (age >= ARP_ENTRY_LIFETIME) {
+		NET_DBG("Entry %s expired", net_sprint_ipv4_addr(&entry->ip));
+
+		arp_entry_table_remove(entry);
+		arp_entry_cleanup(entry, false);
+		sys_slist_prepend(&arp_free_entries, &entry->node);
+
+		return false;
+	}
+
+#if defined(CONFIG_NET_ARP_REFRESH)
+	if (!entry->refresh_sent &&
+	    age >= ARP_ENTRY_LIFETIME - ARP_REFRESH_TIME) {
+		entry->refresh_sent = true;
+		*refresh = true;
+	}
+#endif
+
+	return true;
+}
+#else
+static inline bool arp_entry_check_lifetime(struct arp_entry *entry,
+					    bool *refresh)
+{
+	ARG_UNUSED(entry);
+	ARG_UNUSED(refresh);
+
+	return true;
+}
+#endif /* CONFIG_NET_ARP_ENTRY_LIFETIME > 0 */
 
 static void arp_entry_register_pending(struct arp_entry *entry)
 {
@@ -285,6 +372,7 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	if (entry) {
 		if (!net_pkt_ipv4_auto(pkt)) {
 			k_fifo_put(&entry->pending_queue, net_pkt_ref(pending));
+			entry->pending_count = 1U;
 		}
 
 		entry->iface = net_pkt_iface(pkt);
@@ -335,13 +423,74 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	return pkt;
 }
 
+/* Queue a packet waiting for the address to be resolved. Return false if
+ * the packet is already queued, in which case the request is sent again.
+ */
+static bool arp_entry_queue_pending(struct arp_entry *entry,
+				    struct net_pkt *pkt)
+{
+	if (!k_queue_unique_append(&entry->pending_queue._queue,
+				   net_pkt_ref(pkt))) {
+		return false;
+	}
+
+	if (entry->pending_count < CONFIG_NET_ARP_PENDING_QUEUE_SIZE) {
+		entry->pending_count++;
+	} else {
+		struct net_pkt *oldest;
+
+		oldest = k_fifo_get(&entry->pending_queue, K_NO_WAIT);
+
+		NET_DBG("Pending queue of %s full, dropping pkt %p",
+			net_sprint_ipv4_addr(&entry->ip), oldest);
+
+		net_pkt_unref(oldest);
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_ARP_REFRESH)
+/* Build a request that is sent directly to the cached link address of the
+ * neighbor, as suggested by RFC 1122 chapter 2.3.2.1, so that the entry
+ * can be renewed without a broadcast.
+ */
+static struct net_pkt *arp_prepare_refresh(struct net_if *iface,
+					   struct in_addr *next_addr,
+					   struct arp_entry *entry,
+					   struct net_pkt *pending)
+{
+	struct net_arp_hdr *hdr;
+	struct net_pkt *req;
+
+	req = arp_prepare(iface, next_addr, NULL, pending, NULL);
+	if (!req) {
+		/* Try again the next time the entry is used */
+		entry->refresh_sent = false;
+		return NULL;
+	}
+
+	hdr = NET_ARP_HDR(req);
+
+	memcpy(&hdr->dst_hwaddr, &entry->eth, sizeof(struct net_eth_addr));
+
+	net_pkt_lladdr_dst(req)->addr = hdr->dst_hwaddr.addr;
+
+	return req;
+}
+#else
+#define arp_prepare_refresh(...) NULL
+#endif /* CONFIG_NET_ARP_REFRESH */
+
 struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 				struct in_addr *request_ip,
 				struct in_addr *current_ip)
 {
 	bool is_ipv4_ll_used = false;
+	struct net_pkt *refresh_req = NULL;
 	struct arp_entry *entry;
 	struct in_addr *addr;
+	bool refresh = false;
 
 	if (!pkt || !pkt->buffer) {
 		return NULL;
@@ -382,6 +531,10 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	 * to send any ARP packet.
 	 */
 	entry = arp_entry_find_move_first(net_pkt_iface(pkt), addr);
+	if (entry && !arp_entry_check_lifetime(entry, &refresh)) {
+		entry = NULL;
+	}
+
 	if (!entry) {
 		struct net_pkt *req;
 
@@ -399,8 +552,7 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 			 * append the packet to the request fifo list.
 			 */
 			if (!net_pkt_ipv4_auto(pkt) &&
-			    k_queue_unique_append(&entry->pending_queue._queue,
-						  net_pkt_ref(pkt))) {
+			    arp_entry_queue_pending(entry, pkt)) {
 				k_mutex_unlock(&arp_mutex);
 				return NULL;
 			}
@@ -430,8 +582,20 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 		return req;
 	}
 
+	if (refresh) {
+		refresh_req = arp_prepare_refresh(net_pkt_iface(pkt), addr,
+						  entry, pkt);
+	}
+
 	k_mutex_unlock(&arp_mutex);
 
+	if (refresh_req) {
+		NET_DBG("Refreshing ARP entry for %s",
+			net_sprint_ipv4_addr(addr));
+
+		net_if_queue_tx(net_pkt_iface(refresh_req), refresh_req);
+	}
+
 	net_pkt_lladdr_src(pkt)->addr =
 		(uint8_t *)net_if_get_link_addr(entry->iface)->addr;
 	net_pkt_lladdr_src(pkt)->len = sizeof(struct net_eth_addr);
@@ -447,25 +611,6 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 	return pkt;
 }
 
-static void arp_gratuitous(struct net_if *iface,
-			   struct in_addr *src,
-			   struct net_eth_addr *hwaddr)
-{
-	sys_snode_t *prev = NULL;
-	struct arp_entry *entry;
-
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
-	if (entry) {
-		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
-			net_sprint_ll_addr((const uint8_t *)&entry->eth,
-					   sizeof(struct net_eth_addr)),
-			net_sprint_ll_addr((const uint8_t *)hwaddr,
-					   sizeof(struct net_eth_addr)));
-
-		memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
-	}
-}
-
 void net_arp_update(struct net_if *iface,
 		    struct in_addr *src,
 		    struct net_eth_addr *hwaddr,
@@ -482,35 +627,46 @@ void net_arp_update(struct net_if *iface,
 
 	entry = arp_entry_get_pending(iface, src);
 	if (!entry) {
-		if (IS_ENABLED(CONFIG_NET_ARP_GRATUITOUS) && gratuitous) {
-			arp_gratuitous(iface, src, hwaddr);
-		}
+		entry = arp_entry_find_table(iface, src);
+		if (entry) {
+			/* Only trust the neighbor when told to, when it
+			 * announces itself, or when it answers our refresh
+			 * request, so that unsolicited replies cannot poison
+			 * the cache.
+			 */
+			if (!force && !entry->refresh_sent &&
+			    !(IS_ENABLED(CONFIG_NET_ARP_GRATUITOUS) && gratuitous)) {
+				k_mutex_unlock(&arp_mutex);
+				net_if_tx_unlock(iface);
+				return;
+			}
 
-		if (force) {
-			sys_snode_t *prev = NULL;
-			struct arp_entry *arp_ent;
-
-			arp_ent = arp_entry_find(&arp_table, iface, src, &prev);
-			if (arp_ent) {
-				memcpy(&arp_ent->eth, hwaddr,
-				       sizeof(struct net_eth_addr));
-			} else {
-				/* Add new entry as it was not found and force
-				 * was set.
-				 */
-				arp_ent = arp_entry_get_free();
-				if (!arp_ent) {
-					/* Then let's take one from table? */
-					arp_ent = arp_entry_get_last_from_table();
-				}
-
-				if (arp_ent) {
-					arp_ent->req_start = k_uptime_get_32();
-					arp_ent->iface = iface;
-					net_ipaddr_copy(&arp_ent->ip, src);
-					memcpy(&arp_ent->eth, hwaddr, sizeof(arp_ent->eth));
-					sys_slist_prepend(&arp_table, &arp_ent->node);
-				}
+			NET_DBG("%sARP hwaddr %s -> %s",
+				gratuitous ? "Gratuitous " : "",
+				net_sprint_ll_addr((const uint8_t *)&entry->eth,
+						   sizeof(struct net_eth_addr)),
+				net_sprint_ll_addr((const uint8_t *)hwaddr,
+						   sizeof(struct net_eth_addr)));
+
+			memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+			entry->updated = k_uptime_get_32();
+			entry->refresh_sent = false;
+		} else if (force) {
+			/* Add new entry as it was not found and force
+			 * was set.
+			 */
+			entry = arp_entry_get_free();
+			if (!entry) {
+				/* Then let's take one from table? */
+				entry = arp_entry_get_last_from_table();
+			}
+
+			if (entry) {
+				entry->req_start = k_uptime_get_32();
+				entry->iface = iface;
+				net_ipaddr_copy(&entry->ip, src);
+				memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
+				arp_entry_table_add(entry);
 			}
 		}
 
@@ -522,7 +678,8 @@ void net_arp_update(struct net_if *iface,
 	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
 
 	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+	arp_entry_table_add(entry);
+	entry->pending_count = 0U;
 
 	while (!k_fifo_is_empty(&entry->pending_queue)) {
 		int ret;
@@ -748,20 +905,17 @@ void net_arp_clear_cache(struct net_if *iface)
 
 	k_mutex_lock(&arp_mutex, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, lru_node) {
 		if (iface && iface != entry->iface) {
-			prev = &entry->node;
 			continue;
 		}
 
+		arp_entry_table_remove(entry);
 		arp_entry_cleanup(entry, false);
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
 		sys_slist_prepend(&arp_free_entries, &entry->node);
 	}
 
-	prev = NULL;
-
 	NET_DBG("Flushing ARP pending requests");
 
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
@@ -804,7 +958,7 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 
 	k_mutex_lock(&arp_mutex, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
+	SYS_DLIST_FOR_EACH_CONTAINER(&arp_table, entry, lru_node) {
 		ret++;
 		cb(entry, user_data);
 	}
@@ -824,7 +978,11 @@ void net_arp_init(void)
 
 	sys_slist_init(&arp_free_entries);
 	sys_slist_init(&arp_pending_entries);
-	sys_slist_init(&arp_table);
+	sys_dlist_init(&arp_table);
+
+	for (i = 0; i < ARP_HASH_BUCKETS; i++) {
+		sys_slist_init(&arp_hash[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free with initialised packet queue */
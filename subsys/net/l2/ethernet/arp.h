@@ -10,6 +10,7 @@
 #if defined(CONFIG_NET_ARP) && defined(CONFIG_NET_NATIVE)
 
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 #include <zephyr/net/ethernet.h>
 
 #ifdef __cplusplus
@@ -53,12 +54,19 @@ int net_arp_clear_pending(struct net_if *iface,
 				struct in_addr *dst);
 
 struct arp_entry {
+	/* Free or pending list node, or hash bucket node when resolved */
 	sys_snode_t node;
+	/* Position in the least recently used order of resolved entries */
+	sys_dnode_t lru_node;
 	uint32_t req_start;
+	/* Last time the mapping was confirmed by the peer */
+	uint32_t updated;
 	struct net_if *iface;
 	struct in_addr ip;
 	struct net_eth_addr eth;
 	struct k_fifo pending_queue;
+	uint16_t pending_count;
+	bool refresh_sent;
 };
 
 typedef void (*net_arp_cb_t)(struct arp_entry *entry,
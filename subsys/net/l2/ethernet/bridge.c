@@ -15,6 +15,7 @@ LOG_MODULE_REGISTER(net_eth_bridge, CONFIG_NET_ETHERNET_BRIDGE_LOG_LEVEL);
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/slist.h>
 
+#include "net_private.h"
 #include "bridge.h"
 
 extern struct eth_bridge _eth_bridge_list_start[];
@@ -29,11 +30,170 @@ static void lock_bridge(struct eth_bridge *br)
 	 */
 	if (!br->initialized) {
 		k_mutex_init(&br->lock);
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+		for (int i = 0; i < ARRAY_SIZE(br->fdb_entries); i++) {
+			sys_slist_append(&br->fdb_free, &br->fdb_entries[i].node);
+		}
+#endif
 		br->initialized = true;
 	}
 	k_mutex_lock(&br->lock, K_FOREVER);
 }
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+#define FDB_AGING_TIME_MS (CONFIG_NET_ETHERNET_BRIDGE_FDB_AGING_TIME * MSEC_PER_SEC)
+
+static inline bool fdb_is_expired(struct eth_bridge_fdb_entry *entry, uint32_t now)
+{
+	return now - entry->last_seen >= FDB_AGING_TIME_MS;
+}
+
+static inline sys_slist_t *fdb_bucket(struct eth_bridge *br, const uint8_t *addr,
+				      uint16_t vlan_tag)
+{
+	/* The first half of a MAC address is the vendor prefix, so most of
+	 * the variation is in the last bytes.
+	 */
+	uint32_t hash = (addr[3] << 16) ^ (addr[4] << 8) ^ addr[5] ^ (vlan_tag << 4);
+
+	return &br->fdb[hash % ARRAY_SIZE(br->fdb)];
+}
+
+static struct eth_bridge_fdb_entry *fdb_lookup(struct eth_bridge *br,
+					       const uint8_t *addr,
+					       uint16_t vlan_tag)
+{
+	struct eth_bridge_fdb_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(fdb_bucket(br, addr, vlan_tag), entry, node) {
+		if (entry->vlan_tag == vlan_tag &&
+		    memcmp(entry->addr, addr, sizeof(entry->addr)) == 0) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void fdb_remove(struct eth_bridge *br, struct eth_bridge_fdb_entry *entry)
+{
+	sys_slist_find_and_remove(fdb_bucket(br, entry->addr, entry->vlan_tag),
+				  &entry->node);
+	sys_slist_prepend(&br->fdb_free, &entry->node);
+	entry->iface = NULL;
+}
+
+static struct eth_bridge_fdb_entry *fdb_alloc(struct eth_bridge *br, uint32_t now)
+{
+	struct eth_bridge_fdb_entry *oldest = NULL;
+	sys_snode_t *node;
+
+	node = sys_slist_get(&br->fdb_free);
+	if (node != NULL) {
+		return CONTAINER_OF(node, struct eth_bridge_fdb_entry, node);
+	}
+
+	/* Full: recycle the entry that was seen least recently, which is
+	 * an expired one if there is any.
+	 */
+	for (int i = 0; i < ARRAY_SIZE(br->fdb_entries); i++) {
+		struct eth_bridge_fdb_entry *entry = &br->fdb_entries[i];
+
+		if (oldest == NULL ||
+		    now - entry->last_seen > now - oldest->last_seen) {
+			oldest = entry;
+		}
+	}
+
+	fdb_remove(br, oldest);
+
+	return CONTAINER_OF(sys_slist_get(&br->fdb_free),
+			    struct eth_bridge_fdb_entry, node);
+}
+
+static void fdb_learn(struct eth_bridge *br, struct net_if *iface,
+		      const uint8_t *addr, uint16_t vlan_tag, uint32_t now)
+{
+	struct eth_bridge_fdb_entry *entry;
+
+	/* Only unicast addresses can be a source */
+	if (addr[0] & 0x01) {
+		return;
+	}
+
+	entry = fdb_lookup(br, addr, vlan_tag);
+	if (entry == NULL) {
+		entry = fdb_alloc(br, now);
+		memcpy(entry->addr, addr, sizeof(entry->addr));
+		entry->vlan_tag = vlan_tag;
+		sys_slist_prepend(fdb_bucket(br, addr, vlan_tag), &entry->node);
+	}
+
+	if (entry->iface != iface) {
+		NET_DBG("%s learned on iface %p",
+			net_sprint_ll_addr(addr, sizeof(entry->addr)), iface);
+		entry->iface = iface;
+		br->stats.learned++;
+	}
+
+	entry->last_seen = now;
+}
+
+static struct net_if *fdb_find_port(struct eth_bridge *br, const uint8_t *addr,
+				    uint16_t vlan_tag, uint32_t now)
+{
+	struct eth_bridge_fdb_entry *entry;
+
+	if (addr[0] & 0x01) {
+		/* Broadcast and multicast go everywhere */
+		return NULL;
+	}
+
+	entry = fdb_lookup(br, addr, vlan_tag);
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	if (fdb_is_expired(entry, now)) {
+		fdb_remove(br, entry);
+		return NULL;
+	}
+
+	return entry->iface;
+}
+
+/* Learn the source of the packet and look up the port of its destination */
+static struct net_if *fdb_update(struct eth_bridge *br, struct net_if *iface,
+				 struct net_pkt *pkt)
+{
+	uint32_t now = k_uptime_get_32();
+
+	fdb_learn(br, iface, net_pkt_lladdr_src(pkt)->addr,
+		  net_pkt_vlan_tag(pkt), now);
+
+	return fdb_find_port(br, net_pkt_lladdr_dst(pkt)->addr,
+			     net_pkt_vlan_tag(pkt), now);
+}
+
+static void fdb_flush_iface(struct eth_bridge *br, struct net_if *iface)
+{
+	for (int i = 0; i < ARRAY_SIZE(br->fdb_entries); i++) {
+		struct eth_bridge_fdb_entry *entry = &br->fdb_entries[i];
+
+		if (entry->iface != NULL &&
+		    (iface == NULL || entry->iface == iface)) {
+			fdb_remove(br, entry);
+		}
+	}
+}
+#else
+static inline struct net_if *fdb_update(struct eth_bridge *br, struct net_if *iface,
+					struct net_pkt *pkt)
+{
+	return NULL;
+}
+#endif /* CONFIG_NET_ETHERNET_BRIDGE_FDB */
+
 void net_eth_bridge_foreach(eth_bridge_cb_t cb, void *user_data)
 {
 	STRUCT_SECTION_FOREACH(eth_bridge, br) {
@@ -88,7 +248,8 @@ int eth_bridge_iface_add(struct eth_bridge *br, struct net_if *iface)
 
 	int ret = net_eth_promisc_mode(iface, true);
 
-	if (ret != 0) {
+	/* The interface may still be promiscuous from an earlier bridging */
+	if (ret != 0 && ret != -EALREADY) {
 		NET_DBG("iface %p promiscuous mode failed: %d", iface, ret);
 		eth_bridge_iface_remove(br, iface);
 		return ret;
@@ -116,6 +277,10 @@ int eth_bridge_iface_remove(struct eth_bridge *br, struct net_if *iface)
 	sys_slist_find_and_remove(&br->interfaces, &ctx->bridge.node);
 	ctx->bridge.instance = NULL;
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	fdb_flush_iface(br, iface);
+#endif
+
 	k_mutex_unlock(&br->lock);
 
 	NET_DBG("iface %p removed from bridge %p", iface, br);
@@ -151,6 +316,48 @@ int eth_bridge_listener_remove(struct eth_bridge *br, struct eth_bridge_listener
 	return 0;
 }
 
+void eth_bridge_get_stats(struct eth_bridge *br, struct eth_bridge_stats *stats)
+{
+	lock_bridge(br);
+	*stats = br->stats;
+	k_mutex_unlock(&br->lock);
+}
+
+void eth_bridge_fdb_foreach(struct eth_bridge *br, eth_bridge_fdb_cb_t cb,
+			    void *user_data)
+{
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	uint32_t now = k_uptime_get_32();
+
+	lock_bridge(br);
+
+	for (int i = 0; i < ARRAY_SIZE(br->fdb_entries); i++) {
+		struct eth_bridge_fdb_entry *entry = &br->fdb_entries[i];
+
+		if (entry->iface != NULL && !fdb_is_expired(entry, now)) {
+			cb(br, entry, user_data);
+		}
+	}
+
+	k_mutex_unlock(&br->lock);
+#else
+	ARG_UNUSED(br);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+#endif
+}
+
+void eth_bridge_fdb_flush(struct eth_bridge *br)
+{
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	lock_bridge(br);
+	fdb_flush_iface(br, NULL);
+	k_mutex_unlock(&br->lock);
+#else
+	ARG_UNUSED(br);
+#endif
+}
+
 static inline bool is_link_local_addr(struct net_eth_addr *addr)
 {
 	if (addr->addr[0] == 0x01 &&
@@ -165,10 +372,56 @@ static inline bool is_link_local_addr(struct net_eth_addr *addr)
 	return false;
 }
 
+static bool can_forward_to(struct ethernet_context *ctx,
+			   struct ethernet_context *out_ctx)
+{
+	/* Don't xmit on the same interface as the incoming packet's */
+	if (ctx == out_ctx) {
+		return false;
+	}
+
+	/* Skip it if not allowed to transmit */
+	if (!out_ctx->bridge.allow_tx) {
+		return false;
+	}
+
+	/* Skip it if not up */
+	return net_if_flag_is_set(out_ctx->iface, NET_IF_UP);
+}
+
+static void forward_pkt(struct eth_bridge *br, struct net_pkt *pkt,
+			struct ethernet_context *out_ctx, bool clone)
+{
+	struct net_pkt *out_pkt = pkt;
+	struct net_if *orig_iface = net_pkt_iface(pkt);
+
+	if (clone) {
+		out_pkt = net_pkt_shallow_clone(pkt, K_NO_WAIT);
+		if (out_pkt == NULL) {
+			return;
+		}
+
+		br->stats.clones++;
+	}
+
+	NET_DBG("sending pkt %p as %p on iface %p", pkt, out_pkt, out_ctx->iface);
+
+	/*
+	 * Use AF_UNSPEC to avoid interference, set the output
+	 * interface and send the packet.
+	 */
+	net_pkt_set_family(out_pkt, AF_UNSPEC);
+	net_pkt_set_orig_iface(out_pkt, orig_iface);
+	net_pkt_set_iface(out_pkt, out_ctx->iface);
+	net_if_queue_tx(out_ctx->iface, out_pkt);
+}
+
 enum net_verdict net_eth_bridge_input(struct ethernet_context *ctx,
 				      struct net_pkt *pkt)
 {
 	struct eth_bridge *br = ctx->bridge.instance;
+	struct ethernet_context *out_ctx = NULL;
+	struct net_if *dst_iface;
 	sys_snode_t *node;
 
 	NET_DBG("new pkt %p", pkt);
@@ -180,64 +433,71 @@ enum net_verdict net_eth_bridge_input(struct ethernet_context *ctx,
 
 	lock_bridge(br);
 
-	/*
-	 * Send packet to all registered interfaces for now.
-	 * Eventually we could get smarter with a MAC address cache.
-	 */
-	SYS_SLIST_FOR_EACH_NODE(&br->interfaces, node) {
-		struct ethernet_context *out_ctx;
-		struct net_pkt *out_pkt;
-
-		out_ctx = CONTAINER_OF(node, struct ethernet_context, bridge.node);
+	br->stats.rx_pkts++;
 
-		/* Don't xmit on the same interface as the incoming packet's */
-		if (ctx == out_ctx) {
-			continue;
-		}
+	dst_iface = fdb_update(br, ctx->iface, pkt);
 
-		/* Skip it if not allowed to transmit */
-		if (!out_ctx->bridge.allow_tx) {
-			continue;
-		}
+	/* Software listeners get every packet */
+	SYS_SLIST_FOR_EACH_NODE(&br->listeners, node) {
+		struct eth_bridge_listener *l;
+		struct net_pkt *out_pkt;
 
-		/* Skip it if not up */
-		if (!net_if_flag_is_set(out_ctx->iface, NET_IF_UP)) {
-			continue;
-		}
+		l = CONTAINER_OF(node, struct eth_bridge_listener, node);
 
 		out_pkt = net_pkt_shallow_clone(pkt, K_NO_WAIT);
 		if (out_pkt == NULL) {
 			continue;
 		}
 
-		NET_DBG("sending pkt %p as %p on iface %p", pkt, out_pkt, out_ctx->iface);
+		br->stats.clones++;
+		k_fifo_put(&l->pkt_queue, out_pkt);
+	}
+
+	if (dst_iface == ctx->iface) {
+		/* The destination is on the segment the packet came from */
+		br->stats.filtered++;
+	} else if (dst_iface != NULL) {
+		out_ctx = net_if_l2_data(dst_iface);
 
+		if (can_forward_to(ctx, out_ctx)) {
+			br->stats.unicast++;
+		} else {
+			out_ctx = NULL;
+		}
+	} else {
 		/*
-		 * Use AF_UNSPEC to avoid interference, set the output
-		 * interface and send the packet.
+		 * Unknown destination, broadcast or multicast: send the packet
+		 * to all other interfaces. Every interface but the last one
+		 * gets a clone, the last one gets the packet itself.
 		 */
-		net_pkt_set_family(out_pkt, AF_UNSPEC);
-		net_pkt_set_orig_iface(out_pkt, net_pkt_iface(pkt));
-		net_pkt_set_iface(out_pkt, out_ctx->iface);
-		net_if_queue_tx(out_ctx->iface, out_pkt);
-	}
+		br->stats.flooded++;
 
-	SYS_SLIST_FOR_EACH_NODE(&br->listeners, node) {
-		struct eth_bridge_listener *l;
-		struct net_pkt *out_pkt;
+		SYS_SLIST_FOR_EACH_NODE(&br->interfaces, node) {
+			struct ethernet_context *next_ctx;
 
-		l = CONTAINER_OF(node, struct eth_bridge_listener, node);
+			next_ctx = CONTAINER_OF(node, struct ethernet_context, bridge.node);
 
-		out_pkt = net_pkt_shallow_clone(pkt, K_NO_WAIT);
-		if (out_pkt == NULL) {
-			continue;
+			if (!can_forward_to(ctx, next_ctx)) {
+				continue;
+			}
+
+			if (out_ctx != NULL) {
+				forward_pkt(br, pkt, out_ctx, true);
+			}
+
+			out_ctx = next_ctx;
 		}
+	}
 
-		k_fifo_put(&l->pkt_queue, out_pkt);
+	if (out_ctx != NULL) {
+		forward_pkt(br, pkt, out_ctx, false);
 	}
 
 	k_mutex_unlock(&br->lock);
 
-	net_pkt_unref(pkt);
+	if (out_ctx == NULL) {
+		net_pkt_unref(pkt);
+	}
+
 	return NET_OK;
 }
@@ -201,6 +201,105 @@ static int cmd_bridge_show(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+static void fdb_show(struct eth_bridge *br, const struct eth_bridge_fdb_entry *entry,
+		     void *data)
+{
+	const struct shell *sh = data;
+	uint32_t age = k_uptime_get_32() - entry->last_seen;
+
+	shell_fprintf(sh, SHELL_NORMAL, "%02x:%02x:%02x:%02x:%02x:%02x  ",
+		      entry->addr[0], entry->addr[1], entry->addr[2],
+		      entry->addr[3], entry->addr[4], entry->addr[5]);
+
+	if (entry->vlan_tag == NET_VLAN_TAG_UNSPEC) {
+		shell_fprintf(sh, SHELL_NORMAL, "%-6s", "-");
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, "%-6d", entry->vlan_tag);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "%-10d%u.%03u\n",
+		      net_if_get_by_iface(entry->iface),
+		      age / MSEC_PER_SEC, age % MSEC_PER_SEC);
+}
+
+static int cmd_bridge_fdb(const struct shell *sh, size_t argc, char *argv[])
+{
+	int br_idx;
+	struct eth_bridge *br;
+
+	if (!IS_ENABLED(CONFIG_NET_ETHERNET_BRIDGE_FDB)) {
+		shell_warn(sh, "Address learning is disabled, "
+			   "enable CONFIG_NET_ETHERNET_BRIDGE_FDB.\n");
+		return -ENOEXEC;
+	}
+
+	br_idx = get_idx(sh, argv[1]);
+	if (br_idx < 0) {
+		return br_idx;
+	}
+	br = eth_bridge_get_by_index(br_idx);
+	if (br == NULL) {
+		shell_warn(sh, "Bridge %d not found\n", br_idx);
+		return -ENOENT;
+	}
+
+	if (argc == 3) {
+		if (strcmp(argv[2], "flush") != 0) {
+			shell_warn(sh, "Unknown argument %s\n", argv[2]);
+			return -EINVAL;
+		}
+
+		eth_bridge_fdb_flush(br);
+		return 0;
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "address            vlan  iface     age\n");
+	eth_bridge_fdb_foreach(br, fdb_show, (void *)sh);
+
+	return 0;
+}
+
+static void stats_show(struct eth_bridge *br, void *data)
+{
+	const struct shell *sh = data;
+	struct eth_bridge_stats stats;
+
+	eth_bridge_get_stats(br, &stats);
+
+	shell_fprintf(sh, SHELL_NORMAL, "Bridge %d\n", eth_bridge_get_index(br));
+	shell_fprintf(sh, SHELL_NORMAL, "  Received     %u\n", stats.rx_pkts);
+	shell_fprintf(sh, SHELL_NORMAL, "  Unicast      %u\n", stats.unicast);
+	shell_fprintf(sh, SHELL_NORMAL, "  Flooded      %u\n", stats.flooded);
+	shell_fprintf(sh, SHELL_NORMAL, "  Filtered     %u\n", stats.filtered);
+	shell_fprintf(sh, SHELL_NORMAL, "  Clones       %u\n", stats.clones);
+	shell_fprintf(sh, SHELL_NORMAL, "  Learned      %u\n", stats.learned);
+}
+
+static int cmd_bridge_stats(const struct shell *sh, size_t argc, char *argv[])
+{
+	int br_idx;
+	struct eth_bridge *br;
+
+	if (argc == 1) {
+		net_eth_bridge_foreach(stats_show, (void *)sh);
+		return 0;
+	}
+
+	br_idx = get_idx(sh, argv[1]);
+	if (br_idx < 0) {
+		return br_idx;
+	}
+	br = eth_bridge_get_by_index(br_idx);
+	if (br == NULL) {
+		shell_warn(sh, "Bridge %d not found\n", br_idx);
+		return -ENOENT;
+	}
+
+	stats_show(br, (void *)sh);
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(bridge_commands,
 	SHELL_CMD_ARG(addif, NULL,
 		  "Add a network interface to a bridge.\n"
@@ -218,6 +317,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(bridge_commands,
 		  "Show bridge information.\n"
 		  "'bridge show [<bridge_index>]'",
 		  cmd_bridge_show, 1, 1),
+	SHELL_CMD_ARG(fdb, NULL,
+		  "Show or flush the learned addresses of a bridge.\n"
+		  "'bridge fdb <bridge_index> [flush]'",
+		  cmd_bridge_fdb, 2, 1),
+	SHELL_CMD_ARG(stats, NULL,
+		  "Show bridge forwarding statistics.\n"
+		  "'bridge stats [<bridge_index>]'",
+		  cmd_bridge_stats, 1, 1),
 	SHELL_SUBCMD_SET_END
 );
 
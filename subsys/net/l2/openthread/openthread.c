@@ -385,6 +385,7 @@ int openthread_send(struct net_if *iface, struct net_pkt *pkt)
 	}
 
 	net_capture_pkt(iface, pkt);
+	net_capture_ring_pkt(iface, pkt, true);
 
 	if (notify_new_tx_frame(pkt) != 0) {
 		net_pkt_unref(pkt);
@@ -0,0 +1,519 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_capture_ring, CONFIG_NET_CAPTURE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/capture.h>
+
+#if defined(CONFIG_NET_CAPTURE_RING_HOST_FILE)
+#include "ring_posix_bottom.h"
+#elif defined(CONFIG_FILE_SYSTEM)
+#include <zephyr/fs/fs.h>
+#endif
+
+#define RING_COUNT CONFIG_NET_CAPTURE_RING_PKT_COUNT
+#define RING_SNAPLEN CONFIG_NET_CAPTURE_RING_SNAPLEN
+
+BUILD_ASSERT(IS_POWER_OF_TWO(RING_COUNT),
+	     "CONFIG_NET_CAPTURE_RING_PKT_COUNT must be a power of two");
+
+/* pcapng block types and values, see draft-ietf-opsawg-pcapng */
+#define PCAPNG_SHB 0x0A0D0D0A
+#define PCAPNG_IDB 0x00000001
+#define PCAPNG_EPB 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_OPT_EPB_FLAGS 2
+#define PCAPNG_EPB_INBOUND 1
+#define PCAPNG_EPB_OUTBOUND 2
+
+#define LINKTYPE_ETHERNET 1
+#define LINKTYPE_RAW 101
+#define LINKTYPE_IEEE802_15_4_NOFCS 230
+
+/* The low bit of the slot state is set while the slot is written, the
+ * other bits are incremented every time a packet is stored in the slot.
+ */
+#define SLOT_BUSY 1
+#define SLOT_GENERATION 2
+
+struct capture_ring_slot {
+	/** Write state, see SLOT_BUSY */
+	atomic_t state;
+	/** Sequence number of the stored packet */
+	uint32_t seq;
+	/** Capture time in microseconds */
+	uint64_t timestamp;
+	/** Length of the packet */
+	uint32_t orig_len;
+	/** Number of bytes stored */
+	uint16_t cap_len;
+	/** Index of the network interface */
+	uint8_t if_index;
+	/** Was the packet sent */
+	bool outgoing;
+	/** Beginning of the packet */
+	uint8_t data[RING_SNAPLEN];
+};
+
+struct pcapng_block_hdr {
+	uint32_t type;
+	uint32_t len;
+};
+
+struct pcapng_shb {
+	struct pcapng_block_hdr hdr;
+	uint32_t magic;
+	uint16_t major;
+	uint16_t minor;
+	int64_t section_len;
+	uint32_t len;
+} __packed;
+
+struct pcapng_idb {
+	struct pcapng_block_hdr hdr;
+	uint16_t link_type;
+	uint16_t reserved;
+	uint32_t snaplen;
+	uint32_t len;
+} __packed;
+
+struct pcapng_epb {
+	struct pcapng_block_hdr hdr;
+	uint32_t if_id;
+	uint32_t ts_high;
+	uint32_t ts_low;
+	uint32_t cap_len;
+	uint32_t orig_len;
+} __packed;
+
+struct pcapng_epb_trailer {
+	uint16_t flags_code;
+	uint16_t flags_len;
+	uint32_t flags;
+	uint32_t end_of_opt;
+	uint32_t len;
+} __packed;
+
+static struct capture_ring {
+	struct capture_ring_slot slots[RING_COUNT];
+	struct net_capture_ring_filter filter;
+	/** Sequence number of the next packet */
+	atomic_t next;
+	atomic_t captured;
+	atomic_t dropped;
+	atomic_t enabled;
+} ring;
+
+/* Serializes the control and export functions */
+static K_MUTEX_DEFINE(lock);
+
+static struct capture_ring_slot export_slot;
+
+static uint16_t capture_ring_link_type(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return LINKTYPE_ETHERNET;
+	}
+#endif
+#if defined(CONFIG_NET_L2_IEEE802154)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(IEEE802154)) {
+		return LINKTYPE_IEEE802_15_4_NOFCS;
+	}
+#endif
+
+	/* Loopback, tunnels and OpenThread carry IP packets */
+	return LINKTYPE_RAW;
+}
+
+static uint16_t capture_ring_ptype(struct net_if *iface, struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+
+	if (buf == NULL || buf->len == 0) {
+		return 0;
+	}
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		const struct net_eth_hdr *hdr = (struct net_eth_hdr *)buf->data;
+		uint16_t ptype;
+
+		if (buf->len < sizeof(struct net_eth_hdr)) {
+			return 0;
+		}
+
+		ptype = ntohs(hdr->type);
+
+		if (ptype == NET_ETH_PTYPE_VLAN &&
+		    buf->len >= sizeof(struct net_eth_vlan_hdr)) {
+			ptype = ntohs(((struct net_eth_vlan_hdr *)buf->data)->type);
+		}
+
+		return ptype;
+	}
+#endif
+
+	switch (buf->data[0] & 0xf0) {
+	case 0x40:
+		return NET_ETH_PTYPE_IP;
+	case 0x60:
+		return NET_ETH_PTYPE_IPV6;
+	}
+
+	return 0;
+}
+
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt, bool outgoing)
+{
+	const struct net_capture_ring_filter *filter = &ring.filter;
+	struct capture_ring_slot *slot;
+	atomic_val_t state;
+	uint32_t seq;
+
+	if (!atomic_get(&ring.enabled)) {
+		return;
+	}
+
+	if ((filter->iface != NULL && filter->iface != iface) ||
+	    !(filter->direction & (outgoing ? NET_CAPTURE_RING_TX : NET_CAPTURE_RING_RX))) {
+		return;
+	}
+
+	if (filter->ptype != 0 && capture_ring_ptype(iface, pkt) != filter->ptype) {
+		return;
+	}
+
+	seq = (uint32_t)atomic_inc(&ring.next);
+	slot = &ring.slots[seq & (RING_COUNT - 1)];
+
+	/* Claim the slot, unless a writer that was interrupted one lap
+	 * earlier is still storing its packet there.
+	 */
+	state = atomic_get(&slot->state);
+	if ((state & SLOT_BUSY) || !atomic_cas(&slot->state, state, state | SLOT_BUSY)) {
+		atomic_inc(&ring.dropped);
+		return;
+	}
+
+	slot->seq = seq;
+	slot->timestamp = k_ticks_to_us_floor64(k_uptime_ticks());
+	slot->orig_len = net_pkt_get_len(pkt);
+	slot->cap_len = net_buf_linearize(slot->data, filter->snaplen, pkt->buffer, 0,
+					  filter->snaplen);
+	slot->if_index = net_if_get_by_iface(iface);
+	slot->outgoing = outgoing;
+
+	atomic_set(&slot->state, state + SLOT_GENERATION);
+	atomic_inc(&ring.captured);
+}
+
+int net_capture_ring_start(const struct net_capture_ring_filter *filter)
+{
+	struct net_capture_ring_filter new_filter = { 0 };
+
+	if (filter != NULL) {
+		new_filter = *filter;
+	}
+
+	if (new_filter.snaplen == 0) {
+		new_filter.snaplen = RING_SNAPLEN;
+	} else if (new_filter.snaplen > RING_SNAPLEN) {
+		return -EINVAL;
+	}
+
+	if (new_filter.direction == 0) {
+		new_filter.direction = NET_CAPTURE_RING_RX | NET_CAPTURE_RING_TX;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	/* Writers do not take the lock, so stop the capture while the filter
+	 * is replaced.
+	 */
+	atomic_set(&ring.enabled, false);
+	ring.filter = new_filter;
+	atomic_set(&ring.enabled, true);
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+int net_capture_ring_stop(void)
+{
+	atomic_set(&ring.enabled, false);
+
+	return 0;
+}
+
+bool net_capture_ring_is_enabled(void)
+{
+	return atomic_get(&ring.enabled);
+}
+
+int net_capture_ring_clear(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (atomic_get(&ring.enabled)) {
+		ret = -EBUSY;
+		goto out;
+	}
+
+	for (int i = 0; i < RING_COUNT; i++) {
+		atomic_set(&ring.slots[i].state, 0);
+	}
+
+	atomic_set(&ring.next, 0);
+	atomic_set(&ring.captured, 0);
+	atomic_set(&ring.dropped, 0);
+
+out:
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+void net_capture_ring_get_stats(struct net_capture_ring_stats *stats)
+{
+	stats->captured = atomic_get(&ring.captured);
+	stats->dropped = atomic_get(&ring.dropped);
+	stats->stored = MIN(stats->captured, RING_COUNT);
+}
+
+/* Copy a slot, returns false if it is empty, being written or was replaced
+ * while it was copied.
+ */
+static bool capture_ring_read_slot(int index, struct capture_ring_slot *copy)
+{
+	struct capture_ring_slot *slot = &ring.slots[index];
+	atomic_val_t state = atomic_get(&slot->state);
+
+	if (state == 0 || (state & SLOT_BUSY)) {
+		return false;
+	}
+
+	memcpy(copy, slot, sizeof(*copy));
+
+	return atomic_get(&slot->state) == state;
+}
+
+struct export_data {
+	net_capture_ring_write_cb_t cb;
+	void *user_data;
+	uint32_t snaplen;
+	int ret;
+};
+
+static void export_idb(struct net_if *iface, void *user_data)
+{
+	struct export_data *data = user_data;
+	struct pcapng_idb idb = {
+		.hdr.type = PCAPNG_IDB,
+		.hdr.len = sizeof(idb),
+		.link_type = capture_ring_link_type(iface),
+		.snaplen = data->snaplen,
+		.len = sizeof(idb),
+	};
+
+	if (data->ret == 0) {
+		data->ret = data->cb(&idb, sizeof(idb), data->user_data);
+	}
+}
+
+static int export_epb(struct export_data *data, const struct capture_ring_slot *slot)
+{
+	static const uint8_t padding[3];
+	size_t pad = ROUND_UP(slot->cap_len, 4) - slot->cap_len;
+	uint32_t len = sizeof(struct pcapng_epb) + slot->cap_len + pad +
+		       sizeof(struct pcapng_epb_trailer);
+	struct pcapng_epb epb = {
+		.hdr.type = PCAPNG_EPB,
+		.hdr.len = len,
+		/* Interface blocks are written in interface index order */
+		.if_id = slot->if_index - 1,
+		.ts_high = slot->timestamp >> 32,
+		.ts_low = (uint32_t)slot->timestamp,
+		.cap_len = slot->cap_len,
+		.orig_len = slot->orig_len,
+	};
+	struct pcapng_epb_trailer trailer = {
+		.flags_code = PCAPNG_OPT_EPB_FLAGS,
+		.flags_len = sizeof(uint32_t),
+		.flags = slot->outgoing ? PCAPNG_EPB_OUTBOUND : PCAPNG_EPB_INBOUND,
+		.len = len,
+	};
+	int ret;
+
+	ret = data->cb(&epb, sizeof(epb), data->user_data);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = data->cb(slot->data, slot->cap_len, data->user_data);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (pad > 0) {
+		ret = data->cb(padding, pad, data->user_data);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return data->cb(&trailer, sizeof(trailer), data->user_data);
+}
+
+int net_capture_ring_export(net_capture_ring_write_cb_t cb, void *user_data)
+{
+	struct pcapng_shb shb = {
+		.hdr.type = PCAPNG_SHB,
+		.hdr.len = sizeof(shb),
+		.magic = PCAPNG_BYTE_ORDER_MAGIC,
+		.major = 1,
+		.minor = 0,
+		.section_len = -1,
+		.len = sizeof(shb),
+	};
+	struct export_data data = {
+		.cb = cb,
+		.user_data = user_data,
+		.snaplen = RING_SNAPLEN,
+	};
+	uint32_t next;
+	int count = 0;
+
+	if (cb == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (ring.filter.snaplen != 0) {
+		data.snaplen = ring.filter.snaplen;
+	}
+
+	data.ret = cb(&shb, sizeof(shb), user_data);
+	if (data.ret < 0) {
+		goto out;
+	}
+
+	net_if_foreach(export_idb, &data);
+	if (data.ret < 0) {
+		goto out;
+	}
+
+	/* Starting at the slot of the next packet goes through the packets
+	 * from the oldest to the most recent one.
+	 */
+	next = (uint32_t)atomic_get(&ring.next);
+
+	for (int i = 0; i < RING_COUNT; i++) {
+		if (!capture_ring_read_slot((next + i) & (RING_COUNT - 1), &export_slot)) {
+			continue;
+		}
+
+		/* Skip packets stored after the export was started */
+		if ((uint32_t)(next - export_slot.seq - 1) >= RING_COUNT) {
+			continue;
+		}
+
+		data.ret = export_epb(&data, &export_slot);
+		if (data.ret < 0) {
+			goto out;
+		}
+
+		count++;
+	}
+
+out:
+	k_mutex_unlock(&lock);
+
+	if (data.ret < 0) {
+		NET_DBG("Export failed (%d)", data.ret);
+		return data.ret;
+	}
+
+	return count;
+}
+
+#if defined(CONFIG_NET_CAPTURE_RING_HOST_FILE)
+static int save_write(const void *data, size_t len, void *user_data)
+{
+	return net_capture_ring_write_bottom(user_data, data, len);
+}
+
+int net_capture_ring_save(const char *path)
+{
+	void *file;
+	int ret;
+
+	file = net_capture_ring_open_bottom(path);
+	if (file == NULL) {
+		NET_ERR("Cannot create %s", path);
+		return -EIO;
+	}
+
+	ret = net_capture_ring_export(save_write, file);
+
+	net_capture_ring_close_bottom(file);
+
+	return ret;
+}
+#elif defined(CONFIG_FILE_SYSTEM)
+static int save_write(const void *data, size_t len, void *user_data)
+{
+	ssize_t ret;
+
+	ret = fs_write(user_data, data, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return ret == len ? 0 : -ENOSPC;
+}
+
+int net_capture_ring_save(const char *path)
+{
+	struct fs_file_t file;
+	int ret;
+
+	fs_file_t_init(&file);
+
+	/* Remove a previous capture, the new one may be shorter */
+	(void)fs_unlink(path);
+
+	ret = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE);
+	if (ret < 0) {
+		NET_ERR("Cannot create %s (%d)", path, ret);
+		return ret;
+	}
+
+	ret = net_capture_ring_export(save_write, &file);
+
+	(void)fs_close(&file);
+
+	return ret;
+}
+#else
+int net_capture_ring_save(const char *path)
+{
+	ARG_UNUSED(path);
+
+	return -ENOTSUP;
+}
+#endif
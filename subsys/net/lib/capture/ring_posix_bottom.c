@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <errno.h>
+
+void *net_capture_ring_open_bottom(const char *file_name)
+{
+	return (void *)fopen(file_name, "wb");
+}
+
+int net_capture_ring_write_bottom(void *out_stream, const void *data, unsigned long length)
+{
+	if (length == 0) {
+		return 0;
+	}
+
+	if (fwrite(data, length, 1, (FILE *)out_stream) != 1) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+void net_capture_ring_close_bottom(void *out_stream)
+{
+	fclose((FILE *)out_stream);
+}
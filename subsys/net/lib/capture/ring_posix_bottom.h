@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * "Bottom" of the capture ring file output for the native targets.
+ * When built with the native_simulator this will be built in the runner context,
+ * that is, with the host C library, and with the host include paths.
+ *
+ * Note: None of these functions are public interfaces. But internal to the capture ring.
+ */
+
+#ifndef SUBSYS_NET_LIB_CAPTURE_RING_POSIX_BOTTOM_H
+#define SUBSYS_NET_LIB_CAPTURE_RING_POSIX_BOTTOM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *net_capture_ring_open_bottom(const char *file_name);
+int net_capture_ring_write_bottom(void *out_stream, const void *data, unsigned long length);
+void net_capture_ring_close_bottom(void *out_stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_NET_LIB_CAPTURE_RING_POSIX_BOTTOM_H */
@@ -34,6 +34,8 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #define MAX_PENDINGS   CONFIG_COAP_SERVICE_PENDING_MESSAGES
 #define MAX_OBSERVERS  CONFIG_COAP_SERVICE_OBSERVERS
 #define MAX_POLL_FD    CONFIG_NET_SOCKETS_POLL_MAX
+#define MAX_WORKERS    CONFIG_COAP_SERVER_WORKERS
+#define RES_INDEX_SIZE CONFIG_COAP_SERVER_RESOURCE_INDEX_SIZE
 
 BUILD_ASSERT(CONFIG_NET_SOCKETS_POLL_MAX > 0, "CONFIG_NET_SOCKETS_POLL_MAX can't be 0");
 
@@ -81,6 +83,161 @@ static inline void coap_server_free(void *ptr)
 #endif
 }
 
+#if MAX_WORKERS > 0
+/* A received datagram waiting for a worker thread */
+struct coap_server_request {
+	void *fifo_reserved;
+	int sock_fd;
+	struct sockaddr addr;
+	socklen_t addr_len;
+	size_t len;
+	uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+};
+
+K_MEM_SLAB_DEFINE_STATIC(request_slab, sizeof(struct coap_server_request),
+			 CONFIG_COAP_SERVER_WORKER_QUEUE_SIZE, 4);
+static K_FIFO_DEFINE(request_fifo);
+
+static K_KERNEL_STACK_ARRAY_DEFINE(worker_stacks, MAX_WORKERS,
+				   CONFIG_COAP_SERVER_WORKER_STACK_SIZE);
+static struct k_thread worker_threads[MAX_WORKERS];
+#endif /* MAX_WORKERS > 0 */
+
+#if RES_INDEX_SIZE > 0
+#define PATH_HASH_INIT  2166136261U
+#define PATH_HASH_PRIME 16777619U
+
+/* FNV-1a hash of the path segments, each preceded by a separator */
+static uint32_t path_hash_update(uint32_t hash, const uint8_t *segment, size_t len)
+{
+	hash = (hash ^ '/') * PATH_HASH_PRIME;
+
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ segment[i]) * PATH_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+static bool coap_resource_has_wildcard(const struct coap_resource *resource)
+{
+	if (!IS_ENABLED(CONFIG_COAP_URI_WILDCARD)) {
+		return false;
+	}
+
+	for (const char * const *segment = resource->path; *segment != NULL; segment++) {
+		if (strcmp(*segment, "+") == 0 || strcmp(*segment, "#") == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void coap_service_build_index(const struct coap_service *service)
+{
+	struct coap_service_data *data = service->data;
+	size_t count = COAP_SERVICE_RESOURCE_COUNT(service);
+
+	memset(data->res_index, 0, sizeof(data->res_index));
+	data->res_first_wildcard = count;
+	data->res_indexed = false;
+
+	/* Keep at least one free slot so that a lookup always terminates */
+	if (count >= RES_INDEX_SIZE) {
+		LOG_DBG("Too many resources in %s to index (%zu)", service->name, count);
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		const struct coap_resource *resource = &service->res_begin[i];
+		uint32_t hash = PATH_HASH_INIT;
+		size_t slot;
+
+		/* Wildcard paths cannot be hashed, they are matched by walking */
+		if (coap_resource_has_wildcard(resource)) {
+			data->res_first_wildcard = MIN(data->res_first_wildcard, i);
+			continue;
+		}
+
+		for (const char * const *segment = resource->path; *segment != NULL; segment++) {
+			hash = path_hash_update(hash, *segment, strlen(*segment));
+		}
+
+		slot = hash % RES_INDEX_SIZE;
+		while (data->res_index[slot] != 0U) {
+			slot = (slot + 1) % RES_INDEX_SIZE;
+		}
+
+		data->res_index[slot] = i + 1;
+	}
+
+	data->res_indexed = true;
+}
+
+static int coap_service_handle_request(const struct coap_service *service,
+				       struct coap_packet *request,
+				       struct coap_option *options, uint8_t opt_num,
+				       struct sockaddr *addr, socklen_t addr_len)
+{
+	struct coap_service_data *data = service->data;
+	size_t count = COAP_SERVICE_RESOURCE_COUNT(service);
+	uint32_t hash = PATH_HASH_INIT;
+	size_t slot;
+
+	if (!data->res_indexed) {
+		return coap_handle_request_len(request, service->res_begin, count, options,
+					       opt_num, addr, addr_len);
+	}
+
+	for (uint8_t i = 0; i < opt_num; i++) {
+		if (options[i].delta == COAP_OPTION_URI_PATH) {
+			hash = path_hash_update(hash, options[i].value, options[i].len);
+		}
+	}
+
+	for (slot = hash % RES_INDEX_SIZE; data->res_index[slot] != 0U;
+	     slot = (slot + 1) % RES_INDEX_SIZE) {
+		size_t idx = data->res_index[slot] - 1;
+		struct coap_resource *resource = &service->res_begin[idx];
+
+		if (!coap_uri_path_match(resource->path, options, opt_num)) {
+			continue;
+		}
+
+		if (idx > data->res_first_wildcard) {
+			/* A wildcard resource defined earlier takes precedence */
+			break;
+		}
+
+		return coap_handle_request_len(request, resource, 1, options, opt_num,
+					       addr, addr_len);
+	}
+
+	/* Walk the resources from the first wildcard one, exact paths defined before it
+	 * did not match.
+	 */
+	return coap_handle_request_len(request, &service->res_begin[data->res_first_wildcard],
+				       count - data->res_first_wildcard, options, opt_num,
+				       addr, addr_len);
+}
+#else
+static inline void coap_service_build_index(const struct coap_service *service)
+{
+	ARG_UNUSED(service);
+}
+
+static inline int coap_service_handle_request(const struct coap_service *service,
+					      struct coap_packet *request,
+					      struct coap_option *options, uint8_t opt_num,
+					      struct sockaddr *addr, socklen_t addr_len)
+{
+	return coap_handle_request_len(request, service->res_begin,
+				       COAP_SERVICE_RESOURCE_COUNT(service), options, opt_num,
+				       addr, addr_len);
+}
+#endif /* RES_INDEX_SIZE > 0 */
+
 static int coap_service_remove_observer(const struct coap_service *service,
 					struct coap_resource *resource,
 					const struct sockaddr *addr,
@@ -121,34 +278,17 @@ static int coap_service_remove_observer(const struct coap_service *service,
 	return 0;
 }
 
-static int coap_server_process(int sock_fd)
+static int coap_server_handle(int sock_fd, uint8_t *buf, size_t received,
+			      struct sockaddr *client_addr, socklen_t client_addr_len)
 {
-	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
-
-	struct sockaddr client_addr;
-	socklen_t client_addr_len = sizeof(client_addr);
 	struct coap_service *service = NULL;
 	struct coap_packet request;
 	struct coap_pending *pending;
 	struct coap_option options[MAX_OPTIONS] = { 0 };
 	uint8_t opt_num = MAX_OPTIONS;
 	uint8_t type;
-	ssize_t received;
 	int ret;
 
-	received = zsock_recvfrom(sock_fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT, &client_addr,
-				  &client_addr_len);
-	__ASSERT_NO_MSG(received <= sizeof(buf));
-
-	if (received < 0) {
-		if (errno == EWOULDBLOCK) {
-			return 0;
-		}
-
-		LOG_ERR("Failed to process client request (%d)", -errno);
-		return -errno;
-	}
-
 	ret = coap_packet_parse(&request, buf, received, options, opt_num);
 	if (ret < 0) {
 		LOG_ERR("Failed To parse coap message (%d)", ret);
@@ -178,7 +318,7 @@ static int coap_server_process(int sock_fd)
 		switch (type) {
 		case COAP_TYPE_RESET:
 			tkl = coap_header_get_token(&request, token);
-			coap_service_remove_observer(service, NULL, &client_addr, token, tkl);
+			coap_service_remove_observer(service, NULL, client_addr, token, tkl);
 			__fallthrough;
 		case COAP_TYPE_ACK:
 			coap_server_free(pending->data);
@@ -197,6 +337,11 @@ static int coap_server_process(int sock_fd)
 		goto unlock;
 	}
 
+	/* The resources are not modified while the service exists, so the request is
+	 * dispatched without holding the lock to let the workers run concurrently.
+	 */
+	(void)k_mutex_unlock(&lock);
+
 	if (IS_ENABLED(CONFIG_COAP_SERVER_WELL_KNOWN_CORE) &&
 	    coap_header_get_code(&request) == COAP_METHOD_GET &&
 	    coap_uri_path_match(COAP_WELL_KNOWN_CORE_PATH, options, opt_num)) {
@@ -209,14 +354,13 @@ static int coap_server_process(int sock_fd)
 						   well_known_buf, sizeof(well_known_buf));
 		if (ret < 0) {
 			LOG_ERR("Failed to build well known core for %s (%d)", service->name, ret);
-			goto unlock;
+			return ret;
 		}
 
-		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
+		ret = coap_service_send(service, &response, client_addr, client_addr_len, NULL);
 	} else {
-		ret = coap_handle_request_len(&request, service->res_begin,
-					      COAP_SERVICE_RESOURCE_COUNT(service),
-					      options, opt_num, &client_addr, client_addr_len);
+		ret = coap_service_handle_request(service, &request, options, opt_num,
+						  client_addr, client_addr_len);
 
 		/* Translate errors to response codes */
 		switch (ret) {
@@ -240,19 +384,116 @@ static int coap_server_process(int sock_fd)
 			ret = coap_ack_init(&ack, &request, ack_buf, sizeof(ack_buf), (uint8_t)ret);
 			if (ret < 0) {
 				LOG_ERR("Failed to init ACK (%d)", ret);
-				goto unlock;
+				return ret;
 			}
 
-			ret = coap_service_send(service, &ack, &client_addr, client_addr_len, NULL);
+			ret = coap_service_send(service, &ack, client_addr, client_addr_len, NULL);
 		}
 	}
 
+	return ret;
+
 unlock:
 	(void)k_mutex_unlock(&lock);
 
 	return ret;
 }
 
+#if MAX_WORKERS > 0
+static void coap_server_worker(void *p1, void *p2, void *p3)
+{
+	struct coap_server_request *req;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		req = k_fifo_get(&request_fifo, K_FOREVER);
+
+		(void)coap_server_handle(req->sock_fd, req->buf, req->len, &req->addr,
+					 req->addr_len);
+
+		k_mem_slab_free(&request_slab, req);
+	}
+}
+
+static void coap_server_start_workers(void)
+{
+	for (int i = 0; i < MAX_WORKERS; i++) {
+		k_tid_t tid;
+
+		tid = k_thread_create(&worker_threads[i], worker_stacks[i],
+				      K_KERNEL_STACK_SIZEOF(worker_stacks[i]),
+				      coap_server_worker, NULL, NULL, NULL,
+				      THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(tid, "coap_worker");
+	}
+}
+
+static int coap_server_process(int sock_fd)
+{
+	struct coap_server_request *req;
+	ssize_t received;
+
+	/* Wait for a worker to finish a request if all buffers are in use, the
+	 * socket queues the datagrams received meanwhile.
+	 */
+	(void)k_mem_slab_alloc(&request_slab, (void **)&req, K_FOREVER);
+
+	req->addr_len = sizeof(req->addr);
+	received = zsock_recvfrom(sock_fd, req->buf, sizeof(req->buf), ZSOCK_MSG_DONTWAIT,
+				  &req->addr, &req->addr_len);
+	__ASSERT_NO_MSG(received <= sizeof(req->buf));
+
+	if (received < 0) {
+		k_mem_slab_free(&request_slab, req);
+
+		if (errno == EWOULDBLOCK) {
+			return 0;
+		}
+
+		LOG_ERR("Failed to process client request (%d)", -errno);
+		return -errno;
+	}
+
+	req->sock_fd = sock_fd;
+	req->len = received;
+
+	k_fifo_put(&request_fifo, req);
+
+	return 0;
+}
+#else
+static inline void coap_server_start_workers(void)
+{
+}
+
+static int coap_server_process(int sock_fd)
+{
+	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+
+	struct sockaddr client_addr;
+	socklen_t client_addr_len = sizeof(client_addr);
+	ssize_t received;
+
+	received = zsock_recvfrom(sock_fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT, &client_addr,
+				  &client_addr_len);
+	__ASSERT_NO_MSG(received <= sizeof(buf));
+
+	if (received < 0) {
+		if (errno == EWOULDBLOCK) {
+			return 0;
+		}
+
+		LOG_ERR("Failed to process client request (%d)", -errno);
+		return -errno;
+	}
+
+	return coap_server_handle(sock_fd, buf, received, &client_addr, client_addr_len);
+}
+#endif /* MAX_WORKERS > 0 */
+
 static void coap_server_retransmit(void)
 {
 	struct coap_pending *pending;
@@ -456,6 +697,8 @@ int coap_service_start(const struct coap_service *service)
 		}
 	}
 
+	coap_service_build_index(service);
+
 end:
 	k_mutex_unlock(&lock);
 
@@ -724,6 +967,8 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+	coap_server_start_workers();
+
 	/* Create a socket pair to wake zsock_poll */
 	ret = zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, control_socks);
 	if (ret < 0) {
@@ -9,30 +9,94 @@
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+/* Entries are to be refreshed when less than 1/DNS_CACHE_REFRESH_DIV of their TTL is left */
+#define DNS_CACHE_REFRESH_DIV 10
 
-int dns_cache_flush(struct dns_cache *cache)
+static void dns_cache_clean(struct dns_cache *cache);
+
+/* FNV-1a hash of the query string */
+static uint32_t dns_cache_hash(const char *query)
 {
-	k_mutex_lock(cache->lock, K_FOREVER);
-	for (size_t i = 0; i < cache->size; i++) {
-		cache->entries[i].in_use = false;
+	uint32_t hash = 2166136261U;
+
+	while (*query != '\0') {
+		hash ^= (uint8_t)*query++;
+		hash *= 16777619U;
 	}
-	k_mutex_unlock(cache->lock);
 
-	return 0;
+	return hash;
 }
 
-int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
-		  uint32_t ttl)
+static inline sys_slist_t *dns_cache_bucket(struct dns_cache *cache, uint32_t hash)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	return &cache->buckets[hash % cache->size];
+}
 
-	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
-		return -EINVAL;
+static inline bool dns_cache_match(const struct dns_cache_entry *entry, uint32_t hash,
+				   const char *query)
+{
+	return entry->hash == hash && strcmp(entry->query, query) == 0;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_entry_remove(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	sys_slist_find_and_remove(dns_cache_bucket(cache, entry->hash), &entry->node);
+	sys_dlist_remove(&entry->lru_node);
+	entry->in_use = false;
+}
+
+/* Needs to be called when lock is already acquired */
+static bool dns_cache_entry_expired(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	if (!sys_timepoint_expired(entry->expiry)) {
+		return false;
+	}
+
+	NET_DBG("Remove \"%s\"", entry->query);
+	dns_cache_entry_remove(cache, entry);
+
+	return true;
+}
+
+/* Needs to be called when lock is already acquired */
+static inline void dns_cache_entry_used(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	if (sys_dnode_is_linked(&entry->lru_node)) {
+		sys_dlist_remove(&entry->lru_node);
 	}
 
+	sys_dlist_prepend(&cache->lru, &entry->lru_node);
+}
+
+/* Needs to be called when lock is already acquired */
+static struct dns_cache_entry *dns_cache_entry_alloc(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry;
+
+	dns_cache_clean(cache);
+
+	for (size_t i = 0; i < cache->size; i++) {
+		if (!cache->entries[i].in_use) {
+			return &cache->entries[i];
+		}
+	}
+
+	entry = CONTAINER_OF(sys_dlist_peek_tail(&cache->lru), struct dns_cache_entry, lru_node);
+
+	NET_DBG("Overwrite \"%s\"", entry->query);
+	dns_cache_entry_remove(cache, entry);
+
+	return entry;
+}
+
+static int dns_cache_insert(struct dns_cache *cache, char const *query,
+			    struct dns_addrinfo const *addrinfo, int status, uint32_t ttl)
+{
+	struct dns_cache_entry *entry;
+	sys_slist_t *bucket;
+	uint32_t hash;
+
 	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
 		NET_WARN("Query string to big to be processed %u >= "
 			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
@@ -40,41 +104,85 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+	bucket = dns_cache_bucket(cache, hash);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
-	dns_cache_clean(cache);
+	entry = dns_cache_entry_alloc(cache);
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->data = *addrinfo;
+	entry->hash = hash;
+	entry->status = status;
+	entry->in_use = true;
+	sys_slist_append(bucket, &entry->node);
+
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->refresh = sys_timepoint_calc(
+		K_MSEC((uint64_t)ttl * MSEC_PER_SEC * (DNS_CACHE_REFRESH_DIV - 1) /
+		       DNS_CACHE_REFRESH_DIV));
+	entry->refreshing = false;
+	dns_cache_entry_used(cache, entry);
+
+	k_mutex_unlock(cache->lock);
 
+	return 0;
+}
+
+int dns_cache_flush(struct dns_cache *cache)
+{
+	k_mutex_lock(cache->lock, K_FOREVER);
 	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+		cache->entries[i].in_use = false;
+		sys_dnode_init(&cache->entries[i].lru_node);
+		sys_slist_init(&cache->buckets[i]);
 	}
+	sys_dlist_init(&cache->lru);
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
+		  uint32_t ttl)
+{
+	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	return dns_cache_insert(cache, query, addrinfo, 0, ttl);
+}
 
-	k_mutex_unlock(cache->lock);
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, sa_family_t family,
+			   int status, uint32_t ttl)
+{
+	struct dns_addrinfo addrinfo = {
+		.ai_family = family,
+	};
 
-	return 0;
+	if (cache == NULL || query == NULL || ttl == 0 ||
+	    (status != DNS_EAI_NONAME && status != DNS_EAI_NODATA)) {
+		return -EINVAL;
+	}
+
+	return dns_cache_insert(cache, query, &addrinfo, status, ttl);
 }
 
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
-	NET_DBG("Remove all entries with query \"%s\"", query);
+	return dns_cache_remove_family(cache, query, AF_UNSPEC);
+}
+
+int dns_cache_remove_family(struct dns_cache *cache, char const *query, sa_family_t family)
+{
+	struct dns_cache_entry *entry, *next;
+	sys_slist_t *bucket;
+	uint32_t hash;
+
+	NET_DBG("Remove all entries with query \"%s\" and family %d", query, family);
 	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
 		NET_WARN("Query string to big to be processed %u >= "
 			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
@@ -82,13 +190,20 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+	bucket = dns_cache_bucket(cache, hash);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
-	dns_cache_clean(cache);
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(bucket, entry, next, node) {
+		if (!dns_cache_match(entry, hash, query)) {
+			continue;
+		}
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
+		/* Negative answers for all families are removed too */
+		if (family == AF_UNSPEC || entry->data.ai_family == family ||
+		    entry->data.ai_family == AF_UNSPEC) {
+			dns_cache_entry_remove(cache, entry);
 		}
 	}
 
@@ -97,10 +212,13 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
-		   size_t addrinfo_array_len)
+int dns_cache_lookup(struct dns_cache *cache, const char *query, sa_family_t family,
+		     struct dns_addrinfo *addrinfo, size_t addrinfo_array_len, bool *refresh)
 {
+	struct dns_cache_entry *entry, *next;
+	sys_slist_t *bucket;
 	size_t found = 0;
+	uint32_t hash;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
@@ -113,24 +231,44 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 		return -EINVAL;
 	}
 
-	k_mutex_lock(cache->lock, K_FOREVER);
+	if (refresh != NULL) {
+		*refresh = false;
+	}
 
-	dns_cache_clean(cache);
+	hash = dns_cache_hash(query);
+	bucket = dns_cache_bucket(cache, hash);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(bucket, entry, next, node) {
+		if (!dns_cache_match(entry, hash, query)) {
+			continue;
+		}
+		if (dns_cache_entry_expired(cache, entry)) {
+			continue;
+		}
+		if (entry->status != 0) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (family != AF_UNSPEC && entry->data.ai_family != family) {
 			continue;
 		}
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
-		} else {
-			addrinfo[found] = cache->entries[i].data;
-			found++;
-			NET_DBG("Found \"%s\"", query);
+			continue;
+		}
+
+		addrinfo[found] = entry->data;
+		found++;
+		NET_DBG("Found \"%s\"", query);
+
+		dns_cache_entry_used(cache, entry);
+
+		if (refresh != NULL && !entry->refreshing &&
+		    sys_timepoint_expired(entry->refresh)) {
+			entry->refreshing = true;
+			*refresh = true;
 		}
 	}
 
@@ -146,17 +284,84 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 	return found;
 }
 
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+void dns_cache_refresh_abort(struct dns_cache *cache, const char *query)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
+	struct dns_cache_entry *entry;
+	sys_slist_t *bucket;
+	uint32_t hash;
+
+	if (cache == NULL || query == NULL) {
+		return;
+	}
+
+	hash = dns_cache_hash(query);
+	bucket = dns_cache_bucket(cache, hash);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, entry, node) {
+		if (dns_cache_match(entry, hash, query)) {
+			entry->refreshing = false;
 		}
+	}
+
+	k_mutex_unlock(cache->lock);
+}
+
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
+		   size_t addrinfo_array_len)
+{
+	return dns_cache_lookup(cache, query, AF_UNSPEC, addrinfo, addrinfo_array_len, NULL);
+}
+
+int dns_cache_find_negative(struct dns_cache *cache, const char *query, sa_family_t family)
+{
+	struct dns_cache_entry *entry, *next;
+	sys_slist_t *bucket;
+	uint32_t hash;
+	int ret = 0;
+
+	if (cache == NULL || query == NULL) {
+		return -EINVAL;
+	}
+
+	hash = dns_cache_hash(query);
+	bucket = dns_cache_bucket(cache, hash);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(bucket, entry, next, node) {
+		if (!dns_cache_match(entry, hash, query)) {
+			continue;
+		}
+		if (dns_cache_entry_expired(cache, entry)) {
+			continue;
+		}
+		if (entry->status == 0) {
+			continue;
 		}
+		if (entry->data.ai_family != AF_UNSPEC && entry->data.ai_family != family) {
+			continue;
+		}
+
+		NET_DBG("Found negative answer %d for \"%s\"", entry->status, query);
+
+		dns_cache_entry_used(cache, entry);
+		ret = entry->status;
+		break;
+	}
+
+	k_mutex_unlock(cache->lock);
+
+	return ret;
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_clean(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry, *next;
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&cache->lru, entry, next, lru_node) {
+		(void)dns_cache_entry_expired(cache, entry);
 	}
 }
@@ -17,17 +17,35 @@
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 struct dns_cache_entry {
+	/* Hash bucket node */
+	sys_snode_t node;
+	/* Position in the least recently used order of the entries */
+	sys_dnode_t lru_node;
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Time after which a lookup asks for the entry to be refreshed */
+	k_timepoint_t refresh;
+	uint32_t hash;
+	/* 0 for an address, DNS_EAI_NONAME or DNS_EAI_NODATA for a cached
+	 * negative answer.
+	 */
+	int status;
 	bool in_use;
+	bool refreshing;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	/* One hash bucket per entry */
+	sys_slist_t *buckets;
+	/* Entries in use, most recently used first */
+	sys_dlist_t lru;
 	struct k_mutex *lock;
 };
 
@@ -43,8 +61,10 @@ struct dns_cache {
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static sys_slist_t name##_buckets[cache_size];                                             \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries, .size = cache_size, .buckets = name##_buckets,          \
+		.lru = SYS_DLIST_STATIC_INIT(&name.lru), .lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -56,8 +76,8 @@ struct dns_cache {
 int dns_cache_flush(struct dns_cache *cache);
 
 /**
- * @brief Adds a new entry to the dns cache removing the one closest to expiry
- * if no free space is available.
+ * @brief Adds a new entry to the dns cache removing the least recently used
+ * one if no free space is available.
  *
  * @param cache Cache where the entry should be added.
  * @param query Query which should be persisted in the cache.
@@ -71,6 +91,23 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds a negative answer to the dns cache as described in RFC 2308.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param family Address family of the query for a DNS_EAI_NODATA answer,
+ * AF_UNSPEC for a DNS_EAI_NONAME answer which applies to all families.
+ * @param status DNS_EAI_NONAME if the name does not exist, DNS_EAI_NODATA if
+ * it has no address of the given family.
+ * @param ttl Time to live for the entry in seconds, derived from the SOA record
+ * of the answer.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, sa_family_t family,
+			   int status, uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -81,6 +118,20 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
  */
 int dns_cache_remove(struct dns_cache *cache, char const *query);
 
+/**
+ * @brief Removes the entries with the given query and address family
+ *
+ * Used to replace the cached answers to a query with a new answer. Negative
+ * answers which apply to all families are removed as well.
+ *
+ * @param cache Cache where the entries should be removed.
+ * @param query Query which should be searched for.
+ * @param family Address family of the entries to remove, AF_UNSPEC for all.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_remove_family(struct dns_cache *cache, char const *query, sa_family_t family);
+
 /**
  * @brief Tries to find the specified query entry within the cache.
  *
@@ -94,7 +145,51 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len);
 
+/**
+ * @brief Tries to find the specified query entry within the cache, and checks
+ * whether the entries are about to expire.
+ *
+ * Works like dns_cache_find(), but only returns the addresses of the given family
+ * unless it is AF_UNSPEC. When less than a tenth of the TTL of the entries is left,
+ * @p refresh is set once so that the caller can query them again before they expire.
+ *
+ * @param cache Cache where the entry should be searched.
+ * @param query Query which should be searched for.
+ * @param family Address family of the addresses to return, or AF_UNSPEC.
+ * @param addrinfo dns_addrinfo array which will be written if the query was found.
+ * @param addrinfo_array_len Array size of the dns_addrinfo array
+ * @param refresh Set to true if the entries should be refreshed. Can be NULL.
+ * @retval on success the amount of dns_addrinfo written into the addrinfo array will be returned.
+ * A cache miss will therefore return a 0.
+ * @retval On error a negative value is returned, see dns_cache_find().
+ */
+int dns_cache_lookup(struct dns_cache *cache, const char *query, sa_family_t family,
+		     struct dns_addrinfo *addrinfo, size_t addrinfo_array_len, bool *refresh);
+
+/**
+ * @brief Allows the entries of the specified query to be refreshed again.
+ *
+ * To be called when a refresh requested by dns_cache_lookup() could not be
+ * completed, so that a later lookup requests it again.
+ *
+ * @param cache Cache where the entries should be searched.
+ * @param query Query whose entries could not be refreshed.
+ */
+void dns_cache_refresh_abort(struct dns_cache *cache, const char *query);
+
+/**
+ * @brief Tries to find a negative answer for the specified query within the cache.
+ *
+ * @param cache Cache where the entry should be searched.
+ * @param query Query which should be searched for.
+ * @param family Address family of the query.
+ * @retval DNS_EAI_NONAME or DNS_EAI_NODATA if a negative answer was cached.
+ * @retval 0 if no negative answer was cached.
+ * @retval On error another negative value is returned.
+ */
+int dns_cache_find_negative(struct dns_cache *cache, const char *query, sa_family_t family);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
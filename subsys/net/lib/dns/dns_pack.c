@@ -177,6 +177,62 @@ int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 	return 0;
 }
 
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl)
+{
+	int ancount = dns_header_ancount(dns_msg->msg);
+	int count = ancount + dns_header_nscount(dns_msg->msg);
+	uint16_t offset = dns_msg->answer_offset;
+	uint32_t minimum;
+	uint16_t len;
+	uint16_t pos;
+	uint8_t *rr;
+	int dname_len;
+
+	/* Skip the answers, a CNAME chain might precede the SOA record */
+	for (int i = 0; i < count; i++) {
+		if (offset >= dns_msg->msg_size) {
+			return -EINVAL;
+		}
+
+		rr = dns_msg->msg + offset;
+
+		dname_len = skip_fqdn(rr, dns_msg->msg_size - offset);
+		if (dname_len < 0) {
+			return dname_len;
+		}
+
+		pos = offset + dname_len +
+			DNS_COMMON_UINT_SIZE + /* type length */
+			DNS_COMMON_UINT_SIZE + /* class length */
+			DNS_TTL_LEN +
+			DNS_RDLENGTH_LEN;
+		if (pos > dns_msg->msg_size) {
+			return -EINVAL;
+		}
+
+		len = dns_answer_rdlength(dname_len, rr);
+		if (pos + len > dns_msg->msg_size) {
+			return -EINVAL;
+		}
+
+		if (i >= ancount && dns_answer_type(dname_len, rr) == DNS_RR_TYPE_SOA) {
+			if (len < DNS_SOA_MIN_RDLENGTH) {
+				return -EINVAL;
+			}
+
+			minimum = ntohl(UNALIGNED_GET((uint32_t *)(dns_msg->msg + pos + len -
+								  DNS_SOA_MINIMUM_LEN)));
+			*ttl = MIN((uint32_t)dns_answer_ttl(dname_len, rr), minimum);
+
+			return 0;
+		}
+
+		offset = pos + len;
+	}
+
+	return -ENOENT;
+}
+
 int dns_unpack_response_header(struct dns_msg_t *msg, int src_id)
 {
 	uint8_t *dns_header;
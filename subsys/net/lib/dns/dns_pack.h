@@ -38,6 +38,12 @@
 #define DNS_ARCOUNT_LEN		2
 #define DNS_TTL_LEN		4
 #define DNS_RDLENGTH_LEN	2
+#define DNS_SOA_MINIMUM_LEN	4
+
+/* MNAME and RNAME of at least one octet followed by SERIAL, REFRESH, RETRY,
+ * EXPIRE and MINIMUM. See RFC 1035, 3.3.13. SOA RDATA format.
+ */
+#define DNS_SOA_MIN_RDLENGTH	(2 * DNS_LABEL_MIN_SIZE + 5 * DNS_TTL_LEN)
 
 #define NS_CMPRSFLGS    0xc0   /* DNS name compression */
 
@@ -89,6 +95,7 @@ enum dns_rr_type {
 	DNS_RR_TYPE_INVALID = 0,
 	DNS_RR_TYPE_A	= 1,		/* IPv4  */
 	DNS_RR_TYPE_CNAME = 5,		/* CNAME */
+	DNS_RR_TYPE_SOA = 6,		/* SOA   */
 	DNS_RR_TYPE_PTR = 12,		/* PTR   */
 	DNS_RR_TYPE_TXT = 16,		/* TXT   */
 	DNS_RR_TYPE_AAAA = 28,		/* IPv6  */
@@ -347,6 +354,22 @@ int dns_msg_pack_qname(uint16_t *len, uint8_t *buf, uint16_t size,
 int dns_unpack_answer(struct dns_msg_t *dns_msg, int dname_ptr, uint32_t *ttl,
 		      enum dns_rr_type *type);
 
+/**
+ * @brief Unpacks the TTL of a negative response
+ *
+ * @details The time a negative response may be cached is the minimum of the
+ *          TTL of the SOA record in the authority section and the MINIMUM
+ *          field of that record, see RFC 2308, 5. Caching Negative Answers.
+ *          The answer_offset field must point after the question.
+ *
+ * @param dns_msg Structure containing the response.
+ * @param ttl Time in seconds the response may be cached.
+ * @retval 0 on success
+ * @retval -ENOENT if the response has no SOA record
+ * @retval -EINVAL if a resource record is malformed
+ */
+int dns_unpack_negative_ttl(struct dns_msg_t *dns_msg, uint32_t *ttl);
+
 /**
  * @brief Unpacks the header's response.
  *
@@ -27,6 +27,7 @@ LOG_MODULE_REGISTER(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 #include "dns_pack.h"
 #include "dns_internal.h"
 #include "dns_cache.h"
+#include "net_stats.h"
 
 #define DNS_SERVER_COUNT CONFIG_DNS_RESOLVER_MAX_SERVERS
 #define SERVER_COUNT     (DNS_SERVER_COUNT + DNS_MAX_MCAST_SERVERS)
@@ -72,6 +73,14 @@ NET_BUF_POOL_DEFINE(dns_qname_pool, DNS_RESOLVER_BUF_CTR, CONFIG_DNS_RESOLVER_MA
 DNS_CACHE_DEFINE(dns_cache, CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+/* Only one entry is refreshed at a time, the query name must stay valid
+ * while the query is pending.
+ */
+static char dns_prefetch_query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+static atomic_t dns_prefetch_active;
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
 static struct dns_resolve_context dns_default_ctx;
 
 /* Must be invoked with context lock held */
@@ -458,6 +467,83 @@ static inline int get_slot_by_id(struct dns_resolve_context *ctx,
 	return -ENOENT;
 }
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+static sa_family_t dns_query_type_to_family(enum dns_query_type type)
+{
+	if (type == DNS_QUERY_TYPE_A) {
+		return AF_INET;
+	}
+
+	if (type == DNS_QUERY_TYPE_AAAA) {
+		return AF_INET6;
+	}
+
+	return AF_UNSPEC;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+/* Must be invoked with context lock held */
+static int dns_validate_negative_msg(struct dns_resolve_context *ctx,
+				     struct dns_msg_t *dns_msg,
+				     uint16_t dns_id,
+				     int *query_idx,
+				     uint16_t *query_hash)
+{
+	const uint8_t *query_name;
+	const uint8_t *end;
+	int status;
+
+	/* A non-existent name applies to all the record types, while an
+	 * empty answer only applies to the type that was asked.
+	 */
+	if (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR) {
+		status = DNS_EAI_NONAME;
+	} else {
+		status = DNS_EAI_NODATA;
+	}
+
+	dns_msg->query_offset = DNS_MSG_HEADER_SIZE;
+	query_name = dns_msg->msg + dns_msg->query_offset;
+
+	end = memchr(query_name, 0, dns_msg->msg_size - dns_msg->query_offset);
+	if (end == NULL ||
+	    end + 1 + DNS_QTYPE_LEN + DNS_QCLASS_LEN > dns_msg->msg + dns_msg->msg_size) {
+		return DNS_EAI_FAIL;
+	}
+
+	dns_msg->answer_offset = end + 1 + DNS_QTYPE_LEN + DNS_QCLASS_LEN - dns_msg->msg;
+
+	/* Add \0 and query type (A or AAAA) to the hash */
+	*query_hash = crc16_ansi(query_name, end - query_name + 1 + 2);
+
+	*query_idx = get_slot_by_id(ctx, dns_id, *query_hash);
+	if (*query_idx < 0) {
+		return DNS_EAI_SYSTEM;
+	}
+
+#ifdef CONFIG_DNS_RESOLVER_CACHE_NEGATIVE
+	const char *query = ctx->queries[*query_idx].query;
+	sa_family_t family = AF_UNSPEC;
+	uint32_t ttl;
+
+	/* Negative answers without a SOA record are not cached, see
+	 * RFC 2308, 5. Caching Negative Answers.
+	 */
+	if (dns_unpack_negative_ttl(dns_msg, &ttl) == 0 && ttl > 0) {
+		if (status == DNS_EAI_NODATA) {
+			family = dns_query_type_to_family(ctx->queries[*query_idx].query_type);
+		}
+
+		ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_MAX_TTL);
+
+		dns_cache_remove_family(&dns_cache, query, family);
+		dns_cache_add_negative(&dns_cache, query, family, status, ttl);
+	}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_NEGATIVE */
+
+	return status;
+}
+
 /* Unit test needs to be able to call this function */
 #if !defined(CONFIG_NET_TEST)
 static
@@ -507,6 +593,24 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+	/* Name errors and empty answers are reported to the caller as such,
+	 * and cached if possible. mDNS responders do not send these. A
+	 * truncated response may have dropped the answers, so it is not
+	 * taken as a negative answer and fails below instead.
+	 */
+	if (*dns_id > 0 && dns_msg->msg_size >= DNS_MSG_HEADER_SIZE &&
+	    dns_header_opcode(dns_msg->msg) == DNS_QUERY &&
+	    dns_header_z(dns_msg->msg) == 0 &&
+	    !dns_header_tc(dns_msg->msg) &&
+	    dns_header_qdcount(dns_msg->msg) == 1 &&
+	    (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NAMEERROR ||
+	     (dns_header_rcode(dns_msg->msg) == DNS_HEADER_NOERROR &&
+	      dns_header_ancount(dns_msg->msg) == 0))) {
+		ret = dns_validate_negative_msg(ctx, dns_msg, *dns_id,
+						query_idx, query_hash);
+		goto quit;
+	}
+
 	ret = dns_unpack_response_header(dns_msg, *dns_id);
 	if (ret < 0) {
 		ret = DNS_EAI_FAIL;
@@ -634,6 +738,13 @@ query_known:
 			invoke_query_callback(DNS_EAI_INPROGRESS, &info,
 					      &ctx->queries[*query_idx]);
 #ifdef CONFIG_DNS_RESOLVER_CACHE
+			/* The answers replace the ones cached earlier */
+			if (items == 0) {
+				dns_cache_remove_family(&dns_cache,
+					ctx->queries[*query_idx].query,
+					info.ai_family);
+			}
+
 			dns_cache_add(&dns_cache,
 				ctx->queries[*query_idx].query, &info, ttl);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
@@ -1109,13 +1220,72 @@ static void query_timeout(struct k_work *work)
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
-int dns_resolve_name(struct dns_resolve_context *ctx,
-		     const char *query,
-		     enum dns_query_type type,
-		     uint16_t *dns_id,
-		     dns_resolve_cb_t cb,
-		     void *user_data,
-		     int32_t timeout)
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+static void dns_prefetch_cb(enum dns_resolve_status status,
+			    struct dns_addrinfo *info,
+			    void *user_data)
+{
+	ARG_UNUSED(info);
+	ARG_UNUSED(user_data);
+
+	if (status == DNS_EAI_INPROGRESS) {
+		return;
+	}
+
+	if (status != DNS_EAI_ALLDONE) {
+		dns_cache_refresh_abort(&dns_cache, dns_prefetch_query);
+	}
+
+	atomic_clear(&dns_prefetch_active);
+}
+
+static int dns_resolve_name_internal(struct dns_resolve_context *ctx,
+				     const char *query,
+				     enum dns_query_type type,
+				     uint16_t *dns_id,
+				     dns_resolve_cb_t cb,
+				     void *user_data,
+				     int32_t timeout,
+				     bool use_cache);
+
+/* Query again a cached name before its entries expire, the answers update
+ * the cache when they arrive.
+ */
+static void dns_prefetch(struct dns_resolve_context *ctx, const char *query,
+			 enum dns_query_type type, int32_t timeout)
+{
+	int ret;
+
+	if (!atomic_cas(&dns_prefetch_active, 0, 1)) {
+		/* Another name is being prefetched, try again on next use */
+		dns_cache_refresh_abort(&dns_cache, query);
+		return;
+	}
+
+	strncpy(dns_prefetch_query, query, sizeof(dns_prefetch_query) - 1);
+	dns_prefetch_query[sizeof(dns_prefetch_query) - 1] = '\0';
+
+	ret = dns_resolve_name_internal(ctx, dns_prefetch_query, type, NULL,
+					dns_prefetch_cb, NULL, timeout, false);
+	if (ret < 0) {
+		NET_DBG("Cannot prefetch \"%s\" (%d)", query, ret);
+		dns_cache_refresh_abort(&dns_cache, query);
+		atomic_clear(&dns_prefetch_active);
+		return;
+	}
+
+	net_stats_update_dns_cache_prefetch();
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
+static int dns_resolve_name_internal(struct dns_resolve_context *ctx,
+				     const char *query,
+				     enum dns_query_type type,
+				     uint16_t *dns_id,
+				     dns_resolve_cb_t cb,
+				     void *user_data,
+				     int32_t timeout,
+				     bool use_cache)
 {
 	k_timeout_t tout;
 	struct net_buf *dns_data = NULL;
@@ -1127,6 +1297,7 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	uint8_t hop_limit;
 #ifdef CONFIG_DNS_RESOLVER_CACHE
 	struct dns_addrinfo cached_info[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES] = {0};
+	bool refresh;
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
 	if (!ctx || !query || !cb) {
@@ -1190,18 +1361,44 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 
 try_resolve:
 #ifdef CONFIG_DNS_RESOLVER_CACHE
-	ret = dns_cache_find(&dns_cache, query, cached_info, sizeof(cached_info));
+	if (!use_cache) {
+		goto skip_cache;
+	}
+
+	ret = dns_cache_lookup(&dns_cache, query, dns_query_type_to_family(type),
+			       cached_info, ARRAY_SIZE(cached_info), &refresh);
 	if (ret > 0) {
 		/* The query was cached, no
 		 * need to continue further.
 		 */
+		net_stats_update_dns_cache_hit();
+
 		for (size_t cache_index = 0; cache_index < ret; cache_index++) {
 			cb(DNS_EAI_INPROGRESS, &cached_info[cache_index], user_data);
 		}
 		cb(DNS_EAI_ALLDONE, NULL, user_data);
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE_PREFETCH
+		if (refresh) {
+			dns_prefetch(ctx, query, type, timeout);
+		}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
+		return 0;
+	}
+
+	ret = dns_cache_find_negative(&dns_cache, query, dns_query_type_to_family(type));
+	if (ret < 0) {
+		net_stats_update_dns_cache_negative_hit();
+
+		cb(ret, NULL, user_data);
+
 		return 0;
 	}
+
+	net_stats_update_dns_cache_miss();
+
+skip_cache:
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
 	k_mutex_lock(&ctx->lock, K_FOREVER);
@@ -1346,6 +1543,18 @@ fail:
 	return ret;
 }
 
+int dns_resolve_name(struct dns_resolve_context *ctx,
+		     const char *query,
+		     enum dns_query_type type,
+		     uint16_t *dns_id,
+		     dns_resolve_cb_t cb,
+		     void *user_data,
+		     int32_t timeout)
+{
+	return dns_resolve_name_internal(ctx, query, type, dns_id, cb,
+					 user_data, timeout, true);
+}
+
 /* Must be invoked with context lock held */
 static int dns_resolve_close_locked(struct dns_resolve_context *ctx)
 {
@@ -25,6 +25,9 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+#if CONFIG_MQTT_PUBLISH_INFLIGHT_WINDOW > 0
+	client->internal.inflight_count = 0U;
+#endif
 }
 
 /** @brief Initialize tx buffer. */
@@ -236,6 +239,56 @@ static int verify_tx_state(const struct mqtt_client *client)
 	return 0;
 }
 
+#if CONFIG_MQTT_PUBLISH_INFLIGHT_WINDOW > 0
+static int inflight_acquire(struct mqtt_client *client,
+			    const struct mqtt_publish_param *param)
+{
+	struct mqtt_internal *internal = &client->internal;
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return 0;
+	}
+
+	/* A retransmission keeps the slot of the original message. */
+	for (int i = 0; i < internal->inflight_count; i++) {
+		if (internal->inflight[i] == param->message_id) {
+			return 0;
+		}
+	}
+
+	if (internal->inflight_count >= CONFIG_MQTT_PUBLISH_INFLIGHT_WINDOW) {
+		NET_DBG("[CID %p]: In-flight window full", client);
+		return -EAGAIN;
+	}
+
+	internal->inflight[internal->inflight_count++] = param->message_id;
+
+	return 0;
+}
+
+void mqtt_inflight_release(struct mqtt_client *client, uint16_t message_id)
+{
+	struct mqtt_internal *internal = &client->internal;
+
+	for (int i = 0; i < internal->inflight_count; i++) {
+		if (internal->inflight[i] == message_id) {
+			internal->inflight[i] =
+				internal->inflight[--internal->inflight_count];
+			return;
+		}
+	}
+}
+#else
+static inline int inflight_acquire(struct mqtt_client *client,
+				   const struct mqtt_publish_param *param)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(param);
+
+	return 0;
+}
+#endif /* CONFIG_MQTT_PUBLISH_INFLIGHT_WINDOW > 0 */
+
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param)
 {
@@ -266,6 +319,11 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
+	err_code = inflight_acquire(client, param);
+	if (err_code < 0) {
+		goto error;
+	}
+
 	io_vector[0].iov_base = packet.cur;
 	io_vector[0].iov_len = packet.end - packet.cur;
 	io_vector[1].iov_base = param->message.payload.data;
@@ -287,6 +345,90 @@ error:
 	return err_code;
 }
 
+int mqtt_publish_batch(struct mqtt_client *client,
+		       const struct mqtt_publish_param *params, size_t count)
+{
+	int err_code;
+	struct buf_ctx packet;
+	struct iovec io_vector[2 * CONFIG_MQTT_PUBLISH_BATCH_MAX];
+	struct msghdr msg;
+	size_t iovcnt = 0;
+	size_t sent;
+	uint8_t *end;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(params);
+
+	if (count == 0) {
+		return -EINVAL;
+	}
+
+	count = MIN(count, CONFIG_MQTT_PUBLISH_BATCH_MAX);
+
+	NET_DBG("[CID %p]:[State 0x%02x]: >> Batch of %zu messages",
+		 client, client->internal.state, count);
+
+	mqtt_mutex_lock(client);
+
+	tx_buf_init(client, &packet);
+	end = packet.end;
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	for (sent = 0; sent < count; sent++) {
+		const struct mqtt_publish_param *param = &params[sent];
+
+		err_code = publish_encode(param, &packet);
+		if (err_code < 0) {
+			break;
+		}
+
+		err_code = inflight_acquire(client, param);
+		if (err_code < 0) {
+			break;
+		}
+
+		io_vector[iovcnt].iov_base = packet.cur;
+		io_vector[iovcnt].iov_len = packet.end - packet.cur;
+		iovcnt++;
+
+		if (param->message.payload.len > 0) {
+			io_vector[iovcnt].iov_base = param->message.payload.data;
+			io_vector[iovcnt].iov_len = param->message.payload.len;
+			iovcnt++;
+		}
+
+		/* Encode the next header right after this one. */
+		packet.cur = packet.end;
+		packet.end = end;
+	}
+
+	if (sent == 0) {
+		goto error;
+	}
+
+	memset(&msg, 0, sizeof(msg));
+
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = iovcnt;
+
+	err_code = client_write_msg(client, &msg);
+	if (err_code == 0) {
+		err_code = sent;
+	}
+
+error:
+	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
+			 client, client->internal.state, err_code);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
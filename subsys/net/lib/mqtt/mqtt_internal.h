@@ -154,6 +154,22 @@ enum mqtt_state {
  */
 void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
 
+#if CONFIG_MQTT_PUBLISH_INFLIGHT_WINDOW > 0
+/**@brief Releases the in-flight window slot of an acknowledged publish.
+ *
+ * @param[in] client Identifies the client for which the ack was received.
+ * @param[in] message_id Message ID of the acknowledged publish.
+ */
+void mqtt_inflight_release(struct mqtt_client *client, uint16_t message_id);
+#else
+static inline void mqtt_inflight_release(struct mqtt_client *client,
+					 uint16_t message_id)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(message_id);
+}
+#endif
+
 /**@brief Handles MQTT messages received from the peer.
  *
  * @param[in] client Identifies the client for which the data was received.
@@ -249,6 +249,206 @@ static int cmd_net_capture_disable(const struct shell *sh, size_t argc, char *ar
 	return 0;
 }
 
+#if defined(CONFIG_NET_CAPTURE_RING)
+struct ring_dump_data {
+	const struct shell *sh;
+	int column;
+};
+
+static int ring_dump_cb(const void *data, size_t len, void *user_data)
+{
+	struct ring_dump_data *dump = user_data;
+	const struct shell *sh = dump->sh;
+	const uint8_t *ptr = data;
+
+	for (size_t i = 0; i < len; i++) {
+		PR("%02x", ptr[i]);
+
+		if (++dump->column == 32) {
+			PR("\n");
+			dump->column = 0;
+		}
+	}
+
+	return 0;
+}
+#endif
+
+static int cmd_net_capture_ring(const struct shell *sh, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+	struct net_capture_ring_stats stats;
+
+	net_capture_ring_get_stats(&stats);
+
+	PR_INFO("Network packet capture ring %s\n",
+		net_capture_ring_is_enabled() ? "enabled" : "disabled");
+	PR("Captured %u, dropped %u, stored %u of %d packets\n",
+	   stats.captured, stats.dropped, stats.stored,
+	   CONFIG_NET_CAPTURE_RING_PKT_COUNT);
+#else
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "network packet capture ring");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_capture_ring_start(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_CAPTURE_RING)
+	struct net_capture_ring_filter filter = { 0 };
+	int ret, arg = 1, if_index;
+
+	if (argc > arg) {
+		if_index = atoi(argv[arg++]);
+		if (if_index != 0) {
+			filter.iface = net_if_get_by_index(if_index);
+			if (filter.iface == NULL) {
+				PR_WARNING("No such interface with index %d\n", if_index);
+				return -ENOEXEC;
+			}
+		}
+	}
+
+	if (argc > arg) {
+		filter.snaplen = atoi(argv[arg++]);
+	}
+
+	if (argc > arg) {
+		filter.ptype = strtol(argv[arg++], NULL, 0);
+	}
+
+	ret = net_capture_ring_start(&filter);
+	if (ret < 0) {
+		PR_WARNING("Capture %s failed (%d)\n", "start", ret);
+		return -ENOEXEC;
+	}
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "network packet capture ring");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_capture_ring_stop(const struct shell *sh, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+	(void)net_capture_ring_stop();
+#else
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "network packet capture ring");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_capture_ring_clear(const struct shell *sh, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+	int ret;
+
+	ret = net_capture_ring_clear();
+	if (ret < 0) {
+		PR_WARNING("Capture %s failed (%d)\n", "clear", ret);
+		return -ENOEXEC;
+	}
+#else
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "network packet capture ring");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_capture_ring_dump(const struct shell *sh, size_t argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_NET_CAPTURE_RING)
+	struct ring_dump_data dump = {
+		.sh = sh,
+	};
+	int ret;
+
+	ret = net_capture_ring_export(ring_dump_cb, &dump);
+	if (dump.column != 0) {
+		PR("\n");
+	}
+
+	if (ret < 0) {
+		PR_WARNING("Capture %s failed (%d)\n", "dump", ret);
+		return -ENOEXEC;
+	}
+#else
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "network packet capture ring");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_capture_ring_save(const struct shell *sh, size_t argc, char *argv[])
+{
+#if defined(CONFIG_NET_CAPTURE_RING)
+	int ret;
+
+	if (argc < 2) {
+		PR_WARNING("File name is missing.\n");
+		return -ENOEXEC;
+	}
+
+	ret = net_capture_ring_save(argv[1]);
+	if (ret < 0) {
+		PR_WARNING("Capture %s failed (%d)\n", "save", ret);
+		return -ENOEXEC;
+	}
+
+	PR_INFO("Saved %d packets to %s\n", ret, argv[1]);
+#else
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_NET_CAPTURE_RING", "network packet capture ring");
+#endif
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture_ring,
+	SHELL_CMD(start, NULL, "Start recording packets into the capture ring.\n"
+		  "'net capture ring start [<interface index> [<snaplen> [<ptype>]]]'\n"
+		  "Interface index 0 captures all interfaces, <ptype> is the\n"
+		  "link layer protocol to capture, like 0x0800 for IPv4",
+		  cmd_net_capture_ring_start),
+	SHELL_CMD(stop, NULL, "Stop recording packets.",
+		  cmd_net_capture_ring_stop),
+	SHELL_CMD(clear, NULL, "Discard the recorded packets.",
+		  cmd_net_capture_ring_clear),
+	SHELL_CMD(dump, NULL, "Print the recorded packets in pcapng format as hex.\n"
+		  "The output can be converted with 'xxd -r -p'",
+		  cmd_net_capture_ring_dump),
+	SHELL_CMD(save, NULL, "Save the recorded packets in pcapng format.\n"
+		  "'net capture ring save <file>'",
+		  cmd_net_capture_ring_save),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture,
 	SHELL_CMD(setup, NULL, "Setup network packet capture.\n"
 		  "'net capture setup <remote-ip-addr> <local-addr> <peer-addr>'\n"
@@ -266,6 +466,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_capture,
 		  cmd_net_capture_enable),
 	SHELL_CMD(disable, NULL, "Disable network packet capture.",
 		  cmd_net_capture_disable),
+	SHELL_CMD(ring, &net_cmd_capture_ring, "Show the capture ring status.",
+		  cmd_net_capture_ring),
 	SHELL_SUBCMD_SET_END
 );
 
@@ -516,6 +516,17 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, udp.chkerr));
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_DNS) && defined(CONFIG_NET_NATIVE)
+	/* The DNS resolver statistics are only kept globally */
+	if (iface == NULL) {
+		PR("DNS cache hit  %d\tneghit\t%d\tmiss\t%d\tprefetch\t%d\n",
+		   GET_STAT(iface, dns.cache_hit),
+		   GET_STAT(iface, dns.cache_negative_hit),
+		   GET_STAT(iface, dns.cache_miss),
+		   GET_STAT(iface, dns.cache_prefetch));
+	}
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_TCP) && defined(CONFIG_NET_NATIVE_TCP)
 	PR("TCP bytes recv %u\tsent\t%d\tresent\t%d\n",
 	   GET_STAT(iface, tcp.bytes.received),
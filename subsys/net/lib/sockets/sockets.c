@@ -151,6 +151,8 @@ static void zsock_flush_queue(struct net_context *ctx)
 
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
+
+	zsock_epoll_notify(ctx);
 }
 
 #if defined(CONFIG_NET_NATIVE)
@@ -254,6 +256,8 @@ static inline int z_vrfy_zsock_socket(int family, int type, int proto)
 
 int zsock_close_ctx(struct net_context *ctx)
 {
+	zsock_epoll_ctx_close(ctx);
+
 	/* Reset callbacks to avoid any race conditions while
 	 * flushing queues. No need to check return values here,
 	 * as these are fail-free operations and we're closing
@@ -374,6 +378,8 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		net_context_ref(new_ctx);
 
 		(void)k_condvar_signal(&parent->cond.recv);
+
+		zsock_epoll_notify(parent);
 	}
 
 }
@@ -428,6 +434,8 @@ unlock:
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
 
+	zsock_epoll_notify(ctx);
+
 	if (ctx->cond.lock) {
 		(void)k_mutex_unlock(ctx->cond.lock);
 	}
@@ -1027,6 +1035,81 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	/* Look up and lock the socket once for the whole batch */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		sock_obj_core_update_send_stats(sock, ret);
+	}
+
+	k_mutex_unlock(lock);
+
+	/* As on Linux, an error is only reported if nothing was sent */
+	if (i == 0U && ret < 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int i;
+	ssize_t ret = 0;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	/* Every message needs to be copied from user space anyway, so reuse
+	 * the sendmsg() verification for each of them.
+	 */
+	for (i = 0; i < vlen; i++) {
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	if (i == 0U && ret < 0) {
+		return -1;
+	}
+
+	return i;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -2020,6 +2103,369 @@ fail:
 #include <syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static inline int recvmmsg_next_flags(int flags)
+{
+	/* After the first message, only collect what is already queued */
+	if (flags & ZSOCK_MSG_WAITFORONE) {
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	return flags & ~ZSOCK_MSG_WAITFORONE;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags,
+			  struct timespec *timeout)
+{
+	const struct socket_op_vtable *vtable;
+	k_timepoint_t end = sys_timepoint_calc(K_FOREVER);
+	int msg_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (timeout != NULL) {
+		end = sys_timepoint_calc(K_USEC(timeout->tv_sec * USEC_PER_SEC +
+						timeout->tv_nsec / NSEC_PER_USEC));
+	}
+
+	/* Look up and lock the socket once for the whole batch */
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->recvmsg(obj, &msgvec[i].msg_hdr, msg_flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		sock_obj_core_update_recv_stats(sock, ret);
+
+		if (sys_timepoint_expired(end)) {
+			i++;
+			break;
+		}
+
+		msg_flags = recvmmsg_next_flags(flags);
+	}
+
+	k_mutex_unlock(lock);
+
+	/* As on Linux, an error is only reported if nothing was received */
+	if (i == 0U && ret < 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags,
+					struct timespec *timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(K_FOREVER);
+	int msg_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+	struct timespec timeout_copy;
+	unsigned int i;
+	ssize_t ret = 0;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	if (timeout != NULL) {
+		K_OOPS(k_usermode_from_copy(&timeout_copy, timeout,
+					    sizeof(timeout_copy)));
+		end = sys_timepoint_calc(
+			K_USEC(timeout_copy.tv_sec * USEC_PER_SEC +
+			       timeout_copy.tv_nsec / NSEC_PER_USEC));
+	}
+
+	/* Every message needs to be copied to user space anyway, so reuse
+	 * the recvmsg() verification for each of them.
+	 */
+	for (i = 0; i < vlen; i++) {
+		ret = z_vrfy_zsock_recvmsg(sock, &msgvec[i].msg_hdr, msg_flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		if (sys_timepoint_expired(end)) {
+			i++;
+			break;
+		}
+
+		msg_flags = recvmmsg_next_flags(flags);
+	}
+
+	if (i == 0U && ret < 0) {
+		return -1;
+	}
+
+	return i;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Point the loan at the unread data of the packet, one entry per fragment,
+ * and move the packet cursor past the lent data.
+ */
+static size_t recv_loan_fill(struct net_pkt *pkt, struct zsock_recv_loan *loan)
+{
+	struct net_buf *frag = pkt->cursor.buf;
+	uint8_t *pos = pkt->cursor.pos;
+	size_t iovlen = 0;
+	size_t len = 0;
+
+	while (frag != NULL && iovlen < loan->iovlen) {
+		size_t frag_len = frag->len - (pos - frag->data);
+
+		if (frag_len > 0) {
+			loan->iov[iovlen].iov_base = pos;
+			loan->iov[iovlen].iov_len = frag_len;
+			len += frag_len;
+			iovlen++;
+		}
+
+		frag = frag->frags;
+		pos = frag != NULL ? frag->data : NULL;
+	}
+
+	loan->iovlen = iovlen;
+
+	pkt->cursor.buf = frag;
+	pkt->cursor.pos = pos;
+
+	return len;
+}
+
+static ssize_t zsock_recv_loan_ctx(struct net_context *ctx,
+				   struct zsock_recv_loan *loan, int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	k_timepoint_t end;
+	size_t len;
+	int ret;
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+	} else if (sock_type != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	for (end = sys_timepoint_calc(timeout); ; timeout = sys_timepoint_timeout(end)) {
+		if (sock_type == SOCK_STREAM) {
+			if (sock_is_error(ctx)) {
+				errno = POINTER_TO_INT(ctx->user_data);
+				return -1;
+			}
+
+			if (sock_is_eof(ctx)) {
+				loan->iovlen = 0;
+				return 0;
+			}
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (pkt != NULL) {
+			if (sock_type != SOCK_STREAM ||
+			    net_pkt_remaining_data(pkt) > 0) {
+				break;
+			}
+
+			/* Nothing to lend from a segment without data, e.g. FIN */
+			pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+			if (net_pkt_eof(pkt)) {
+				sock_set_eof(ctx);
+			}
+
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			errno = EAGAIN;
+			return -1;
+		}
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	len = recv_loan_fill(pkt, loan);
+
+	if (sock_type == SOCK_STREAM && net_pkt_remaining_data(pkt) > 0) {
+		/* The rest of the segment stays queued for the next call */
+		net_pkt_ref(pkt);
+	} else {
+		/* The loan takes over the reference held by the queue */
+		(void)k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+
+		if (net_pkt_remaining_data(pkt) > 0) {
+			loan->msg_flags |= ZSOCK_MSG_TRUNC;
+		}
+
+		if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, len);
+	}
+
+	loan->handle = pkt;
+
+	return len;
+}
+
+ssize_t z_impl_zsock_recv_loan(int sock, struct zsock_recv_loan *loan,
+			       int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t ret;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Only native sockets keep the received data in network buffers */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (loan->iov == NULL || loan->iovlen == 0 || (flags & ZSOCK_MSG_PEEK)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	loan->msg_flags = 0;
+	loan->handle = NULL;
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_loan_ctx(obj, loan, flags);
+
+	k_mutex_unlock(lock);
+
+	if (ret >= 0) {
+		sock_obj_core_update_recv_stats(sock, ret);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline ssize_t z_vrfy_zsock_recv_loan(int sock,
+					     struct zsock_recv_loan *loan,
+					     int flags)
+{
+	struct zsock_recv_loan loan_copy;
+	struct msghdr msg = { 0 };
+	struct iovec iov;
+	ssize_t ret;
+
+	K_OOPS(k_usermode_from_copy(&loan_copy, loan, sizeof(loan_copy)));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(loan_copy.iov, loan_copy.iovlen,
+					    sizeof(struct iovec)));
+
+	if (loan_copy.iovlen == 0 || (flags & ZSOCK_MSG_PEEK)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (K_SYSCALL_MEMORY_WRITE(loan_copy.buf, loan_copy.buf_len)) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	/* The network buffers cannot be handed to a user thread, so copy the
+	 * data to the caller's buffer and lend that one instead. Receiving
+	 * through a message reports the truncation of datagrams.
+	 */
+	iov.iov_base = loan_copy.buf;
+	iov.iov_len = loan_copy.buf_len;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+
+	ret = z_impl_zsock_recvmsg(sock, &msg, flags);
+	if (ret < 0) {
+		return -1;
+	}
+
+	iov.iov_base = loan_copy.buf;
+	iov.iov_len = ret;
+	K_OOPS(k_usermode_to_copy(loan_copy.iov, &iov, sizeof(iov)));
+
+	loan_copy.iovlen = 1;
+	loan_copy.msg_flags = msg.msg_flags;
+	loan_copy.handle = NULL;
+	K_OOPS(k_usermode_to_copy(loan, &loan_copy, sizeof(loan_copy)));
+
+	return ret;
+}
+#include <syscalls/zsock_recv_loan_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+void z_impl_zsock_recv_loan_release(struct zsock_recv_loan *loan)
+{
+	if (loan->handle != NULL) {
+		net_pkt_unref(loan->handle);
+		loan->handle = NULL;
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_zsock_recv_loan_release(struct zsock_recv_loan *loan)
+{
+	struct zsock_recv_loan loan_copy;
+
+	/* Loans made to user threads never reference network buffers */
+	K_OOPS(k_usermode_from_copy(&loan_copy, loan, sizeof(loan_copy)));
+	K_OOPS(loan_copy.handle != NULL);
+}
+#include <syscalls/zsock_recv_loan_release_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2194,6 +2640,60 @@ static int zsock_poll_update_ctx(struct net_context *ctx,
 	return 0;
 }
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+static inline bool zsock_is_native_tcp(struct net_context *ctx)
+{
+	return IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+	       net_context_get_type(ctx) == SOCK_STREAM &&
+	       !net_if_is_ip_offloaded(net_context_get_iface(ctx));
+}
+
+int zsock_poll_events_ctx(struct net_context *ctx)
+{
+	int revents = 0;
+
+	if (!k_fifo_is_empty(&ctx->recv_q) || sock_is_eof(ctx)) {
+		revents |= ZSOCK_POLLIN;
+	}
+
+	if (zsock_is_native_tcp(ctx)) {
+		if (!sock_is_eof(ctx) &&
+		    net_context_get_state(ctx) == NET_CONTEXT_CONNECTED &&
+		    k_sem_count_get(net_tcp_tx_sem_get(ctx)) > 0) {
+			revents |= ZSOCK_POLLOUT;
+		}
+	} else {
+		revents |= ZSOCK_POLLOUT;
+	}
+
+	if (sock_is_error(ctx)) {
+		revents |= ZSOCK_POLLERR;
+	}
+
+	if (sock_is_eof(ctx)) {
+		revents |= ZSOCK_POLLHUP;
+	}
+
+	return revents;
+}
+
+struct k_sem *zsock_poll_tx_sem_ctx(struct net_context *ctx)
+{
+	if (!zsock_is_native_tcp(ctx) || sock_is_eof(ctx)) {
+		return NULL;
+	}
+
+	switch (net_context_get_state(ctx)) {
+	case NET_CONTEXT_CONNECTING:
+		return net_tcp_conn_sem_get(ctx);
+	case NET_CONTEXT_CONNECTED:
+		return net_tcp_tx_sem_get(ctx);
+	default:
+		return NULL;
+	}
+}
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
+
 static inline int time_left(uint32_t start, uint32_t timeout)
 {
 	uint32_t elapsed = k_uptime_get_32() - start;
@@ -2611,6 +3111,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
@@ -3148,6 +3662,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
@@ -0,0 +1,556 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Socket event queue (epoll).
+ *
+ * Every registration of a socket is an item that is linked both to the
+ * socket (so that the socket can find the queues interested in it) and,
+ * while it may have something to report, to the ready list of its queue.
+ * Sockets put their items on the ready list when their readiness changes,
+ * so zsock_epoll_wait() only looks at the ready list and idle sockets cost
+ * nothing. Items stay on the ready list while they are level-triggered and
+ * ready, and while they wait for ZSOCK_EPOLLOUT as native TCP sockets do
+ * not signal send window changes.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/math_extras.h>
+
+#include "sockets_internal.h"
+
+#define EPOLL_ALWAYS_EVENTS (ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+#define EPOLL_READY_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT | EPOLL_ALWAYS_EVENTS)
+
+extern const struct socket_op_vtable sock_fd_op_vtable;
+
+struct epoll_queue;
+
+struct epoll_item {
+	/* Link in the registrations list of the socket */
+	sys_snode_t ctx_node;
+	/* Link in the ready list of the queue */
+	sys_dnode_t ready_node;
+	struct epoll_queue *queue;
+	struct net_context *ctx;
+	struct zsock_epoll_event event;
+	/* Socket was signalled since the item was last reported */
+	bool pending;
+	/* Socket was writable when the item was last checked */
+	bool writable;
+};
+
+struct epoll_queue {
+	sys_dlist_t ready;
+	struct k_poll_signal signal;
+	bool in_use;
+};
+
+static struct epoll_queue epoll_queues[CONFIG_NET_SOCKETS_EPOLL_MAX];
+static struct epoll_item epoll_items[CONFIG_NET_SOCKETS_EPOLL_MAX_ITEMS];
+
+/* Protects the items, the ready lists and the socket registration lists.
+ * It is only held for short non-blocking sections, so one lock for all
+ * the queues is enough.
+ */
+static struct k_spinlock epoll_lock;
+
+static const struct fd_op_vtable epoll_fd_vtable;
+
+static void item_queue(struct epoll_item *item)
+{
+	item->pending = true;
+
+	if (!sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_append(&item->queue->ready, &item->ready_node);
+	}
+}
+
+static void item_free(struct epoll_item *item)
+{
+	if (sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+
+	(void)sys_slist_find_and_remove(&item->ctx->epoll_items,
+					&item->ctx_node);
+
+	item->queue = NULL;
+	item->ctx = NULL;
+}
+
+static struct epoll_item *item_find(struct epoll_queue *queue,
+				    struct net_context *ctx)
+{
+	struct epoll_item *item;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		if (item->queue == queue) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+void zsock_epoll_notify(struct net_context *ctx)
+{
+	struct epoll_queue *signalled = NULL;
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&ctx->epoll_items, item, ctx_node) {
+		if ((item->event.events & EPOLL_READY_EVENTS) == 0U) {
+			/* Disabled one-shot registration */
+			continue;
+		}
+
+		item_queue(item);
+
+		if (signalled != item->queue) {
+			k_poll_signal_raise(&item->queue->signal, 0);
+			signalled = item->queue;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+void zsock_epoll_ctx_close(struct net_context *ctx)
+{
+	sys_snode_t *node;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&epoll_lock);
+
+	while ((node = sys_slist_peek_head(&ctx->epoll_items)) != NULL) {
+		item_free(CONTAINER_OF(node, struct epoll_item, ctx_node));
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+}
+
+static int epoll_close_vmeth(void *obj)
+{
+	struct epoll_queue *queue = obj;
+	k_spinlock_key_t key;
+	int i;
+
+	key = k_spin_lock(&epoll_lock);
+
+	for (i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+		if (epoll_items[i].queue == queue) {
+			item_free(&epoll_items[i]);
+		}
+	}
+
+	queue->in_use = false;
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return 0;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable epoll_fd_vtable = {
+	.close = epoll_close_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
+
+int z_impl_zsock_epoll_create1(int flags)
+{
+	struct epoll_queue *queue = NULL;
+	k_spinlock_key_t key;
+	int fd;
+	int i;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	for (i = 0; i < ARRAY_SIZE(epoll_queues); i++) {
+		if (!epoll_queues[i].in_use) {
+			queue = &epoll_queues[i];
+			queue->in_use = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	if (queue == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	sys_dlist_init(&queue->ready);
+	k_poll_signal_init(&queue->signal);
+
+	z_finalize_fd(fd, queue, &epoll_fd_vtable);
+
+	NET_DBG("epoll: queue=%p, fd=%d", queue, fd);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create1(int flags)
+{
+	return z_impl_zsock_epoll_create1(flags);
+}
+#include <syscalls/zsock_epoll_create1_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static struct net_context *epoll_get_ctx(int fd)
+{
+	struct net_context *ctx;
+
+	ctx = z_get_fd_obj(fd, (const struct fd_op_vtable *)&sock_fd_op_vtable,
+			   EPERM);
+
+#ifdef CONFIG_USERSPACE
+	if (ctx != NULL && k_is_in_user_syscall() &&
+	    !k_object_is_valid(ctx, K_OBJ_NET_SOCKET)) {
+		errno = EBADF;
+		ctx = NULL;
+	}
+#endif /* CONFIG_USERSPACE */
+
+	return ctx;
+}
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	struct epoll_queue *queue;
+	struct epoll_item *item;
+	struct net_context *ctx;
+	k_spinlock_key_t key;
+	int ret = 0;
+	int i;
+
+	queue = z_get_fd_obj(epfd, &epoll_fd_vtable, EINVAL);
+	if (queue == NULL) {
+		return -1;
+	}
+
+	ctx = epoll_get_ctx(fd);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if (op != ZSOCK_EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	key = k_spin_lock(&epoll_lock);
+
+	item = item_find(queue, ctx);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		for (i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+			if (epoll_items[i].queue == NULL) {
+				item = &epoll_items[i];
+				break;
+			}
+		}
+
+		if (item == NULL) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		item->queue = queue;
+		item->ctx = ctx;
+		item->writable = false;
+		sys_dnode_init(&item->ready_node);
+		sys_slist_append(&ctx->epoll_items, &item->ctx_node);
+
+		__fallthrough;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		item->event = *event;
+		item->event.events |= EPOLL_ALWAYS_EVENTS;
+
+		/* Let the next wait find out the current state */
+		item_queue(item);
+		k_poll_signal_raise(&queue->signal, 0);
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		item_free(item);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	NET_DBG("epoll ctl: queue=%p, op=%d, ctx=%p, fd=%d, ret=%d",
+		queue, op, ctx, fd, ret);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (op == ZSOCK_EPOLL_CTL_DEL || event == NULL) {
+		return z_impl_zsock_epoll_ctl(epfd, op, fd, event);
+	}
+
+	K_OOPS(k_usermode_from_copy(&event_copy, event, sizeof(event_copy)));
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, &event_copy);
+}
+#include <syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Check the ready list once and store what is to be reported. Items that
+ * have to be looked at again by the next call are rotated to the tail of
+ * the list, so that a busy socket cannot starve the others.
+ */
+static int epoll_collect(struct epoll_queue *queue,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	sys_dlist_t again;
+	sys_dnode_t *node;
+	k_spinlock_key_t key;
+	int count = 0;
+
+	sys_dlist_init(&again);
+
+	key = k_spin_lock(&epoll_lock);
+
+	while (count < maxevents &&
+	       (node = sys_dlist_get(&queue->ready)) != NULL) {
+		struct epoll_item *item =
+			CONTAINER_OF(node, struct epoll_item, ready_node);
+		uint32_t interest = item->event.events;
+		uint32_t revents, report;
+
+		revents = zsock_poll_events_ctx(item->ctx) & interest;
+
+		if (interest & ZSOCK_EPOLLET) {
+			report = item->pending ? revents :
+				 revents & ZSOCK_EPOLLOUT;
+
+			if (item->writable && !item->pending) {
+				/* Still writable, nothing changed */
+				report &= ~ZSOCK_EPOLLOUT;
+			}
+		} else {
+			report = revents;
+		}
+
+		item->pending = false;
+		item->writable = (revents & ZSOCK_EPOLLOUT) != 0U;
+
+		if (report != 0U) {
+			events[count].events = report;
+			events[count].data = item->event.data;
+			count++;
+
+			if (interest & ZSOCK_EPOLLONESHOT) {
+				item->event.events &= ~EPOLL_READY_EVENTS;
+				continue;
+			}
+		}
+
+		if (((interest & ZSOCK_EPOLLET) == 0U && revents != 0U) ||
+		    (interest & ZSOCK_EPOLLOUT)) {
+			sys_dlist_append(&again, node);
+		}
+	}
+
+	while ((node = sys_dlist_get(&again)) != NULL) {
+		sys_dlist_append(&queue->ready, node);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return count;
+}
+
+/* Build the events to sleep on: the queue signal and the transmit
+ * semaphores of the TCP sockets that wait to become writable.
+ */
+static int epoll_prepare_sleep(struct epoll_queue *queue,
+			       struct k_poll_event *poll_events, int max)
+{
+	struct epoll_item *item;
+	k_spinlock_key_t key;
+	int count = 0;
+
+	k_poll_event_init(&poll_events[count++], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &queue->signal);
+
+	key = k_spin_lock(&epoll_lock);
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&queue->ready, item, ready_node) {
+		struct k_sem *sem;
+
+		if (count == max) {
+			break;
+		}
+
+		if ((item->event.events & ZSOCK_EPOLLOUT) == 0U ||
+		    item->writable) {
+			continue;
+		}
+
+		sem = zsock_poll_tx_sem_ctx(item->ctx);
+		if (sem == NULL) {
+			continue;
+		}
+
+		k_poll_event_init(&poll_events[count++],
+				  K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, sem);
+	}
+
+	k_spin_unlock(&epoll_lock, key);
+
+	return count;
+}
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct k_poll_event poll_events[1 + CONFIG_NET_SOCKETS_EPOLL_WAIT_WRITERS];
+	struct epoll_queue *queue;
+	k_timepoint_t end;
+	int count;
+	int ret;
+
+	queue = z_get_fd_obj(epfd, &epoll_fd_vtable, EINVAL);
+	if (queue == NULL) {
+		return -1;
+	}
+
+	if (maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	do {
+		/* Reset before looking at the sockets, so that anything
+		 * signalled from now on wakes up the sleep below.
+		 */
+		k_poll_signal_reset(&queue->signal);
+
+		count = epoll_collect(queue, events, maxevents);
+		if (count > 0) {
+			return count;
+		}
+
+		ret = epoll_prepare_sleep(queue, poll_events,
+					  ARRAY_SIZE(poll_events));
+
+		ret = k_poll(poll_events, ret, sys_timepoint_timeout(end));
+		if (ret < 0 && ret != -EAGAIN) {
+			errno = -ret;
+			return -1;
+		}
+	} while (ret == 0);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd,
+					  struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	struct zsock_epoll_event *events_copy;
+	size_t events_size;
+	int ret;
+
+	if (maxevents <= 0) {
+		return z_impl_zsock_epoll_wait(epfd, events, maxevents, timeout);
+	}
+
+	if (size_mul_overflow(maxevents, sizeof(struct zsock_epoll_event),
+			      &events_size)) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(events, events_size));
+
+	events_copy = k_usermode_alloc_from_copy((void *)events, events_size);
+	if (events_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ret = z_impl_zsock_epoll_wait(epfd, events_copy, maxevents, timeout);
+
+	if (ret > 0) {
+		k_usermode_to_copy(events, events_copy,
+				   ret * sizeof(struct zsock_epoll_event));
+	}
+	k_free(events_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
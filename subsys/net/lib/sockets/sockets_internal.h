@@ -129,4 +129,24 @@ static inline void sock_obj_core_update_recv_stats(int sock, int bytes)
 }
 #endif /* CONFIG_NET_SOCKETS_OBJ_CORE */
 
+#if defined(CONFIG_NET_SOCKETS_EPOLL)
+/* Current ZSOCK_POLL* readiness of a native socket, never blocks */
+int zsock_poll_events_ctx(struct net_context *ctx);
+/* Semaphore signalling that a native TCP socket may become writable */
+struct k_sem *zsock_poll_tx_sem_ctx(struct net_context *ctx);
+
+void zsock_epoll_notify(struct net_context *ctx);
+void zsock_epoll_ctx_close(struct net_context *ctx);
+#else
+static inline void zsock_epoll_notify(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline void zsock_epoll_ctx_close(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif /* CONFIG_NET_SOCKETS_EPOLL */
+
 #endif /* _SOCKETS_INTERNAL_H_ */
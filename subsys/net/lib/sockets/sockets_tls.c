@@ -47,6 +47,9 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
 #include <mbedtls/ssl_cache.h>
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include <mbedtls/ssl_ticket.h>
+#endif
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -68,12 +71,31 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #define DTLS_SENDMSG_BUF_SIZE 0
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_CORK_BUF_SIZE)
+#define TLS_CORK_BUF_SIZE (CONFIG_NET_SOCKETS_TLS_CORK_BUF_SIZE)
+#else
+#define TLS_CORK_BUF_SIZE 0
+#endif /* CONFIG_NET_SOCKETS_TLS_CORK_BUF_SIZE */
+
+#if defined(CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT)
+#define TLS_SERVER_SESSION_COUNT (CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT)
+#else
+#define TLS_SERVER_SESSION_COUNT 0
+#endif /* CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT */
+
+/* Maximum session ID length, see RFC 5246, 7.4.1.2. */
+#define TLS_SESSION_ID_MAX_LEN 32
+
 static const struct socket_op_vtable tls_sock_fd_op_vtable;
 
 #ifndef MBEDTLS_ERR_SSL_PEER_VERIFY_FAILED
 #define MBEDTLS_ERR_SSL_PEER_VERIFY_FAILED MBEDTLS_ERR_SSL_UNEXPECTED_MESSAGE
 #endif
 
+#ifndef MBEDTLS_ERR_SSL_CACHE_ENTRY_NOT_FOUND
+#define MBEDTLS_ERR_SSL_CACHE_ENTRY_NOT_FOUND MBEDTLS_ERR_SSL_BAD_INPUT_DATA
+#endif
+
 /** A list of secure tags that TLS context should use. */
 struct sec_tag_list {
 	/** An array of secure tags referencing TLS credentials. */
@@ -114,6 +136,30 @@ struct tls_session_cache {
 	size_t session_len;
 };
 
+/** TLS server session ID/session mapping. */
+struct tls_server_session_cache {
+	/** Hash table bucket node. */
+	sys_snode_t node;
+
+	/** Creation time. */
+	int64_t timestamp;
+
+	/** Hash of the session ID. */
+	uint32_t hash;
+
+	/** Session ID. */
+	unsigned char id[TLS_SESSION_ID_MAX_LEN];
+
+	/** Session ID length. */
+	size_t id_len;
+
+	/** Session buffer. */
+	uint8_t *session;
+
+	/** Session length. */
+	size_t session_len;
+};
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 struct tls_dtls_cid {
 	bool enabled;
@@ -143,6 +189,9 @@ __net_socket struct tls_context {
 	/** Session ended at the TLS/DTLS level. */
 	bool session_closed : 1;
 
+	/** A record with the coalesced data is being sent. */
+	bool cork_flushing : 1;
+
 	/** Socket type. */
 	enum net_sock_type type;
 
@@ -192,6 +241,9 @@ __net_socket struct tls_context {
 		/** Session cache enabled on a socket. */
 		bool cache_enabled;
 
+		/** Written data is coalesced until the option is cleared. */
+		bool cork;
+
 		/** Socket TX timeout */
 		k_timeout_t timeout_tx;
 
@@ -223,6 +275,14 @@ __net_socket struct tls_context {
 	socklen_t dtls_peer_addrlen;
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS */
 
+#if TLS_CORK_BUF_SIZE > 0
+	/** Written data waiting to be sent in one record. */
+	uint8_t cork_buf[TLS_CORK_BUF_SIZE];
+
+	/** Length of the data in cork_buf. */
+	size_t cork_len;
+#endif /* TLS_CORK_BUF_SIZE > 0 */
+
 #if defined(CONFIG_MBEDTLS)
 	/** mbedTLS context. */
 	mbedtls_ssl_context ssl;
@@ -250,10 +310,19 @@ static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 
 static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT];
 
-#if defined(MBEDTLS_SSL_CACHE_C)
+#if TLS_SERVER_SESSION_COUNT > 0
+static struct tls_server_session_cache server_cache[TLS_SERVER_SESSION_COUNT];
+static sys_slist_t server_cache_buckets[TLS_SERVER_SESSION_COUNT];
+static K_MUTEX_DEFINE(server_cache_lock);
+#elif defined(MBEDTLS_SSL_CACHE_C)
 static mbedtls_ssl_cache_context server_cache;
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+static mbedtls_ssl_ticket_context server_ticket;
+static bool server_ticket_ready;
+#endif
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -273,6 +342,25 @@ static void tls_session_cache_reset(void)
 	(void)memset(client_cache, 0, sizeof(client_cache));
 }
 
+#if TLS_SERVER_SESSION_COUNT > 0
+static void tls_server_session_cache_reset(void)
+{
+	k_mutex_lock(&server_cache_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(server_cache); i++) {
+		if (server_cache[i].session != NULL) {
+			mbedtls_free(server_cache[i].session);
+		}
+
+		sys_slist_init(&server_cache_buckets[i]);
+	}
+
+	(void)memset(server_cache, 0, sizeof(server_cache));
+
+	k_mutex_unlock(&server_cache_lock);
+}
+#endif /* TLS_SERVER_SESSION_COUNT > 0 */
+
 bool net_socket_is_tls(void *obj)
 {
 	return PART_OF_ARRAY(tls_contexts, (struct tls_context *)obj);
@@ -358,6 +446,9 @@ static int dtls_get_remaining_timeout(struct tls_context *ctx)
 /* Initialize TLS internals. */
 static int tls_init(void)
 {
+#if defined(MBEDTLS_SSL_TICKET_C)
+	int ret;
+#endif
 
 #if !defined(CONFIG_ENTROPY_HAS_DRIVER)
 	NET_WARN("No entropy device on the system, "
@@ -369,10 +460,27 @@ static int tls_init(void)
 
 	k_mutex_init(&context_lock);
 
-#if defined(MBEDTLS_SSL_CACHE_C)
+#if TLS_SERVER_SESSION_COUNT > 0
+	tls_server_session_cache_reset();
+#elif defined(MBEDTLS_SSL_CACHE_C)
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	/* The ticket key is shared by all the server sockets, so tickets
+	 * issued on one socket can be used on another one.
+	 */
+	mbedtls_ssl_ticket_init(&server_ticket);
+	ret = mbedtls_ssl_ticket_setup(&server_ticket, tls_ctr_drbg_random, NULL,
+				       MBEDTLS_CIPHER_AES_128_GCM,
+				       CONFIG_NET_SOCKETS_TLS_SERVER_SESSION_LIFETIME);
+	if (ret != 0) {
+		NET_ERR("Failed to set up session tickets, err: -0x%x.", -ret);
+	} else {
+		server_ticket_ready = true;
+	}
+#endif
+
 	return 0;
 }
 
@@ -722,11 +830,178 @@ exit:
 	mbedtls_ssl_session_free(&session);
 }
 
+#if TLS_SERVER_SESSION_COUNT > 0
+static uint32_t tls_server_session_hash(const unsigned char *id, size_t id_len)
+{
+	uint32_t hash = 0;
+
+	/* Session IDs are random, no need for a strong hash. */
+	for (size_t i = 0; i < id_len; i++) {
+		hash = hash * 31 + id[i];
+	}
+
+	return hash;
+}
+
+static inline sys_slist_t *tls_server_session_bucket(uint32_t hash)
+{
+	return &server_cache_buckets[hash % ARRAY_SIZE(server_cache_buckets)];
+}
+
+/* Must be invoked with server cache lock held */
+static struct tls_server_session_cache *tls_server_session_find(
+	const unsigned char *id, size_t id_len, uint32_t hash)
+{
+	struct tls_server_session_cache *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(tls_server_session_bucket(hash), entry, node) {
+		if (entry->hash == hash && entry->id_len == id_len &&
+		    memcmp(entry->id, id, id_len) == 0) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Must be invoked with server cache lock held */
+static void tls_server_session_remove(struct tls_server_session_cache *entry)
+{
+	(void)sys_slist_find_and_remove(tls_server_session_bucket(entry->hash),
+					&entry->node);
+
+	mbedtls_free(entry->session);
+	entry->session = NULL;
+}
+
+static bool tls_server_session_expired(struct tls_server_session_cache *entry)
+{
+	return k_uptime_get() - entry->timestamp >
+	       CONFIG_NET_SOCKETS_TLS_SERVER_SESSION_LIFETIME * MSEC_PER_SEC;
+}
+
+/* Must be invoked with server cache lock held */
+static struct tls_server_session_cache *tls_server_session_alloc(void)
+{
+	struct tls_server_session_cache *entry = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(server_cache); i++) {
+		if (server_cache[i].session == NULL) {
+			return &server_cache[i];
+		}
+
+		/* Remember the oldest entry and reuse if needed. */
+		if (entry == NULL ||
+		    entry->timestamp > server_cache[i].timestamp) {
+			entry = &server_cache[i];
+		}
+	}
+
+	tls_server_session_remove(entry);
+
+	return entry;
+}
+
+/* mbedTLS-defined function for loading a server session by ID. */
+static int tls_server_session_get(void *data, unsigned char const *session_id,
+				  size_t session_id_len,
+				  mbedtls_ssl_session *session)
+{
+	struct tls_server_session_cache *entry;
+	uint32_t hash = tls_server_session_hash(session_id, session_id_len);
+	int ret = MBEDTLS_ERR_SSL_CACHE_ENTRY_NOT_FOUND;
+
+	ARG_UNUSED(data);
+
+	k_mutex_lock(&server_cache_lock, K_FOREVER);
+
+	entry = tls_server_session_find(session_id, session_id_len, hash);
+	if (entry == NULL) {
+		goto exit;
+	}
+
+	if (tls_server_session_expired(entry)) {
+		tls_server_session_remove(entry);
+		goto exit;
+	}
+
+	ret = mbedtls_ssl_session_load(session, entry->session,
+				       entry->session_len);
+	if (ret < 0) {
+		/* Discard corrupted session data. */
+		tls_server_session_remove(entry);
+		NET_ERR("Failed to load TLS session %d", ret);
+	}
+
+exit:
+	k_mutex_unlock(&server_cache_lock);
+
+	return ret;
+}
+
+/* mbedTLS-defined function for storing a server session by ID. */
+static int tls_server_session_set(void *data, unsigned char const *session_id,
+				  size_t session_id_len,
+				  const mbedtls_ssl_session *session)
+{
+	struct tls_server_session_cache *entry;
+	uint32_t hash = tls_server_session_hash(session_id, session_id_len);
+	size_t session_len;
+	uint8_t *buf;
+	int ret;
+
+	ARG_UNUSED(data);
+
+	if (session_id_len == 0 || session_id_len > TLS_SESSION_ID_MAX_LEN) {
+		return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+	}
+
+	/* Serialize the session before taking the lock. */
+	(void)mbedtls_ssl_session_save(session, NULL, 0, &session_len);
+
+	buf = mbedtls_calloc(1, session_len);
+	if (buf == NULL) {
+		NET_ERR("Failed to allocate session buffer.");
+		return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+	}
+
+	ret = mbedtls_ssl_session_save(session, buf, session_len, &session_len);
+	if (ret < 0) {
+		NET_ERR("Failed to serialize session, err: -0x%x.", -ret);
+		mbedtls_free(buf);
+		return ret;
+	}
+
+	k_mutex_lock(&server_cache_lock, K_FOREVER);
+
+	entry = tls_server_session_find(session_id, session_id_len, hash);
+	if (entry != NULL) {
+		tls_server_session_remove(entry);
+	} else {
+		entry = tls_server_session_alloc();
+	}
+
+	memcpy(entry->id, session_id, session_id_len);
+	entry->id_len = session_id_len;
+	entry->hash = hash;
+	entry->session = buf;
+	entry->session_len = session_len;
+	entry->timestamp = k_uptime_get();
+	sys_slist_prepend(tls_server_session_bucket(hash), &entry->node);
+
+	k_mutex_unlock(&server_cache_lock);
+
+	return 0;
+}
+#endif /* TLS_SERVER_SESSION_COUNT > 0 */
+
 static void tls_session_purge(void)
 {
 	tls_session_cache_reset();
 
-#if defined(MBEDTLS_SSL_CACHE_C)
+#if TLS_SERVER_SESSION_COUNT > 0
+	tls_server_session_cache_reset();
+#elif defined(MBEDTLS_SSL_CACHE_C)
 	mbedtls_ssl_cache_free(&server_cache);
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
@@ -1170,6 +1445,11 @@ static int tls_mbedtls_reset(struct tls_context *context)
 
 	k_sem_reset(&context->tls_established);
 
+#if TLS_CORK_BUF_SIZE > 0
+	context->cork_len = 0;
+	context->cork_flushing = false;
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	/* Server role: reset the address so that a new
 	 *              client can connect w/o a need to reopen a socket
@@ -1413,7 +1693,13 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif /* CONFIG_MBEDTLS_SSL_ALPN */
 
-#if defined(MBEDTLS_SSL_CACHE_C)
+#if TLS_SERVER_SESSION_COUNT > 0
+	if (is_server && context->options.cache_enabled) {
+		mbedtls_ssl_conf_session_cache(&context->config, NULL,
+					       tls_server_session_get,
+					       tls_server_session_set);
+	}
+#elif defined(MBEDTLS_SSL_CACHE_C)
 	if (is_server && context->options.cache_enabled) {
 		mbedtls_ssl_conf_session_cache(&context->config, &server_cache,
 					       mbedtls_ssl_cache_get,
@@ -1421,6 +1707,15 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (is_server && context->options.cache_enabled && server_ticket_ready) {
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    mbedtls_ssl_ticket_write,
+						    mbedtls_ssl_ticket_parse,
+						    &server_ticket);
+	}
+#endif
+
 	ret = mbedtls_ssl_setup(&context->ssl,
 				&context->config);
 	if (ret != 0) {
@@ -2104,6 +2399,10 @@ free_fd:
 	return -1;
 }
 
+#if TLS_CORK_BUF_SIZE > 0
+static int tls_cork_flush(struct tls_context *ctx, int flags);
+#endif
+
 int ztls_close_ctx(struct tls_context *ctx)
 {
 	int ret, err = 0;
@@ -2111,6 +2410,12 @@ int ztls_close_ctx(struct tls_context *ctx)
 	/* Try to send close notification. */
 	ctx->flags = 0;
 
+#if TLS_CORK_BUF_SIZE > 0
+	if (ctx->type == SOCK_STREAM && ctx->cork_len > 0) {
+		(void)tls_cork_flush(ctx, 0);
+	}
+#endif
+
 	(void)mbedtls_ssl_close_notify(&ctx->ssl);
 
 	err = tls_release(ctx);
@@ -2337,6 +2642,117 @@ static ssize_t send_tls(struct tls_context *ctx, const void *buf,
 	return -1;
 }
 
+#if TLS_CORK_BUF_SIZE > 0
+/* Send the coalesced data. As mbedTLS requires a write that could not
+ * complete to be retried with the same data, the buffer is kept intact until
+ * it is fully sent.
+ */
+static int tls_cork_flush(struct tls_context *ctx, int flags)
+{
+	ssize_t ret;
+
+	/* The flags are used by the underlying socket, which could be called
+	 * from setsockopt() or shutdown() with those of a previous send.
+	 */
+	flags &= ~ZSOCK_MSG_MORE;
+	ctx->flags = flags;
+	ctx->cork_flushing = true;
+
+	while (ctx->cork_len > 0) {
+		ret = send_tls(ctx, ctx->cork_buf, ctx->cork_len, flags);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		ctx->cork_len -= ret;
+		memmove(ctx->cork_buf, ctx->cork_buf + ret, ctx->cork_len);
+	}
+
+	ctx->cork_flushing = false;
+
+	return 0;
+}
+
+static ssize_t send_tls_corked(struct tls_context *ctx, const void *buf,
+			       size_t len, int flags)
+{
+	const bool more = ctx->options.cork || (flags & ZSOCK_MSG_MORE);
+	size_t copied = 0;
+	int ret;
+
+	/* Finish sending a record interrupted by a non-blocking call. */
+	if (ctx->cork_flushing) {
+		ret = tls_cork_flush(ctx, flags);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	if (!more && ctx->cork_len == 0) {
+		return send_tls(ctx, buf, len, flags & ~ZSOCK_MSG_MORE);
+	}
+
+	while (copied < len) {
+		size_t chunk = MIN(len - copied, sizeof(ctx->cork_buf) - ctx->cork_len);
+
+		memcpy(ctx->cork_buf + ctx->cork_len, (const uint8_t *)buf + copied, chunk);
+		ctx->cork_len += chunk;
+		copied += chunk;
+
+		if (ctx->cork_len < sizeof(ctx->cork_buf) && (more || copied < len)) {
+			continue;
+		}
+
+		ret = tls_cork_flush(ctx, flags);
+		if (ret < 0) {
+			/* The data is already committed to the buffer, so it
+			 * was accepted. The send is retried, or the error
+			 * reported, by the next call.
+			 */
+			break;
+		}
+	}
+
+	return copied;
+}
+
+static int tls_opt_cork_set(struct tls_context *context,
+			    const void *optval, socklen_t optlen)
+{
+	int *val = (int *)optval;
+
+	if (!optval) {
+		return -EINVAL;
+	}
+
+	if (sizeof(int) != optlen) {
+		return -EINVAL;
+	}
+
+	context->options.cork = (*val != 0);
+
+	/* Send the data held back so far when the option is cleared. */
+	if (!context->options.cork && context->cork_len > 0) {
+		return tls_cork_flush(context, 0);
+	}
+
+	return 0;
+}
+
+static int tls_opt_cork_get(struct tls_context *context,
+			    void *optval, socklen_t *optlen)
+{
+	if (*optlen != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	*(int *)optval = context->options.cork ? 1 : 0;
+
+	return 0;
+}
+#endif /* TLS_CORK_BUF_SIZE > 0 */
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 static ssize_t sendto_dtls_client(struct tls_context *ctx, const void *buf,
 				  size_t len, int flags,
@@ -2423,11 +2839,16 @@ ssize_t ztls_sendto_ctx(struct tls_context *ctx, const void *buf, size_t len,
 			int flags, const struct sockaddr *dest_addr,
 			socklen_t addrlen)
 {
-	ctx->flags = flags;
+	/* ZSOCK_MSG_MORE is handled here, not by the underlying socket. */
+	ctx->flags = flags & ~ZSOCK_MSG_MORE;
 
 	/* TLS */
 	if (ctx->type == SOCK_STREAM) {
+#if TLS_CORK_BUF_SIZE > 0
+		return send_tls_corked(ctx, buf, len, flags);
+#else
 		return send_tls(ctx, buf, len, flags);
+#endif
 	}
 
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
@@ -2486,19 +2907,33 @@ static ssize_t tls_sendmsg_loop_and_send(struct tls_context *ctx,
 	ssize_t len = 0;
 	ssize_t ret;
 
+	int last = msg->msg_iovlen - 1;
+
+	/* Find the last buffer holding data, so that the preceding ones can be
+	 * coalesced with it into one record.
+	 */
+	while (last > 0 && msg->msg_iov[last].iov_len == 0) {
+		last--;
+	}
+
 	for (int i = 0; i < msg->msg_iovlen; i++) {
 		struct iovec *vec = msg->msg_iov + i;
+		int vec_flags = flags;
 		size_t sent = 0;
 
 		if (vec->iov_len == 0) {
 			continue;
 		}
 
+		if (TLS_CORK_BUF_SIZE > 0 && ctx->type == SOCK_STREAM && i < last) {
+			vec_flags |= ZSOCK_MSG_MORE;
+		}
+
 		while (sent < vec->iov_len) {
 			uint8_t *ptr = (uint8_t *)vec->iov_base + sent;
 
 			ret = ztls_sendto_ctx(ctx, ptr, vec->iov_len - sent,
-					      flags, msg->msg_name,
+					      vec_flags, msg->msg_name,
 					      msg->msg_namelen);
 			if (ret < 0) {
 				return ret;
@@ -3445,6 +3880,19 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		return 0;
 	}
 
+#if TLS_CORK_BUF_SIZE > 0
+	if ((level == IPPROTO_TCP) && (optname == TCP_CORK) &&
+	    ctx->type == SOCK_STREAM) {
+		err = tls_opt_cork_get(ctx, optval, optlen);
+		if (err < 0) {
+			errno = -err;
+			return -1;
+		}
+
+		return 0;
+	}
+#endif
+
 	if (level != SOL_TLS) {
 		return zsock_getsockopt(ctx->sock, level, optname,
 					optval, optlen);
@@ -3551,6 +3999,17 @@ int ztls_setsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		goto out;
 	}
 
+#if TLS_CORK_BUF_SIZE > 0
+	/* Records are built at the TLS socket level, hence coalesce the data
+	 * here rather than in the underlying socket.
+	 */
+	if ((level == IPPROTO_TCP) && (optname == TCP_CORK) &&
+	    ctx->type == SOCK_STREAM) {
+		err = tls_opt_cork_set(ctx, optval, optlen);
+		goto out;
+	}
+#endif
+
 	if (level != SOL_TLS) {
 		return zsock_setsockopt(ctx->sock, level, optname,
 					optval, optlen);
@@ -3748,6 +4207,13 @@ static int tls_sock_shutdown_vmeth(void *obj, int how)
 {
 	struct tls_context *ctx = obj;
 
+#if TLS_CORK_BUF_SIZE > 0
+	if (ctx->type == SOCK_STREAM && ctx->cork_len > 0 &&
+	    (how == ZSOCK_SHUT_WR || how == ZSOCK_SHUT_RDWR)) {
+		(void)tls_cork_flush(ctx, 0);
+	}
+#endif
+
 	return zsock_shutdown(ctx->sock, how);
 }
 
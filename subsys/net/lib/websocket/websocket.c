@@ -574,30 +574,64 @@ static int sendmsg_all(int sock, const struct msghdr *message, int flags)
 }
 #endif /* !defined(CONFIG_NET_TEST) */
 
+/* Apply the masking key (RFC 6455 chapter 5.3) to len bytes, offset being
+ * the position of src in the payload. The data is processed a machine word
+ * at a time, and src and dst can be the same buffer.
+ */
+static void websocket_mask(uint32_t key, size_t offset, const uint8_t *src,
+			   uint8_t *dst, size_t len)
+{
+	uint8_t key_bytes[sizeof(unsigned long)];
+	unsigned long word_key, word;
+	size_t i;
+
+	/* The key repeats every 4 bytes, so it also fits a whole word */
+	for (i = 0; i < sizeof(key_bytes); i++) {
+		key_bytes[i] = key >> (8 * (3 - (offset + i) % 4));
+	}
+
+	memcpy(&word_key, key_bytes, sizeof(word_key));
+
+	for (i = 0; i + sizeof(word) <= len; i += sizeof(word)) {
+		memcpy(&word, src + i, sizeof(word));
+		word ^= word_key;
+		memcpy(dst + i, &word, sizeof(word));
+	}
+
+	for (; i < len; i++) {
+		dst[i] = src[i] ^ key_bytes[i % sizeof(key_bytes)];
+	}
+}
+
 static int websocket_prepare_and_send(struct websocket_context *ctx,
 				      uint8_t *header, size_t header_len,
-				      uint8_t *payload, size_t payload_len,
-				      int32_t timeout)
+				      const struct iovec *payload,
+				      size_t payload_count, int32_t timeout)
 {
-	struct iovec io_vector[2];
+	struct iovec io_vector[1 + CONFIG_WEBSOCKET_SEND_IOV_MAX];
 	struct msghdr msg;
+	size_t i;
 
 	io_vector[0].iov_base = header;
 	io_vector[0].iov_len = header_len;
-	io_vector[1].iov_base = payload;
-	io_vector[1].iov_len = payload_len;
+
+	/* The payload is sent from where it is, without copying it */
+	for (i = 0; i < payload_count; i++) {
+		io_vector[1 + i] = payload[i];
+	}
 
 	memset(&msg, 0, sizeof(msg));
 
 	msg.msg_iov = io_vector;
-	msg.msg_iovlen = ARRAY_SIZE(io_vector);
+	msg.msg_iovlen = 1 + payload_count;
 
 	if (HEXDUMP_SENT_PACKETS) {
 		LOG_HEXDUMP_DBG(header, header_len, "Header");
-		if ((payload != NULL) && (payload_len > 0)) {
-			LOG_HEXDUMP_DBG(payload, payload_len, "Payload");
-		} else {
-			LOG_DBG("No payload");
+		for (i = 0; i < payload_count; i++) {
+			if ((payload[i].iov_base != NULL) && (payload[i].iov_len > 0)) {
+				LOG_HEXDUMP_DBG(payload[i].iov_base, payload[i].iov_len,
+						"Payload");
+			}
 		}
 	}
 
@@ -614,17 +648,33 @@ static int websocket_prepare_and_send(struct websocket_context *ctx,
 	}
 
 	return sendmsg_all(ctx->real_sock, &msg,
-			   K_TIMEOUT_EQ(tout, K_NO_WAIT) ? MSG_DONTWAIT : 0);
+			   K_TIMEOUT_EQ(tout, K_NO_WAIT) ? ZSOCK_MSG_DONTWAIT : 0);
 #endif /* CONFIG_NET_TEST */
 }
 
 int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		       enum websocket_opcode opcode, bool mask, bool final,
 		       int32_t timeout)
+{
+	struct iovec iov = {
+		.iov_base = (void *)payload,
+		.iov_len = payload_len,
+	};
+
+	return websocket_send_msgv(ws_sock, &iov, 1, opcode, mask, final,
+				   timeout);
+}
+
+int websocket_send_msgv(int ws_sock, const struct iovec *iov, size_t iovcnt,
+			enum websocket_opcode opcode, bool mask, bool final,
+			int32_t timeout)
 {
 	struct websocket_context *ctx;
 	uint8_t header[MAX_HEADER_LEN], hdr_len = 2;
-	uint8_t *data_to_send = (uint8_t *)payload;
+	struct iovec masked_iov;
+	uint8_t *masked = NULL;
+	size_t payload_len = 0;
+	size_t i;
 	int ret;
 
 	if (opcode != WEBSOCKET_OPCODE_DATA_TEXT &&
@@ -636,6 +686,14 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		return -EINVAL;
 	}
 
+	if (iovcnt > CONFIG_WEBSOCKET_SEND_IOV_MAX) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < iovcnt; i++) {
+		payload_len += iov[i].iov_len;
+	}
+
 	ctx = z_get_fd_obj(ws_sock, NULL, 0);
 	if (ctx == NULL) {
 		return -EBADF;
@@ -687,7 +745,7 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 
 	/* Add masking value if needed */
 	if (mask) {
-		int i;
+		size_t offset = 0;
 
 		ctx->masking_value = sys_rand32_get();
 
@@ -696,31 +754,37 @@ int websocket_send_msg(int ws_sock, const uint8_t *payload, size_t payload_len,
 		header[hdr_len++] |= ctx->masking_value >> 8;
 		header[hdr_len++] |= ctx->masking_value;
 
-		if ((payload != NULL) && (payload_len > 0)) {
-			data_to_send = k_malloc(payload_len);
-			if (!data_to_send) {
+		/* The caller's data is not modified, so the masked payload
+		 * is built in one pass in a separate buffer.
+		 */
+		if (payload_len > 0) {
+			masked = k_malloc(payload_len);
+			if (!masked) {
 				return -ENOMEM;
 			}
 
-			memcpy(data_to_send, payload, payload_len);
-
-			for (i = 0; i < payload_len; i++) {
-				data_to_send[i] ^= ctx->masking_value >> (8 * (3 - i % 4));
+			for (i = 0; i < iovcnt; i++) {
+				websocket_mask(ctx->masking_value, offset,
+					       iov[i].iov_base, masked + offset,
+					       iov[i].iov_len);
+				offset += iov[i].iov_len;
 			}
+
+			masked_iov.iov_base = masked;
+			masked_iov.iov_len = payload_len;
+
+			iov = &masked_iov;
+			iovcnt = 1;
 		}
 	}
 
-	ret = websocket_prepare_and_send(ctx, header, hdr_len,
-					 data_to_send, payload_len, timeout);
+	ret = websocket_prepare_and_send(ctx, header, hdr_len, iov, iovcnt,
+					 timeout);
 	if (ret < 0) {
 		NET_DBG("Cannot send ws msg (%d)", -errno);
-		goto quit;
 	}
 
-quit:
-	if (data_to_send != payload) {
-		k_free(data_to_send);
-	}
+	k_free(masked);
 
 	/* Do no math with 0 and error codes */
 	if (ret <= 0) {
@@ -964,7 +1028,7 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 			ret = wait_rx(ctx->real_sock, timeout_to_ms(&tout));
 			if (ret == 0) {
 				ret = zsock_recv(ctx->real_sock, ctx->recv_buf.buf,
-						 ctx->recv_buf.size, MSG_DONTWAIT);
+						 ctx->recv_buf.size, ZSOCK_MSG_DONTWAIT);
 				if (ret < 0) {
 					ret = -errno;
 				}
@@ -1019,15 +1083,10 @@ int websocket_recv_msg(int ws_sock, uint8_t *buf, size_t buf_len,
 
 	/* Unmask the data */
 	if (ctx->masked) {
-		uint8_t *mask_as_bytes = (uint8_t *)&ctx->masking_value;
 		size_t data_buf_offset = ctx->message_len - ctx->parser_remaining - payload.count;
 
-		for (size_t i = 0; i < payload.count; i++) {
-			size_t m = data_buf_offset % 4;
-
-			payload.buf[i] ^= mask_as_bytes[3 - m];
-			data_buf_offset++;
-		}
+		websocket_mask(ctx->masking_value, data_buf_offset, payload.buf,
+			       payload.buf, payload.count);
 	}
 
 	return payload.count;
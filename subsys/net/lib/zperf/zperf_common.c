@@ -206,6 +206,134 @@ uint32_t zperf_packet_duration(uint32_t packet_size, uint32_t rate_in_kbps)
 			  (rate_in_kbps * 1024U));
 }
 
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+struct zperf_stream {
+	struct k_thread thread;
+	const struct zperf_upload_params *param;
+	zperf_stream_fn stream_fn;
+	struct zperf_results results;
+	int ret;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(zperf_stream_stacks,
+				   CONFIG_NET_ZPERF_MAX_STREAMS - 1,
+				   CONFIG_NET_ZPERF_STREAM_STACK_SIZE);
+static struct zperf_stream zperf_streams[CONFIG_NET_ZPERF_MAX_STREAMS - 1];
+static K_MUTEX_DEFINE(zperf_streams_lock);
+
+static void zperf_stream_thread(void *p1, void *p2, void *p3)
+{
+	struct zperf_stream *stream = p1;
+	int index = POINTER_TO_INT(p2);
+
+	ARG_UNUSED(p3);
+
+	stream->ret = stream->stream_fn(stream->param, index, &stream->results);
+}
+
+static void zperf_results_add(struct zperf_results *results,
+			      const struct zperf_results *stream)
+{
+	results->nb_packets_sent += stream->nb_packets_sent;
+	results->nb_packets_rcvd += stream->nb_packets_rcvd;
+	results->nb_packets_lost += stream->nb_packets_lost;
+	results->nb_packets_outorder += stream->nb_packets_outorder;
+	results->nb_packets_errors += stream->nb_packets_errors;
+	results->total_len += stream->total_len;
+	results->time_in_us = MAX(results->time_in_us, stream->time_in_us);
+	results->client_time_in_us = MAX(results->client_time_in_us,
+					 stream->client_time_in_us);
+	results->jitter_in_us = MAX(results->jitter_in_us, stream->jitter_in_us);
+}
+
+static int zperf_run_streams(const struct zperf_upload_params *param,
+			     zperf_stream_fn stream_fn, int count,
+			     struct zperf_results *results)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	int ret;
+
+	k_mutex_lock(&zperf_streams_lock, K_FOREVER);
+
+	for (int i = 0; i < count - 1; i++) {
+		struct zperf_stream *stream = &zperf_streams[i];
+
+		stream->param = param;
+		stream->stream_fn = stream_fn;
+		stream->results = (struct zperf_results){ 0 };
+		stream->ret = 0;
+
+		k_thread_create(&stream->thread, zperf_stream_stacks[i],
+				K_THREAD_STACK_SIZEOF(zperf_stream_stacks[i]),
+				zperf_stream_thread, stream, INT_TO_POINTER(i + 1),
+				NULL, prio, 0, K_NO_WAIT);
+		k_thread_name_set(&stream->thread, "zperf_stream");
+	}
+
+	/* The first stream runs in the calling thread */
+	ret = stream_fn(param, 0, results);
+
+	for (int i = 0; i < count - 1; i++) {
+		struct zperf_stream *stream = &zperf_streams[i];
+
+		(void)k_thread_join(&stream->thread, K_FOREVER);
+
+		if (stream->ret < 0 && ret == 0) {
+			ret = stream->ret;
+		}
+
+		zperf_results_add(results, &stream->results);
+	}
+
+	k_mutex_unlock(&zperf_streams_lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_ZPERF_MAX_STREAMS > 1 */
+
+int zperf_upload_streams(const struct zperf_upload_params *param,
+			 zperf_stream_fn stream_fn,
+			 struct zperf_results *results)
+{
+	int count = MAX(param->num_streams, 1);
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+	k_thread_runtime_stats_t start, end;
+#endif
+	int ret;
+
+	if (count > CONFIG_NET_ZPERF_MAX_STREAMS) {
+		NET_ERR("Too many streams %d, maximum is %d", count,
+			CONFIG_NET_ZPERF_MAX_STREAMS);
+		return -EINVAL;
+	}
+
+	*results = (struct zperf_results){ 0 };
+
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+	(void)k_thread_runtime_stats_all_get(&start);
+#endif
+
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+	ret = zperf_run_streams(param, stream_fn, count, results);
+#else
+	ret = stream_fn(param, 0, results);
+#endif
+
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+	/* The execution cycles of the CPU statistics include the idle ones */
+	(void)k_thread_runtime_stats_all_get(&end);
+	if (end.execution_cycles > start.execution_cycles) {
+		results->cpu_load = (uint16_t)
+			(((end.total_cycles - start.total_cycles) * 1000U) /
+			 (end.execution_cycles - start.execution_cycles));
+	}
+#endif
+
+	results->num_streams = count;
+
+	return ret;
+}
+
 void zperf_async_work_submit(struct k_work *work)
 {
 	k_work_submit_to_queue(&zperf_work_q, work);
@@ -108,6 +108,14 @@ int zperf_prepare_upload_sock(const struct sockaddr *peer_addr, uint8_t tos,
 
 uint32_t zperf_packet_duration(uint32_t packet_size, uint32_t rate_in_kbps);
 
+/* Run one upload stream, stream is the index of the stream */
+typedef int (*zperf_stream_fn)(const struct zperf_upload_params *param,
+			       int stream, struct zperf_results *results);
+
+int zperf_upload_streams(const struct zperf_upload_params *param,
+			 zperf_stream_fn stream_fn,
+			 struct zperf_results *results);
+
 void zperf_async_work_submit(struct k_work *work);
 void zperf_udp_uploader_init(void);
 void zperf_tcp_uploader_init(void);
@@ -100,8 +100,68 @@ void zperf_reset_session_stats(struct session *session)
 	session->error = 0U;
 	session->jitter = 0;
 	session->last_transit_time = 0;
+#if defined(CONFIG_NET_ZPERF_LATENCY_HISTOGRAM)
+	(void)memset(session->latency, 0, sizeof(session->latency));
+#endif
 }
 
+#if defined(CONFIG_NET_ZPERF_LATENCY_HISTOGRAM)
+void zperf_session_latency_add(struct session *session, uint32_t latency_us)
+{
+	uint32_t index;
+	int msb;
+
+	latency_us = MIN(latency_us, BIT(LATENCY_MAX_BITS) - 1);
+
+	if (latency_us < BIT(LATENCY_SUB_BITS)) {
+		index = latency_us;
+	} else {
+		msb = 31 - __builtin_clz(latency_us);
+		index = ((msb - LATENCY_SUB_BITS + 1) << LATENCY_SUB_BITS) +
+			((latency_us >> (msb - LATENCY_SUB_BITS)) &
+			 (BIT(LATENCY_SUB_BITS) - 1));
+	}
+
+	session->latency[index]++;
+}
+
+uint32_t zperf_session_latency_get(const struct session *session,
+				   uint32_t permille)
+{
+	uint64_t total = 0U;
+	uint64_t count = 0U;
+	uint64_t rank;
+	uint32_t index;
+	int shift;
+
+	for (index = 0; index < LATENCY_BUCKETS; index++) {
+		total += session->latency[index];
+	}
+
+	if (total == 0U) {
+		return 0U;
+	}
+
+	rank = DIV_ROUND_UP(total * permille, 1000U);
+
+	for (index = 0; index < LATENCY_BUCKETS - 1; index++) {
+		count += session->latency[index];
+		if (count >= rank) {
+			break;
+		}
+	}
+
+	if (index < BIT(LATENCY_SUB_BITS)) {
+		return index;
+	}
+
+	shift = (index >> LATENCY_SUB_BITS) - 1;
+
+	return ((BIT(LATENCY_SUB_BITS) + (index & (BIT(LATENCY_SUB_BITS) - 1)) + 1)
+		<< shift) - 1;
+}
+#endif /* CONFIG_NET_ZPERF_LATENCY_HISTOGRAM */
+
 void zperf_session_reset(enum session_proto proto)
 {
 	int i, j;
@@ -26,6 +26,13 @@ enum state {
 	STATE_COMPLETED /* Session completed, stats pkt can be sent if needed */
 };
 
+/* Latencies are counted with 4 buckets per power of two up to 2^24 us, so
+ * a percentile is known within 25% of its value.
+ */
+#define LATENCY_SUB_BITS 2
+#define LATENCY_MAX_BITS 24
+#define LATENCY_BUCKETS ((LATENCY_MAX_BITS - LATENCY_SUB_BITS + 1) << LATENCY_SUB_BITS)
+
 enum session_proto {
 	SESSION_UDP = 0,
 	SESSION_TCP = 1,
@@ -50,6 +57,11 @@ struct session {
 	int32_t jitter;
 	int32_t last_transit_time;
 
+#if defined(CONFIG_NET_ZPERF_LATENCY_HISTOGRAM)
+	/* One-way latency histogram */
+	uint32_t latency[LATENCY_BUCKETS];
+#endif
+
 	/* Stats packet*/
 	struct zperf_server_hdr stat;
 };
@@ -61,4 +73,11 @@ void zperf_reset_session_stats(struct session *session);
 /* Reset all sessions for a given protocol. */
 void zperf_session_reset(enum session_proto proto);
 
+#if defined(CONFIG_NET_ZPERF_LATENCY_HISTOGRAM)
+void zperf_session_latency_add(struct session *session, uint32_t latency_us);
+/* Return the upper bound of the latency percentile given in permille. */
+uint32_t zperf_session_latency_get(const struct session *session,
+				   uint32_t permille);
+#endif
+
 #endif /* __ZPERF_SESSION_H */
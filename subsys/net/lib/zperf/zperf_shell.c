@@ -72,6 +72,11 @@ static struct in6_addr shell_ipv6;
 
 static struct in_addr shell_ipv4;
 
+/* Print the results as JSON objects, one per line */
+static bool upload_json;
+static bool udp_download_json;
+static bool tcp_download_json;
+
 #define DEVICE_NAME "zperf shell"
 
 const uint32_t TIME_US[] = { 60 * 1000 * 1000, 1000 * 1000, 1000, 0 };
@@ -311,6 +316,37 @@ static int cmd_setip(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+static void print_results_json(const struct shell *sh, const char *proto,
+			       const struct zperf_results *results)
+{
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "{\"proto\":\"%s\",\"streams\":%u,"
+		      "\"packets_sent\":%u,\"packets_rcvd\":%u,"
+		      "\"packets_lost\":%u,\"packets_outorder\":%u,"
+		      "\"errors\":%u,\"total_len\":%" PRIu64 ","
+		      "\"time_us\":%" PRIu64 ",\"client_time_us\":%" PRIu64 ","
+		      "\"packet_size\":%u,\"jitter_us\":%u,"
+		      "\"latency_p50_us\":%u,\"latency_p99_us\":%u,"
+		      "\"latency_p999_us\":%u,\"cpu_load\":%u}\n",
+		      proto, results->num_streams,
+		      results->nb_packets_sent, results->nb_packets_rcvd,
+		      results->nb_packets_lost, results->nb_packets_outorder,
+		      results->nb_packets_errors, results->total_len,
+		      results->time_in_us, results->client_time_in_us,
+		      results->packet_size, results->jitter_in_us,
+		      results->latency_p50_us, results->latency_p99_us,
+		      results->latency_p999_us, results->cpu_load);
+}
+
+static void print_cpu_load(const struct shell *sh,
+			   const struct zperf_results *results)
+{
+	if (IS_ENABLED(CONFIG_SCHED_THREAD_USAGE_ALL)) {
+		shell_fprintf(sh, SHELL_NORMAL, "CPU load:\t\t%u.%u %%\n",
+			      results->cpu_load / 10U, results->cpu_load % 10U);
+	}
+}
+
 static void udp_session_cb(enum zperf_status status,
 			   struct zperf_results *result,
 			   void *user_data)
@@ -325,6 +361,11 @@ static void udp_session_cb(enum zperf_status status,
 	case ZPERF_SESSION_FINISHED: {
 		uint32_t rate_in_kbps;
 
+		if (udp_download_json) {
+			print_results_json(sh, "udp", result);
+			break;
+		}
+
 		/* Compute baud rate */
 		if (result->time_in_us != 0U) {
 			rate_in_kbps = (uint32_t)
@@ -355,6 +396,14 @@ static void udp_session_cb(enum zperf_status status,
 		print_number(sh, rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
 
+		if (IS_ENABLED(CONFIG_NET_ZPERF_LATENCY_HISTOGRAM)) {
+			shell_fprintf(sh, SHELL_NORMAL,
+				      " latency p50/p99/p99.9:\t%u/%u/%u us\n",
+				      result->latency_p50_us,
+				      result->latency_p99_us,
+				      result->latency_p999_us);
+		}
+
 		break;
 	}
 
@@ -373,7 +422,8 @@ static void udp_session_cb(enum zperf_status status,
  */
 static int shell_cmd_download(const struct shell *sh, size_t argc,
 			      char *argv[],
-			      struct zperf_download_params *param)
+			      struct zperf_download_params *param,
+			      bool *json)
 {
 	int opt_cnt = 0;
 	size_t i;
@@ -401,6 +451,11 @@ static int shell_cmd_download(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+		case 'J':
+			*json = true;
+			opt_cnt += 1;
+			break;
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -432,10 +487,11 @@ static int cmd_udp_download(const struct shell *sh, size_t argc,
 {
 	if (IS_ENABLED(CONFIG_NET_UDP)) {
 		struct zperf_download_params param = { 0 };
+		bool json = false;
 		int ret;
 		int start;
 
-		start = shell_cmd_download(sh, argc, argv, &param);
+		start = shell_cmd_download(sh, argc, argv, &param, &json);
 		if (start < 0) {
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unable to parse option.\n");
@@ -450,6 +506,8 @@ static int cmd_udp_download(const struct shell *sh, size_t argc,
 			return -ENOEXEC;
 		}
 
+		udp_download_json = json;
+
 		ret = zperf_udp_download(&param, udp_session_cb, (void *)sh);
 		if (ret == -EALREADY) {
 			shell_fprintf(sh, SHELL_WARNING,
@@ -478,6 +536,11 @@ static void shell_udp_upload_print_stats(const struct shell *sh,
 	if (IS_ENABLED(CONFIG_NET_UDP)) {
 		unsigned int rate_in_kbps, client_rate_in_kbps;
 
+		if (upload_json) {
+			print_results_json(sh, "udp", results);
+			return;
+		}
+
 		shell_fprintf(sh, SHELL_NORMAL, "-\nUpload completed!\n");
 
 		if (results->time_in_us != 0U) {
@@ -533,6 +596,13 @@ static void shell_udp_upload_print_stats(const struct shell *sh,
 		shell_fprintf(sh, SHELL_NORMAL, "\t(");
 		print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, ")\n");
+
+		if (results->num_streams > 1) {
+			shell_fprintf(sh, SHELL_NORMAL, "Num streams:\t\t%u\n",
+				      results->num_streams);
+		}
+
+		print_cpu_load(sh, results);
 	}
 }
 
@@ -542,6 +612,11 @@ static void shell_tcp_upload_print_stats(const struct shell *sh,
 	if (IS_ENABLED(CONFIG_NET_TCP)) {
 		unsigned int client_rate_in_kbps;
 
+		if (upload_json) {
+			print_results_json(sh, "tcp", results);
+			return;
+		}
+
 		shell_fprintf(sh, SHELL_NORMAL, "-\nUpload completed!\n");
 
 		if (results->client_time_in_us != 0U) {
@@ -566,6 +641,13 @@ static void shell_tcp_upload_print_stats(const struct shell *sh,
 		shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t");
 		print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
+
+		if (results->num_streams > 1) {
+			shell_fprintf(sh, SHELL_NORMAL, "Num streams:\t%u\n",
+				      results->num_streams);
+		}
+
+		print_cpu_load(sh, results);
 	}
 }
 
@@ -675,8 +757,17 @@ static int execute_upload(const struct shell *sh,
 	shell_fprintf(sh, SHELL_NORMAL, "\n");
 	shell_fprintf(sh, SHELL_NORMAL, "Packet size:\t%u bytes\n",
 		      param->packet_size);
-	shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t%u kbps\n",
-		      param->rate_kbps);
+	if (param->rate_pps != 0U) {
+		shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t%u pps\n",
+			      param->rate_pps);
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t%u kbps\n",
+			      param->rate_kbps);
+	}
+	if (param->num_streams > 1) {
+		shell_fprintf(sh, SHELL_NORMAL, "Streams:\t%u\n",
+			      param->num_streams);
+	}
 	shell_fprintf(sh, SHELL_NORMAL, "Starting...\n");
 
 	if (IS_ENABLED(CONFIG_NET_IPV6) && param->peer_addr.sa_family == AF_INET6) {
@@ -690,12 +781,15 @@ static int execute_upload(const struct shell *sh,
 	}
 
 	if (is_udp && IS_ENABLED(CONFIG_NET_UDP)) {
-		uint32_t packet_duration =
+		uint32_t packet_duration = param->rate_pps != 0U ?
+			USEC_PER_SEC / param->rate_pps :
 			zperf_packet_duration(param->packet_size, param->rate_kbps);
 
-		shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t");
-		print_number(sh, param->rate_kbps, KBPS, KBPS_UNIT);
-		shell_fprintf(sh, SHELL_NORMAL, "\n");
+		if (param->rate_pps == 0U) {
+			shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t");
+			print_number(sh, param->rate_kbps, KBPS, KBPS_UNIT);
+			shell_fprintf(sh, SHELL_NORMAL, "\n");
+		}
 
 		if (packet_duration > 1000U) {
 			shell_fprintf(sh, SHELL_NORMAL, "Packet duration %u ms\n",
@@ -796,6 +890,7 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 	struct sockaddr_in ipv4 = { .sin_family = AF_INET };
 	char *port_str;
 	bool async = false;
+	bool json = false;
 	bool is_udp;
 	int start = 0;
 	size_t opt_cnt = 0;
@@ -866,6 +961,46 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+		case 'P': {
+			int streams = parse_arg(&i, argc, argv);
+
+			if (streams < 1 || streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			param.num_streams = streams;
+			opt_cnt += 2;
+			break;
+		}
+
+		case 'R': {
+			int pps;
+
+			if (!is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "TCP does not support -R option\n");
+				return -ENOEXEC;
+			}
+
+			pps = parse_arg(&i, argc, argv);
+			if (pps <= 0) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			param.rate_pps = pps;
+			opt_cnt += 2;
+			break;
+		}
+
+		case 'J':
+			json = true;
+			opt_cnt += 1;
+			break;
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -994,6 +1129,8 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 		param.rate_kbps = DEF_RATE_KBPS;
 	}
 
+	upload_json = json;
+
 	return execute_upload(sh, &param, is_udp, async);
 }
 
@@ -1014,6 +1151,7 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 	sa_family_t family;
 	uint8_t is_udp;
 	bool async = false;
+	bool json = false;
 	int start = 0;
 	size_t opt_cnt = 0;
 
@@ -1081,6 +1219,46 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+		case 'P': {
+			int streams = parse_arg(&i, argc, argv);
+
+			if (streams < 1 || streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			param.num_streams = streams;
+			opt_cnt += 2;
+			break;
+		}
+
+		case 'R': {
+			int pps;
+
+			if (!is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "TCP does not support -R option\n");
+				return -ENOEXEC;
+			}
+
+			pps = parse_arg(&i, argc, argv);
+			if (pps <= 0) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s\n", argv[i]);
+				return -ENOEXEC;
+			}
+
+			param.rate_pps = pps;
+			opt_cnt += 2;
+			break;
+		}
+
+		case 'J':
+			json = true;
+			opt_cnt += 1;
+			break;
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -1162,6 +1340,8 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 		param.rate_kbps = DEF_RATE_KBPS;
 	}
 
+	upload_json = json;
+
 	return execute_upload(sh, &param, is_udp, async);
 }
 
@@ -1225,6 +1405,11 @@ static void tcp_session_cb(enum zperf_status status,
 	case ZPERF_SESSION_FINISHED: {
 		uint32_t rate_in_kbps;
 
+		if (tcp_download_json) {
+			print_results_json(sh, "tcp", result);
+			break;
+		}
+
 		/* Compute baud rate */
 		if (result->time_in_us != 0U) {
 			rate_in_kbps = (uint32_t)
@@ -1274,10 +1459,11 @@ static int cmd_tcp_download(const struct shell *sh, size_t argc,
 {
 	if (IS_ENABLED(CONFIG_NET_TCP)) {
 		struct zperf_download_params param = { 0 };
+		bool json = false;
 		int ret;
 		int start;
 
-		start = shell_cmd_download(sh, argc, argv, &param);
+		start = shell_cmd_download(sh, argc, argv, &param, &json);
 		if (start < 0) {
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unable to parse option.\n");
@@ -1292,6 +1478,8 @@ static int cmd_tcp_download(const struct shell *sh, size_t argc,
 			return -ENOEXEC;
 		}
 
+		tcp_download_json = json;
+
 		ret = zperf_tcp_download(&param, tcp_session_cb, (void *)sh);
 		if (ret == -EALREADY) {
 			shell_fprintf(sh, SHELL_WARNING,
@@ -1394,6 +1582,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
+		  "-P streams: Number of parallel streams\n"
+		  "-J: Print the results as JSON\n"
 		  "Example: tcp upload 192.0.2.2 1111 1 1K\n"
 		  "Example: tcp upload 2001:db8::2\n",
 		  cmd_tcp_upload),
@@ -1412,6 +1602,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
+		  "-P streams: Number of parallel streams\n"
+		  "-J: Print the results as JSON\n"
 		  "Example: tcp upload2 v6 1 1K\n"
 		  "Example: tcp upload2 v4\n"
 		  "-n: Disable Nagle's algorithm\n"
@@ -1426,8 +1618,11 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  ,
 		  cmd_tcp_upload2),
 	SHELL_CMD(download, &zperf_cmd_tcp_download,
+		  "[<options>] command options (optional): [-J]\n"
 		  "[<port>]:  Server port to listen on/connect to\n"
 		  "[<host>]:  Bind to <host>, an interface address\n"
+		  "Available options:\n"
+		  "-J: Print the results as JSON\n"
 		  "Example: tcp download 5001 192.168.0.1\n",
 		  cmd_tcp_download),
 	SHELL_SUBCMD_SET_END
@@ -1459,6 +1654,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
 		  "-I: Specify host interface name\n"
+		  "-P streams: Number of parallel streams\n"
+		  "-R pps: Send packets at a fixed rate, overriding <baud rate>\n"
+		  "-J: Print the results as JSON\n"
 		  "Example: udp upload 192.0.2.2 1111 1 1K 1M\n"
 		  "Example: udp upload 2001:db8::2\n",
 		  cmd_udp_upload),
@@ -1480,6 +1678,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
 		  "-I: Specify host interface name\n"
+		  "-P streams: Number of parallel streams\n"
+		  "-R pps: Send packets at a fixed rate, overriding <baud rate>\n"
+		  "-J: Print the results as JSON\n"
 		  "Example: udp upload2 v4 1 1K 1M\n"
 		  "Example: udp upload2 v6\n"
 #if defined(CONFIG_NET_IPV6) && defined(MY_IP6ADDR_SET)
@@ -1498,6 +1699,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "[<host>]:  Bind to <host>, an interface address\n"
 		  "Available options:\n"
 		  "-I <interface name>: Specify host interface name\n"
+		  "-J: Print the results as JSON\n"
 		  "Example: udp download 5001 192.168.0.1\n",
 		  cmd_udp_download),
 	SHELL_SUBCMD_SET_END
@@ -16,7 +16,8 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 #include "zperf_internal.h"
 
-static char sample_packet[PACKET_SIZE_MAX];
+/* One packet buffer per stream */
+static char sample_packets[CONFIG_NET_ZPERF_MAX_STREAMS][PACKET_SIZE_MAX];
 
 static struct zperf_async_upload_context tcp_async_upload_ctx;
 
@@ -36,7 +37,7 @@ static ssize_t sendall(int sock, const void *buf, size_t len)
 	return 0;
 }
 
-static int tcp_upload(int sock,
+static int tcp_upload(int sock, char *sample_packet,
 		      unsigned int duration_in_ms,
 		      unsigned int packet_size,
 		      struct zperf_results *results)
@@ -56,7 +57,7 @@ static int tcp_upload(int sock,
 	/* Start the loop */
 	start_time = k_uptime_ticks();
 
-	(void)memset(sample_packet, 'z', sizeof(sample_packet));
+	(void)memset(sample_packet, 'z', PACKET_SIZE_MAX);
 
 	/* Set the "flags" field in start of the packet to be 0.
 	 * As the protocol is not properly described anywhere, it is
@@ -122,16 +123,12 @@ static int tcp_upload(int sock,
 	return 0;
 }
 
-int zperf_tcp_upload(const struct zperf_upload_params *param,
-		     struct zperf_results *result)
+static int tcp_upload_stream(const struct zperf_upload_params *param,
+			     int stream, struct zperf_results *result)
 {
 	int sock;
 	int ret;
 
-	if (param == NULL || result == NULL) {
-		return -EINVAL;
-	}
-
 	sock = zperf_prepare_upload_sock(&param->peer_addr, param->options.tos,
 					 param->options.priority, IPPROTO_TCP);
 	if (sock < 0) {
@@ -143,16 +140,28 @@ int zperf_tcp_upload(const struct zperf_upload_params *param,
 			     &param->options.tcp_nodelay,
 			     sizeof(param->options.tcp_nodelay)) != 0) {
 		NET_WARN("Failed to set IPPROTO_TCP - TCP_NODELAY socket option.");
+		zsock_close(sock);
 		return -EINVAL;
 	}
 
-	ret = tcp_upload(sock, param->duration_ms, param->packet_size, result);
+	ret = tcp_upload(sock, sample_packets[stream], param->duration_ms,
+			 param->packet_size, result);
 
 	zsock_close(sock);
 
 	return ret;
 }
 
+int zperf_tcp_upload(const struct zperf_upload_params *param,
+		     struct zperf_results *result)
+{
+	if (param == NULL || result == NULL) {
+		return -EINVAL;
+	}
+
+	return zperf_upload_streams(param, tcp_upload_stream, result);
+}
+
 static void tcp_upload_async_work(struct k_work *work)
 {
 	struct zperf_async_upload_context *upload_ctx =
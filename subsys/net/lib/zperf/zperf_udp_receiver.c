@@ -183,12 +183,21 @@ static void udp_received(int sock, const struct sockaddr *addr, uint8_t *data,
 			results.time_in_us = duration;
 			results.jitter_in_us = session->jitter;
 			results.packet_size = session->length / session->counter;
+#if defined(CONFIG_NET_ZPERF_LATENCY_HISTOGRAM)
+			results.latency_p50_us = zperf_session_latency_get(session, 500U);
+			results.latency_p99_us = zperf_session_latency_get(session, 990U);
+			results.latency_p999_us = zperf_session_latency_get(session, 999U);
+#endif
 
 			if (udp_session_cb != NULL) {
 				udp_session_cb(ZPERF_SESSION_FINISHED, &results,
 					       udp_user_data);
 			}
 		} else {
+#if defined(CONFIG_NET_ZPERF_LATENCY_HISTOGRAM)
+			int64_t latency;
+#endif
+
 			/* Update counter */
 			session->counter++;
 			session->length += datalen;
@@ -212,6 +221,15 @@ static void udp_received(int sock, const struct sockaddr *addr, uint8_t *data,
 
 			session->last_transit_time = transit_time;
 
+#if defined(CONFIG_NET_ZPERF_LATENCY_HISTOGRAM)
+			/* Only meaningful if the sender shares our clock */
+			latency = (int64_t)k_ticks_to_us_floor64(time) -
+				  ((int64_t)ntohl(hdr->tv_sec) * USEC_PER_SEC +
+				   ntohl(hdr->tv_usec));
+
+			zperf_session_latency_add(session, MAX(latency, 0));
+#endif
+
 			/* Check header id */
 			if (id != session->next_id) {
 				if (id < session->next_id) {
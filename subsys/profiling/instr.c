@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/profiling/instr.h>
+
+#define __no_instrument __attribute__((no_instrument_function))
+
+static struct instr_event instr_events[CONFIG_PROFILING_INSTR_BUFFER_SIZE];
+/* Slots whose event has been written. A slot is reserved before it is
+ * written, so capture can be stopped in between by another context.
+ */
+static ATOMIC_DEFINE(instr_valid, CONFIG_PROFILING_INSTR_BUFFER_SIZE);
+static atomic_t instr_idx;
+static atomic_t instr_lost;
+static atomic_t instr_running;
+
+/* Values of instr_running. Capture is claimed while the buffer is cleared,
+ * so that concurrent starts do not clear a running capture.
+ */
+#define INSTR_STOPPED 0
+#define INSTR_RUNNING 1
+#define INSTR_STARTING 2
+
+/* Called for every function entry and exit, from any context. Slots are
+ * reserved atomically so that threads, interrupts and CPUs record to the
+ * same buffer, in the order they reached it.
+ */
+static __no_instrument void instr_record(enum instr_event_type type, void *func,
+					 void *call_site)
+{
+	struct instr_event *event;
+	atomic_val_t idx;
+
+	if (atomic_get(&instr_running) != INSTR_RUNNING) {
+		return;
+	}
+
+	/* Check before reserving, so that the index does not keep growing
+	 * once the buffer is full.
+	 */
+	if ((size_t)atomic_get(&instr_idx) >= ARRAY_SIZE(instr_events)) {
+		atomic_inc(&instr_lost);
+		return;
+	}
+
+	idx = atomic_inc(&instr_idx);
+	if ((size_t)idx >= ARRAY_SIZE(instr_events)) {
+		atomic_inc(&instr_lost);
+		return;
+	}
+
+	event = &instr_events[idx];
+	event->func = (uintptr_t)func;
+	event->call_site = (uintptr_t)call_site;
+	event->thread = _current;
+	event->timestamp = k_cycle_get_32();
+	event->type = type;
+
+	atomic_set_bit(instr_valid, idx);
+}
+
+__no_instrument void __cyg_profile_func_enter(void *func, void *call_site)
+{
+	instr_record(INSTR_EVENT_ENTRY, func, call_site);
+}
+
+__no_instrument void __cyg_profile_func_exit(void *func, void *call_site)
+{
+	instr_record(INSTR_EVENT_EXIT, func, call_site);
+}
+
+int instr_start(void)
+{
+	if (!atomic_cas(&instr_running, INSTR_STOPPED, INSTR_STARTING)) {
+		return -EALREADY;
+	}
+
+	atomic_clear(&instr_idx);
+	atomic_clear(&instr_lost);
+
+	for (size_t i = 0; i < ARRAY_SIZE(instr_valid); i++) {
+		atomic_clear(&instr_valid[i]);
+	}
+
+	atomic_set(&instr_running, INSTR_RUNNING);
+
+	return 0;
+}
+
+int instr_stop(void)
+{
+	if (!atomic_cas(&instr_running, INSTR_RUNNING, INSTR_STOPPED)) {
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+int instr_events_foreach(instr_event_cb_t cb, void *user_data)
+{
+	size_t reserved;
+	int count = 0;
+
+	if (atomic_get(&instr_running) != INSTR_STOPPED) {
+		return -EBUSY;
+	}
+
+	reserved = MIN((size_t)atomic_get(&instr_idx), ARRAY_SIZE(instr_events));
+
+	for (size_t i = 0; i < reserved; i++) {
+		if (!atomic_test_bit(instr_valid, i)) {
+			continue;
+		}
+
+		cb(&instr_events[i], user_data);
+		count++;
+	}
+
+	return count;
+}
+
+uint32_t instr_lost_get(void)
+{
+	return atomic_get(&instr_lost);
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/profiling/instr.h>
+
+#include "profiling_shell.h"
+
+static int cmd_instr_start(const struct shell *sh, size_t argc, char *argv[])
+{
+	int ret;
+
+	ret = instr_start();
+	if (ret < 0) {
+		shell_error(sh, "Cannot start capture: %d", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_instr_stop(const struct shell *sh, size_t argc, char *argv[])
+{
+	int ret;
+
+	ret = instr_stop();
+	if (ret < 0) {
+		shell_error(sh, "Cannot stop capture: %d", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+static void event_print(const struct instr_event *event, void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_print(sh, "%s %u %p %#lx %#lx",
+		    event->type == INSTR_EVENT_ENTRY ? "entry" : "exit",
+		    event->timestamp, event->thread, (unsigned long)event->func,
+		    (unsigned long)event->call_site);
+}
+
+static int cmd_instr_dump(const struct shell *sh, size_t argc, char *argv[])
+{
+	int count;
+
+	shell_print(sh, "cycles %u", sys_clock_hw_cycles_per_sec());
+
+	count = instr_events_foreach(event_print, (void *)sh);
+	if (count < 0) {
+		shell_error(sh, "Cannot dump while capturing: %d", count);
+		return count;
+	}
+
+	profiling_shell_threads_print(sh);
+
+	shell_print(sh, "%d events, %u lost", count, instr_lost_get());
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_instr_cmds,
+	SHELL_CMD_ARG(start, NULL, "Start capture, discarding previous events",
+		      cmd_instr_start, 1, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop capture", cmd_instr_stop, 1, 0),
+	SHELL_CMD_ARG(dump, NULL,
+		      "Print the events, to be converted with "
+		      "scripts/profiling/instr_report.py",
+		      cmd_instr_dump, 1, 0),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(instr, &sub_instr_cmds, "Function instrumentation commands", NULL);
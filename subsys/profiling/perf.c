@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/profiling/perf.h>
+
+/* Samples are stored as the number of entries of the stack trace and the
+ * interrupted thread, followed by the stack trace.
+ */
+#define SAMPLE_HDR_WORDS 2
+#define SAMPLE_MAX_WORDS (SAMPLE_HDR_WORDS + CONFIG_PROFILING_PERF_STACK_DEPTH)
+
+BUILD_ASSERT(CONFIG_PROFILING_PERF_BUFFER_SIZE >= SAMPLE_MAX_WORDS,
+	     "CONFIG_PROFILING_PERF_BUFFER_SIZE cannot hold a sample");
+
+struct perf_cpu_buffer {
+	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
+	size_t idx;
+	uint32_t lost;
+};
+
+static struct perf_cpu_buffer perf_buffers[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t perf_running;
+
+static void perf_sample(struct k_timer *timer)
+{
+	struct perf_cpu_buffer *cpu_buf = &perf_buffers[_current_cpu->id];
+	uintptr_t *sample = &cpu_buf->buf[cpu_buf->idx];
+	size_t len;
+
+	ARG_UNUSED(timer);
+
+	if (ARRAY_SIZE(cpu_buf->buf) - cpu_buf->idx < SAMPLE_MAX_WORDS) {
+		cpu_buf->lost++;
+		return;
+	}
+
+	len = arch_perf_current_stack_trace(&sample[SAMPLE_HDR_WORDS],
+					    CONFIG_PROFILING_PERF_STACK_DEPTH);
+	if (len == 0U) {
+		cpu_buf->lost++;
+		return;
+	}
+
+	sample[0] = len;
+	sample[1] = (uintptr_t)_current;
+	cpu_buf->idx += SAMPLE_HDR_WORDS + len;
+}
+
+static K_TIMER_DEFINE(perf_timer, perf_sample, NULL);
+
+int perf_start(uint32_t frequency)
+{
+	k_timeout_t period;
+
+	/* The period is in whole microseconds */
+	if ((frequency == 0U) || (frequency > USEC_PER_SEC)) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&perf_running, 0, 1)) {
+		return -EALREADY;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(perf_buffers); i++) {
+		perf_buffers[i].idx = 0;
+		perf_buffers[i].lost = 0;
+	}
+
+	period = K_USEC(USEC_PER_SEC / frequency);
+	k_timer_start(&perf_timer, period, period);
+
+	return 0;
+}
+
+int perf_stop(void)
+{
+	if (!atomic_cas(&perf_running, 1, 0)) {
+		return -EALREADY;
+	}
+
+	k_timer_stop(&perf_timer);
+
+	return 0;
+}
+
+int perf_samples_foreach(perf_sample_cb_t cb, void *user_data)
+{
+	int count = 0;
+
+	if (atomic_get(&perf_running)) {
+		return -EBUSY;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(perf_buffers); i++) {
+		struct perf_cpu_buffer *cpu_buf = &perf_buffers[i];
+		size_t idx = 0;
+
+		while (idx < cpu_buf->idx) {
+			struct perf_sample sample = {
+				.cpu = i,
+				.thread = (const struct k_thread *)cpu_buf->buf[idx + 1],
+				.trace = &cpu_buf->buf[idx + SAMPLE_HDR_WORDS],
+				.len = cpu_buf->buf[idx],
+			};
+
+			cb(&sample, user_data);
+			idx += SAMPLE_HDR_WORDS + sample.len;
+			count++;
+		}
+	}
+
+	return count;
+}
+
+uint32_t perf_lost_get(void)
+{
+	uint32_t lost = 0;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(perf_buffers); i++) {
+		lost += perf_buffers[i].lost;
+	}
+
+	return lost;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/profiling/perf.h>
+
+#include "profiling_shell.h"
+
+#define PERF_DEFAULT_FREQUENCY 100
+
+static int cmd_perf_start(const struct shell *sh, size_t argc, char *argv[])
+{
+	uint32_t frequency = PERF_DEFAULT_FREQUENCY;
+	int ret;
+
+	if (argc > 1) {
+		frequency = strtoul(argv[1], NULL, 10);
+	}
+
+	ret = perf_start(frequency);
+	if (ret < 0) {
+		shell_error(sh, "Cannot start sampling: %d", ret);
+		return ret;
+	}
+
+	shell_print(sh, "Sampling at %u Hz", frequency);
+
+	return 0;
+}
+
+static int cmd_perf_stop(const struct shell *sh, size_t argc, char *argv[])
+{
+	int ret;
+
+	ret = perf_stop();
+	if (ret < 0) {
+		shell_error(sh, "Cannot stop sampling: %d", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+static void sample_print(const struct perf_sample *sample, void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_fprintf(sh, SHELL_NORMAL, "sample %u %p", sample->cpu, sample->thread);
+
+	for (size_t i = 0; i < sample->len; i++) {
+		shell_fprintf(sh, SHELL_NORMAL, " %#lx", (unsigned long)sample->trace[i]);
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+}
+
+static int cmd_perf_dump(const struct shell *sh, size_t argc, char *argv[])
+{
+	int count;
+
+	count = perf_samples_foreach(sample_print, (void *)sh);
+	if (count < 0) {
+		shell_error(sh, "Cannot dump while sampling: %d", count);
+		return count;
+	}
+
+	profiling_shell_threads_print(sh);
+
+	shell_print(sh, "%d samples, %u lost", count, perf_lost_get());
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+	sub_perf_cmds,
+	SHELL_CMD_ARG(start, NULL,
+		      "Start sampling, discarding previous samples\n"
+		      "Usage: start [frequency in Hz]",
+		      cmd_perf_start, 1, 1),
+	SHELL_CMD_ARG(stop, NULL, "Stop sampling", cmd_perf_stop, 1, 0),
+	SHELL_CMD_ARG(dump, NULL,
+		      "Print the samples, to be converted with "
+		      "scripts/profiling/stackcollapse.py",
+		      cmd_perf_dump, 1, 0),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(perf, &sub_perf_cmds, "Sampling profiler commands", NULL);
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include "profiling_shell.h"
+
+#ifdef CONFIG_THREAD_MONITOR
+static void thread_print(const struct k_thread *thread, void *user_data)
+{
+	const struct shell *sh = user_data;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	if ((name != NULL) && (name[0] != '\0')) {
+		shell_print(sh, "thread %p %s", thread, name);
+	}
+}
+#endif
+
+void profiling_shell_threads_print(const struct shell *sh)
+{
+#ifdef CONFIG_THREAD_MONITOR
+	k_thread_foreach_unlocked(thread_print, (void *)sh);
+#else
+	ARG_UNUSED(sh);
+#endif
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_PROFILING_PROFILING_SHELL_H_
+#define ZEPHYR_SUBSYS_PROFILING_PROFILING_SHELL_H_
+
+#include <zephyr/shell/shell.h>
+
+/**
+ * @brief Print the address and name of the named threads.
+ *
+ * Used by the dump commands, so that the scripts converting the dumps can
+ * name the threads. Nothing is printed without CONFIG_THREAD_MONITOR.
+ *
+ * @param sh Shell instance.
+ */
+void profiling_shell_threads_print(const struct shell *sh);
+
+#endif /* ZEPHYR_SUBSYS_PROFILING_PROFILING_SHELL_H_ */
@@ -151,6 +151,11 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 		shell_print(sh, "\tTotal execution cycles: %u (%u %%)",
 			    (uint32_t)rt_stats_thread.execution_cycles,
 			    pcnt);
+#ifdef CONFIG_SCHED_USAGE_MONITOR
+		shell_print(sh, "\tLoad over last window: %u.%u %%",
+			    rt_stats_thread.window_load / 10U,
+			    rt_stats_thread.window_load % 10U);
+#endif
 #ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
 		shell_print(sh, "\tCurrent execution cycles: %u",
 			    (uint32_t)rt_stats_thread.current_cycles);
@@ -274,6 +279,91 @@ static int cmd_kernel_stacks(const struct shell *sh,
 }
 #endif
 
+#if defined(CONFIG_SCHED_USAGE_MONITOR)
+struct load_thread_find {
+	const struct k_thread *thread;
+	const char *name;
+};
+
+static void load_thread_find(const struct k_thread *thread, void *user_data)
+{
+	struct load_thread_find *find = (struct load_thread_find *)user_data;
+
+	if (thread == find->thread) {
+		find->name = k_thread_name_get((struct k_thread *)thread);
+	}
+}
+
+static void load_window_print(const struct shell *sh, const struct k_usage_window *window)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	shell_print(sh, "Window ending at %u ms:", window->end_ms);
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+#if defined(CONFIG_SCHED_USAGE_MONITOR_ISR)
+		shell_print(sh, "\tCPU %u: %3u.%u %%, in interrupts %3u.%u %%", i,
+			    window->cpu_load[i] / 10U, window->cpu_load[i] % 10U,
+			    window->isr_load[i] / 10U, window->isr_load[i] % 10U);
+#else
+		shell_print(sh, "\tCPU %u: %3u.%u %%", i,
+			    window->cpu_load[i] / 10U, window->cpu_load[i] % 10U);
+#endif
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(window->threads); i++) {
+		const struct k_usage_window_thread *top = &window->threads[i];
+		struct load_thread_find find = { .thread = top->thread };
+
+		if (top->thread == NULL) {
+			break;
+		}
+
+		/* The thread may have exited since the end of the window */
+		k_thread_foreach_unlocked(load_thread_find, &find);
+
+		shell_print(sh, "\tThread %p %-10s %3u.%u %%", top->thread,
+			    find.name ? find.name : "NA", top->load / 10U, top->load % 10U);
+	}
+
+#if defined(CONFIG_SCHED_USAGE_MONITOR_ISR)
+	for (size_t i = 0; i < ARRAY_SIZE(window->isrs); i++) {
+		const struct k_usage_window_isr *top = &window->isrs[i];
+
+		if (top->load == 0U) {
+			break;
+		}
+
+		shell_print(sh, "\tIRQ %-4u %3u.%u %%", top->irq, top->load / 10U, top->load % 10U);
+	}
+#endif
+}
+
+static int cmd_kernel_load(const struct shell *sh,
+			   size_t argc, char **argv)
+{
+	struct k_usage_window window;
+	unsigned int count = 1;
+
+	if (argc > 1) {
+		count = strtoul(argv[1], NULL, 10);
+	}
+
+	for (unsigned int age = 0; age < count; age++) {
+		if (k_usage_monitor_window_get(age, &window) != 0) {
+			if (age == 0U) {
+				shell_print(sh, "No window completed yet");
+			}
+			break;
+		}
+
+		load_window_print(sh, &window);
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (K_HEAP_MEM_POOL_SIZE > 0)
 extern struct sys_heap _system_heap;
 
@@ -400,6 +490,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 #endif
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (K_HEAP_MEM_POOL_SIZE > 0)
 	SHELL_CMD(heap, NULL, "System heap usage statistics.", cmd_kernel_heap),
+#endif
+#if defined(CONFIG_SCHED_USAGE_MONITOR)
+	SHELL_CMD_ARG(load, NULL, "Load over the last windows, newest first.\n"
+		      "Usage: load [number of windows]", cmd_kernel_load, 1, 1),
 #endif
 	SHELL_CMD_ARG(uptime, NULL, "Kernel uptime. Can be called with the -p or --pretty options",
 		      cmd_kernel_uptime, 1, 1),
@@ -8,13 +8,36 @@
 #include <stdio.h>
 #include <errno.h>
 #include <zephyr/types.h>
+#include <zephyr/sys/util.h>
 #include <zephyr/stats/stats.h>
 
 #define STATS_GEN_NAME_MAX_LEN  (sizeof("s255"))
 
+/* Offset of the entries of the first CPU from the header, and distance
+ * between the entries of consecutive CPUs, as laid out by STATS_SECT_START()
+ * and STATS_SECT_END().
+ */
+#ifdef CONFIG_STATS_PER_CPU
+#define STATS_NUM_COPIES CONFIG_MP_MAX_NUM_CPUS
+#define STATS_ENTRIES_OFF \
+	ROUND_UP(sizeof(struct stats_hdr), CONFIG_STATS_PER_CPU_ALIGNMENT)
+#define STATS_CPU_STRIDE(hdr) \
+	ROUND_UP((hdr)->s_size * (hdr)->s_cnt, CONFIG_STATS_PER_CPU_ALIGNMENT)
+#else
+#define STATS_NUM_COPIES 1
+#define STATS_ENTRIES_OFF sizeof(struct stats_hdr)
+#define STATS_CPU_STRIDE(hdr) ((hdr)->s_size * (hdr)->s_cnt)
+#endif
+
 /* The global list of registered statistic groups. */
 static struct stats_hdr *stats_list;
 
+static uint16_t
+stats_get_off(const struct stats_hdr *hdr, int idx)
+{
+	return (uint16_t) (STATS_ENTRIES_OFF + idx * (int) hdr->s_size);
+}
+
 static const char *
 stats_get_name(const struct stats_hdr *hdr, int idx)
 {
@@ -28,7 +51,7 @@ stats_get_name(const struct stats_hdr *hdr, int idx)
 	 * offset.  This annotation allows for naming only certain statistics,
 	 * and doesn't enforce ordering restrictions on the stats name map.
 	 */
-	off = sizeof(*hdr) + idx * hdr->s_size;
+	off = stats_get_off(hdr, idx);
 	for (i = 0; i < hdr->s_map_cnt; i++) {
 		cur = hdr->s_map + i;
 		if (cur->snm_off == off) {
@@ -40,12 +63,6 @@ stats_get_name(const struct stats_hdr *hdr, int idx)
 	return NULL;
 }
 
-static uint16_t
-stats_get_off(const struct stats_hdr *hdr, int idx)
-{
-	return (uint16_t) (sizeof(*hdr) + idx * (int) hdr->s_size);
-}
-
 /**
  * Creates a generic name for an unnamed stat.  The name has the form:
  *     s<idx>
@@ -117,6 +134,36 @@ stats_walk(struct stats_hdr *hdr, stats_walk_fn *walk_func, void *arg)
 	return 0;
 }
 
+/**
+ * Get the value of the entry at the given offset, summing the copies of the
+ * CPUs.  The sum wraps around like a single entry of the same size would.
+ */
+uint64_t
+stats_value_get(const struct stats_hdr *hdr, uint16_t off)
+{
+	const uint8_t *addr = (const uint8_t *)hdr + off;
+	uint64_t val = 0;
+	int i;
+
+	for (i = 0; i < STATS_NUM_COPIES; i++) {
+		switch (hdr->s_size) {
+		case sizeof(uint16_t):
+			val = (uint16_t)(val + *(const uint16_t *)addr);
+			break;
+		case sizeof(uint32_t):
+			val = (uint32_t)(val + *(const uint32_t *)addr);
+			break;
+		case sizeof(uint64_t):
+			val += *(const uint64_t *)addr;
+			break;
+		}
+
+		addr += STATS_CPU_STRIDE(hdr);
+	}
+
+	return val;
+}
+
 /**
  * Initialize a statistics structure, pointed to by hdr.
  *
@@ -280,5 +327,6 @@ stats_init_and_reg(struct stats_hdr *shdr, uint8_t size, uint16_t cnt,
 void
 stats_reset(struct stats_hdr *hdr)
 {
-	(void)memset((uint8_t *)hdr + sizeof(*hdr), 0, hdr->s_size * hdr->s_cnt);
+	(void)memset((uint8_t *)hdr + STATS_ENTRIES_OFF, 0,
+		     STATS_CPU_STRIDE(hdr) * STATS_NUM_COPIES);
 }
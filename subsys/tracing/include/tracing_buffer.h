@@ -9,6 +9,7 @@
 
 #include <stdbool.h>
 #include <zephyr/types.h>
+#include <zephyr/tracing/tracing_format.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -113,6 +114,34 @@ uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
  */
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data);
 
+/**
+ * @brief Initialize per-CPU tracing buffers.
+ */
+void tracing_cpu_buffer_init(void);
+
+/**
+ * @brief Put a tracing packet to the buffer of the current CPU.
+ *
+ * @param tracing_data_array Tracing_data format data array of the packet.
+ * @param count Tracing_data array data count.
+ * @param before_put_is_empty Set to true if the buffer was empty before
+ *                            this put.
+ *
+ * @return true if the packet was put to the buffer.
+ */
+bool tracing_cpu_buffer_put(tracing_data_t *tracing_data_array, uint32_t count,
+			    bool *before_put_is_empty);
+
+/**
+ * @brief Move packets from the per-CPU buffers to the tracing buffer.
+ *
+ * Packets are moved in timestamp order, until the per-CPU buffers are empty
+ * or the tracing buffer is full.
+ *
+ * @return Number of bytes moved to the tracing buffer.
+ */
+uint32_t tracing_cpu_buffer_merge(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -65,6 +65,16 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 
 	while (true) {
 		if (tracing_buffer_is_empty()) {
+			/* Packets of the per-CPU buffers are only moved to
+			 * the tracing buffer when dumped in flight recorder
+			 * mode.
+			 */
+			if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS) &&
+			    !IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER) &&
+			    (tracing_cpu_buffer_merge() != 0U)) {
+				continue;
+			}
+
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
 		} else {
 			transferring_length =
@@ -94,6 +104,10 @@ static int tracing_init(void)
 
 	tracing_buffer_init();
 
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		tracing_cpu_buffer_init();
+	}
+
 	working_backend = tracing_backend_get(TRACING_BACKEND_NAME);
 	tracing_backend_init(working_backend);
 
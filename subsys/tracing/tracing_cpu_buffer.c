@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DISABLE_SYSCALL_TRACING
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <tracing_core.h>
+#include <tracing_buffer.h>
+
+#define CPU_BUFFER_SIZE CONFIG_TRACING_PER_CPU_BUFFER_SIZE
+#define CPU_BUFFER_MASK (CPU_BUFFER_SIZE - 1)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CPU_BUFFER_SIZE),
+	     "CONFIG_TRACING_PER_CPU_BUFFER_SIZE must be a power of two");
+
+/* Packets are recorded contiguously, as a header followed by the packet
+ * data. A zero length byte marks the end of the data when the next packet
+ * does not fit before the end of the buffer.
+ */
+struct cpu_packet_hdr {
+	uint8_t length;
+	uint32_t timestamp;
+} __packed;
+
+struct cpu_buffer {
+	/* Free-running positions. The write position is only updated by the
+	 * owning CPU. The read position is updated by the tracing thread, or
+	 * by the owning CPU when it overwrites the oldest packets in flight
+	 * recorder mode.
+	 */
+	atomic_t wr;
+	atomic_t rd;
+
+	/* Set while the owning CPU puts a packet, in flight recorder mode. */
+	atomic_t busy;
+
+	uint8_t data[CPU_BUFFER_SIZE];
+};
+
+static struct cpu_buffer cpu_buffers[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Set while the flight recorder is dumped. */
+static atomic_t frozen;
+
+static uint32_t packet_next(struct cpu_buffer *buf, uint32_t pos)
+{
+	uint32_t offset = pos & CPU_BUFFER_MASK;
+	struct cpu_packet_hdr *hdr = (struct cpu_packet_hdr *)&buf->data[offset];
+
+	if (hdr->length == 0U) {
+		return pos + CPU_BUFFER_SIZE - offset;
+	}
+
+	return pos + sizeof(*hdr) + hdr->length;
+}
+
+static struct cpu_packet_hdr *packet_peek(struct cpu_buffer *buf, uint32_t *rd)
+{
+	uint32_t wr = (uint32_t)atomic_get(&buf->wr);
+	uint32_t pos = (uint32_t)atomic_get(&buf->rd);
+
+	if ((pos != wr) && (buf->data[pos & CPU_BUFFER_MASK] == 0U)) {
+		pos = packet_next(buf, pos);
+	}
+
+	if (pos == wr) {
+		return NULL;
+	}
+
+	*rd = pos;
+
+	return (struct cpu_packet_hdr *)&buf->data[pos & CPU_BUFFER_MASK];
+}
+
+/* Find the oldest packet across the CPUs. Timestamps wrap around, so they
+ * are compared by their difference.
+ */
+static struct cpu_buffer *packet_oldest(struct cpu_packet_hdr **oldest, uint32_t *rd)
+{
+	struct cpu_buffer *oldest_buf = NULL;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct cpu_packet_hdr *hdr;
+		uint32_t pos;
+
+		hdr = packet_peek(&cpu_buffers[i], &pos);
+		if (hdr == NULL) {
+			continue;
+		}
+
+		if ((oldest_buf == NULL) ||
+		    ((int32_t)(hdr->timestamp - (*oldest)->timestamp) < 0)) {
+			oldest_buf = &cpu_buffers[i];
+			*oldest = hdr;
+			*rd = pos;
+		}
+	}
+
+	return oldest_buf;
+}
+
+void tracing_cpu_buffer_init(void)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(cpu_buffers); i++) {
+		atomic_set(&cpu_buffers[i].wr, 0);
+		atomic_set(&cpu_buffers[i].rd, 0);
+		atomic_set(&cpu_buffers[i].busy, 0);
+	}
+
+	atomic_set(&frozen, 0);
+}
+
+bool tracing_cpu_buffer_put(tracing_data_t *tracing_data_array, uint32_t count,
+			    bool *before_put_is_empty)
+{
+	struct cpu_packet_hdr hdr = {0};
+	struct cpu_buffer *buf;
+	uint32_t length = 0U;
+	uint32_t wr, rd, pad, size;
+	unsigned int key;
+	uint8_t *dst;
+	bool put_success = false;
+
+	for (uint32_t i = 0; i < count; i++) {
+		length += tracing_data_array[i].length;
+	}
+
+	if ((length == 0U) || (length > UINT8_MAX)) {
+		return false;
+	}
+
+	hdr.length = length;
+	size = sizeof(hdr) + length;
+
+	/* Only the local CPU writes to its buffer, so locking local
+	 * interrupts is enough.
+	 */
+	key = arch_irq_lock();
+	buf = &cpu_buffers[_current_cpu->id];
+
+	if (IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+		atomic_set(&buf->busy, 1);
+		if (atomic_get(&frozen)) {
+			goto out;
+		}
+	}
+
+	wr = (uint32_t)atomic_get(&buf->wr);
+	rd = (uint32_t)atomic_get(&buf->rd);
+	*before_put_is_empty = (wr == rd);
+
+	pad = CPU_BUFFER_SIZE - (wr & CPU_BUFFER_MASK);
+	if (pad >= size) {
+		pad = 0U;
+	}
+
+	if ((wr - rd) + pad + size > CPU_BUFFER_SIZE) {
+		if (!IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+			goto out;
+		}
+
+		do {
+			rd = packet_next(buf, rd);
+		} while ((wr - rd) + pad + size > CPU_BUFFER_SIZE);
+
+		atomic_set(&buf->rd, rd);
+	}
+
+	if (pad != 0U) {
+		buf->data[wr & CPU_BUFFER_MASK] = 0U;
+		wr += pad;
+	}
+
+	hdr.timestamp = k_cycle_get_32();
+	dst = &buf->data[wr & CPU_BUFFER_MASK];
+	memcpy(dst, &hdr, sizeof(hdr));
+	dst += sizeof(hdr);
+
+	for (uint32_t i = 0; i < count; i++) {
+		memcpy(dst, tracing_data_array[i].data, tracing_data_array[i].length);
+		dst += tracing_data_array[i].length;
+	}
+
+	atomic_set(&buf->wr, wr + size);
+	put_success = true;
+
+out:
+	if (IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+		atomic_set(&buf->busy, 0);
+	}
+
+	arch_irq_unlock(key);
+
+	return put_success;
+}
+
+uint32_t tracing_cpu_buffer_merge(void)
+{
+	struct cpu_packet_hdr *hdr;
+	struct cpu_buffer *buf;
+	uint32_t moved = 0U;
+	uint32_t rd;
+
+	while ((buf = packet_oldest(&hdr, &rd)) != NULL) {
+		if (tracing_buffer_space_get() < hdr->length) {
+			break;
+		}
+
+		tracing_buffer_put((uint8_t *)(hdr + 1), hdr->length);
+		moved += hdr->length;
+		atomic_set(&buf->rd, rd + sizeof(*hdr) + hdr->length);
+	}
+
+	return moved;
+}
+
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+int tracing_flight_recorder_dump(void)
+{
+	struct cpu_packet_hdr *hdr;
+	struct cpu_buffer *buf;
+	unsigned int key;
+	uint32_t rd;
+	int count = 0;
+
+	if (!atomic_cas(&frozen, 0, 1)) {
+		return -EBUSY;
+	}
+
+	/* Wait for the other CPUs to finish the packet they are putting. The
+	 * current CPU may only be putting one if the dump is called from an
+	 * exception raised while putting it, which must not be waited for.
+	 */
+	key = arch_irq_lock();
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		if (i == _current_cpu->id) {
+			continue;
+		}
+
+		while (atomic_get(&cpu_buffers[i].busy)) {
+			arch_spin_relax();
+		}
+	}
+	arch_irq_unlock(key);
+
+	while ((buf = packet_oldest(&hdr, &rd)) != NULL) {
+		tracing_buffer_handle((uint8_t *)(hdr + 1), hdr->length);
+		atomic_set(&buf->rd, rd + sizeof(*hdr) + hdr->length);
+		count++;
+	}
+
+	atomic_set(&frozen, 0);
+
+	return count;
+}
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DISABLE_SYSCALL_TRACING
+
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <tracing_core.h>
+#include <tracing_buffer.h>
+#include <tracing_format_common.h>
+
+static void tracing_cpu_put(tracing_data_t *tracing_data_array, uint32_t count)
+{
+	bool before_put_is_empty = false;
+
+	if (!tracing_cpu_buffer_put(tracing_data_array, count, &before_put_is_empty)) {
+		tracing_packet_drop_handle();
+	} else if (!IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+		tracing_trigger_output(before_put_is_empty);
+	}
+}
+
+void tracing_format_string(const char *str, ...)
+{
+	char buf[CONFIG_TRACING_PACKET_MAX_SIZE];
+	tracing_data_t tracing_data = {.data = (uint8_t *)buf};
+	va_list args;
+	int length;
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	va_start(args, str);
+	length = vsnprintk(buf, sizeof(buf), str, args);
+	va_end(args);
+
+	if (length <= 0) {
+		return;
+	}
+
+	tracing_data.length = MIN((uint32_t)length, sizeof(buf) - 1);
+	tracing_cpu_put(&tracing_data, 1);
+}
+
+void tracing_format_raw_data(uint8_t *data, uint32_t length)
+{
+	tracing_data_t tracing_data = {.data = data, .length = length};
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	tracing_cpu_put(&tracing_data, 1);
+}
+
+void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
+{
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	tracing_cpu_put(tracing_data_array, count);
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Load the CoAP server with confirmable GET requests over the loopback
+ * interface and report the request rate and the latency percentiles for
+ * the configured number of worker threads. A client keeps a window of
+ * requests outstanding towards a resource whose handler waits for a
+ * simulated backend (e.g. a sensor bus) before replying, so that worker
+ * threads can overlap the waits. The testcase variants build the server
+ * with 0 to 4 workers.
+ *
+ * Time is measured with the system uptime, which advances with the
+ * simulated time on native_sim, so the results only reflect the
+ * handler waits and not the processing cost.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/net/coap_service.h>
+
+#define SERVER_PORT 5683
+#define BACKEND_DELAY_MS 2
+#define WINDOW 8
+#define REQUESTS 256
+
+static const uint16_t bench_port = SERVER_PORT;
+COAP_SERVICE_DEFINE(bench, "127.0.0.1", &bench_port, COAP_SERVICE_AUTOSTART);
+
+static int reply(struct coap_resource *resource, struct coap_packet *request,
+		 struct sockaddr *addr, socklen_t addr_len, const char *payload)
+{
+	uint8_t buf[64];
+	struct coap_packet response;
+	int ret;
+
+	ret = coap_ack_init(&response, request, buf, sizeof(buf),
+			    COAP_RESPONSE_CODE_CONTENT);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = coap_packet_append_payload_marker(&response);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = coap_packet_append_payload(&response, (const uint8_t *)payload,
+					 strlen(payload));
+	if (ret < 0) {
+		return ret;
+	}
+
+	return coap_resource_send(resource, &response, addr, addr_len, NULL);
+}
+
+static int load_get(struct coap_resource *resource, struct coap_packet *request,
+		    struct sockaddr *addr, socklen_t addr_len)
+{
+	k_sleep(K_MSEC(BACKEND_DELAY_MS));
+
+	return reply(resource, request, addr, addr_len, "load");
+}
+
+static int path_get(struct coap_resource *resource, struct coap_packet *request,
+		    struct sockaddr *addr, socklen_t addr_len)
+{
+	return reply(resource, request, addr, addr_len, resource->user_data);
+}
+
+static const char * const load_path[] = { "load", NULL };
+COAP_RESOURCE_DEFINE(res_0_load, bench, {
+	.path = load_path,
+	.get = load_get,
+});
+
+/* Resources are sorted by name, so this wildcard resource is defined before
+ * an exact path it also matches.
+ */
+static const char * const wild_path[] = { "sensors", "+", NULL };
+COAP_RESOURCE_DEFINE(res_1_wild, bench, {
+	.path = wild_path,
+	.get = path_get,
+	.user_data = "wild",
+});
+
+#define SENSOR_RESOURCE(_n)							\
+	static const char * const sensor##_n##_path[] = {			\
+		"sensors", "s" #_n, "value", NULL				\
+	};									\
+	COAP_RESOURCE_DEFINE(res_2_sensor##_n, bench, {				\
+		.path = sensor##_n##_path,					\
+		.get = path_get,						\
+		.user_data = "s" #_n,						\
+	})
+
+SENSOR_RESOURCE(0);
+SENSOR_RESOURCE(1);
+SENSOR_RESOURCE(2);
+SENSOR_RESOURCE(3);
+SENSOR_RESOURCE(4);
+SENSOR_RESOURCE(5);
+SENSOR_RESOURCE(6);
+SENSOR_RESOURCE(7);
+
+static const char * const shadowed_path[] = { "sensors", "shadowed", NULL };
+COAP_RESOURCE_DEFINE(res_3_shadowed, bench, {
+	.path = shadowed_path,
+	.get = path_get,
+	.user_data = "shadowed",
+});
+
+static int sock;
+static uint32_t sent_at[REQUESTS];
+static uint32_t latency[REQUESTS];
+
+static void client_setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	struct timeval timeo = {
+		.tv_sec = 1,
+	};
+	int ret;
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "socket open failed");
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	ret = zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(ret, 0, "connect failed");
+
+	ret = zsock_setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeo, sizeof(timeo));
+	zassert_equal(ret, 0, "setsockopt failed");
+
+	/* The service is started by the server thread */
+	for (int i = 0; i < 100 && coap_service_is_running(&bench) != 1; i++) {
+		k_msleep(10);
+	}
+
+	zassert_equal(coap_service_is_running(&bench), 1, "service not running");
+}
+
+static void send_get(uint16_t id, const char * const *path)
+{
+	uint8_t buf[64];
+	struct coap_packet request;
+	int ret;
+
+	ret = coap_packet_init(&request, buf, sizeof(buf), COAP_VERSION_1,
+			       COAP_TYPE_CON, sizeof(id), (uint8_t *)&id,
+			       COAP_METHOD_GET, id);
+	zassert_equal(ret, 0, "packet init failed");
+
+	for (; *path != NULL; path++) {
+		ret = coap_packet_append_option(&request, COAP_OPTION_URI_PATH,
+						*path, strlen(*path));
+		zassert_equal(ret, 0, "append option failed");
+	}
+
+	ret = zsock_send(sock, request.data, request.offset, 0);
+	zassert_equal(ret, request.offset, "send failed");
+}
+
+static uint16_t recv_response(uint8_t *code, char *payload, size_t payload_len)
+{
+	uint8_t buf[64];
+	struct coap_packet response;
+	const uint8_t *data;
+	uint16_t len;
+	int ret;
+
+	ret = zsock_recv(sock, buf, sizeof(buf), 0);
+	zassert_true(ret > 0, "recv failed (%d)", errno);
+
+	ret = coap_packet_parse(&response, buf, ret, NULL, 0);
+	zassert_equal(ret, 0, "invalid response");
+
+	zassert_equal(coap_header_get_type(&response), COAP_TYPE_ACK, "not an ACK");
+	*code = coap_header_get_code(&response);
+
+	if (payload != NULL) {
+		data = coap_packet_get_payload(&response, &len);
+		len = MIN(len, payload_len - 1);
+		memcpy(payload, data, len);
+		payload[len] = '\0';
+	}
+
+	return coap_header_get_id(&response);
+}
+
+static void check_get(const char * const *path, uint8_t expected_code,
+		      const char *expected_payload)
+{
+	static uint16_t id = REQUESTS;
+	char payload[16] = { 0 };
+	uint8_t code;
+
+	send_get(id, path);
+
+	zassert_equal(recv_response(&code, payload, sizeof(payload)), id,
+		      "unexpected response");
+	zassert_equal(code, expected_code, "unexpected code %u.%02u",
+		      code >> 5, code & 0x1f);
+
+	if (expected_payload != NULL) {
+		zassert_equal(strcmp(payload, expected_payload), 0,
+			      "request for %s handled by %s", path[1], payload);
+	}
+
+	id++;
+}
+
+ZTEST(coap_server_load, test_dispatch)
+{
+	const char * const sensor_path[] = { "sensors", "s5", "value", NULL };
+	const char * const shadowed_req[] = { "sensors", "shadowed", NULL };
+	const char * const wild_req[] = { "sensors", "unknown", NULL };
+	const char * const missing_path[] = { "sensors", "s5", "value", "raw", NULL };
+	const char * const unknown_path[] = { "unknown", NULL };
+
+	check_get(sensor_path, COAP_RESPONSE_CODE_CONTENT, "s5");
+	check_get(wild_req, COAP_RESPONSE_CODE_CONTENT, "wild");
+
+	/* The wildcard resource defined first takes precedence */
+	check_get(shadowed_req, COAP_RESPONSE_CODE_CONTENT, "wild");
+
+	check_get(missing_path, COAP_RESPONSE_CODE_NOT_FOUND, NULL);
+	check_get(unknown_path, COAP_RESPONSE_CODE_NOT_FOUND, NULL);
+}
+
+static void sort(uint32_t *values, int count)
+{
+	for (int i = 1; i < count; i++) {
+		uint32_t value = values[i];
+		int j;
+
+		for (j = i; j > 0 && values[j - 1] > value; j--) {
+			values[j] = values[j - 1];
+		}
+
+		values[j] = value;
+	}
+}
+
+static inline uint32_t percentile(int pct)
+{
+	return k_ticks_to_us_floor32(latency[(REQUESTS * pct) / 100 - 1]);
+}
+
+ZTEST(coap_server_load, test_load)
+{
+	int sent = 0, received = 0;
+	uint32_t start, elapsed;
+	uint8_t code;
+	uint16_t id;
+
+	start = k_uptime_ticks();
+
+	while (received < REQUESTS) {
+		while (sent < REQUESTS && sent - received < WINDOW) {
+			sent_at[sent] = k_uptime_ticks();
+			send_get(sent, load_path);
+			sent++;
+		}
+
+		id = recv_response(&code, NULL, 0);
+		zassert_true(id < sent, "unexpected response %u", id);
+		zassert_equal(code, COAP_RESPONSE_CODE_CONTENT, "request %u failed", id);
+
+		latency[received++] = k_uptime_ticks() - sent_at[id];
+	}
+
+	elapsed = k_uptime_ticks() - start;
+
+	sort(latency, REQUESTS);
+
+	TC_PRINT("%d workers: %u requests in %u ms, %u requests/sec, "
+		 "latency p50 %u us, p99 %u us\n",
+		 CONFIG_COAP_SERVER_WORKERS, REQUESTS, k_ticks_to_ms_floor32(elapsed),
+		 (uint32_t)((uint64_t)REQUESTS * CONFIG_SYS_CLOCK_TICKS_PER_SEC / elapsed),
+		 percentile(50), percentile(99));
+}
+
+static void *setup(void)
+{
+	client_setup();
+
+	return NULL;
+}
+
+ZTEST_SUITE(coap_server_load, NULL, setup, NULL, NULL, NULL);
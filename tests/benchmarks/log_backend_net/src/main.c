@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Log a burst of messages to the networking backend, which sends them over
+ * the loopback interface to a syslog server socket, and report the number
+ * of datagrams and messages received per second and the cycles spent per
+ * message. With CONFIG_LOG_BACKEND_NET_BATCH the server splits datagrams
+ * into messages using their octet count.
+ *
+ * On native_sim the cycle counter does not advance while code executes, so
+ * there only the datagram and message rates are reported.
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/ztest.h>
+
+#define SERVER_PORT 5140
+#define BURST_LOGS 2000
+#define BURST_PERIOD_US 100
+#define IDLE_TIMEOUT_MS 200
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+static int server_sock = -1;
+static uint8_t server_buf[2048];
+static uint32_t datagrams;
+static uint32_t messages;
+static int64_t last_rx;
+
+/* Count the messages of a datagram, framed with their octet count when the
+ * backend sends batches.
+ */
+static uint32_t count_messages(const uint8_t *buf, size_t len)
+{
+	uint32_t count = 0;
+	size_t offset = 0;
+
+	if (!IS_ENABLED(CONFIG_LOG_BACKEND_NET_BATCH)) {
+		return 1;
+	}
+
+	while (offset < len) {
+		char *end;
+		unsigned long msg_len;
+
+		msg_len = strtoul((const char *)&buf[offset], &end, 10);
+		if ((end == (const char *)&buf[offset]) || (*end != ' ')) {
+			break;
+		}
+
+		offset = (const uint8_t *)end - buf + 1 + msg_len;
+		count++;
+	}
+
+	return count;
+}
+
+static void server_func(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		ssize_t len;
+
+		len = zsock_recv(server_sock, server_buf, sizeof(server_buf) - 1, 0);
+		if (len <= 0) {
+			return;
+		}
+
+		server_buf[len] = '\0';
+		datagrams++;
+		messages += count_messages(server_buf, len);
+		last_rx = k_uptime_ticks();
+	}
+}
+
+K_THREAD_STACK_DEFINE(server_stack, 2048);
+static struct k_thread server_thread;
+
+static void wait_idle(void)
+{
+	uint32_t count;
+
+	do {
+		count = datagrams;
+		k_msleep(IDLE_TIMEOUT_MS);
+	} while (count != datagrams);
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int ret;
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	server_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(server_sock >= 0, "cannot create server socket");
+
+	ret = zsock_bind(server_sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_ok(ret, "cannot bind server socket");
+
+	k_thread_create(&server_thread, server_stack, K_THREAD_STACK_SIZEOF(server_stack),
+			server_func, NULL, NULL, NULL, K_PRIO_COOP(7), 0, K_NO_WAIT);
+
+	/* Let the backend get started by the log processing thread. */
+	k_msleep(100);
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	zsock_close(server_sock);
+}
+
+ZTEST(log_backend_net, test_burst)
+{
+	k_thread_runtime_stats_t before, after;
+	uint64_t cycles;
+	int64_t start;
+	uint64_t us;
+
+	(void)k_thread_runtime_stats_all_get(&before);
+	start = k_uptime_ticks();
+
+	for (int i = 0; i < BURST_LOGS; i++) {
+		LOG_INF("burst message %d of %d", i, BURST_LOGS);
+		k_usleep(BURST_PERIOD_US);
+	}
+
+	wait_idle();
+
+	(void)k_thread_runtime_stats_all_get(&after);
+	zassert_true(last_rx > start, "nothing received");
+
+	cycles = after.total_cycles - before.total_cycles;
+	us = k_ticks_to_us_floor64(last_rx - start);
+
+	TC_PRINT("%s: %u messages logged in %llu us\n",
+		 IS_ENABLED(CONFIG_LOG_BACKEND_NET_BATCH) ? "batch" : "single",
+		 BURST_LOGS, us);
+	TC_PRINT("received %u datagrams (%llu/s), %u messages (%llu/s)\n",
+		 datagrams, (uint64_t)datagrams * USEC_PER_SEC / us,
+		 messages, (uint64_t)messages * USEC_PER_SEC / us);
+
+	if (cycles == 0U) {
+		TC_PRINT("cycle counter did not advance\n");
+	} else {
+		TC_PRINT("%llu cycles per message\n", cycles / BURST_LOGS);
+	}
+
+	zassert_equal(messages, BURST_LOGS, "messages lost");
+}
+
+ZTEST_SUITE(log_backend_net, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Log a mix of messages to a backend which formats every message as text, as
+ * dictionary-based records, as packed dictionary-based records and as packed
+ * records with delta timestamps, and report the bytes and the cycles spent
+ * per message for each output.
+ *
+ * On native_sim the cycle counter does not advance while code executes, so
+ * there only the size of the output is reported.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
+#include <zephyr/ztest.h>
+
+#define ROUNDS 100
+#define MSGS_PER_ROUND 4
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_DBG);
+
+enum format {
+	FORMAT_TEXT,
+	FORMAT_DICT,
+	FORMAT_PACKED,
+	FORMAT_PACKED_DELTA,
+	FORMAT_COUNT,
+};
+
+static const char *const format_str[] = {
+	[FORMAT_TEXT] = "text",
+	[FORMAT_DICT] = "dictionary",
+	[FORMAT_PACKED] = "packed",
+	[FORMAT_PACKED_DELTA] = "packed delta",
+};
+
+struct format_stats {
+	size_t bytes;
+	uint32_t cycles;
+};
+
+static struct format_stats stats[FORMAT_COUNT];
+static uint32_t msg_count;
+static log_timestamp_t ref_timestamp;
+static bool ref_timestamp_valid;
+
+static int out(uint8_t *data, size_t length, void *ctx)
+{
+	struct format_stats *s = ctx;
+
+	s->bytes += length;
+
+	return length;
+}
+
+static uint8_t text_buf[256];
+static uint8_t dict_buf[256];
+static uint8_t packed_buf[256];
+static uint8_t packed_delta_buf[256];
+
+LOG_OUTPUT_DEFINE(text_output, out, text_buf, sizeof(text_buf));
+LOG_OUTPUT_DEFINE(dict_output, out, dict_buf, sizeof(dict_buf));
+LOG_OUTPUT_DEFINE(packed_output, out, packed_buf, sizeof(packed_buf));
+LOG_OUTPUT_DEFINE(packed_delta_output, out, packed_delta_buf, sizeof(packed_delta_buf));
+
+static void format(enum format fmt, struct log_msg *msg)
+{
+	uint32_t start = k_cycle_get_32();
+
+	switch (fmt) {
+	case FORMAT_TEXT:
+		log_output_msg_process(&text_output, msg,
+				       LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_TIMESTAMP |
+				       LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP);
+		break;
+	case FORMAT_DICT:
+		log_dict_output_msg_process(&dict_output, msg, 0);
+		break;
+	case FORMAT_PACKED:
+		(void)log_dict_output_packed_msg_process(&packed_output, msg, NULL);
+		break;
+	case FORMAT_PACKED_DELTA:
+		(void)log_dict_output_packed_msg_process(&packed_delta_output, msg,
+							 ref_timestamp_valid ?
+							 &ref_timestamp : NULL);
+		ref_timestamp = log_msg_get_timestamp(msg);
+		ref_timestamp_valid = true;
+		break;
+	default:
+		break;
+	}
+
+	stats[fmt].cycles += k_cycle_get_32() - start;
+}
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	for (int i = 0; i < FORMAT_COUNT; i++) {
+		format(i, &msg->log);
+	}
+
+	msg_count++;
+}
+
+static void panic(const struct log_backend *const backend)
+{
+}
+
+static const struct log_backend_api bench_api = {
+	.process = process,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_api, true);
+
+static void report(enum format fmt)
+{
+	if (stats[fmt].cycles == 0U) {
+		TC_PRINT("%-12s: %zu bytes per message, cycle counter did not advance\n",
+			 format_str[fmt], stats[fmt].bytes / msg_count);
+		return;
+	}
+
+	TC_PRINT("%-12s: %zu bytes, %u cycles per message\n", format_str[fmt],
+		 stats[fmt].bytes / msg_count, stats[fmt].cycles / msg_count);
+}
+
+ZTEST(log_output_dict, test_bytes_per_message)
+{
+	static const uint8_t data[16] = { 1, 2, 3, 4 };
+	static const char *const name = "sensor";
+
+	log_output_ctx_set(&text_output, &stats[FORMAT_TEXT]);
+	log_output_ctx_set(&dict_output, &stats[FORMAT_DICT]);
+	log_output_ctx_set(&packed_output, &stats[FORMAT_PACKED]);
+	log_output_ctx_set(&packed_delta_output, &stats[FORMAT_PACKED_DELTA]);
+
+	for (int i = 0; i < ROUNDS; i++) {
+		LOG_INF("round started");
+		LOG_WRN("%s reading %d out of range %d", name, i, 1000);
+		LOG_DBG("state %u, count %u, flags 0x%x", 3, i, 0x10);
+		LOG_HEXDUMP_INF(data, sizeof(data), "frame");
+
+		while (log_process()) {
+		}
+
+		k_msleep(1);
+	}
+
+	zassert_equal(msg_count, ROUNDS * MSGS_PER_ROUND, "messages lost");
+
+	TC_PRINT("%d messages\n", msg_count);
+	for (int i = 0; i < FORMAT_COUNT; i++) {
+		report(i);
+	}
+
+	zassert_true(stats[FORMAT_PACKED].bytes < stats[FORMAT_DICT].bytes);
+	zassert_true(stats[FORMAT_PACKED_DELTA].bytes <= stats[FORMAT_PACKED].bytes);
+}
+
+ZTEST_SUITE(log_output_dict, NULL, NULL, NULL, NULL, NULL);
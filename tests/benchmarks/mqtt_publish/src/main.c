@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Publish QoS 1 telemetry messages to a broker stand-in over the loopback
+ * interface and report the message rate when waiting for the PUBACK of
+ * every message, when pipelining messages up to the in-flight window and
+ * when sending batches of messages with one transport write. The broker
+ * stand-in acknowledges every PUBLISH it receives, and the loopback link
+ * delays every packet to emulate the round trip to a remote broker.
+ *
+ * Time is measured with the system uptime, which advances with the
+ * simulated time on native_sim, so the results only reflect the number of
+ * round trips and not the processing cost.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/mqtt.h>
+#include <zephyr/net/loopback.h>
+#include <zephyr/sys/byteorder.h>
+
+#define BROKER_PORT 1883
+#define LINK_DELAY_MS 1
+#define MESSAGES 512
+#define PAYLOAD_LEN 32
+#define WINDOW CONFIG_MQTT_PUBLISH_INFLIGHT_WINDOW
+#define BATCH CONFIG_MQTT_PUBLISH_BATCH_MAX
+
+#define MQTT_PKT_CONNECT 1
+#define MQTT_PKT_PUBLISH 3
+#define MQTT_PKT_DISCONNECT 14
+
+static K_THREAD_STACK_DEFINE(broker_stack, 2048);
+static struct k_thread broker_thread;
+static int listen_sock;
+
+static struct mqtt_client client;
+static struct sockaddr_in broker = {
+	.sin_family = AF_INET,
+	.sin_port = htons(BROKER_PORT),
+};
+static uint8_t rx_buffer[256];
+static uint8_t tx_buffer[512];
+static uint8_t payload[PAYLOAD_LEN];
+static bool connected;
+static uint32_t acked;
+static uint16_t next_id = 1;
+
+/* Returns the length of the packet at the start of buf, or 0 if it has not
+ * been fully received yet.
+ */
+static size_t broker_packet_len(const uint8_t *buf, size_t len)
+{
+	size_t remaining = 0;
+	size_t offset = 1;
+	int shift = 0;
+
+	do {
+		if (offset >= len) {
+			return 0;
+		}
+
+		remaining |= (buf[offset] & 0x7f) << shift;
+		shift += 7;
+	} while (buf[offset++] & 0x80);
+
+	if (offset + remaining > len) {
+		return 0;
+	}
+
+	return offset + remaining;
+}
+
+static void broker_handler(void *p1, void *p2, void *p3)
+{
+	uint8_t in[1024];
+	uint8_t out[1024];
+	size_t in_len = 0;
+	size_t out_len;
+	size_t offset;
+	size_t len;
+	bool done = false;
+	int one = 1;
+	int sock;
+	int ret;
+
+	sock = zsock_accept(listen_sock, NULL, NULL);
+	if (sock < 0) {
+		return;
+	}
+
+	(void)zsock_setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+	while (!done) {
+		ret = zsock_recv(sock, in + in_len, sizeof(in) - in_len, 0);
+		if (ret <= 0) {
+			break;
+		}
+
+		in_len += ret;
+		out_len = 0;
+
+		for (offset = 0; offset < in_len; offset += len) {
+			const uint8_t *pkt = in + offset;
+			const uint8_t *id;
+
+			len = broker_packet_len(pkt, in_len - offset);
+			if (len == 0) {
+				break;
+			}
+
+			switch (pkt[0] >> 4) {
+			case MQTT_PKT_CONNECT:
+				/* CONNACK, session not present, accepted */
+				out[out_len++] = 0x20;
+				out[out_len++] = 0x02;
+				out[out_len++] = 0x00;
+				out[out_len++] = 0x00;
+				break;
+			case MQTT_PKT_PUBLISH:
+				/* PUBACK with the message ID following the
+				 * topic, the fixed header is 2 bytes long as
+				 * the messages are short.
+				 */
+				id = pkt + 2 + 2 + sys_get_be16(pkt + 2);
+				out[out_len++] = 0x40;
+				out[out_len++] = 0x02;
+				out[out_len++] = id[0];
+				out[out_len++] = id[1];
+				break;
+			case MQTT_PKT_DISCONNECT:
+				done = true;
+				break;
+			}
+		}
+
+		in_len -= offset;
+		memmove(in, in + offset, in_len);
+
+		if (out_len > 0) {
+			ret = zsock_send(sock, out, out_len, 0);
+			if (ret < 0) {
+				break;
+			}
+		}
+	}
+
+	zsock_close(sock);
+}
+
+static void mqtt_evt_handler(struct mqtt_client *const c,
+			     const struct mqtt_evt *evt)
+{
+	switch (evt->type) {
+	case MQTT_EVT_CONNACK:
+		connected = (evt->result == 0);
+		break;
+	case MQTT_EVT_PUBACK:
+		acked++;
+		break;
+	default:
+		break;
+	}
+}
+
+static void process_input(void)
+{
+	struct zsock_pollfd fds = {
+		.fd = client.transport.tcp.sock,
+		.events = ZSOCK_POLLIN,
+	};
+	int ret;
+
+	ret = zsock_poll(&fds, 1, 1000);
+	zassert_equal(ret, 1, "no data from broker");
+
+	ret = mqtt_input(&client);
+	zassert_equal(ret, 0, "input failed (%d)", ret);
+}
+
+static void wait_acked(uint32_t count)
+{
+	while (acked < count) {
+		process_input();
+	}
+}
+
+static void init_param(struct mqtt_publish_param *param)
+{
+	static char topic[] = "sensors/telemetry";
+
+	memset(param, 0, sizeof(*param));
+
+	param->message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE;
+	param->message.topic.topic.utf8 = topic;
+	param->message.topic.topic.size = sizeof(topic) - 1;
+	param->message.payload.data = payload;
+	param->message.payload.len = sizeof(payload);
+	param->message_id = next_id++;
+}
+
+static uint32_t publish_stop_and_wait(void)
+{
+	struct mqtt_publish_param param;
+	uint32_t start = k_uptime_ticks();
+	int ret;
+
+	acked = 0;
+
+	for (int i = 0; i < MESSAGES; i++) {
+		init_param(&param);
+
+		ret = mqtt_publish(&client, &param);
+		zassert_equal(ret, 0, "publish failed (%d)", ret);
+
+		wait_acked(i + 1);
+	}
+
+	return k_uptime_ticks() - start;
+}
+
+static uint32_t publish_pipelined(void)
+{
+	struct mqtt_publish_param param;
+	uint32_t start = k_uptime_ticks();
+	int sent = 0;
+	int ret;
+
+	acked = 0;
+	init_param(&param);
+
+	while (sent < MESSAGES) {
+		ret = mqtt_publish(&client, &param);
+		if (ret == -EAGAIN) {
+			process_input();
+			continue;
+		}
+
+		zassert_equal(ret, 0, "publish failed (%d)", ret);
+
+		if (++sent < MESSAGES) {
+			init_param(&param);
+		}
+	}
+
+	wait_acked(MESSAGES);
+
+	return k_uptime_ticks() - start;
+}
+
+static uint32_t publish_batched(void)
+{
+	struct mqtt_publish_param params[BATCH];
+	uint32_t start = k_uptime_ticks();
+	int pending = 0;
+	int sent = 0;
+	int ret;
+
+	acked = 0;
+
+	while (sent < MESSAGES) {
+		/* Keep the messages the previous batch could not send */
+		for (; pending < MIN(BATCH, MESSAGES - sent); pending++) {
+			init_param(&params[pending]);
+		}
+
+		ret = mqtt_publish_batch(&client, params, pending);
+		if (ret == -EAGAIN) {
+			process_input();
+			continue;
+		}
+
+		zassert_true(ret > 0, "publish failed (%d)", ret);
+
+		sent += ret;
+		pending -= ret;
+		memmove(params, params + ret, pending * sizeof(params[0]));
+	}
+
+	wait_acked(MESSAGES);
+
+	return k_uptime_ticks() - start;
+}
+
+static void report(const char *mode, uint32_t elapsed)
+{
+	TC_PRINT("%-14s %u messages in %u ms, %u msgs/sec\n", mode, MESSAGES,
+		 k_ticks_to_ms_floor32(elapsed),
+		 (uint32_t)((uint64_t)MESSAGES * CONFIG_SYS_CLOCK_TICKS_PER_SEC /
+			    MAX(elapsed, 1)));
+}
+
+ZTEST(mqtt_publish, test_publish_rate)
+{
+	TC_PRINT("QoS 1, %d byte payload, window %d, batch %d, "
+		 "link delay %d ms\n", PAYLOAD_LEN, WINDOW, BATCH, LINK_DELAY_MS);
+
+	report("stop-and-wait", publish_stop_and_wait());
+	report("pipelined", publish_pipelined());
+	report("batched", publish_batched());
+}
+
+ZTEST(mqtt_publish, test_window)
+{
+	struct mqtt_publish_param params[WINDOW + 1];
+	struct mqtt_publish_param param;
+	int ret;
+
+	acked = 0;
+
+	for (int i = 0; i < WINDOW; i++) {
+		init_param(&params[i]);
+
+		ret = mqtt_publish(&client, &params[i]);
+		zassert_equal(ret, 0, "publish failed (%d)", ret);
+	}
+
+	init_param(&params[WINDOW]);
+
+	ret = mqtt_publish(&client, &params[WINDOW]);
+	zassert_equal(ret, -EAGAIN, "window not enforced (%d)", ret);
+
+	/* A retransmission does not need a new slot */
+	params[0].dup_flag = 1U;
+	ret = mqtt_publish(&client, &params[0]);
+	zassert_equal(ret, 0, "retransmission failed (%d)", ret);
+
+	/* QoS 0 messages are not tracked */
+	init_param(&param);
+	param.message.topic.qos = MQTT_QOS_0_AT_MOST_ONCE;
+	ret = mqtt_publish(&client, &param);
+	zassert_equal(ret, 0, "QoS 0 publish failed (%d)", ret);
+
+	/* The retransmission is acknowledged too */
+	wait_acked(WINDOW + 1);
+
+	ret = mqtt_publish_batch(&client, &params[WINDOW], 1);
+	zassert_equal(ret, 1, "publish after acks failed (%d)", ret);
+
+	wait_acked(WINDOW + 2);
+}
+
+static void *setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(BROKER_PORT),
+	};
+	int one = 1;
+	int ret;
+
+	memset(payload, 'x', sizeof(payload));
+
+	loopback_set_packet_delay(LINK_DELAY_MS);
+
+	listen_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(listen_sock >= 0, "socket open failed");
+
+	ret = zsock_bind(listen_sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	ret = zsock_listen(listen_sock, 1);
+	zassert_equal(ret, 0, "listen failed");
+
+	k_thread_create(&broker_thread, broker_stack,
+			K_THREAD_STACK_SIZEOF(broker_stack), broker_handler,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &broker.sin_addr);
+
+	mqtt_client_init(&client);
+
+	client.broker = &broker;
+	client.evt_cb = mqtt_evt_handler;
+	client.client_id.utf8 = (uint8_t *)"zephyr_bench";
+	client.client_id.size = strlen("zephyr_bench");
+	client.protocol_version = MQTT_VERSION_3_1_1;
+	client.transport.type = MQTT_TRANSPORT_NON_SECURE;
+	client.rx_buf = rx_buffer;
+	client.rx_buf_size = sizeof(rx_buffer);
+	client.tx_buf = tx_buffer;
+	client.tx_buf_size = sizeof(tx_buffer);
+
+	ret = mqtt_connect(&client);
+	zassert_equal(ret, 0, "connect failed (%d)", ret);
+
+	/* Small messages are not held back until the previous ones are
+	 * acknowledged, as a telemetry client would configure it.
+	 */
+	ret = zsock_setsockopt(client.transport.tcp.sock, IPPROTO_TCP,
+			       TCP_NODELAY, &one, sizeof(one));
+	zassert_equal(ret, 0, "setsockopt failed");
+
+	while (!connected) {
+		process_input();
+	}
+
+	return NULL;
+}
+
+static void teardown(void *data)
+{
+	mqtt_disconnect(&client);
+	k_thread_join(&broker_thread, K_SECONDS(1));
+	zsock_close(listen_sock);
+}
+
+ZTEST_SUITE(mqtt_publish, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the cost of resolving the link address of outgoing IPv4 packets
+ * with net_arp_prepare() when 4 to 64 neighbors are in the ARP cache. The
+ * packets are sent round robin to all the neighbors, which is the worst
+ * case for a cache that is searched linearly in most recently used order.
+ *
+ * The cost is derived from the cycle counter. On native_sim the cycle
+ * counter does not advance while code executes, so there the benchmark
+ * only checks that every lookup is resolved from the cache.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
+
+#include "arp.h"
+
+#define MAX_NEIGHBORS CONFIG_NET_ARP_TABLE_SIZE
+#define ROUNDS 1024
+
+static uint8_t fake_mac[] = { 0x02, 0x00, 0x5e, 0x00, 0x53, 0x01 };
+
+static void fake_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, fake_mac, sizeof(fake_mac),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int fake_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static const struct ethernet_api fake_api = {
+	.iface_api.init = fake_iface_init,
+	.send = fake_send,
+};
+
+ETH_NET_DEVICE_INIT(fake_eth, "fake_eth", NULL, NULL, NULL, NULL,
+		    CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &fake_api,
+		    NET_ETH_MTU);
+
+static struct net_if *iface;
+static struct in_addr my_addr = { { { 192, 168, 1, 1 } } };
+
+static inline void neighbor_addr(struct in_addr *addr, int idx)
+{
+	addr->s4_addr[0] = 192;
+	addr->s4_addr[1] = 168;
+	addr->s4_addr[2] = 1;
+	addr->s4_addr[3] = 10 + idx;
+}
+
+static void count_cb(struct arp_entry *entry, void *user_data)
+{
+}
+
+static void add_neighbors(int count)
+{
+	struct net_eth_addr hwaddr = { { 0x02, 0x00, 0x5e, 0x00, 0x54, 0x00 } };
+	struct in_addr addr;
+	int i;
+
+	net_arp_clear_cache(iface);
+
+	for (i = 0; i < count; i++) {
+		neighbor_addr(&addr, i);
+		hwaddr.addr[5] = i;
+
+		net_arp_update(iface, &addr, &hwaddr, false, true);
+	}
+
+	zassert_equal(net_arp_foreach(count_cb, NULL), count,
+		      "neighbors not added");
+}
+
+static uint32_t run_lookups(int count)
+{
+	uint32_t start, cycles = 0U;
+	struct net_ipv4_hdr *ipv4;
+	struct in_addr dst;
+	struct net_pkt *pkt, *ret;
+	int r;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr),
+					AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+
+	ipv4 = (struct net_ipv4_hdr *)net_buf_add(pkt->buffer,
+						  sizeof(struct net_ipv4_hdr));
+	net_ipv4_addr_copy_raw(ipv4->src, (uint8_t *)&my_addr);
+
+	for (r = 0; r < ROUNDS; r++) {
+		neighbor_addr(&dst, r % count);
+		net_ipv4_addr_copy_raw(ipv4->dst, (uint8_t *)&dst);
+
+		start = k_cycle_get_32();
+
+		ret = net_arp_prepare(pkt, &dst, NULL);
+
+		cycles += k_cycle_get_32() - start;
+
+		zassert_equal(ret, pkt, "neighbor %d not in cache", r % count);
+		zassert_equal(net_pkt_lladdr_dst(pkt)->addr[5], r % count,
+			      "wrong link address");
+	}
+
+	net_pkt_unref(pkt);
+
+	return cycles;
+}
+
+ZTEST(arp_perf, test_tx_lookups)
+{
+	struct net_if_addr *ifaddr;
+	struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+	int count;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(ETHERNET));
+	zassert_not_null(iface, "no interface");
+
+	ifaddr = net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "cannot add address");
+
+	net_if_ipv4_set_netmask_by_addr(iface, &my_addr, &netmask);
+
+	for (count = 4; count <= MAX_NEIGHBORS; count *= 2) {
+		uint32_t cycles;
+
+		add_neighbors(count);
+
+		cycles = run_lookups(count);
+		if (cycles == 0U) {
+			TC_PRINT("%2d neighbors: %u lookups, "
+				 "cycle counter did not advance\n",
+				 count, ROUNDS);
+			continue;
+		}
+
+		TC_PRINT("%2d neighbors: %u cycles/lookup, %llu lookups/sec\n",
+			 count, cycles / ROUNDS,
+			 (uint64_t)ROUNDS * sys_clock_hw_cycles_per_sec() /
+			 cycles);
+	}
+
+	net_arp_clear_cache(iface);
+}
+
+ZTEST_SUITE(arp_perf, NULL, NULL, NULL, NULL, NULL);
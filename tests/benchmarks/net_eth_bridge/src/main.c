@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Forward unicast traffic between hosts behind the ports of a four port
+ * bridge and report the forwarding rate, the number of frames sent per
+ * forwarded packet and the number of packet clones the bridge made.
+ *
+ * The rate is derived from the cycle counter. On native_sim the cycle
+ * counter does not advance while code executes, so there only the frame
+ * and clone counts are meaningful.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/ethernet_bridge.h>
+
+#define PORTS 4
+#define HOSTS_PER_PORT 4
+#define ROUNDS 256
+#define PAYLOAD_SIZE 64
+
+struct eth_fake_context {
+	struct net_if *iface;
+	uint8_t mac_address[6];
+	uint32_t sent;
+};
+
+static struct eth_fake_context eth_fake_data[PORTS];
+static struct net_if *ports[PORTS];
+
+static void eth_fake_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_fake_context *ctx = dev->data;
+
+	ctx->iface = iface;
+
+	ctx->mac_address[0] = 0xc2;
+	ctx->mac_address[1] = 0xaa;
+	ctx->mac_address[2] = 0xbb;
+	ctx->mac_address[3] = 0xcc;
+	ctx->mac_address[4] = 0xdd;
+	ctx->mac_address[5] = ctx - eth_fake_data;
+
+	net_if_set_link_addr(iface, ctx->mac_address,
+			     sizeof(ctx->mac_address),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_fake_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct eth_fake_context *ctx = dev->data;
+
+	if (NET_ETH_HDR(pkt)->type == htons(NET_ETH_PTYPE_ALL)) {
+		ctx->sent++;
+	}
+
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_fake_get_capabilities(const struct device *dev)
+{
+	return ETHERNET_PROMISC_MODE;
+}
+
+static int eth_fake_set_config(const struct device *dev,
+			       enum ethernet_config_type type,
+			       const struct ethernet_config *config)
+{
+	return type == ETHERNET_CONFIG_TYPE_PROMISC_MODE ? 0 : -EINVAL;
+}
+
+static const struct ethernet_api eth_fake_api_funcs = {
+	.iface_api.init = eth_fake_iface_init,
+	.get_capabilities = eth_fake_get_capabilities,
+	.set_config = eth_fake_set_config,
+	.send = eth_fake_send,
+};
+
+#define ETH_FAKE_DEVICE(n, _)						\
+	ETH_NET_DEVICE_INIT(eth_fake##n, "eth_fake" #n, NULL, NULL,	\
+			    &eth_fake_data[n], NULL,			\
+			    CONFIG_ETH_INIT_PRIORITY,			\
+			    &eth_fake_api_funcs, NET_ETH_MTU)
+
+LISTIFY(PORTS, ETH_FAKE_DEVICE, (;));
+
+static ETH_BRIDGE_INIT(bench_bridge);
+
+static void iface_cb(struct net_if *iface, void *user_data)
+{
+	const struct device *dev = net_if_get_device(iface);
+
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	    ((const struct ethernet_api *)dev->api)->send == eth_fake_send) {
+		struct eth_fake_context *ctx = dev->data;
+
+		ports[ctx - eth_fake_data] = iface;
+	}
+}
+
+static void host_addr(int port, int host, uint8_t *addr)
+{
+	addr[0] = 0x02;
+	addr[1] = 0x00;
+	addr[2] = 0x00;
+	addr[3] = 0x00;
+	addr[4] = port;
+	addr[5] = host;
+}
+
+static void inject(int port, const uint8_t *src, const uint8_t *dst)
+{
+	static const uint8_t payload[PAYLOAD_SIZE];
+	struct net_eth_hdr hdr;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(ports[port], sizeof(hdr) + sizeof(payload),
+					   AF_UNSPEC, 0, K_FOREVER);
+	zassert_not_null(pkt, "");
+
+	memcpy(hdr.dst.addr, dst, sizeof(hdr.dst.addr));
+	memcpy(hdr.src.addr, src, sizeof(hdr.src.addr));
+	hdr.type = htons(NET_ETH_PTYPE_ALL);
+
+	zassert_ok(net_pkt_write(pkt, &hdr, sizeof(hdr)), "");
+	zassert_ok(net_pkt_write(pkt, payload, sizeof(payload)), "");
+
+	zassert_ok(net_recv_data(ports[port], pkt), "");
+}
+
+static uint32_t total_sent(void)
+{
+	uint32_t sent = 0;
+
+	for (int i = 0; i < PORTS; i++) {
+		sent += eth_fake_data[i].sent;
+	}
+
+	return sent;
+}
+
+ZTEST(net_eth_bridge_perf, test_forwarding)
+{
+	static const uint8_t bcast[] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+	struct eth_bridge_stats before, after;
+	uint8_t src[6], dst[6];
+	uint32_t start, cycles, sent, pkts = 0;
+	int port, host, round;
+
+	net_if_foreach(iface_cb, NULL);
+
+	for (port = 0; port < PORTS; port++) {
+		zassert_not_null(ports[port], "");
+		net_if_up(ports[port]);
+		zassert_ok(eth_bridge_iface_add(&bench_bridge, ports[port]), "");
+		zassert_ok(eth_bridge_iface_allow_tx(ports[port], true), "");
+	}
+
+	/* Every host announces itself once, like with an ARP request */
+	for (port = 0; port < PORTS; port++) {
+		for (host = 0; host < HOSTS_PER_PORT; host++) {
+			host_addr(port, host, src);
+			inject(port, src, bcast);
+		}
+	}
+
+	eth_bridge_get_stats(&bench_bridge, &before);
+	sent = total_sent();
+
+	start = k_cycle_get_32();
+
+	for (round = 0; round < ROUNDS; round++) {
+		for (port = 0; port < PORTS; port++) {
+			host = round % HOSTS_PER_PORT;
+			host_addr(port, host, src);
+			host_addr((port + 1) % PORTS, host, dst);
+			inject(port, src, dst);
+			pkts++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	eth_bridge_get_stats(&bench_bridge, &after);
+	sent = total_sent() - sent;
+
+	TC_PRINT("%u packets over %d ports: %u frames sent, %u clones, "
+		 "%u unicast, %u flooded\n",
+		 pkts, PORTS, sent, after.clones - before.clones,
+		 after.unicast - before.unicast, after.flooded - before.flooded);
+
+	if (cycles == 0U) {
+		TC_PRINT("cycle counter did not advance\n");
+	} else {
+		TC_PRINT("%u cycles/packet, %llu packets/s\n", cycles / pkts,
+			 (uint64_t)pkts * sys_clock_hw_cycles_per_sec() / cycles);
+	}
+
+	zassert_equal(after.rx_pkts - before.rx_pkts, pkts, "packets lost");
+
+	if (IS_ENABLED(CONFIG_NET_ETHERNET_BRIDGE_FDB)) {
+		zassert_equal(sent, pkts, "unicast packets were flooded");
+		zassert_equal(after.clones - before.clones, 0, "unexpected clones");
+	} else {
+		zassert_equal(sent, pkts * (PORTS - 1), "packets not flooded");
+	}
+
+	for (port = 0; port < PORTS; port++) {
+		zassert_ok(eth_bridge_iface_remove(&bench_bridge, ports[port]), "");
+	}
+}
+
+ZTEST_SUITE(net_eth_bridge_perf, NULL, NULL, NULL, NULL, NULL);
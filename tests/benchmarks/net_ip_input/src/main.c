@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measure the cost of net_ipv4_input() and net_ipv6_input() for UDP
+ * packets delivered to a connection, when the headers are in the first
+ * buffer of the packet, when the UDP header straddles two buffers, and when
+ * such a packet is first made contiguous with net_pkt_pullup() as done at
+ * L2 ingress with CONFIG_NET_PKT_PULLUP_LEN. The cost of the pull up is
+ * included in the last case.
+ *
+ * The cost is derived from the cycle counter. On native_sim the cycle
+ * counter does not advance while code executes, so there the benchmark
+ * only checks that every packet is delivered.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "udp_internal.h"
+
+#define PORT 4242
+#define PAYLOAD_LEN 64
+#define ROUNDS 1024
+#define PULLUP_LEN 64
+#define FRAG_SIZE 128
+
+NET_BUF_POOL_FIXED_DEFINE(frag_pool, 8, FRAG_SIZE,
+			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
+
+enum layout {
+	LAYOUT_CONTIGUOUS,
+	LAYOUT_SPLIT,
+	LAYOUT_SPLIT_PULLUP,
+};
+
+static const char * const layout_str[] = {
+	[LAYOUT_CONTIGUOUS] = "contiguous",
+	[LAYOUT_SPLIT] = "split",
+	[LAYOUT_SPLIT_PULLUP] = "split+pullup",
+};
+
+static struct net_if *iface;
+static uint8_t template[NET_IPV6H_LEN + NET_UDPH_LEN + PAYLOAD_LEN];
+static size_t template_len;
+static int delivered;
+
+static enum net_verdict udp_cb(struct net_conn *conn, struct net_pkt *pkt,
+			       union net_ip_header *ip_hdr,
+			       union net_proto_header *proto_hdr,
+			       void *user_data)
+{
+	delivered++;
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+/* Build a valid packet once with the stack, and keep its bytes */
+static void make_template(sa_family_t family)
+{
+	uint8_t payload[PAYLOAD_LEN] = { 0 };
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(payload), family,
+					IPPROTO_UDP, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+
+	if (family == AF_INET) {
+		ret = net_ipv4_create(pkt, net_ipv4_unspecified_address(),
+				      net_ipv4_unspecified_address());
+	} else {
+		ret = net_ipv6_create(pkt, net_ipv6_unspecified_address(),
+				      net_ipv6_unspecified_address());
+	}
+
+	zassert_equal(ret, 0, "cannot create IP header");
+
+	/* The addresses are set before computing the checksums */
+	if (family == AF_INET) {
+		struct in_addr lo = INADDR_LOOPBACK_INIT;
+
+		net_ipv4_addr_copy_raw(NET_IPV4_HDR(pkt)->src, (uint8_t *)&lo);
+		net_ipv4_addr_copy_raw(NET_IPV4_HDR(pkt)->dst, (uint8_t *)&lo);
+	} else {
+		net_ipv6_addr_copy_raw(NET_IPV6_HDR(pkt)->src,
+				       (uint8_t *)net_ipv6_unspecified_address());
+		NET_IPV6_HDR(pkt)->src[15] = 1;
+		net_ipv6_addr_copy_raw(NET_IPV6_HDR(pkt)->dst,
+				       NET_IPV6_HDR(pkt)->src);
+	}
+
+	zassert_equal(net_udp_create(pkt, htons(PORT + 1), htons(PORT)), 0,
+		      "cannot create UDP header");
+	zassert_equal(net_pkt_write(pkt, payload, sizeof(payload)), 0,
+		      "cannot write payload");
+
+	net_pkt_cursor_init(pkt);
+
+	if (family == AF_INET) {
+		ret = net_ipv4_finalize(pkt, IPPROTO_UDP);
+	} else {
+		ret = net_ipv6_finalize(pkt, IPPROTO_UDP);
+	}
+
+	zassert_equal(ret, 0, "cannot finalize packet");
+
+	template_len = net_pkt_get_len(pkt);
+	zassert_true(template_len <= sizeof(template));
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_pkt_read(pkt, template, template_len), 0);
+
+	net_pkt_unref(pkt);
+}
+
+/* Received packet with the template split in buffers of frag_len bytes */
+static struct net_pkt *rx_packet(size_t frag_len)
+{
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	size_t len;
+
+	pkt = net_pkt_rx_alloc_on_iface(iface, K_NO_WAIT);
+	zassert_not_null(pkt, "out of mem");
+
+	for (size_t offset = 0; offset < template_len; offset += len) {
+		len = MIN(frag_len, template_len - offset);
+
+		frag = net_buf_alloc(&frag_pool, K_NO_WAIT);
+		zassert_not_null(frag, "out of frags");
+
+		net_buf_add_mem(frag, template + offset, len);
+		net_pkt_frag_add(pkt, frag);
+	}
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static uint32_t run_input(sa_family_t family, enum layout layout)
+{
+	size_t ip_hdr_len = family == AF_INET ? NET_IPV4H_LEN : NET_IPV6H_LEN;
+	/* The UDP header straddles the first two buffers */
+	size_t frag_len = layout == LAYOUT_CONTIGUOUS ? FRAG_SIZE : ip_hdr_len + 4;
+	uint32_t start, cycles = 0U;
+	enum net_verdict verdict;
+	struct net_pkt *pkt;
+
+	delivered = 0;
+
+	for (int r = 0; r < ROUNDS; r++) {
+		pkt = rx_packet(frag_len);
+
+		start = k_cycle_get_32();
+
+		if (layout == LAYOUT_SPLIT_PULLUP) {
+			(void)net_pkt_pullup(pkt, PULLUP_LEN);
+		}
+
+		if (family == AF_INET) {
+			verdict = net_ipv4_input(pkt, true);
+		} else {
+			verdict = net_ipv6_input(pkt, true);
+		}
+
+		cycles += k_cycle_get_32() - start;
+
+		if (verdict == NET_DROP) {
+			net_pkt_unref(pkt);
+		}
+
+		zassert_equal(verdict, NET_OK, "%s packet dropped",
+			      layout_str[layout]);
+	}
+
+	zassert_equal(delivered, ROUNDS, "packets not delivered");
+
+	return cycles;
+}
+
+static void run_family(sa_family_t family)
+{
+	const char *name = family == AF_INET ? "IPv4" : "IPv6";
+	uint32_t cycles[ARRAY_SIZE(layout_str)];
+	struct net_conn_handle *handle;
+	int ret;
+
+	ret = net_udp_register(family, NULL, NULL, 0, PORT, NULL, udp_cb, NULL,
+			       &handle);
+	zassert_equal(ret, 0, "cannot register UDP handler (%d)", ret);
+
+	make_template(family);
+
+	for (int layout = 0; layout < ARRAY_SIZE(layout_str); layout++) {
+		cycles[layout] = run_input(family, layout);
+
+		if (cycles[layout] == 0U) {
+			TC_PRINT("%s %-12s: %u packets, "
+				 "cycle counter did not advance\n",
+				 name, layout_str[layout], ROUNDS);
+			continue;
+		}
+
+		TC_PRINT("%s %-12s: %u cycles/packet\n", name,
+			 layout_str[layout], cycles[layout] / ROUNDS);
+	}
+
+	if (cycles[LAYOUT_SPLIT] != 0U) {
+		TC_PRINT("%s pullup saves %d cycles/packet on split headers\n",
+			 name, (int)(cycles[LAYOUT_SPLIT] -
+				     cycles[LAYOUT_SPLIT_PULLUP]) / ROUNDS);
+	}
+
+	net_udp_unregister(handle);
+}
+
+ZTEST(net_ip_input, test_ipv4_input)
+{
+	run_family(AF_INET);
+}
+
+ZTEST(net_ip_input, test_ipv6_input)
+{
+	run_family(AF_INET6);
+}
+
+static void *setup(void)
+{
+	iface = net_if_get_default();
+	zassert_not_null(iface, "no interface");
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_ip_input, NULL, setup, NULL, NULL, NULL);
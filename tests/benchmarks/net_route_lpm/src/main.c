@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Compare route lookups per second of the longest prefix match trie
+ * against a linear scan of the same routes, which is what the routing
+ * table does when CONFIG_NET_ROUTE_LPM is disabled.
+ *
+ * The rates are derived from the cycle counter. On native_sim the cycle
+ * counter does not advance while code executes, so there the benchmark
+ * only checks that both lookups agree.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+
+#include "route_lpm.h"
+
+#define MAX_ROUTES 1024
+#define LOOKUPS 20000
+
+struct test_route {
+	sys_snode_t node;
+	uint8_t prefix[16];
+	uint8_t prefix_len;
+};
+
+static struct test_route routes[MAX_ROUTES];
+static struct net_route_lpm_node lpm_nodes[2 * MAX_ROUTES];
+static struct net_route_lpm lpm;
+static uint8_t keys[64][16];
+
+static bool prefix_match(const uint8_t *addr, const uint8_t *prefix,
+			 uint8_t len)
+{
+	uint8_t bytes = len / 8;
+	uint8_t bits = len % 8;
+
+	if (memcmp(addr, prefix, bytes) != 0) {
+		return false;
+	}
+
+	if (bits == 0U) {
+		return true;
+	}
+
+	return ((addr[bytes] ^ prefix[bytes]) & (uint8_t)(0xff << (8 - bits))) == 0U;
+}
+
+static struct test_route *linear_lookup(int count, const uint8_t *key)
+{
+	struct test_route *found = NULL;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		if ((found == NULL || routes[i].prefix_len > found->prefix_len) &&
+		    prefix_match(key, routes[i].prefix, routes[i].prefix_len)) {
+			found = &routes[i];
+		}
+	}
+
+	return found;
+}
+
+static void routes_setup(int count)
+{
+	int i;
+
+	net_route_lpm_init(&lpm, lpm_nodes, ARRAY_SIZE(lpm_nodes), 128);
+
+	for (i = 0; i < count; i++) {
+		/* 2001:db8:xxxx:xxxx::/48../64 style prefixes plus some
+		 * host routes, similar to a border router table.
+		 */
+		memset(routes[i].prefix, 0, sizeof(routes[i].prefix));
+		routes[i].prefix[0] = 0x20;
+		routes[i].prefix[1] = 0x01;
+		routes[i].prefix[2] = 0x0d;
+		routes[i].prefix[3] = 0xb8;
+		routes[i].prefix[4] = i >> 8;
+		routes[i].prefix[5] = i & 0xff;
+		routes[i].prefix[6] = sys_rand32_get() & 0xff;
+		routes[i].prefix_len = (i % 8) == 0 ? 128 : 48 + (i % 3) * 8;
+
+		if (routes[i].prefix_len == 128) {
+			sys_rand_get(&routes[i].prefix[8], 8);
+		}
+
+		zassert_ok(net_route_lpm_add(&lpm, routes[i].prefix,
+					     routes[i].prefix_len,
+					     &routes[i].node));
+	}
+
+	for (i = 0; i < ARRAY_SIZE(keys); i++) {
+		memcpy(keys[i], routes[sys_rand32_get() % count].prefix, 16);
+	}
+}
+
+static uint64_t lookups_per_sec(uint32_t cycles)
+{
+	return (uint64_t)LOOKUPS * sys_clock_hw_cycles_per_sec() / cycles;
+}
+
+ZTEST(route_lpm_perf, test_lookup_rate)
+{
+	int counts[] = { 16, 64, 256, 1024 };
+	int c, i;
+
+	for (c = 0; c < ARRAY_SIZE(counts); c++) {
+		uint32_t start, lpm_cycles, linear_cycles;
+		sys_snode_t *entry;
+
+		routes_setup(counts[c]);
+
+		for (i = 0; i < ARRAY_SIZE(keys); i++) {
+			entry = net_route_lpm_lookup(&lpm, keys[i], NULL, NULL);
+			zassert_equal_ptr(entry, &linear_lookup(counts[c], keys[i])->node,
+					  "Trie and linear lookup differ");
+		}
+
+		start = k_cycle_get_32();
+		for (i = 0; i < LOOKUPS; i++) {
+			entry = net_route_lpm_lookup(&lpm, keys[i % ARRAY_SIZE(keys)],
+						     NULL, NULL);
+			zassert_not_null(entry);
+		}
+		lpm_cycles = k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		for (i = 0; i < LOOKUPS; i++) {
+			zassert_not_null(linear_lookup(counts[c],
+						       keys[i % ARRAY_SIZE(keys)]));
+		}
+		linear_cycles = k_cycle_get_32() - start;
+
+		if (lpm_cycles == 0U || linear_cycles == 0U) {
+			TC_PRINT("routes %4d: cycle counter did not advance\n",
+				 counts[c]);
+			continue;
+		}
+
+		TC_PRINT("routes %4d: trie %llu lookups/s, linear %llu lookups/s\n",
+			 counts[c], lookups_per_sec(lpm_cycles),
+			 lookups_per_sec(linear_cycles));
+	}
+}
+
+ZTEST_SUITE(route_lpm_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Compare the cost of waiting for events with zsock_poll() against
+ * zsock_epoll_wait() when many sockets are open but mostly idle: for each
+ * event a single datagram is sent over the loopback interface to one of
+ * 8 to 128 bound sockets and the receiver waits for it on all of them.
+ *
+ * The cost is derived from the cycle counter. On native_sim the cycle
+ * counter does not advance while code executes, so there the benchmark
+ * only checks that both mechanisms report the right socket.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+
+#define BASE_PORT 4242
+#define MAX_SOCKETS 128
+#define ROUNDS 64
+
+static int client_sock;
+static int server_socks[MAX_SOCKETS];
+static struct sockaddr_in server_addrs[MAX_SOCKETS];
+static struct zsock_pollfd pollfds[MAX_SOCKETS];
+static uint8_t payload[16];
+
+static void send_to(int idx)
+{
+	ssize_t ret;
+
+	ret = zsock_sendto(client_sock, payload, sizeof(payload), 0,
+			   (struct sockaddr *)&server_addrs[idx],
+			   sizeof(server_addrs[idx]));
+	zassert_equal(ret, sizeof(payload), "sendto failed");
+}
+
+static void recv_from(int idx)
+{
+	uint8_t buf[sizeof(payload)];
+	ssize_t ret;
+
+	ret = zsock_recv(server_socks[idx], buf, sizeof(buf), 0);
+	zassert_equal(ret, sizeof(payload), "recv failed");
+}
+
+/* Spread the events over the sockets */
+static inline int target(int round, int count)
+{
+	return (round * 7 + 3) % count;
+}
+
+static uint32_t run_poll(int count)
+{
+	uint32_t start, cycles = 0U;
+	int r, i, ret;
+
+	for (i = 0; i < count; i++) {
+		pollfds[i].fd = server_socks[i];
+		pollfds[i].events = ZSOCK_POLLIN;
+	}
+
+	for (r = 0; r < ROUNDS; r++) {
+		int idx = target(r, count);
+
+		send_to(idx);
+
+		start = k_cycle_get_32();
+
+		ret = zsock_poll(pollfds, count, -1);
+
+		cycles += k_cycle_get_32() - start;
+
+		zassert_equal(ret, 1, "poll failed");
+		zassert_equal(pollfds[idx].revents, ZSOCK_POLLIN, "wrong socket");
+
+		recv_from(idx);
+	}
+
+	return cycles;
+}
+
+static uint32_t run_epoll(int count)
+{
+	struct zsock_epoll_event ev;
+	uint32_t start, cycles = 0U;
+	int epfd, r, i, ret;
+
+	epfd = zsock_epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	for (i = 0; i < count; i++) {
+		ev.events = ZSOCK_EPOLLIN;
+		ev.data.u32 = i;
+
+		ret = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD,
+				      server_socks[i], &ev);
+		zassert_equal(ret, 0, "epoll_ctl failed");
+	}
+
+	/* Drop the initial readiness check of the new registrations */
+	ret = zsock_epoll_wait(epfd, &ev, 1, 0);
+	zassert_equal(ret, 0, "unexpected event");
+
+	for (r = 0; r < ROUNDS; r++) {
+		int idx = target(r, count);
+
+		send_to(idx);
+
+		start = k_cycle_get_32();
+
+		ret = zsock_epoll_wait(epfd, &ev, 1, -1);
+
+		cycles += k_cycle_get_32() - start;
+
+		zassert_equal(ret, 1, "epoll_wait failed");
+		zassert_equal(ev.data.u32, idx, "wrong socket");
+
+		recv_from(idx);
+	}
+
+	zsock_close(epfd);
+
+	return cycles;
+}
+
+static void report(int count, uint32_t poll_cycles, uint32_t epoll_cycles)
+{
+	if (poll_cycles == 0U || epoll_cycles == 0U) {
+		TC_PRINT("%3d sockets: %u events, cycle counter did not advance\n",
+			 count, ROUNDS);
+		return;
+	}
+
+	TC_PRINT("%3d sockets: poll %u cycles/event, epoll %u cycles/event\n",
+		 count, poll_cycles / ROUNDS, epoll_cycles / ROUNDS);
+}
+
+ZTEST(socket_epoll_perf, test_idle_sockets)
+{
+	int count, i, ret;
+
+	client_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(client_sock >= 0, "socket open failed");
+
+	for (i = 0; i < MAX_SOCKETS; i++) {
+		server_socks[i] = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		zassert_true(server_socks[i] >= 0, "socket open failed");
+
+		server_addrs[i].sin_family = AF_INET;
+		server_addrs[i].sin_port = htons(BASE_PORT + i);
+		zsock_inet_pton(AF_INET, "127.0.0.1",
+				&server_addrs[i].sin_addr);
+
+		ret = zsock_bind(server_socks[i],
+				 (struct sockaddr *)&server_addrs[i],
+				 sizeof(server_addrs[i]));
+		zassert_equal(ret, 0, "bind failed");
+	}
+
+	for (count = 8; count <= MAX_SOCKETS; count *= 2) {
+		uint32_t poll_cycles = run_poll(count);
+		uint32_t epoll_cycles = run_epoll(count);
+
+		report(count, poll_cycles, epoll_cycles);
+	}
+
+	for (i = 0; i < MAX_SOCKETS; i++) {
+		zsock_close(server_socks[i]);
+	}
+
+	zsock_close(client_sock);
+}
+
+ZTEST_SUITE(socket_epoll_perf, NULL, NULL, NULL, NULL, NULL);
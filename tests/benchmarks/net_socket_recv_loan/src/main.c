@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Compare the receive side CPU cost of a large TCP transfer over the
+ * loopback interface when the application stores the data in a final
+ * destination buffer (standing in for a flash page or a DMA buffer):
+ * once with zsock_recv() into an intermediate buffer followed by a copy,
+ * and once with zsock_recv_loan() copying straight out of the network
+ * buffers.
+ *
+ * The cost is derived from the cycle counter and only covers the receive
+ * calls and the copies, not the sending side. On native_sim the cycle
+ * counter does not advance while code executes, so there the benchmark
+ * only checks the data and reports the number of copied bytes.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+
+#define SERVER_PORT 4242
+#define TRANSFER_SIZE (1024 * 1024)
+#define CHUNK_SIZE 4096
+#define PAGE_SIZE 4096
+#define MAX_IOV 8
+
+static uint8_t tx_chunk[CHUNK_SIZE];
+static uint8_t recv_buf[CHUNK_SIZE];
+static uint8_t page[PAGE_SIZE];
+
+struct sink {
+	size_t fill;
+	size_t copied;
+	uint32_t sum;
+};
+
+static void sink_write(struct sink *sink, const uint8_t *data, size_t len)
+{
+	while (len > 0) {
+		size_t n = MIN(len, PAGE_SIZE - sink->fill);
+
+		memcpy(page + sink->fill, data, n);
+		sink->copied += n;
+		sink->fill += n;
+		data += n;
+		len -= n;
+
+		if (sink->fill == PAGE_SIZE) {
+			/* "Program" the page */
+			sink->sum += page[0] + page[PAGE_SIZE - 1];
+			sink->fill = 0;
+		}
+	}
+}
+
+static void open_connection(int *client, int *server)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int listener, ret;
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	listener = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(listener >= 0, "socket open failed");
+
+	ret = zsock_bind(listener, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(ret, 0, "bind failed (%d)", errno);
+
+	ret = zsock_listen(listener, 1);
+	zassert_equal(ret, 0, "listen failed (%d)", errno);
+
+	*client = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(*client >= 0, "socket open failed");
+
+	ret = zsock_connect(*client, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(ret, 0, "connect failed (%d)", errno);
+
+	*server = zsock_accept(listener, NULL, NULL);
+	zassert_true(*server >= 0, "accept failed (%d)", errno);
+
+	zsock_close(listener);
+}
+
+static void wait_readable(int sock)
+{
+	struct zsock_pollfd pfd = {
+		.fd = sock,
+		.events = ZSOCK_POLLIN,
+	};
+
+	zassert_equal(zsock_poll(&pfd, 1, 1000), 1, "no data");
+}
+
+static ssize_t recv_copy(int sock, struct sink *sink)
+{
+	ssize_t ret;
+
+	ret = zsock_recv(sock, recv_buf, sizeof(recv_buf), ZSOCK_MSG_DONTWAIT);
+	if (ret > 0) {
+		/* Account for the copy done by zsock_recv() as well */
+		sink->copied += ret;
+		sink_write(sink, recv_buf, ret);
+	}
+
+	return ret;
+}
+
+static ssize_t recv_loan(int sock, struct sink *sink)
+{
+	struct iovec iov[MAX_IOV];
+	struct zsock_recv_loan loan = {
+		.iov = iov,
+		.iovlen = ARRAY_SIZE(iov),
+		.buf = recv_buf,
+		.buf_len = sizeof(recv_buf),
+	};
+	ssize_t ret;
+
+	ret = zsock_recv_loan(sock, &loan, ZSOCK_MSG_DONTWAIT);
+	if (ret > 0) {
+		for (size_t i = 0; i < loan.iovlen; i++) {
+			sink_write(sink, loan.iov[i].iov_base, loan.iov[i].iov_len);
+		}
+
+		zsock_recv_loan_release(&loan);
+	}
+
+	return ret;
+}
+
+static uint32_t run(ssize_t (*receive)(int sock, struct sink *sink),
+		    struct sink *sink)
+{
+	uint32_t start, cycles = 0U;
+	size_t sent = 0, received = 0;
+	int client, server;
+	ssize_t ret;
+
+	open_connection(&client, &server);
+
+	while (received < TRANSFER_SIZE) {
+		if (sent == received) {
+			ret = zsock_send(client, tx_chunk,
+					 MIN(sizeof(tx_chunk), TRANSFER_SIZE - sent), 0);
+			zassert_true(ret > 0, "send failed (%d)", errno);
+			sent += ret;
+		}
+
+		wait_readable(server);
+
+		start = k_cycle_get_32();
+
+		ret = receive(server, sink);
+
+		cycles += k_cycle_get_32() - start;
+
+		if (ret < 0 && errno == EAGAIN) {
+			continue;
+		}
+
+		zassert_true(ret > 0, "receive failed (%d)", errno);
+		received += ret;
+	}
+
+	zassert_equal(received, TRANSFER_SIZE, "too much data");
+
+	zsock_close(client);
+	zsock_close(server);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY + 100));
+
+	return cycles;
+}
+
+static void report(const char *name, uint32_t cycles, struct sink *sink)
+{
+	if (cycles == 0U) {
+		TC_PRINT("%-5s %u bytes, %zu bytes copied, "
+			 "cycle counter did not advance\n",
+			 name, TRANSFER_SIZE, sink->copied);
+		return;
+	}
+
+	TC_PRINT("%-5s %u bytes, %zu bytes copied, %u cycles/KiB\n",
+		 name, TRANSFER_SIZE, sink->copied,
+		 cycles / (TRANSFER_SIZE / 1024));
+}
+
+ZTEST(socket_recv_loan_perf, test_large_transfer)
+{
+	struct sink copy_sink = { 0 }, loan_sink = { 0 };
+	uint32_t copy_cycles, loan_cycles;
+
+	for (size_t i = 0; i < sizeof(tx_chunk); i++) {
+		tx_chunk[i] = (uint8_t)i;
+	}
+
+	copy_cycles = run(recv_copy, &copy_sink);
+	loan_cycles = run(recv_loan, &loan_sink);
+
+	report("recv", copy_cycles, &copy_sink);
+	report("loan", loan_cycles, &loan_sink);
+
+	zassert_equal(copy_sink.sum, loan_sink.sum, "data differs");
+
+	if (copy_cycles > 0U && loan_cycles > 0U) {
+		TC_PRINT("receive CPU time reduced by %d%%\n",
+			 (int)(100 - (uint64_t)loan_cycles * 100U / copy_cycles));
+	}
+}
+
+ZTEST_SUITE(socket_recv_loan_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Compare UDP packets per second over the loopback interface when each
+ * datagram is sent and received with its own call against batching them
+ * with zsock_sendmmsg() and zsock_recvmmsg().
+ *
+ * The rates are derived from the cycle counter. On native_sim the cycle
+ * counter does not advance while code executes, so there only the number
+ * of socket calls per packet is meaningful.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+
+#define SERVER_PORT 4242
+#define PAYLOAD_LEN 32
+#define BATCH 16
+#define ROUNDS 64
+
+static uint8_t tx_payload[PAYLOAD_LEN];
+static uint8_t rx_bufs[BATCH][PAYLOAD_LEN];
+
+static int client_sock;
+static int server_sock;
+static struct sockaddr_in server_addr;
+
+struct bench_result {
+	uint32_t cycles;
+	uint32_t calls;
+};
+
+static void report(const char *name, struct bench_result *res)
+{
+	uint32_t pkts = BATCH * ROUNDS;
+
+	if (res->cycles == 0U) {
+		TC_PRINT("%-8s: %u packets, %u calls/1000 packets, "
+			 "cycle counter did not advance\n",
+			 name, pkts, res->calls * 1000U / pkts);
+		return;
+	}
+
+	TC_PRINT("%-8s: %u packets, %u calls/1000 packets, %llu packets/s\n",
+		 name, pkts, res->calls * 1000U / pkts,
+		 (uint64_t)pkts * sys_clock_hw_cycles_per_sec() / res->cycles);
+}
+
+static void run_single(struct bench_result *res)
+{
+	uint32_t start = k_cycle_get_32();
+	ssize_t ret;
+	int r, i;
+
+	for (r = 0; r < ROUNDS; r++) {
+		for (i = 0; i < BATCH; i++) {
+			ret = zsock_sendto(client_sock, tx_payload,
+					   sizeof(tx_payload), 0,
+					   (struct sockaddr *)&server_addr,
+					   sizeof(server_addr));
+			zassert_equal(ret, sizeof(tx_payload), "sendto failed");
+			res->calls++;
+		}
+
+		for (i = 0; i < BATCH; i++) {
+			ret = zsock_recv(server_sock, rx_bufs[i],
+					 sizeof(rx_bufs[i]), 0);
+			zassert_equal(ret, sizeof(tx_payload), "recv failed");
+			res->calls++;
+		}
+	}
+
+	res->cycles = k_cycle_get_32() - start;
+}
+
+static void run_batched(struct bench_result *res)
+{
+	struct zsock_mmsghdr tx_msgs[BATCH];
+	struct zsock_mmsghdr rx_msgs[BATCH];
+	struct iovec tx_io = {
+		.iov_base = tx_payload,
+		.iov_len = sizeof(tx_payload),
+	};
+	struct iovec rx_io[BATCH];
+	uint32_t start;
+	int received;
+	int ret;
+	int r, i;
+
+	memset(tx_msgs, 0, sizeof(tx_msgs));
+	memset(rx_msgs, 0, sizeof(rx_msgs));
+
+	for (i = 0; i < BATCH; i++) {
+		tx_msgs[i].msg_hdr.msg_iov = &tx_io;
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+		tx_msgs[i].msg_hdr.msg_name = &server_addr;
+		tx_msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+
+		rx_io[i].iov_base = rx_bufs[i];
+		rx_io[i].iov_len = sizeof(rx_bufs[i]);
+		rx_msgs[i].msg_hdr.msg_iov = &rx_io[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	start = k_cycle_get_32();
+
+	for (r = 0; r < ROUNDS; r++) {
+		ret = zsock_sendmmsg(client_sock, tx_msgs, BATCH, 0);
+		zassert_equal(ret, BATCH, "sendmmsg failed");
+		res->calls++;
+
+		for (received = 0; received < BATCH; received += ret) {
+			ret = zsock_recvmmsg(server_sock, &rx_msgs[received],
+					     BATCH - received,
+					     ZSOCK_MSG_WAITFORONE, NULL);
+			zassert_true(ret > 0, "recvmmsg failed");
+			res->calls++;
+		}
+	}
+
+	res->cycles = k_cycle_get_32() - start;
+}
+
+ZTEST(udp_mmsg_perf, test_packet_rate)
+{
+	struct bench_result single = { 0 };
+	struct bench_result batched = { 0 };
+	int ret;
+
+	client_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(client_sock >= 0, "socket open failed");
+
+	server_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(server_sock >= 0, "socket open failed");
+
+	server_addr.sin_family = AF_INET;
+	server_addr.sin_port = htons(SERVER_PORT);
+	zsock_inet_pton(AF_INET, "127.0.0.1", &server_addr.sin_addr);
+
+	ret = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			 sizeof(server_addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	run_single(&single);
+	run_batched(&batched);
+
+	report("single", &single);
+	report("batched", &batched);
+
+	zassert_true(batched.calls < single.calls, "batching did not help");
+
+	zsock_close(client_sock);
+	zsock_close(server_sock);
+}
+
+ZTEST_SUITE(udp_mmsg_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Run zperf uploads against the zperf receivers of the same image over the
+ * loopback interface, with one and with several parallel streams, and print
+ * one JSON object per run so that the results can be collected by a script
+ * and compared between builds.
+ *
+ * UDP runs send small packets at a fixed packet rate, and the receiver
+ * reports the one-way latency percentiles, which are meaningful here as the
+ * sender and the receiver share the same clock. The CPU load is sampled
+ * with the thread usage statistics during the uploads.
+ *
+ * Time is measured with the system uptime, which advances with the
+ * simulated time on native_sim, so there the latencies only reflect the
+ * queuing in the stack and not the processing cost. Run on hardware to get
+ * the processing cost.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/zperf.h>
+
+#define UDP_PORT 5001
+#define TCP_PORT 5002
+#define DURATION_MS 1000
+#define UDP_PACKET_SIZE 64
+#define UDP_RATE_PPS 1000
+#define TCP_PACKET_SIZE 512
+
+/* Aggregated results of the receiver sessions */
+static struct zperf_results server_results;
+static K_SEM_DEFINE(server_done, 0, CONFIG_NET_ZPERF_MAX_STREAMS);
+
+static void server_cb(enum zperf_status status, struct zperf_results *result,
+		      void *user_data)
+{
+	if (status != ZPERF_SESSION_FINISHED) {
+		return;
+	}
+
+	server_results.nb_packets_rcvd += result->nb_packets_rcvd;
+	server_results.nb_packets_lost += result->nb_packets_lost;
+	server_results.total_len += result->total_len;
+	server_results.latency_p50_us = MAX(server_results.latency_p50_us,
+					    result->latency_p50_us);
+	server_results.latency_p99_us = MAX(server_results.latency_p99_us,
+					    result->latency_p99_us);
+	server_results.latency_p999_us = MAX(server_results.latency_p999_us,
+					     result->latency_p999_us);
+
+	k_sem_give(&server_done);
+}
+
+static void wait_server(int streams)
+{
+	for (int i = 0; i < streams; i++) {
+		zassert_equal(k_sem_take(&server_done, K_SECONDS(5)), 0,
+			      "receiver session did not finish");
+	}
+}
+
+static void peer_addr(struct zperf_upload_params *param, uint16_t port)
+{
+	struct sockaddr_in *addr = net_sin(&param->peer_addr);
+
+	addr->sin_family = AF_INET;
+	addr->sin_port = htons(port);
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr->sin_addr);
+}
+
+static void udp_run(int streams)
+{
+	struct zperf_upload_params param = {
+		.duration_ms = DURATION_MS,
+		.rate_pps = UDP_RATE_PPS,
+		.packet_size = UDP_PACKET_SIZE,
+		.num_streams = streams,
+	};
+	struct zperf_results results;
+	int ret;
+
+	peer_addr(&param, UDP_PORT);
+	server_results = (struct zperf_results){ 0 };
+
+	ret = zperf_udp_upload(&param, &results);
+	zassert_equal(ret, 0, "UDP upload failed (%d)", ret);
+
+	wait_server(streams);
+
+	TC_PRINT("{\"proto\":\"udp\",\"streams\":%u,\"packet_size\":%u,"
+		 "\"packets_sent\":%u,\"packets_rcvd\":%u,\"pps\":%u,"
+		 "\"latency_p50_us\":%u,\"latency_p99_us\":%u,"
+		 "\"latency_p999_us\":%u,\"cpu_load\":%u}\n",
+		 results.num_streams, results.packet_size,
+		 results.nb_packets_sent, server_results.nb_packets_rcvd,
+		 (uint32_t)((uint64_t)results.nb_packets_sent * USEC_PER_SEC /
+			    MAX(results.client_time_in_us, 1)),
+		 server_results.latency_p50_us, server_results.latency_p99_us,
+		 server_results.latency_p999_us, results.cpu_load);
+
+	zassert_equal(results.num_streams, streams);
+	zassert_true(results.nb_packets_sent > 0, "nothing sent");
+	zassert_equal(results.nb_packets_rcvd, server_results.nb_packets_rcvd,
+		      "streams not aggregated");
+	zassert_equal(server_results.nb_packets_lost, 0, "packets lost");
+
+	/* Every stream keeps the packet rate */
+	zassert_within(results.nb_packets_sent,
+		       streams * UDP_RATE_PPS * DURATION_MS / MSEC_PER_SEC,
+		       streams * UDP_RATE_PPS * DURATION_MS / MSEC_PER_SEC / 10,
+		       "packet rate not kept");
+
+	zassert_true(server_results.latency_p50_us <= server_results.latency_p99_us &&
+		     server_results.latency_p99_us <= server_results.latency_p999_us,
+		     "inconsistent percentiles");
+}
+
+static void tcp_run(int streams)
+{
+	struct zperf_upload_params param = {
+		.duration_ms = DURATION_MS,
+		.packet_size = TCP_PACKET_SIZE,
+		.num_streams = streams,
+		.options.tcp_nodelay = 1,
+	};
+	struct zperf_results results;
+	int ret;
+
+	peer_addr(&param, TCP_PORT);
+	server_results = (struct zperf_results){ 0 };
+
+	ret = zperf_tcp_upload(&param, &results);
+	zassert_equal(ret, 0, "TCP upload failed (%d)", ret);
+
+	wait_server(streams);
+
+	TC_PRINT("{\"proto\":\"tcp\",\"streams\":%u,\"packet_size\":%u,"
+		 "\"packets_sent\":%u,\"errors\":%u,\"total_len\":%u,"
+		 "\"kbps\":%u,\"cpu_load\":%u}\n",
+		 results.num_streams, results.packet_size,
+		 results.nb_packets_sent, results.nb_packets_errors,
+		 (uint32_t)server_results.total_len,
+		 (uint32_t)(server_results.total_len * 8U * USEC_PER_SEC /
+			    1000U / MAX(results.client_time_in_us, 1)),
+		 results.cpu_load);
+
+	zassert_equal(results.num_streams, streams);
+	zassert_equal(results.nb_packets_errors, 0, "send errors");
+	zassert_equal(server_results.total_len,
+		      (uint64_t)results.nb_packets_sent * TCP_PACKET_SIZE,
+		      "data lost");
+}
+
+ZTEST(net_zperf, test_udp_pps)
+{
+	udp_run(1);
+	udp_run(CONFIG_NET_ZPERF_MAX_STREAMS);
+}
+
+ZTEST(net_zperf, test_tcp_streams)
+{
+	tcp_run(1);
+	tcp_run(CONFIG_NET_ZPERF_MAX_STREAMS);
+}
+
+ZTEST(net_zperf, test_too_many_streams)
+{
+	struct zperf_upload_params param = {
+		.duration_ms = DURATION_MS,
+		.num_streams = CONFIG_NET_ZPERF_MAX_STREAMS + 1,
+	};
+	struct zperf_results results;
+
+	peer_addr(&param, UDP_PORT);
+
+	zassert_equal(zperf_udp_upload(&param, &results), -EINVAL);
+}
+
+static void *setup(void)
+{
+	struct zperf_download_params param = { 0 };
+	int ret;
+
+	param.port = UDP_PORT;
+	ret = zperf_udp_download(&param, server_cb, NULL);
+	zassert_equal(ret, 0, "Cannot start UDP receiver (%d)", ret);
+
+	param.port = TCP_PORT;
+	ret = zperf_tcp_download(&param, server_cb, NULL);
+	zassert_equal(ret, 0, "Cannot start TCP receiver (%d)", ret);
+
+	return NULL;
+}
+
+static void teardown(void *data)
+{
+	(void)zperf_udp_download_stop();
+	(void)zperf_tcp_download_stop();
+}
+
+ZTEST_SUITE(net_zperf, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Increment the counters of a statistics group from one thread per CPU,
+ * concurrently, and report the cycles spent per increment. The threads are
+ * pinned to their CPU when CONFIG_SCHED_CPU_MASK is enabled, as it is in
+ * the SMP scenarios. Without
+ * CONFIG_STATS_PER_CPU all CPUs write to the same cache lines, with it each
+ * CPU writes to its own copy of the entries.
+ *
+ * Increments are not atomic, so without CONFIG_STATS_PER_CPU concurrent
+ * increments from several CPUs may be lost; the number of them lost is
+ * reported as well.
+ *
+ * On native_sim the cycle counter does not advance while code executes, so
+ * only the number of increments is reported there.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/ztest.h>
+
+#define BATCH_INCS 1000
+#define ROUNDS 100
+#define STACK_SIZE 1024
+
+STATS_SECT_START(bench_stats)
+STATS_SECT_ENTRY32(packets)
+STATS_SECT_END;
+
+STATS_NAME_START(bench_stats)
+STATS_NAME(bench_stats, packets)
+STATS_NAME_END(bench_stats);
+
+static STATS_SECT_DECL(bench_stats) bench_stats;
+
+static K_THREAD_STACK_ARRAY_DEFINE(bench_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread bench_threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static void bench_func(void *p1, void *p2, void *p3)
+{
+	uint64_t *result = p1;
+
+	for (int round = 0; round < ROUNDS; round++) {
+		uint32_t start = k_cycle_get_32();
+
+		for (int i = 0; i < BATCH_INCS; i++) {
+			STATS_INC(bench_stats, packets);
+		}
+
+		*result += k_cycle_get_32() - start;
+
+		/* Let the other threads run on a single CPU. */
+		k_yield();
+	}
+}
+
+ZTEST(stats_counters, test_increments)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint32_t expected = num_cpus * ROUNDS * BATCH_INCS;
+	uint64_t total = 0;
+	uint32_t packets;
+
+	zassert_ok(STATS_INIT_AND_REG(bench_stats, STATS_SIZE_32, "bench_stats"));
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_create(&bench_threads[i], bench_stacks[i],
+				K_THREAD_STACK_SIZEOF(bench_stacks[i]), bench_func,
+				&cycles[i], NULL, NULL, K_PRIO_PREEMPT(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		/* Keep each thread on its own CPU for the whole run. */
+		zassert_ok(k_thread_cpu_pin(&bench_threads[i], i));
+#endif
+	}
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_start(&bench_threads[i]);
+	}
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_join(&bench_threads[i], K_FOREVER);
+		total += cycles[i];
+	}
+
+	packets = STATS_GET(bench_stats, packets);
+
+	TC_PRINT("%s: %u increments from %u CPUs, %u lost\n",
+		 IS_ENABLED(CONFIG_STATS_PER_CPU) ? "per-CPU counters" : "shared counters",
+		 expected, num_cpus, expected - packets);
+
+	if (total == 0U) {
+		TC_PRINT("cycle counter did not advance\n");
+	} else {
+		TC_PRINT("%llu cycles per 1000 increments\n", total * 1000U / expected);
+	}
+
+	if (IS_ENABLED(CONFIG_STATS_PER_CPU) || (num_cpus == 1U)) {
+		zassert_equal(packets, expected);
+	}
+}
+
+ZTEST_SUITE(stats_counters, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Connect TLS sockets to a server socket over the loopback interface and
+ * report the handshake rate with full handshakes and with handshakes
+ * resuming a session from the server session cache (or from a session
+ * ticket when CONFIG_MBEDTLS_SSL_TICKET_C is enabled). Then send a stream
+ * of small writes and report the throughput when every write is sent in
+ * its own record, and when the writes are coalesced with TCP_CORK or
+ * MSG_MORE.
+ *
+ * Time is measured with the system uptime, which advances with the
+ * simulated time on native_sim, so there the results only reflect the
+ * number of round trips and packets, and not the cost of the cryptography.
+ * Run on hardware to get the processing cost.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/loopback.h>
+#include <zephyr/net/tls_credentials.h>
+
+#define SERVER_PORT 4433
+#define LINK_DELAY_MS 1
+#define HANDSHAKES 16
+#define WRITES 1024
+#define WRITE_LEN 16
+
+#define PSK_TAG 1
+
+static const unsigned char psk[] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+	0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+};
+static const char psk_id[] = "bench";
+static const sec_tag_t sec_tags[] = { PSK_TAG };
+
+static K_THREAD_STACK_DEFINE(server_stack, 8192);
+static struct k_thread server_thread;
+static int listen_sock;
+
+static struct sockaddr_in server_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(SERVER_PORT),
+};
+
+/* Given by the server when a connection has been closed by the client */
+static K_SEM_DEFINE(server_done, 0, 1);
+static size_t server_received;
+
+static void server_handler(void *p1, void *p2, void *p3)
+{
+	uint8_t buf[512];
+	int sock;
+	int ret;
+
+	while (true) {
+		sock = zsock_accept(listen_sock, NULL, NULL);
+		if (sock < 0) {
+			break;
+		}
+
+		server_received = 0;
+
+		while (true) {
+			ret = zsock_recv(sock, buf, sizeof(buf), 0);
+			if (ret <= 0) {
+				break;
+			}
+
+			server_received += ret;
+		}
+
+		zsock_close(sock);
+		k_sem_give(&server_done);
+	}
+}
+
+static int client_connect(bool resume)
+{
+	int cache = resume ? TLS_SESSION_CACHE_ENABLED : TLS_SESSION_CACHE_DISABLED;
+	int one = 1;
+	int sock;
+	int ret;
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	zassert_true(sock >= 0, "socket open failed (%d)", errno);
+
+	ret = zsock_setsockopt(sock, SOL_TLS, TLS_SEC_TAG_LIST, sec_tags, sizeof(sec_tags));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	ret = zsock_setsockopt(sock, SOL_TLS, TLS_SESSION_CACHE, &cache, sizeof(cache));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	ret = zsock_connect(sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(ret, 0, "connect failed (%d)", errno);
+
+	return sock;
+}
+
+static void client_close(int sock)
+{
+	zsock_close(sock);
+
+	zassert_equal(k_sem_take(&server_done, K_SECONDS(5)), 0, "server did not finish");
+
+	/* Let the connection go through TIME_WAIT */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY + 10));
+}
+
+static uint32_t handshakes(bool resume)
+{
+	uint32_t elapsed = 0;
+	uint32_t start;
+	int sock;
+
+	/* Prime the session caches */
+	if (resume) {
+		client_close(client_connect(true));
+	}
+
+	for (int i = 0; i < HANDSHAKES; i++) {
+		start = k_uptime_ticks();
+		sock = client_connect(resume);
+		elapsed += k_uptime_ticks() - start;
+
+		client_close(sock);
+	}
+
+	return elapsed;
+}
+
+enum write_mode {
+	WRITE_PLAIN,
+	WRITE_CORK,
+	WRITE_MSG_MORE,
+};
+
+static uint32_t bulk(enum write_mode mode)
+{
+	uint8_t buf[WRITE_LEN];
+	uint32_t start;
+	int optval;
+	int sock;
+	int ret;
+
+	memset(buf, 'x', sizeof(buf));
+
+	sock = client_connect(true);
+
+	start = k_uptime_ticks();
+
+	if (mode == WRITE_CORK) {
+		optval = 1;
+		ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CORK, &optval, sizeof(optval));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+	}
+
+	for (int i = 0; i < WRITES; i++) {
+		int flags = 0;
+
+		if (mode == WRITE_MSG_MORE && i < WRITES - 1) {
+			flags = ZSOCK_MSG_MORE;
+		}
+
+		ret = zsock_send(sock, buf, sizeof(buf), flags);
+		zassert_equal(ret, sizeof(buf), "send failed (%d)", errno);
+	}
+
+	if (mode == WRITE_CORK) {
+		optval = 0;
+		ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CORK, &optval, sizeof(optval));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+	}
+
+	client_close(sock);
+
+	zassert_equal(server_received, WRITES * WRITE_LEN, "data lost");
+
+	return k_uptime_ticks() - start;
+}
+
+static void report_handshakes(const char *mode, uint32_t elapsed)
+{
+	TC_PRINT("%-10s %u handshakes in %u ms, %u handshakes/sec\n", mode, HANDSHAKES,
+		 k_ticks_to_ms_floor32(elapsed),
+		 (uint32_t)((uint64_t)HANDSHAKES * CONFIG_SYS_CLOCK_TICKS_PER_SEC /
+			    MAX(elapsed, 1)));
+}
+
+static void report_bulk(const char *mode, uint32_t elapsed)
+{
+	TC_PRINT("%-10s %u bytes in %u ms, %u kB/sec\n", mode, WRITES * WRITE_LEN,
+		 k_ticks_to_ms_floor32(elapsed),
+		 (uint32_t)((uint64_t)WRITES * WRITE_LEN * CONFIG_SYS_CLOCK_TICKS_PER_SEC /
+			    1024 / MAX(elapsed, 1)));
+}
+
+ZTEST(tls_sockets, test_handshake_rate)
+{
+	TC_PRINT("ECDHE-PSK, link delay %d ms\n", LINK_DELAY_MS);
+
+	report_handshakes("full", handshakes(false));
+	report_handshakes("resumed", handshakes(true));
+}
+
+ZTEST(tls_sockets, test_bulk_small_writes)
+{
+	TC_PRINT("%d writes of %d bytes, coalescing buffer %d bytes, link delay %d ms\n",
+		 WRITES, WRITE_LEN, CONFIG_NET_SOCKETS_TLS_CORK_BUF_SIZE, LINK_DELAY_MS);
+
+	report_bulk("plain", bulk(WRITE_PLAIN));
+	report_bulk("TCP_CORK", bulk(WRITE_CORK));
+	report_bulk("MSG_MORE", bulk(WRITE_MSG_MORE));
+}
+
+static void *setup(void)
+{
+	int cache = TLS_SESSION_CACHE_ENABLED;
+	int ret;
+
+	loopback_set_packet_delay(LINK_DELAY_MS);
+
+	ret = tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK, psk, sizeof(psk));
+	zassert_equal(ret, 0, "Failed to register PSK (%d)", ret);
+
+	ret = tls_credential_add(PSK_TAG, TLS_CREDENTIAL_PSK_ID, psk_id, strlen(psk_id));
+	zassert_equal(ret, 0, "Failed to register PSK ID (%d)", ret);
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &server_addr.sin_addr);
+
+	listen_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TLS_1_2);
+	zassert_true(listen_sock >= 0, "socket open failed");
+
+	ret = zsock_setsockopt(listen_sock, SOL_TLS, TLS_SEC_TAG_LIST, sec_tags,
+			       sizeof(sec_tags));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	/* Accepted sockets inherit the option and share the server cache */
+	ret = zsock_setsockopt(listen_sock, SOL_TLS, TLS_SESSION_CACHE, &cache, sizeof(cache));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	ret = zsock_bind(listen_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	ret = zsock_listen(listen_sock, 1);
+	zassert_equal(ret, 0, "listen failed");
+
+	k_thread_create(&server_thread, server_stack,
+			K_THREAD_STACK_SIZEOF(server_stack), server_handler,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	return NULL;
+}
+
+static void teardown(void *data)
+{
+	zsock_close(listen_sock);
+	k_thread_join(&server_thread, K_SECONDS(1));
+}
+
+ZTEST_SUITE(tls_sockets, NULL, setup, NULL, NULL, teardown);
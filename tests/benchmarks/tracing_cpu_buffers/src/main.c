@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Trace batches of events the size of a CTF thread event from one thread
+ * per CPU, concurrently, and report the cycles spent per event. The batches
+ * are small enough for the tracing buffers to hold them, and the threads
+ * sleep between batches to let the tracing thread output them, so that only
+ * recording is measured. With CONFIG_TRACING_PER_CPU_BUFFERS the events are
+ * recorded to the buffer of the CPU without a lock shared between CPUs.
+ *
+ * On native_sim the cycle counter does not advance while code executes, so
+ * only the number of events traced is reported there.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tracing/tracing_format.h>
+#include <zephyr/ztest.h>
+
+#define BATCH_EVENTS 16
+#define ROUNDS 200
+#define STACK_SIZE 2048
+
+/* Timestamp, event ID, thread ID and bounded thread name. */
+struct bench_event {
+	uint32_t timestamp;
+	uint8_t id;
+	uint32_t thread_id;
+	char name[20];
+} __packed;
+
+struct bench_result {
+	uint64_t cycles;
+	uint32_t events;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(bench_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread bench_threads[CONFIG_MP_MAX_NUM_CPUS];
+static struct bench_result results[CONFIG_MP_MAX_NUM_CPUS];
+
+static void bench_func(void *p1, void *p2, void *p3)
+{
+	struct bench_result *result = p1;
+	struct bench_event event = {
+		.id = 0x11,
+		.thread_id = (uint32_t)(uintptr_t)k_current_get(),
+		.name = "bench",
+	};
+
+	for (int round = 0; round < ROUNDS; round++) {
+		uint32_t start = k_cycle_get_32();
+
+		for (int i = 0; i < BATCH_EVENTS; i++) {
+			event.timestamp = start;
+			tracing_format_raw_data((uint8_t *)&event, sizeof(event));
+		}
+
+		result->cycles += k_cycle_get_32() - start;
+		result->events += BATCH_EVENTS;
+
+		if (IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER)) {
+			continue;
+		}
+
+		k_msleep(1);
+	}
+}
+
+ZTEST(tracing_cpu_buffers, test_events)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint64_t cycles = 0;
+	uint32_t events = 0;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_create(&bench_threads[i], bench_stacks[i],
+				K_THREAD_STACK_SIZEOF(bench_stacks[i]), bench_func,
+				&results[i], NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_thread_join(&bench_threads[i], K_FOREVER);
+		cycles += results[i].cycles;
+		events += results[i].events;
+	}
+
+	TC_PRINT("%s: %u events traced from %u CPUs\n",
+		 IS_ENABLED(CONFIG_TRACING_FLIGHT_RECORDER) ? "flight recorder" :
+		 IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS) ? "per-CPU buffers" :
+		 "shared buffer",
+		 events, num_cpus);
+
+	if (cycles == 0U) {
+		TC_PRINT("cycle counter did not advance\n");
+	} else {
+		TC_PRINT("%llu cycles per event\n", cycles / events);
+	}
+
+	zassert_equal(events, num_cpus * ROUNDS * BATCH_EVENTS);
+}
+
+ZTEST_SUITE(tracing_cpu_buffers, NULL, NULL, NULL, NULL, NULL);
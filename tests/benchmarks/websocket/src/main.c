@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Connect a websocket to a minimal server over the loopback interface and
+ * report the client throughput for several frame sizes when sending masked
+ * frames, unmasked frames, and masked frames split in several buffers with
+ * websocket_send_msgv(), and when receiving masked frames.
+ *
+ * The throughput is derived from the cycle counter spent in the websocket
+ * calls, so that it reflects the framing and masking cost. On native_sim
+ * the cycle counter does not advance while code executes, so there the
+ * benchmark only checks that every byte reaches the other end.
+ */
+
+#include <stdio.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/websocket.h>
+#include <zephyr/sys/base64.h>
+#include <mbedtls/sha1.h>
+
+#define SERVER_PORT 8080
+#define TOTAL_LEN (256 * 1024)
+#define MAX_FRAME_LEN (64 * 1024)
+#define SPLIT_COUNT 4
+#define WS_MAGIC "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+static const size_t frame_lens[] = { 1024, 4096, 16384, MAX_FRAME_LEN };
+
+enum mode {
+	MODE_SEND_MASKED,
+	MODE_SEND_UNMASKED,
+	MODE_SEND_MASKED_IOV,
+	MODE_RECV_MASKED,
+};
+
+static const char * const mode_str[] = {
+	[MODE_SEND_MASKED] = "send masked",
+	[MODE_SEND_UNMASKED] = "send unmasked",
+	[MODE_SEND_MASKED_IOV] = "sendv masked",
+	[MODE_RECV_MASKED] = "recv masked",
+};
+
+static K_THREAD_STACK_DEFINE(server_stack, 4096);
+static struct k_thread server_thread;
+static int listen_sock;
+
+static struct sockaddr_in server_addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(SERVER_PORT),
+};
+
+/* Phase run by the server, set before giving server_start */
+static enum mode server_mode;
+static size_t server_frame_len;
+static size_t server_count;
+static K_SEM_DEFINE(server_start, 0, 1);
+static K_SEM_DEFINE(server_done, 0, 1);
+
+static uint8_t payload[MAX_FRAME_LEN];
+static uint8_t server_buf[MAX_FRAME_LEN + 14];
+static uint8_t recv_buf[MAX_FRAME_LEN];
+static uint8_t tmp_buf[512];
+
+static int recv_all(int sock, uint8_t *buf, size_t len)
+{
+	int ret;
+
+	while (len > 0) {
+		ret = zsock_recv(sock, buf, len, 0);
+		if (ret <= 0) {
+			return -EIO;
+		}
+
+		buf += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+static int send_all(int sock, const uint8_t *buf, size_t len)
+{
+	int ret;
+
+	while (len > 0) {
+		ret = zsock_send(sock, buf, len, 0);
+		if (ret < 0) {
+			return -EIO;
+		}
+
+		buf += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+static int server_handshake(int sock)
+{
+	static const char key_hdr[] = "Sec-WebSocket-Key: ";
+	char request[512];
+	char accept_key[sizeof("Sec-WebSocket-Accept: ") + 32];
+	char key_accept[32 + sizeof(WS_MAGIC)];
+	unsigned char sha1[20];
+	char response[256];
+	size_t len = 0;
+	size_t olen;
+	char *key;
+	char *end;
+	int ret;
+
+	while (true) {
+		ret = zsock_recv(sock, request + len, sizeof(request) - 1 - len, 0);
+		if (ret <= 0) {
+			return -EIO;
+		}
+
+		len += ret;
+		request[len] = '\0';
+
+		if (strstr(request, "\r\n\r\n") != NULL) {
+			break;
+		}
+	}
+
+	key = strstr(request, key_hdr);
+	if (key == NULL) {
+		return -EINVAL;
+	}
+
+	key += sizeof(key_hdr) - 1;
+	end = strstr(key, "\r\n");
+	if (end == NULL || end - key > 32) {
+		return -EINVAL;
+	}
+
+	len = end - key;
+	memcpy(key_accept, key, len);
+	memcpy(key_accept + len, WS_MAGIC, sizeof(WS_MAGIC) - 1);
+
+	mbedtls_sha1((const unsigned char *)key_accept,
+		     len + sizeof(WS_MAGIC) - 1, sha1);
+
+	ret = base64_encode(accept_key, sizeof(accept_key), &olen, sha1,
+			    sizeof(sha1));
+	if (ret < 0) {
+		return ret;
+	}
+
+	len = snprintk(response, sizeof(response),
+		       "HTTP/1.1 101 Switching Protocols\r\n"
+		       "Upgrade: websocket\r\n"
+		       "Connection: Upgrade\r\n"
+		       "Sec-WebSocket-Accept: %s\r\n\r\n", accept_key);
+
+	return send_all(sock, response, len);
+}
+
+/* Read count frames from the client and drop their payload */
+static int server_recv_frames(int sock, size_t count)
+{
+	uint64_t len;
+	uint8_t *hdr;
+	size_t hdr_len;
+	int ret;
+
+	for (size_t i = 0; i < count; i++) {
+		hdr = server_buf;
+
+		ret = recv_all(sock, hdr, 2);
+		if (ret < 0) {
+			return ret;
+		}
+
+		len = hdr[1] & 0x7f;
+		hdr_len = 0;
+
+		if (len == 126) {
+			hdr_len = 2;
+		} else if (len == 127) {
+			hdr_len = 8;
+		}
+
+		if (hdr[1] & 0x80) {
+			hdr_len += 4;
+		}
+
+		ret = recv_all(sock, hdr + 2, hdr_len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (len == 126) {
+			len = sys_get_be16(hdr + 2);
+		} else if (len == 127) {
+			len = sys_get_be64(hdr + 2);
+		}
+
+		if (len > MAX_FRAME_LEN) {
+			return -EMSGSIZE;
+		}
+
+		ret = recv_all(sock, server_buf, len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* Send count masked binary frames to the client */
+static int server_send_frames(int sock, size_t frame_len, size_t count)
+{
+	size_t hdr_len = 2 + 4;
+	int ret;
+
+	server_buf[0] = 0x80 | WEBSOCKET_OPCODE_DATA_BINARY;
+
+	if (frame_len < 126) {
+		server_buf[1] = 0x80 | frame_len;
+	} else if (frame_len < 65536) {
+		server_buf[1] = 0x80 | 126;
+		sys_put_be16(frame_len, server_buf + 2);
+		hdr_len += 2;
+	} else {
+		server_buf[1] = 0x80 | 127;
+		sys_put_be64(frame_len, server_buf + 2);
+		hdr_len += 8;
+	}
+
+	/* The content does not matter, the client unmasks it anyway */
+	sys_put_be32(0x12345678, server_buf + hdr_len - 4);
+	memset(server_buf + hdr_len, 0xa5, frame_len);
+
+	for (size_t i = 0; i < count; i++) {
+		ret = send_all(sock, server_buf, hdr_len + frame_len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void server_handler(void *p1, void *p2, void *p3)
+{
+	int sock;
+	int ret;
+
+	sock = zsock_accept(listen_sock, NULL, NULL);
+	if (sock < 0) {
+		return;
+	}
+
+	ret = server_handshake(sock);
+
+	while (ret == 0) {
+		k_sem_take(&server_start, K_FOREVER);
+
+		if (server_count == 0) {
+			break;
+		}
+
+		if (server_mode == MODE_RECV_MASKED) {
+			ret = server_send_frames(sock, server_frame_len,
+						 server_count);
+		} else {
+			ret = server_recv_frames(sock, server_count);
+		}
+
+		k_sem_give(&server_done);
+	}
+
+	zsock_close(sock);
+}
+
+static int client_connect(void)
+{
+	struct websocket_request req = {
+		.host = "127.0.0.1",
+		.url = "/",
+		.tmp_buf = tmp_buf,
+		.tmp_buf_len = sizeof(tmp_buf),
+	};
+	int sock;
+	int ret;
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket open failed (%d)", errno);
+
+	ret = zsock_connect(sock, (struct sockaddr *)&server_addr,
+			    sizeof(server_addr));
+	zassert_equal(ret, 0, "connect failed (%d)", errno);
+
+	ret = websocket_connect(sock, &req, 5 * MSEC_PER_SEC, NULL);
+	zassert_true(ret >= 0, "websocket connect failed (%d)", ret);
+
+	return ret;
+}
+
+static int client_send(int ws_sock, enum mode mode, size_t frame_len)
+{
+	struct iovec iov[SPLIT_COUNT];
+	size_t part = frame_len / SPLIT_COUNT;
+
+	if (mode != MODE_SEND_MASKED_IOV) {
+		return websocket_send_msg(ws_sock, payload, frame_len,
+					  WEBSOCKET_OPCODE_DATA_BINARY,
+					  mode == MODE_SEND_MASKED, true,
+					  SYS_FOREVER_MS);
+	}
+
+	for (int i = 0; i < SPLIT_COUNT; i++) {
+		iov[i].iov_base = payload + i * part;
+		iov[i].iov_len = part;
+	}
+
+	return websocket_send_msgv(ws_sock, iov, SPLIT_COUNT,
+				   WEBSOCKET_OPCODE_DATA_BINARY, true, true,
+				   SYS_FOREVER_MS);
+}
+
+static int client_recv(int ws_sock, size_t frame_len)
+{
+	uint64_t remaining;
+	uint32_t type;
+	size_t len = 0;
+	int ret;
+
+	do {
+		ret = websocket_recv_msg(ws_sock, recv_buf + len,
+					 sizeof(recv_buf) - len, &type,
+					 &remaining, SYS_FOREVER_MS);
+		if (ret < 0) {
+			return ret;
+		}
+
+		len += ret;
+	} while (remaining > 0);
+
+	return len;
+}
+
+static uint32_t run(int ws_sock, enum mode mode, size_t frame_len)
+{
+	size_t count = TOTAL_LEN / frame_len;
+	uint32_t start, cycles = 0U;
+	int ret;
+
+	server_mode = mode;
+	server_frame_len = frame_len;
+	server_count = count;
+	k_sem_give(&server_start);
+
+	for (size_t i = 0; i < count; i++) {
+		start = k_cycle_get_32();
+
+		if (mode == MODE_RECV_MASKED) {
+			ret = client_recv(ws_sock, frame_len);
+		} else {
+			ret = client_send(ws_sock, mode, frame_len);
+		}
+
+		cycles += k_cycle_get_32() - start;
+
+		zassert_equal(ret, frame_len, "%s of %zu bytes failed (%d)",
+			      mode_str[mode], frame_len, ret);
+	}
+
+	zassert_equal(k_sem_take(&server_done, K_SECONDS(10)), 0,
+		      "server did not finish");
+
+	return cycles;
+}
+
+static void report(enum mode mode, size_t frame_len, uint32_t cycles)
+{
+	if (cycles == 0U) {
+		TC_PRINT("%-13s %6zu: %u bytes, cycle counter did not advance\n",
+			 mode_str[mode], frame_len, TOTAL_LEN);
+		return;
+	}
+
+	TC_PRINT("%-13s %6zu: %u bytes in %u cycles, %u kB/sec\n",
+		 mode_str[mode], frame_len, TOTAL_LEN, cycles,
+		 (uint32_t)((uint64_t)TOTAL_LEN * sys_clock_hw_cycles_per_sec() /
+			    1024 / cycles));
+}
+
+ZTEST(websocket, test_throughput)
+{
+	int ws_sock;
+
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+
+	k_thread_create(&server_thread, server_stack,
+			K_THREAD_STACK_SIZEOF(server_stack), server_handler,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	ws_sock = client_connect();
+
+	TC_PRINT("%u bytes per run, %d buffers per sendv frame\n", TOTAL_LEN,
+		 SPLIT_COUNT);
+
+	for (int i = 0; i < ARRAY_SIZE(frame_lens); i++) {
+		for (int mode = 0; mode < ARRAY_SIZE(mode_str); mode++) {
+			report(mode, frame_lens[i],
+			       run(ws_sock, mode, frame_lens[i]));
+		}
+	}
+
+	/* Stop the server */
+	server_count = 0;
+	k_sem_give(&server_start);
+
+	websocket_disconnect(ws_sock);
+	k_thread_join(&server_thread, K_SECONDS(1));
+}
+
+static void *setup(void)
+{
+	int ret;
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &server_addr.sin_addr);
+
+	listen_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(listen_sock >= 0, "socket open failed");
+
+	ret = zsock_bind(listen_sock, (struct sockaddr *)&server_addr,
+			 sizeof(server_addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	ret = zsock_listen(listen_sock, 1);
+	zassert_equal(ret, 0, "listen failed");
+
+	return NULL;
+}
+
+static void teardown(void *data)
+{
+	zsock_close(listen_sock);
+}
+
+ZTEST_SUITE(websocket, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/irq_offload.h>
+#include <zephyr/ztest.h>
+
+#define WINDOW_MS CONFIG_SCHED_USAGE_MONITOR_WINDOW_MS
+#define BUSY_WINDOWS 4
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_THREAD_STACK_DEFINE(busy_stack, STACK_SIZE);
+static struct k_thread busy_thread;
+
+static void busy_entry(void *p1, void *p2, void *p3)
+{
+	int64_t end = k_uptime_get() + BUSY_WINDOWS * WINDOW_MS;
+
+	while (k_uptime_get() < end) {
+		k_busy_wait(100);
+	}
+}
+
+/* Wait for the start of the next window, so that windows are whole */
+static void window_sync(void)
+{
+	struct k_usage_window window;
+	uint32_t end_ms = 0;
+
+	if (k_usage_monitor_window_get(0, &window) == 0) {
+		end_ms = window.end_ms;
+	}
+
+	do {
+		k_msleep(1);
+	} while ((k_usage_monitor_window_get(0, &window) != 0) || (window.end_ms == end_ms));
+}
+
+ZTEST(usage_monitor, test_thread_load)
+{
+	struct k_usage_window window;
+	k_thread_runtime_stats_t stats;
+
+	window_sync();
+
+	k_thread_create(&busy_thread, busy_stack, K_THREAD_STACK_SIZEOF(busy_stack),
+			busy_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_thread_name_set(&busy_thread, "busy");
+	k_thread_join(&busy_thread, K_FOREVER);
+
+	/* The last windows before the end of the busy thread are fully busy */
+	zassert_ok(k_usage_monitor_window_get(1, &window));
+	TC_PRINT("CPU load %u, busiest thread %p load %u\n", window.cpu_load[0],
+		 window.threads[0].thread, window.threads[0].load);
+
+	zassert_true(window.cpu_load[0] > 950, "CPU load %u", window.cpu_load[0]);
+	zassert_equal(window.threads[0].thread, &busy_thread);
+	zassert_true(window.threads[0].load > 950, "thread load %u", window.threads[0].load);
+	zassert_true(window.threads[1].load < 50);
+
+	/* The busy thread has not run in the windows since it ended */
+	window_sync();
+	window_sync();
+
+	zassert_ok(k_usage_monitor_window_get(0, &window));
+	zassert_true(window.cpu_load[0] < 50, "CPU load %u", window.cpu_load[0]);
+	for (size_t i = 0; i < ARRAY_SIZE(window.threads); i++) {
+		zassert_not_equal(window.threads[i].thread, &busy_thread);
+	}
+
+	zassert_ok(k_thread_runtime_stats_get(k_current_get(), &stats));
+	zassert_true(stats.window_load < 50);
+	zassert_ok(k_thread_runtime_stats_all_get(&stats));
+	zassert_true(stats.window_load < 50);
+}
+
+ZTEST(usage_monitor, test_history)
+{
+	struct k_usage_window window;
+	uint32_t end_ms;
+
+	for (unsigned int i = 0; i < CONFIG_SCHED_USAGE_MONITOR_HISTORY; i++) {
+		window_sync();
+	}
+
+	zassert_ok(k_usage_monitor_window_get(0, &window));
+	end_ms = window.end_ms;
+
+	for (unsigned int age = 1; age < CONFIG_SCHED_USAGE_MONITOR_HISTORY; age++) {
+		zassert_ok(k_usage_monitor_window_get(age, &window));
+		zassert_within(end_ms - window.end_ms, WINDOW_MS, 1,
+			       "window %u ends %u ms earlier", age, end_ms - window.end_ms);
+		end_ms = window.end_ms;
+	}
+
+	zassert_equal(k_usage_monitor_window_get(CONFIG_SCHED_USAGE_MONITOR_HISTORY, &window),
+		      -ENOENT);
+}
+
+#ifdef CONFIG_SCHED_USAGE_MONITOR_ISR
+static void isr_busy(const void *arg)
+{
+	k_busy_wait(POINTER_TO_UINT(arg));
+}
+
+ZTEST(usage_monitor, test_isr_load)
+{
+	struct k_usage_window window;
+
+	window_sync();
+
+	/* Spend half of most of a window in interrupts */
+	for (unsigned int i = 0; i < WINDOW_MS * 9 / 10; i++) {
+		irq_offload(isr_busy, UINT_TO_POINTER(USEC_PER_MSEC / 2));
+		k_busy_wait(USEC_PER_MSEC / 2);
+	}
+
+	window_sync();
+
+	zassert_ok(k_usage_monitor_window_get(0, &window));
+	TC_PRINT("ISR load %u, busiest IRQ %u load %u\n", window.isr_load[0],
+		 window.isrs[0].irq, window.isrs[0].load);
+
+	zassert_within(window.isr_load[0], 450, 100, "ISR load %u", window.isr_load[0]);
+	zassert_within(window.isrs[0].load, 450, 100, "IRQ load %u", window.isrs[0].load);
+	zassert_true(window.isrs[1].load < 50);
+}
+#endif
+
+ZTEST_SUITE(usage_monitor, NULL, NULL, NULL, NULL, NULL);
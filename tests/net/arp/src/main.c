@@ -45,6 +45,8 @@ static struct net_eth_addr eth_hwaddr = { { 0x42, 0x11, 0x69, 0xde, 0xfa, 0xec }
 
 static int send_status = -EINVAL;
 
+static int unicast_arp_count;
+
 struct net_arp_context {
 	uint8_t mac_addr[sizeof(struct net_eth_addr)];
 	struct net_linkaddr ll_addr;
@@ -94,6 +96,11 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 
 	hdr = (struct net_eth_hdr *)net_pkt_data(pkt);
 
+	if (ntohs(hdr->type) == NET_ETH_PTYPE_ARP &&
+	    !net_eth_is_addr_broadcast(&hdr->dst)) {
+		unicast_arp_count++;
+	}
+
 	if (ntohs(hdr->type) == NET_ETH_PTYPE_ARP) {
 		/* First frag has eth hdr */
 		struct net_arp_hdr *arp_hdr =
@@ -648,4 +655,196 @@ ZTEST(arp_fn_tests, test_arp)
 	}
 }
 
+static struct net_if *setup_iface(void)
+{
+	struct in_addr src = { { { 192, 168, 0, 1 } } };
+	struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+	struct net_if_addr *ifaddr;
+	struct net_if *iface;
+
+	net_arp_init();
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_arp_test));
+
+	ifaddr = net_if_ipv4_addr_add(iface, &src, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add address");
+	ifaddr->addr_state = NET_ADDR_PREFERRED;
+
+	net_if_ipv4_set_netmask_by_addr(iface, &src, &netmask);
+
+	net_arp_clear_cache(iface);
+
+	return iface;
+}
+
+static struct net_pkt *prepare_ipv4_pkt(struct net_if *iface,
+					struct in_addr *dst)
+{
+	struct in_addr src = { { { 192, 168, 0, 1 } } };
+	struct net_ipv4_hdr *ipv4;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr),
+					AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+
+	ipv4 = (struct net_ipv4_hdr *)net_buf_add(pkt->buffer,
+						  sizeof(struct net_ipv4_hdr));
+	net_ipv4_addr_copy_raw(ipv4->src, (uint8_t *)&src);
+	net_ipv4_addr_copy_raw(ipv4->dst, (uint8_t *)dst);
+
+	return pkt;
+}
+
+ZTEST(arp_fn_tests, test_arp_pending_queue)
+{
+	struct net_pkt *pkts[CONFIG_NET_ARP_PENDING_QUEUE_SIZE + 1];
+	struct in_addr dst = { { { 192, 168, 0, 3 } } };
+	struct net_pkt *req;
+	struct net_if *iface;
+	int i;
+
+	iface = setup_iface();
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		pkts[i] = prepare_ipv4_pkt(iface, &dst);
+
+		req = net_arp_prepare(pkts[i], &dst, NULL);
+		if (i == 0) {
+			zassert_not_null(req, "ARP request not created");
+			zassert_not_equal(req, pkts[i], "Packet not queued");
+			net_pkt_unref(req);
+		} else {
+			zassert_is_null(req, "Packet %d not queued", i);
+		}
+	}
+
+	/* The queue is bounded, so the oldest packet was dropped */
+	zassert_equal(atomic_get(&pkts[0]->atomic_ref), 1,
+		      "Oldest packet still queued");
+
+	for (i = 1; i < ARRAY_SIZE(pkts); i++) {
+		zassert_equal(atomic_get(&pkts[i]->atomic_ref), 2,
+			      "Packet %d not queued", i);
+	}
+
+	/* Resolving the address sends the queued packets */
+	net_arp_update(iface, &dst, &eth_hwaddr, false, false);
+
+	for (i = 1; i < ARRAY_SIZE(pkts); i++) {
+		zassert_equal(atomic_get(&pkts[i]->atomic_ref), 1,
+			      "Packet %d still queued", i);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		net_pkt_unref(pkts[i]);
+	}
+
+	entry_found = false;
+	expected_hwaddr = &eth_hwaddr;
+	net_arp_foreach(arp_cb, &dst);
+	zassert_true(entry_found, "Entry not found");
+
+	net_arp_clear_cache(iface);
+}
+
+ZTEST(arp_fn_tests, test_arp_table_lru)
+{
+	struct net_eth_addr hwaddr = { { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 } };
+	struct in_addr dst = { { { 192, 168, 0, 10 } } };
+	struct net_pkt *pkt, *ret;
+	struct net_if *iface;
+	int i;
+
+	iface = setup_iface();
+
+	/* Fill the table and then use the first entry again, so that
+	 * the second one is the least recently used.
+	 */
+	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
+		dst.s4_addr[3] = 10 + i;
+		hwaddr.addr[5] = i;
+		net_arp_update(iface, &dst, &hwaddr, false, true);
+	}
+
+	dst.s4_addr[3] = 10;
+	pkt = prepare_ipv4_pkt(iface, &dst);
+	ret = net_arp_prepare(pkt, &dst, NULL);
+	zassert_equal(ret, pkt, "Entry not found");
+	net_pkt_unref(pkt);
+
+	dst.s4_addr[3] = 10 + CONFIG_NET_ARP_TABLE_SIZE;
+	hwaddr.addr[5] = CONFIG_NET_ARP_TABLE_SIZE;
+	net_arp_update(iface, &dst, &hwaddr, false, true);
+
+	entry_found = false;
+	expected_hwaddr = &hwaddr;
+	zassert_equal(net_arp_foreach(arp_cb, &dst), CONFIG_NET_ARP_TABLE_SIZE,
+		      "Invalid number of entries");
+	zassert_true(entry_found, "New entry not found");
+
+	dst.s4_addr[3] = 10;
+	hwaddr.addr[5] = 0;
+	entry_found = false;
+	net_arp_foreach(arp_cb, &dst);
+	zassert_true(entry_found, "Recently used entry evicted");
+
+	dst.s4_addr[3] = 11;
+	hwaddr.addr[5] = 1;
+	entry_found = false;
+	net_arp_foreach(arp_cb, &dst);
+	zassert_false(entry_found, "Least recently used entry not evicted");
+
+	net_arp_clear_cache(iface);
+}
+
+ZTEST(arp_fn_tests, test_arp_lifetime)
+{
+#if CONFIG_NET_ARP_ENTRY_LIFETIME > 0
+	struct in_addr dst = { { { 192, 168, 0, 4 } } };
+	struct net_pkt *pkt, *ret;
+	struct net_if *iface;
+
+	iface = setup_iface();
+
+	net_arp_update(iface, &dst, &eth_hwaddr, false, true);
+
+	pkt = prepare_ipv4_pkt(iface, &dst);
+
+	ret = net_arp_prepare(pkt, &dst, NULL);
+	zassert_equal(ret, pkt, "Entry not found");
+
+	unicast_arp_count = 0;
+
+	/* Close to the end of the lifetime the entry is still used but it
+	 * is refreshed with a unicast request.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_ARP_ENTRY_LIFETIME * MSEC_PER_SEC -
+		       CONFIG_NET_ARP_REFRESH_TIME * MSEC_PER_SEC / 2));
+
+	ret = net_arp_prepare(pkt, &dst, NULL);
+	zassert_equal(ret, pkt, "Entry not found before expiry");
+
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(unicast_arp_count, 1, "Entry not refreshed");
+
+	/* Without a reply the entry expires */
+	k_sleep(K_MSEC(CONFIG_NET_ARP_REFRESH_TIME * MSEC_PER_SEC));
+
+	ret = net_arp_prepare(pkt, &dst, NULL);
+	zassert_not_null(ret, "ARP request not created");
+	zassert_not_equal(ret, pkt, "Expired entry used");
+
+	net_pkt_unref(ret);
+
+	net_arp_clear_cache(iface);
+
+	zassert_equal(atomic_get(&pkt->atomic_ref), 1, "Packet still queued");
+	net_pkt_unref(pkt);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(arp_fn_tests, NULL, NULL, NULL, NULL, NULL);
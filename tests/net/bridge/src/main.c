@@ -368,6 +368,168 @@ static void test_recv_after_bridging(void)
 	test_recv_before_bridging();
 }
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+/*
+ * Simulate the reception of a frame with the given addresses
+ */
+static void recv_frame(struct net_if *iface, const uint8_t *src, const uint8_t *dst)
+{
+	struct net_pkt *pkt;
+	struct net_eth_hdr eth_hdr;
+	static uint8_t data[] = { 'f', 'd', 'b', '\0' };
+	int ret;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, sizeof(eth_hdr) + sizeof(data),
+					   AF_UNSPEC, 0, K_FOREVER);
+	zassert_not_null(pkt, "");
+
+	memcpy(eth_hdr.dst.addr, dst, sizeof(eth_hdr.dst.addr));
+	memcpy(eth_hdr.src.addr, src, sizeof(eth_hdr.src.addr));
+	eth_hdr.type = htons(NET_ETH_PTYPE_ALL);
+
+	ret = net_pkt_write(pkt, &eth_hdr, sizeof(eth_hdr));
+	zassert_equal(ret, 0, "");
+
+	ret = net_pkt_write(pkt, data, sizeof(data));
+	zassert_equal(ret, 0, "");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "");
+
+	/* give time to the processing threads to run */
+	k_sleep(K_MSEC(50));
+}
+
+/*
+ * Check which interfaces sent a frame, given as a bit mask, and release
+ * the sent packets.
+ */
+static void check_sent(uint8_t expected, const uint8_t *dst)
+{
+	for (int i = 0; i < ARRAY_SIZE(eth_fake_data); i++) {
+		struct net_pkt *pkt = eth_fake_data[i].sent_pkt;
+
+		if (!(expected & BIT(i))) {
+			zassert_is_null(pkt, "unexpected frame on port %d", i);
+			continue;
+		}
+
+		zassert_not_null(pkt, "no frame on port %d", i);
+		zassert_mem_equal(NET_ETH_HDR(pkt)->dst.addr, dst, 6, "");
+
+		eth_fake_data[i].sent_pkt = NULL;
+		net_pkt_unref(pkt);
+	}
+}
+
+static void count_fdb_entry(struct eth_bridge *br,
+			    const struct eth_bridge_fdb_entry *entry,
+			    void *user_data)
+{
+	(*(int *)user_data)++;
+}
+
+static int fdb_entries(void)
+{
+	int count = 0;
+
+	eth_bridge_fdb_foreach(&test_bridge, count_fdb_entry, &count);
+
+	return count;
+}
+
+static void test_fdb_forwarding(void)
+{
+	static const uint8_t host_a[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x0a };
+	static const uint8_t host_b[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x0b };
+	static const uint8_t host_c[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x0c };
+	static const uint8_t bcast[] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+	struct eth_bridge_stats before, after;
+	int i, ret;
+
+	for (i = 0; i < ARRAY_SIZE(fake_iface); i++) {
+		ret = eth_bridge_iface_add(&test_bridge, fake_iface[i]);
+		zassert_equal(ret, 0, "");
+		ret = eth_bridge_iface_allow_tx(fake_iface[i], true);
+		zassert_equal(ret, 0, "");
+	}
+
+	eth_bridge_get_stats(&test_bridge, &before);
+
+	/* A on port 0 talks to unknown B: flooded, A is learned */
+	recv_frame(fake_iface[0], host_a, host_b);
+	check_sent(BIT(1) | BIT(2), host_b);
+	zassert_equal(fdb_entries(), 1, "");
+
+	/* B on port 1 answers: only sent to port 0 */
+	recv_frame(fake_iface[1], host_b, host_a);
+	check_sent(BIT(0), host_a);
+	zassert_equal(fdb_entries(), 2, "");
+
+	/* Now both are known */
+	recv_frame(fake_iface[0], host_a, host_b);
+	check_sent(BIT(1), host_b);
+
+	/* C behind port 0 talks to A on the same segment: not forwarded */
+	recv_frame(fake_iface[0], host_c, host_a);
+	check_sent(0, host_a);
+
+	/* Broadcasts always go everywhere */
+	recv_frame(fake_iface[2], host_c, bcast);
+	check_sent(BIT(0) | BIT(1), bcast);
+
+	/* C moved to port 2, so port 0 is a valid destination for A again */
+	recv_frame(fake_iface[2], host_c, host_a);
+	check_sent(BIT(0), host_a);
+
+	eth_bridge_get_stats(&test_bridge, &after);
+	zassert_equal(after.rx_pkts - before.rx_pkts, 6, "");
+	zassert_equal(after.unicast - before.unicast, 3, "");
+	zassert_equal(after.flooded - before.flooded, 2, "");
+	zassert_equal(after.filtered - before.filtered, 1, "");
+	zassert_equal(after.learned - before.learned, 4, "");
+	/* A flood to two ports needs a single clone, unicast none */
+	zassert_equal(after.clones - before.clones, 2, "");
+
+	/* Learned addresses expire */
+	k_sleep(K_SECONDS(CONFIG_NET_ETHERNET_BRIDGE_FDB_AGING_TIME));
+	zassert_equal(fdb_entries(), 0, "");
+
+	recv_frame(fake_iface[1], host_b, host_a);
+	check_sent(BIT(0) | BIT(2), host_a);
+
+	/* And can be flushed */
+	recv_frame(fake_iface[0], host_a, host_b);
+	check_sent(BIT(1), host_b);
+
+	eth_bridge_fdb_flush(&test_bridge);
+	zassert_equal(fdb_entries(), 0, "");
+
+	recv_frame(fake_iface[0], host_a, host_b);
+	check_sent(BIT(1) | BIT(2), host_b);
+
+	for (i = 0; i < ARRAY_SIZE(fake_iface); i++) {
+		ret = eth_bridge_iface_remove(&test_bridge, fake_iface[i]);
+		zassert_equal(ret, 0, "");
+	}
+
+	/* Removing the interfaces forgets what was learned on them */
+	zassert_equal(fdb_entries(), 0, "");
+
+	check_free_packet_count();
+}
+#endif /* CONFIG_NET_ETHERNET_BRIDGE_FDB */
+
+ZTEST(net_eth_bridge, test_net_eth_bridge_fdb)
+{
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	test_iface_setup();
+	test_fdb_forwarding();
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST(net_eth_bridge, test_net_eth_bridge)
 {
 	test_iface_setup();
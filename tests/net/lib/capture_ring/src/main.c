@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Send UDP datagrams over the loopback interface while the capture ring is
+ * recording, and check the pcapng blocks produced by the export.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/capture.h>
+#include <zephyr/net/ethernet.h>
+
+#define PORT 4242
+#define RING_COUNT CONFIG_NET_CAPTURE_RING_PKT_COUNT
+#define SNAPLEN CONFIG_NET_CAPTURE_RING_SNAPLEN
+
+#define PCAPNG_SHB 0x0A0D0D0A
+#define PCAPNG_IDB 0x00000001
+#define PCAPNG_EPB 0x00000006
+#define LINKTYPE_RAW 101
+
+/* IPv4 and UDP headers */
+#define HEADERS_LEN 28
+
+static int recv_sock;
+static int send_sock;
+static struct sockaddr_in addr = {
+	.sin_family = AF_INET,
+	.sin_port = htons(PORT),
+};
+
+static uint8_t export_buf[4096];
+static size_t export_len;
+
+struct epb_info {
+	uint32_t if_id;
+	uint64_t timestamp;
+	uint32_t cap_len;
+	uint32_t orig_len;
+	uint32_t flags;
+	const uint8_t *data;
+};
+
+static int export_cb(const void *data, size_t len, void *user_data)
+{
+	if (export_len + len > sizeof(export_buf)) {
+		return -ENOMEM;
+	}
+
+	memcpy(export_buf + export_len, data, len);
+	export_len += len;
+
+	return 0;
+}
+
+static uint32_t get_u32(size_t offset)
+{
+	uint32_t val;
+
+	memcpy(&val, export_buf + offset, sizeof(val));
+
+	return val;
+}
+
+static uint16_t get_u16(size_t offset)
+{
+	uint16_t val;
+
+	memcpy(&val, export_buf + offset, sizeof(val));
+
+	return val;
+}
+
+/* Export the ring and check the block structure, returns the packets */
+static int export(struct epb_info *epbs, int max)
+{
+	size_t offset = 0;
+	int idbs = 0;
+	int count = 0;
+	int ret;
+
+	export_len = 0;
+
+	ret = net_capture_ring_export(export_cb, NULL);
+	zassert_true(ret >= 0, "Export failed (%d)", ret);
+
+	while (offset < export_len) {
+		uint32_t type = get_u32(offset);
+		uint32_t len = get_u32(offset + 4);
+
+		zassert_true(len >= 12 && len % 4 == 0, "Invalid block length %u", len);
+		zassert_true(offset + len <= export_len, "Truncated block");
+		zassert_equal(get_u32(offset + len - 4), len, "Trailing length mismatch");
+
+		if (offset == 0) {
+			zassert_equal(type, PCAPNG_SHB, "No section header");
+			zassert_equal(get_u32(offset + 8), 0x1A2B3C4D, "Wrong byte order magic");
+		} else if (type == PCAPNG_IDB) {
+			zassert_equal(count, 0, "Interface after packets");
+			zassert_equal(get_u16(offset + 8), LINKTYPE_RAW, "Wrong link type");
+			idbs++;
+		} else if (type == PCAPNG_EPB) {
+			struct epb_info *epb;
+
+			zassert_true(count < max, "Too many packets");
+			epb = &epbs[count];
+
+			epb->if_id = get_u32(offset + 8);
+			epb->timestamp = (uint64_t)get_u32(offset + 12) << 32 |
+					 get_u32(offset + 16);
+			epb->cap_len = get_u32(offset + 20);
+			epb->orig_len = get_u32(offset + 24);
+			epb->data = export_buf + offset + 28;
+			/* epb_flags is the only option */
+			epb->flags = get_u32(offset + 28 + ROUND_UP(epb->cap_len, 4) + 4);
+
+			zassert_true(epb->if_id < idbs, "Unknown interface %u", epb->if_id);
+			count++;
+		} else {
+			zassert_unreachable("Unexpected block type %u", type);
+		}
+
+		offset += len;
+	}
+
+	zassert_equal(ret, count, "Wrong packet count");
+
+	return count;
+}
+
+static void send_datagram(size_t len, uint8_t tag)
+{
+	uint8_t buf[128];
+	int ret;
+
+	memset(buf, tag, sizeof(buf));
+
+	ret = zsock_sendto(send_sock, buf, len, 0, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(ret, len, "sendto failed (%d)", errno);
+
+	ret = zsock_recv(recv_sock, buf, sizeof(buf), 0);
+	zassert_equal(ret, len, "recv failed (%d)", errno);
+}
+
+static void before(void *data)
+{
+	(void)net_capture_ring_stop();
+	zassert_equal(net_capture_ring_clear(), 0);
+}
+
+ZTEST(net_capture_ring, test_capture)
+{
+	struct net_capture_ring_stats stats;
+	struct epb_info epbs[RING_COUNT];
+	int ret;
+
+	ret = net_capture_ring_start(NULL);
+	zassert_equal(ret, 0, "Cannot start capture (%d)", ret);
+	zassert_true(net_capture_ring_is_enabled());
+
+	zassert_equal(net_capture_ring_clear(), -EBUSY, "Cleared while running");
+
+	send_datagram(8, 0xaa);
+	send_datagram(100, 0xbb);
+
+	(void)net_capture_ring_stop();
+
+	/* Not recorded once stopped */
+	send_datagram(8, 0xcc);
+
+	net_capture_ring_get_stats(&stats);
+	zassert_equal(stats.captured, 4);
+	zassert_equal(stats.stored, 4);
+	zassert_equal(stats.dropped, 0);
+
+	zassert_equal(export(epbs, ARRAY_SIZE(epbs)), 4);
+
+	/* Every datagram is sent and then received */
+	zassert_equal(epbs[0].flags, 2, "Not outbound");
+	zassert_equal(epbs[1].flags, 1, "Not inbound");
+	zassert_equal(epbs[0].cap_len, HEADERS_LEN + 8);
+	zassert_equal(epbs[0].orig_len, HEADERS_LEN + 8);
+	zassert_equal(epbs[0].data[0] >> 4, 4, "Not an IPv4 packet");
+	zassert_equal(epbs[0].data[HEADERS_LEN], 0xaa);
+
+	/* Long packets are truncated to the snaplen */
+	zassert_equal(epbs[2].cap_len, SNAPLEN);
+	zassert_equal(epbs[2].orig_len, HEADERS_LEN + 100);
+	zassert_equal(epbs[2].data[HEADERS_LEN], 0xbb);
+
+	for (int i = 1; i < 4; i++) {
+		zassert_true(epbs[i].timestamp >= epbs[i - 1].timestamp, "Out of order");
+	}
+}
+
+ZTEST(net_capture_ring, test_overwrite)
+{
+	struct net_capture_ring_stats stats;
+	struct epb_info epbs[RING_COUNT];
+	struct net_capture_ring_filter filter = {
+		.direction = NET_CAPTURE_RING_RX,
+	};
+	int ret;
+
+	ret = net_capture_ring_start(&filter);
+	zassert_equal(ret, 0, "Cannot start capture (%d)", ret);
+
+	for (int i = 0; i < RING_COUNT + 3; i++) {
+		send_datagram(8, i);
+	}
+
+	net_capture_ring_get_stats(&stats);
+	zassert_equal(stats.captured, RING_COUNT + 3);
+	zassert_equal(stats.stored, RING_COUNT);
+
+	/* The export can run while the capture does */
+	zassert_equal(export(epbs, ARRAY_SIZE(epbs)), RING_COUNT);
+
+	/* The oldest packets were replaced, the others come in order */
+	for (int i = 0; i < RING_COUNT; i++) {
+		zassert_equal(epbs[i].flags, 1, "Not inbound");
+		zassert_equal(epbs[i].data[HEADERS_LEN], i + 3, "Wrong packet order");
+	}
+}
+
+ZTEST(net_capture_ring, test_filter)
+{
+	struct epb_info epbs[RING_COUNT];
+	struct net_capture_ring_filter filter = {
+		.ptype = NET_ETH_PTYPE_IPV6,
+	};
+	int ret;
+
+	filter.snaplen = SNAPLEN + 1;
+	ret = net_capture_ring_start(&filter);
+	zassert_equal(ret, -EINVAL, "Snaplen above the maximum accepted");
+
+	filter.snaplen = HEADERS_LEN;
+	ret = net_capture_ring_start(&filter);
+	zassert_equal(ret, 0, "Cannot start capture (%d)", ret);
+
+	send_datagram(8, 0);
+	zassert_equal(export(epbs, ARRAY_SIZE(epbs)), 0, "IPv4 packet captured");
+
+	filter.ptype = NET_ETH_PTYPE_IP;
+	filter.direction = NET_CAPTURE_RING_TX;
+	ret = net_capture_ring_start(&filter);
+	zassert_equal(ret, 0, "Cannot start capture (%d)", ret);
+
+	send_datagram(8, 0);
+	zassert_equal(export(epbs, ARRAY_SIZE(epbs)), 1);
+	zassert_equal(epbs[0].flags, 2, "Not outbound");
+	zassert_equal(epbs[0].cap_len, HEADERS_LEN);
+	zassert_equal(epbs[0].orig_len, HEADERS_LEN + 8);
+
+	/* Packets from other interfaces are not captured */
+	filter.iface = net_if_get_by_index(net_if_get_by_iface(net_if_get_default()) + 1);
+	if (filter.iface != NULL) {
+		ret = net_capture_ring_start(&filter);
+		zassert_equal(ret, 0, "Cannot start capture (%d)", ret);
+
+		send_datagram(8, 0);
+		zassert_equal(export(epbs, ARRAY_SIZE(epbs)), 1);
+	}
+}
+
+#if defined(CONFIG_NET_CAPTURE_RING_HOST_FILE)
+ZTEST(net_capture_ring, test_save)
+{
+	int ret;
+
+	ret = net_capture_ring_start(NULL);
+	zassert_equal(ret, 0, "Cannot start capture (%d)", ret);
+
+	send_datagram(8, 0);
+
+	ret = net_capture_ring_save("capture_ring_test.pcapng");
+	zassert_equal(ret, 2, "Cannot save capture (%d)", ret);
+}
+#endif
+
+static void *setup(void)
+{
+	struct sockaddr_in bind_addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(PORT),
+	};
+	int ret;
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	recv_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(recv_sock >= 0, "socket open failed");
+
+	ret = zsock_bind(recv_sock, (struct sockaddr *)&bind_addr, sizeof(bind_addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	send_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(send_sock >= 0, "socket open failed");
+
+	return NULL;
+}
+
+static void teardown(void *data)
+{
+	(void)net_capture_ring_stop();
+
+	zsock_close(send_sock);
+	zsock_close(recv_sock);
+}
+
+ZTEST_SUITE(net_capture_ring, NULL, setup, before, NULL, teardown);
@@ -133,3 +133,116 @@ ZTEST(net_dns_cache_test, test_expired_entries_removed)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 3));
 	zassert_equal(AF_INET, info_read[0].ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_least_recently_used_removed)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	char query[sizeof("example00.com")];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example%02u.com", (unsigned int)i);
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	/* The oldest entry was used recently so the second one is replaced */
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example00.com", &info_read, 1));
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example00.com", &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example01.com", &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example.com", &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_lookup_family)
+{
+	struct dns_addrinfo info_ipv4 = {.ai_family = AF_INET};
+	struct dns_addrinfo info_ipv6 = {.ai_family = AF_INET6};
+	struct dns_addrinfo info_read[2] = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_ipv4, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_ipv6, TEST_DNS_CACHE_DEFAULT_TTL));
+
+	zassert_equal(2, dns_cache_lookup(&test_dns_cache, query, AF_UNSPEC, info_read, 2, NULL));
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET6, info_read, 2, NULL));
+	zassert_equal(AF_INET6, info_read[0].ai_family);
+
+	zassert_ok(dns_cache_remove_family(&test_dns_cache, query, AF_INET6));
+	zassert_equal(0, dns_cache_lookup(&test_dns_cache, query, AF_INET6, info_read, 2, NULL));
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, info_read, 2, NULL));
+}
+
+ZTEST(net_dns_cache_test, test_negative_entries)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_equal(-EINVAL, dns_cache_add_negative(&test_dns_cache, query, AF_INET,
+						      DNS_EAI_FAIL, TEST_DNS_CACHE_DEFAULT_TTL));
+
+	/* No data for IPv6 only */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, AF_INET6, DNS_EAI_NODATA,
+					  TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+	zassert_equal(AF_INET, info_read.ai_family);
+	zassert_equal(0, dns_cache_find_negative(&test_dns_cache, query, AF_INET));
+	zassert_equal(DNS_EAI_NODATA, dns_cache_find_negative(&test_dns_cache, query, AF_INET6));
+
+	/* A non-existent name applies to all families */
+	zassert_ok(dns_cache_remove(&test_dns_cache, query));
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, AF_UNSPEC, DNS_EAI_NONAME,
+					  TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+	zassert_equal(DNS_EAI_NONAME, dns_cache_find_negative(&test_dns_cache, query, AF_INET));
+	zassert_equal(DNS_EAI_NONAME, dns_cache_find_negative(&test_dns_cache, query, AF_INET6));
+
+	/* and is replaced by an answer for any family */
+	zassert_ok(dns_cache_remove_family(&test_dns_cache, query, AF_INET));
+	zassert_equal(0, dns_cache_find_negative(&test_dns_cache, query, AF_INET6));
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, AF_UNSPEC, DNS_EAI_NONAME,
+					  TEST_DNS_CACHE_DEFAULT_TTL));
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find_negative(&test_dns_cache, query, AF_INET));
+}
+
+ZTEST(net_dns_cache_test, test_refresh)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+	bool refresh;
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1,
+					  &refresh));
+	zassert_false(refresh, "Fresh entry should not be refreshed");
+
+	/* Refreshed once when the end of the TTL is near */
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 * 95 / 100));
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1,
+					  &refresh));
+	zassert_true(refresh, "Entry should be refreshed");
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1,
+					  &refresh));
+	zassert_false(refresh, "Entry refresh should be requested once");
+
+	/* Requested again when the refresh could not be done */
+	dns_cache_refresh_abort(&test_dns_cache, query);
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1,
+					  &refresh));
+	zassert_true(refresh, "Aborted refresh should be requested again");
+
+	/* The new answer starts a new TTL */
+	zassert_ok(dns_cache_remove_family(&test_dns_cache, query, AF_INET));
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1,
+					  &refresh));
+	zassert_false(refresh, "Fresh entry should not be refreshed");
+}
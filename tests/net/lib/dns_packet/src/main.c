@@ -1052,6 +1052,68 @@ static void resolve_cb(enum dns_resolve_status status,
 	ARG_UNUSED(user_data);
 }
 
+static uint8_t resp_name_error[] = {
+	/* DNS msg header (12 bytes), NXDOMAIN with one authority RR */
+	0xb0, 0x41, 0x81, 0x83, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x01, 0x00, 0x00,
+
+	/* Query string (www.zephyrproject.org) */
+	0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+	0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+	0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+
+	/* Query type */
+	0x00, 0x01,
+
+	/* Query class */
+	0x00, 0x01,
+
+	/* Authority name (zephyrproject.org) */
+	0xc0, 0x10,
+
+	/* Authority type (SOA) */
+	0x00, 0x06,
+
+	/* Authority class */
+	0x00, 0x01,
+
+	/* TTL (3600) */
+	0x00, 0x00, 0x0e, 0x10,
+
+	/* Resource data length */
+	0x00, 0x20,
+
+	/* MNAME (ns.zephyrproject.org) */
+	0x02, 0x6e, 0x73, 0xc0, 0x10,
+
+	/* RNAME (host.zephyrproject.org) */
+	0x04, 0x68, 0x6f, 0x73, 0x74, 0xc0, 0x10,
+
+	/* Serial, refresh, retry and expire */
+	0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x1c, 0x20,
+	0x00, 0x00, 0x0e, 0x10, 0x00, 0x12, 0x75, 0x00,
+
+	/* Minimum (300) */
+	0x00, 0x00, 0x01, 0x2c,
+};
+
+static uint8_t resp_no_data[] = {
+	/* DNS msg header (12 bytes), no answers and no authority RR */
+	0xb0, 0x41, 0x81, 0x80, 0x00, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00,
+
+	/* Query string (www.zephyrproject.org) */
+	0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+	0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+	0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+
+	/* Query type */
+	0x00, 0x01,
+
+	/* Query class */
+	0x00, 0x01,
+};
+
 static void setup_dns_context(struct dns_resolve_context *ctx,
 			      int idx,
 			      uint16_t dns_id,
@@ -1206,6 +1268,70 @@ ZTEST(dns_packet, test_dns_malformed_and_valid_responses)
 	test_dns_valid_responses();
 }
 
+static void run_dns_negative_response(const char *test_case,
+				      uint8_t *buf, size_t len,
+				      int expected_ret)
+{
+	static const uint8_t query[] = {
+		/* Labels */
+		0x03, 0x77, 0x77, 0x77, 0x0d, 0x7a, 0x65, 0x70,
+		0x68, 0x79, 0x72, 0x70, 0x72, 0x6f, 0x6a, 0x65,
+		0x63, 0x74, 0x03, 0x6f, 0x72, 0x67, 0x00,
+		/* Query type */
+		0x00, 0x01
+	};
+	struct dns_msg_t dns_msg = { 0 };
+	uint16_t dns_id = 0;
+	int query_idx = -1;
+	uint16_t query_hash = 0;
+	int ret;
+
+	dns_msg.msg = buf;
+	dns_msg.msg_size = len;
+
+	dns_id = dns_unpack_header_id(dns_msg.msg);
+
+	setup_dns_context(&dns_ctx, 0, dns_id, query, sizeof(query),
+			  DNS_QUERY_TYPE_A);
+
+	ret = dns_validate_msg(&dns_ctx, &dns_msg, &dns_id, &query_idx,
+			       NULL, &query_hash);
+	zassert_equal(ret, expected_ret, "[%s] DNS message failed (%d)",
+		      test_case, ret);
+	zassert_equal(query_idx, 0, "[%s] DNS query not found", test_case);
+}
+
+ZTEST(dns_packet, test_dns_negative_responses)
+{
+	run_dns_negative_response("resp_name_error", resp_name_error,
+				  sizeof(resp_name_error), DNS_EAI_NONAME);
+	run_dns_negative_response("resp_no_data", resp_no_data,
+				  sizeof(resp_no_data), DNS_EAI_NODATA);
+}
+
+ZTEST(dns_packet, test_dns_negative_ttl)
+{
+	struct dns_msg_t dns_msg = { 0 };
+	uint32_t ttl = 0;
+	int ret;
+
+	dns_msg.msg = resp_name_error;
+	dns_msg.msg_size = sizeof(resp_name_error);
+
+	ret = dns_unpack_response_query(&dns_msg);
+	zassert_equal(ret, 0, "Cannot unpack query (%d)", ret);
+
+	/* The MINIMUM field is lower than the TTL of the SOA record */
+	ret = dns_unpack_negative_ttl(&dns_msg, &ttl);
+	zassert_equal(ret, 0, "Cannot unpack negative TTL (%d)", ret);
+	zassert_equal(ttl, 300, "Invalid negative TTL %u", ttl);
+
+	/* Truncated SOA record */
+	dns_msg.msg_size = sizeof(resp_name_error) - 1;
+	ret = dns_unpack_negative_ttl(&dns_msg, &ttl);
+	zassert_equal(ret, -EINVAL, "Truncated SOA accepted (%d)", ret);
+}
+
 ZTEST(dns_packet, test_dns_id_len)
 {
 	struct dns_msg_t dns_msg = { 0 };
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Resolve names through a DNS server stand-in listening on the loopback
+ * interface, and check that the resolver cache answers repeated queries,
+ * caches negative answers and refreshes entries before they expire.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/dns_resolve.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+#include <zephyr/sys/byteorder.h>
+
+#define SERVER_PORT 53
+#define QUERY_TIMEOUT_MS 1000
+
+/* TTL of the addresses and of the negative answers sent by the stand-in */
+#define ANSWER_TTL 2
+#define NEGATIVE_TTL 1
+
+#define DNS_HEADER_LEN 12
+#define DNS_TYPE_A 1
+#define DNS_TYPE_SOA 6
+#define DNS_RCODE_NAMEERROR 3
+#define DNS_FLAG_TC 0x02
+
+static K_THREAD_STACK_DEFINE(server_stack, 2048);
+static struct k_thread server_thread;
+static int server_sock;
+static atomic_t server_queries;
+
+static struct dns_resolve_context ctx;
+
+struct resolve_result {
+	struct k_sem done;
+	int status;
+	int count;
+	struct in_addr addr;
+};
+
+static size_t put_rr_header(uint8_t *buf, uint16_t type, uint32_t ttl, uint16_t rdlength)
+{
+	/* The name is a pointer to the question */
+	buf[0] = 0xc0;
+	buf[1] = DNS_HEADER_LEN;
+	sys_put_be16(type, buf + 2);
+	sys_put_be16(1, buf + 4);
+	sys_put_be32(ttl, buf + 6);
+	sys_put_be16(rdlength, buf + 10);
+
+	return 12;
+}
+
+/* Names starting with "nx" do not exist, answers for names starting with "tc"
+ * are truncated, others only have an IPv4 address.
+ */
+static size_t server_answer(uint8_t *buf, size_t len)
+{
+	static const uint8_t soa_rdata[] = {
+		/* MNAME and RNAME point to the question */
+		0xc0, DNS_HEADER_LEN, 0xc0, DNS_HEADER_LEN,
+		/* Serial, refresh, retry and expire */
+		0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x1c, 0x20,
+		0x00, 0x00, 0x0e, 0x10, 0x00, 0x12, 0x75, 0x00,
+		/* Minimum */
+		0x00, 0x00, 0x00, NEGATIVE_TTL,
+	};
+	const uint8_t *name = buf + DNS_HEADER_LEN;
+	const uint8_t *end;
+	uint16_t type;
+	size_t pos;
+
+	end = memchr(name, 0, len - DNS_HEADER_LEN);
+	if (end == NULL || end + 5 > buf + len) {
+		return 0;
+	}
+
+	type = sys_get_be16(end + 1);
+	pos = end + 5 - buf;
+
+	/* QR, RD and RA, no other sections */
+	buf[2] = 0x81;
+	buf[3] = 0x80;
+	memset(buf + 6, 0, 6);
+
+	if (name[0] >= 2 && memcmp(name + 1, "tc", 2) == 0) {
+		/* The answers did not fit, only the question is left */
+		buf[2] |= DNS_FLAG_TC;
+
+		return pos;
+	}
+
+	if (name[0] >= 2 && memcmp(name + 1, "nx", 2) == 0) {
+		buf[3] |= DNS_RCODE_NAMEERROR;
+	} else if (type == DNS_TYPE_A) {
+		sys_put_be16(1, buf + 6);
+		pos += put_rr_header(buf + pos, DNS_TYPE_A, ANSWER_TTL, 4);
+		buf[pos++] = 192;
+		buf[pos++] = 0;
+		buf[pos++] = 2;
+		buf[pos++] = 1;
+
+		return pos;
+	}
+
+	/* Negative answers carry the SOA record of the zone */
+	sys_put_be16(1, buf + 8);
+	pos += put_rr_header(buf + pos, DNS_TYPE_SOA, 3600, sizeof(soa_rdata));
+	memcpy(buf + pos, soa_rdata, sizeof(soa_rdata));
+
+	return pos + sizeof(soa_rdata);
+}
+
+static void server_handler(void *p1, void *p2, void *p3)
+{
+	struct sockaddr_in peer;
+	socklen_t peer_len;
+	uint8_t buf[512];
+	size_t len;
+	int ret;
+
+	while (true) {
+		peer_len = sizeof(peer);
+
+		ret = zsock_recvfrom(server_sock, buf, sizeof(buf) - 64, 0,
+				     (struct sockaddr *)&peer, &peer_len);
+		if (ret < 0) {
+			break;
+		}
+
+		if (ret <= DNS_HEADER_LEN) {
+			continue;
+		}
+
+		atomic_inc(&server_queries);
+
+		len = server_answer(buf, ret);
+		if (len == 0) {
+			continue;
+		}
+
+		(void)zsock_sendto(server_sock, buf, len, 0, (struct sockaddr *)&peer, peer_len);
+	}
+}
+
+static void resolve_cb(enum dns_resolve_status status, struct dns_addrinfo *info,
+		       void *user_data)
+{
+	struct resolve_result *result = user_data;
+
+	if (status == DNS_EAI_INPROGRESS) {
+		result->addr = net_sin(&info->ai_addr)->sin_addr;
+		result->count++;
+		return;
+	}
+
+	result->status = status;
+	k_sem_give(&result->done);
+}
+
+static int resolve(const char *name, enum dns_query_type type, struct resolve_result *result)
+{
+	int ret;
+
+	memset(result, 0, sizeof(*result));
+	k_sem_init(&result->done, 0, 1);
+
+	ret = dns_resolve_name(&ctx, name, type, NULL, resolve_cb, result, QUERY_TIMEOUT_MS);
+	zassert_equal(ret, 0, "Cannot resolve %s (%d)", name, ret);
+
+	ret = k_sem_take(&result->done, K_MSEC(2 * QUERY_TIMEOUT_MS));
+	zassert_equal(ret, 0, "Query for %s did not finish", name);
+
+	return result->status;
+}
+
+static struct net_stats_dns get_stats(void)
+{
+	struct net_stats_dns stats;
+	int ret;
+
+	ret = net_mgmt(NET_REQUEST_STATS_GET_DNS, NULL, &stats, sizeof(stats));
+	zassert_equal(ret, 0, "Cannot get DNS statistics (%d)", ret);
+
+	return stats;
+}
+
+ZTEST(dns_resolve_cache, test_cached_answer)
+{
+	struct net_stats_dns before = get_stats();
+	struct net_stats_dns after;
+	struct resolve_result result;
+	atomic_val_t queries = atomic_get(&server_queries);
+
+	zassert_equal(resolve("host.example.org", DNS_QUERY_TYPE_A, &result), DNS_EAI_ALLDONE);
+	zassert_equal(result.count, 1);
+	zassert_equal(result.addr.s4_addr[0], 192);
+	zassert_equal(atomic_get(&server_queries), queries + 1);
+
+	zassert_equal(resolve("host.example.org", DNS_QUERY_TYPE_A, &result), DNS_EAI_ALLDONE);
+	zassert_equal(result.count, 1);
+	zassert_equal(atomic_get(&server_queries), queries + 1, "Cached name queried again");
+
+	after = get_stats();
+	zassert_equal(after.cache_miss - before.cache_miss, 1);
+	zassert_equal(after.cache_hit - before.cache_hit, 1);
+}
+
+ZTEST(dns_resolve_cache, test_name_error)
+{
+	struct net_stats_dns before = get_stats();
+	struct net_stats_dns after;
+	struct resolve_result result;
+	atomic_val_t queries = atomic_get(&server_queries);
+
+	zassert_equal(resolve("nx.example.org", DNS_QUERY_TYPE_A, &result), DNS_EAI_NONAME);
+	zassert_equal(result.count, 0);
+	zassert_equal(atomic_get(&server_queries), queries + 1);
+
+	/* The name does not exist for any record type */
+	zassert_equal(resolve("nx.example.org", DNS_QUERY_TYPE_A, &result), DNS_EAI_NONAME);
+	zassert_equal(resolve("nx.example.org", DNS_QUERY_TYPE_AAAA, &result), DNS_EAI_NONAME);
+	zassert_equal(atomic_get(&server_queries), queries + 1, "Negative answer not cached");
+
+	after = get_stats();
+	zassert_equal(after.cache_negative_hit - before.cache_negative_hit, 2);
+
+	/* until the negative TTL expires */
+	k_sleep(K_MSEC(NEGATIVE_TTL * MSEC_PER_SEC + 10));
+
+	zassert_equal(resolve("nx.example.org", DNS_QUERY_TYPE_A, &result), DNS_EAI_NONAME);
+	zassert_equal(atomic_get(&server_queries), queries + 2);
+}
+
+ZTEST(dns_resolve_cache, test_no_data)
+{
+	struct resolve_result result;
+	atomic_val_t queries = atomic_get(&server_queries);
+
+	zassert_equal(resolve("ipv4.example.org", DNS_QUERY_TYPE_AAAA, &result), DNS_EAI_NODATA);
+	zassert_equal(resolve("ipv4.example.org", DNS_QUERY_TYPE_AAAA, &result), DNS_EAI_NODATA);
+	zassert_equal(atomic_get(&server_queries), queries + 1, "Negative answer not cached");
+
+	/* An empty answer only applies to the type that was asked */
+	zassert_equal(resolve("ipv4.example.org", DNS_QUERY_TYPE_A, &result), DNS_EAI_ALLDONE);
+	zassert_equal(result.count, 1);
+	zassert_equal(atomic_get(&server_queries), queries + 2);
+}
+
+ZTEST(dns_resolve_cache, test_truncated)
+{
+	struct resolve_result result;
+	atomic_val_t queries = atomic_get(&server_queries);
+
+	/* A truncated response without answers is not a negative answer */
+	zassert_not_equal(resolve("tc.example.org", DNS_QUERY_TYPE_A, &result), DNS_EAI_NODATA);
+	zassert_equal(result.count, 0);
+	zassert_not_equal(resolve("tc.example.org", DNS_QUERY_TYPE_A, &result), DNS_EAI_NODATA);
+	zassert_equal(atomic_get(&server_queries), queries + 2, "Truncated answer cached");
+}
+
+ZTEST(dns_resolve_cache, test_prefetch)
+{
+	struct net_stats_dns before = get_stats();
+	struct net_stats_dns after;
+	struct resolve_result result;
+	atomic_val_t queries = atomic_get(&server_queries);
+
+	zassert_equal(resolve("prefetch.example.org", DNS_QUERY_TYPE_A, &result),
+		      DNS_EAI_ALLDONE);
+	zassert_equal(atomic_get(&server_queries), queries + 1);
+
+	/* Near the end of the TTL the cached answer is returned and the
+	 * name is queried again in the background.
+	 */
+	k_sleep(K_MSEC(ANSWER_TTL * MSEC_PER_SEC * 95 / 100));
+
+	zassert_equal(resolve("prefetch.example.org", DNS_QUERY_TYPE_A, &result),
+		      DNS_EAI_ALLDONE);
+	zassert_equal(result.count, 1);
+
+	k_sleep(K_MSEC(100));
+	zassert_equal(atomic_get(&server_queries), queries + 2, "Entry not refreshed");
+
+	/* The refreshed entry outlives the original TTL */
+	k_sleep(K_MSEC(ANSWER_TTL * MSEC_PER_SEC / 2));
+
+	zassert_equal(resolve("prefetch.example.org", DNS_QUERY_TYPE_A, &result),
+		      DNS_EAI_ALLDONE);
+	zassert_equal(result.count, 1, "Refreshed answers not replaced");
+	zassert_equal(atomic_get(&server_queries), queries + 2);
+
+	after = get_stats();
+	zassert_equal(after.cache_prefetch - before.cache_prefetch, 1);
+	zassert_equal(after.cache_miss - before.cache_miss, 1);
+}
+
+static void *setup(void)
+{
+	const char *servers[] = { "127.0.0.1:53", NULL };
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int ret;
+
+	server_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(server_sock >= 0, "socket open failed");
+
+	ret = zsock_bind(server_sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	k_thread_create(&server_thread, server_stack,
+			K_THREAD_STACK_SIZEOF(server_stack), server_handler,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+
+	ret = dns_resolve_init(&ctx, servers, NULL);
+	zassert_equal(ret, 0, "Cannot initialize resolver (%d)", ret);
+
+	return NULL;
+}
+
+static void teardown(void *data)
+{
+	dns_resolve_close(&ctx);
+	zsock_close(server_sock);
+	k_thread_join(&server_thread, K_SECONDS(1));
+}
+
+ZTEST_SUITE(dns_resolve_cache, NULL, setup, NULL, NULL, teardown);
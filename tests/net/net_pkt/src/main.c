@@ -1273,4 +1273,121 @@ ZTEST(net_pkt_test_suite, test_net_pkt_shallow_clone_append_buf_2)
 	test_net_pkt_shallow_clone_append_buf(2);
 }
 
+static struct net_pkt *pullup_pkt_alloc(int frags, size_t frag_len,
+					size_t reserve)
+{
+	struct net_buf_pool *tx_data;
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	uint8_t value = 0U;
+
+	pkt = net_pkt_alloc(K_NO_WAIT);
+	zassert_true(pkt != NULL, "Pkt not allocated");
+
+	net_pkt_get_info(NULL, NULL, NULL, &tx_data);
+
+	for (int i = 0; i < frags; i++) {
+		frag = net_buf_alloc_len(tx_data, CONFIG_NET_BUF_DATA_SIZE,
+					 K_NO_WAIT);
+		zassert_true(frag != NULL, "Frag not allocated");
+
+		if (i == 0) {
+			net_buf_reserve(frag, reserve);
+		}
+
+		for (size_t j = 0; j < frag_len; j++) {
+			net_buf_add_u8(frag, value++);
+		}
+
+		net_pkt_append_buffer(pkt, frag);
+	}
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static void pullup_check_data(struct net_pkt *pkt, size_t len)
+{
+	uint8_t data[64];
+
+	zassert_true(len <= sizeof(data));
+	zassert_equal(net_pkt_get_len(pkt), len, "Wrong length");
+
+	net_pkt_cursor_init(pkt);
+	zassert_equal(net_pkt_read(pkt, data, len), 0, "Read failed");
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_equal(data[i], i, "Wrong data at %zu", i);
+	}
+
+	net_pkt_cursor_init(pkt);
+}
+
+ZTEST(net_pkt_test_suite, test_net_pkt_pullup)
+{
+	struct net_pkt *pkt, *shallow_pkt;
+	uint8_t *hdr;
+
+	pkt = pullup_pkt_alloc(4, 10, 0);
+
+	zassert_not_null(net_pkt_header_ptr(pkt, 10));
+	zassert_is_null(net_pkt_header_ptr(pkt, 11), "Header not in one buffer");
+
+	/* Already contiguous */
+	zassert_equal(net_pkt_pullup(pkt, 8), 0);
+	zassert_equal(pkt->buffer->len, 10);
+
+	zassert_equal(net_pkt_pullup(pkt, 25), 0);
+	zassert_equal(pkt->buffer->len, 25, "Not pulled up");
+	zassert_equal(net_buf_frags_len(pkt->buffer->frags), 15);
+	zassert_equal(pkt->buffer->frags->len, 5, "Emptied frag not removed");
+	pullup_check_data(pkt, 40);
+
+	hdr = net_pkt_header_ptr(pkt, 25);
+	zassert_equal_ptr(hdr, pkt->buffer->data);
+
+	zassert_equal(net_pkt_skip(pkt, 20), 0);
+	hdr = net_pkt_header_ptr(pkt, 5);
+	zassert_not_null(hdr);
+	zassert_equal(hdr[0], 20, "Not at the cursor");
+
+	/* Shorter packets are pulled up completely */
+	zassert_equal(net_pkt_pullup(pkt, 64), 0);
+	zassert_equal(pkt->buffer->len, 40);
+	zassert_is_null(pkt->buffer->frags, "Frags left");
+	pullup_check_data(pkt, 40);
+
+	net_pkt_unref(pkt);
+
+	/* Not enough room in the first buffer */
+	pkt = pullup_pkt_alloc(2, 8, CONFIG_NET_BUF_DATA_SIZE - 10);
+
+	zassert_equal(net_pkt_pullup(pkt, 12), -ENOBUFS);
+	zassert_equal(pkt->buffer->len, 8, "Packet modified");
+	pullup_check_data(pkt, 16);
+
+	zassert_equal(net_pkt_pullup(pkt, 10), 0);
+	pullup_check_data(pkt, 16);
+
+	net_pkt_unref(pkt);
+
+	/* Buffers shared with another packet are left alone */
+	pkt = pullup_pkt_alloc(2, 8, 0);
+
+	shallow_pkt = net_pkt_shallow_clone(pkt, K_NO_WAIT);
+	zassert_true(shallow_pkt != NULL, "Pkt not allocated");
+
+	zassert_equal(net_pkt_pullup(pkt, 16), -EBUSY);
+	pullup_check_data(shallow_pkt, 16);
+
+	net_pkt_unref(shallow_pkt);
+
+	zassert_equal(net_pkt_pullup(pkt, 16), 0);
+	pullup_check_data(pkt, 16);
+
+	net_pkt_unref(pkt);
+}
+
 ZTEST_SUITE(net_pkt_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -544,6 +544,42 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct net_route_entry *prefix_entry, *host_entry, *entry;
+
+	prefix_entry = net_route_add(my_iface,
+				     &dest_addr, 32,
+				     &peer_addr,
+				     NET_IPV6_ND_INFINITE_LIFETIME,
+				     NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(prefix_entry, "Prefix route add failed");
+
+	host_entry = net_route_add(my_iface,
+				   &dest_addr, 128,
+				   &peer_addr_alt,
+				   NET_IPV6_ND_INFINITE_LIFETIME,
+				   NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(host_entry, "Host route add failed");
+	zassert_not_equal(prefix_entry, host_entry,
+			  "Host route replaced the prefix route");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, host_entry, "Longest prefix not selected");
+
+	entry = net_route_lookup(NULL, &generic_addr);
+	zassert_equal_ptr(entry, prefix_entry, "Prefix route not selected");
+
+	zassert_false(net_route_del(host_entry), "Host route del failed");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, prefix_entry, "Prefix route not selected");
+
+	zassert_false(net_route_del(prefix_entry), "Prefix route del failed");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_is_null(entry, "Route found after deletion");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +602,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/ztest_assert.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_epoll.h>
+#include <zephyr/sys/fdtable.h>
+
+#include "../../socket_helpers.h"
+
+#define BUF_AND_SIZE(buf) buf, sizeof(buf) - 1
+#define STRLEN(buf) (sizeof(buf) - 1)
+
+#define TEST_STR_SMALL "test"
+
+#define MY_IPV6_ADDR "::1"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+
+/* On QEMU, a wait takes +10ms from the requested time. */
+#define FUZZ 10
+
+#define TCP_TEARDOWN_TIMEOUT K_SECONDS(3)
+
+static int c_sock;
+static int s_sock;
+static int epfd;
+
+static void prepare_udp_pair(void)
+{
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	int res;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = zsock_connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	epfd = zsock_epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+}
+
+static void epoll_add(int fd, uint32_t events)
+{
+	struct zsock_epoll_event ev = {
+		.events = events,
+		.data.fd = fd,
+	};
+	int res;
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, fd, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed (%d)", errno);
+}
+
+static void send_small(void)
+{
+	ssize_t len;
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+}
+
+static void recv_small(void)
+{
+	char buf[10];
+	ssize_t len;
+
+	len = zsock_recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+}
+
+static void close_all(void)
+{
+	zassert_equal(zsock_close(epfd), 0, "close failed");
+	zassert_equal(zsock_close(c_sock), 0, "close failed");
+	zassert_equal(zsock_close(s_sock), 0, "close failed");
+}
+
+ZTEST(net_socket_epoll, test_epoll_level_triggered)
+{
+	struct zsock_epoll_event events[2];
+	uint32_t tstamp;
+	int res;
+
+	prepare_udp_pair();
+	epoll_add(c_sock, ZSOCK_EPOLLIN);
+	epoll_add(s_sock, ZSOCK_EPOLLIN);
+
+	/* Nothing ready, timeout of 0 */
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 0, "");
+
+	/* Nothing ready, timeout of 30 */
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "tstamp %d",
+		     tstamp);
+	zassert_equal(res, 0, "");
+
+	send_small();
+
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_true(k_uptime_get_32() - tstamp <= FUZZ, "");
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	/* Level-triggered, so reported again while data is pending */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	recv_small();
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	close_all();
+}
+
+ZTEST(net_socket_epoll, test_epoll_edge_triggered)
+{
+	struct zsock_epoll_event events[2];
+	int res;
+
+	prepare_udp_pair();
+	epoll_add(s_sock, ZSOCK_EPOLLIN | ZSOCK_EPOLLET);
+
+	send_small();
+	send_small();
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	/* No new data arrived, so no new edge */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	recv_small();
+
+	/* A new packet is a new edge even if older data is still queued */
+	send_small();
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	recv_small();
+	recv_small();
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	close_all();
+}
+
+ZTEST(net_socket_epoll, test_epoll_oneshot)
+{
+	struct zsock_epoll_event events[2];
+	struct zsock_epoll_event ev = {
+		.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLONESHOT,
+	};
+	int res;
+
+	prepare_udp_pair();
+	epoll_add(s_sock, ev.events);
+
+	send_small();
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 1, "");
+
+	/* Disabled until re-armed, even though data is pending */
+	send_small();
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+
+	recv_small();
+	recv_small();
+
+	close_all();
+}
+
+ZTEST(net_socket_epoll, test_epoll_ctl)
+{
+	struct zsock_epoll_event events[2];
+	struct zsock_epoll_event ev = {
+		.events = ZSOCK_EPOLLIN,
+	};
+	int res;
+
+	prepare_udp_pair();
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	/* Only sockets can be registered */
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, epfd, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EPERM, "");
+
+	res = zsock_epoll_ctl(s_sock, ZSOCK_EPOLL_CTL_ADD, c_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_ADD, c_sock, &ev);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_wait(epfd, events, 0, 0);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EINVAL, "");
+
+	send_small();
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	/* The removed socket is not reported anymore */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 30);
+	zassert_equal(res, 0, "");
+
+	recv_small();
+
+	/* Closing a socket removes its registration */
+	res = zsock_close(c_sock);
+	zassert_equal(res, 0, "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	zassert_equal(zsock_close(epfd), 0, "close failed");
+	zassert_equal(zsock_close(s_sock), 0, "close failed");
+}
+
+static void send_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	send_small();
+}
+
+static K_WORK_DELAYABLE_DEFINE(send_work, send_work_handler);
+
+ZTEST(net_socket_epoll, test_epoll_wakeup)
+{
+	struct zsock_epoll_event events[2];
+	int res;
+
+	prepare_udp_pair();
+	epoll_add(s_sock, ZSOCK_EPOLLIN);
+
+	k_work_schedule(&send_work, K_MSEC(20));
+
+	/* The socket wakes up the waiting thread */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), -1);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	recv_small();
+
+	close_all();
+}
+
+#define TEST_SNDBUF_SIZE CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE
+
+ZTEST(net_socket_epoll, test_epoll_tcp)
+{
+	struct zsock_epoll_event events[2];
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	char buf[TEST_SNDBUF_SIZE] = { };
+	int new_sock;
+	int res;
+
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_tcp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	epfd = zsock_epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	res = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "");
+	res = zsock_listen(s_sock, 0);
+	zassert_equal(res, 0, "");
+
+	epoll_add(s_sock, ZSOCK_EPOLLIN);
+
+	res = zsock_connect(c_sock, (const struct sockaddr *)&s_addr,
+			    sizeof(s_addr));
+	zassert_equal(res, 0, "");
+
+	/* Pending connection on the listening socket */
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	new_sock = zsock_accept(s_sock, NULL, NULL);
+	zassert_true(new_sock >= 0, "");
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	k_msleep(10);
+
+	/* EPOLLOUT is reported after connecting */
+	epoll_add(c_sock, ZSOCK_EPOLLOUT);
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 10);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLOUT, "");
+
+	/* EPOLLOUT is not reported after filling the window */
+	res = zsock_send(c_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, sizeof(buf), "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 10);
+	zassert_equal(res, 0, "%x", events[0].events);
+
+	/* EPOLLOUT is reported again after the server consumed the data */
+	res = zsock_recv(new_sock, buf, sizeof(buf), 0);
+	zassert_equal(res, sizeof(buf), "");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 500);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLOUT, "");
+
+	/* Peer close is reported to the other end */
+	epoll_add(new_sock, ZSOCK_EPOLLIN | ZSOCK_EPOLLET);
+
+	res = zsock_epoll_ctl(epfd, ZSOCK_EPOLL_CTL_DEL, c_sock, NULL);
+	zassert_equal(res, 0, "");
+
+	res = zsock_close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = zsock_epoll_wait(epfd, events, ARRAY_SIZE(events), 500);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, new_sock, "");
+	zassert_true(events[0].events & ZSOCK_EPOLLIN, "");
+
+	res = zsock_close(new_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(s_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(epfd);
+	zassert_equal(res, 0, "close failed");
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST_SUITE(net_socket_epoll, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+
+#include "../../socket_helpers.h"
+
+#define SERVER_PORT 4242
+#define CLIENT_PORT 9898
+#define MAX_IOV 16
+#define STREAM_SIZE 8192
+
+static ZTEST_BMEM uint8_t tx_buf[STREAM_SIZE];
+static ZTEST_BMEM uint8_t rx_buf[STREAM_SIZE];
+static ZTEST_BMEM uint8_t bounce[1500];
+static ZTEST_BMEM struct iovec iov[MAX_IOV];
+
+static void fill_pattern(uint8_t *buf, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = (uint8_t)(i * 7U + 1U);
+	}
+}
+
+static void loan_init(struct zsock_recv_loan *loan, size_t iovlen)
+{
+	memset(loan, 0, sizeof(*loan));
+	loan->iov = iov;
+	loan->iovlen = iovlen;
+	loan->buf = bounce;
+	loan->buf_len = sizeof(bounce);
+}
+
+/* Gather the lent segments and check that they cover exactly len bytes */
+static size_t loan_gather(struct zsock_recv_loan *loan, uint8_t *dst)
+{
+	size_t len = 0;
+
+	for (size_t i = 0; i < loan->iovlen; i++) {
+		memcpy(dst + len, loan->iov[i].iov_base, loan->iov[i].iov_len);
+		len += loan->iov[i].iov_len;
+	}
+
+	return len;
+}
+
+static void prepare_udp(int *client, int *server, struct sockaddr_in *server_addr)
+{
+	struct sockaddr_in client_addr;
+	int ret;
+
+	prepare_sock_udp_v4("127.0.0.1", CLIENT_PORT, client, &client_addr);
+	prepare_sock_udp_v4("127.0.0.1", SERVER_PORT, server, server_addr);
+
+	ret = zsock_bind(*server, (struct sockaddr *)server_addr, sizeof(*server_addr));
+	zassert_equal(ret, 0, "bind failed (%d)", errno);
+}
+
+static void prepare_tcp(int *client, int *server)
+{
+	struct sockaddr_in client_addr, server_addr;
+	int listener, ret;
+
+	prepare_sock_tcp_v4("127.0.0.1", CLIENT_PORT, client, &client_addr);
+	prepare_sock_tcp_v4("127.0.0.1", SERVER_PORT, &listener, &server_addr);
+
+	ret = zsock_bind(listener, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(ret, 0, "bind failed (%d)", errno);
+
+	ret = zsock_listen(listener, 1);
+	zassert_equal(ret, 0, "listen failed (%d)", errno);
+
+	ret = zsock_connect(*client, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(ret, 0, "connect failed (%d)", errno);
+
+	*server = zsock_accept(listener, NULL, NULL);
+	zassert_true(*server >= 0, "accept failed (%d)", errno);
+
+	zsock_close(listener);
+}
+
+ZTEST_USER(socket_recv_loan, test_udp)
+{
+	struct zsock_recv_loan loan;
+	struct sockaddr_in server_addr;
+	int client, server;
+	ssize_t ret;
+
+	prepare_udp(&client, &server, &server_addr);
+	fill_pattern(tx_buf, 1000);
+
+	ret = zsock_sendto(client, tx_buf, 1000, 0, (struct sockaddr *)&server_addr,
+			   sizeof(server_addr));
+	zassert_equal(ret, 1000, "sendto failed (%d)", errno);
+
+	loan_init(&loan, MAX_IOV);
+	ret = zsock_recv_loan(server, &loan, 0);
+	zassert_equal(ret, 1000, "recv_loan failed (%d)", errno);
+	zassert_true(loan.iovlen >= 1, "no segments lent");
+	zassert_equal(loan_gather(&loan, rx_buf), 1000, "segments do not add up");
+	zassert_mem_equal(rx_buf, tx_buf, 1000, "invalid data");
+	zassert_equal(loan.msg_flags, 0, "unexpected flags");
+
+	zsock_recv_loan_release(&loan);
+
+	/* Nothing queued anymore */
+	loan_init(&loan, MAX_IOV);
+	ret = zsock_recv_loan(server, &loan, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "recv_loan should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	zsock_close(client);
+	zsock_close(server);
+}
+
+ZTEST_USER(socket_recv_loan, test_udp_truncated)
+{
+	struct zsock_recv_loan loan;
+	struct sockaddr_in server_addr;
+	int client, server;
+	ssize_t ret;
+
+	prepare_udp(&client, &server, &server_addr);
+	fill_pattern(tx_buf, 1000);
+
+	ret = zsock_sendto(client, tx_buf, 1000, 0, (struct sockaddr *)&server_addr,
+			   sizeof(server_addr));
+	zassert_equal(ret, 1000, "sendto failed (%d)", errno);
+
+	/* A single segment is lent; the rest of the datagram is dropped if
+	 * it did not fit in the first network buffer.
+	 */
+	loan_init(&loan, 1);
+	ret = zsock_recv_loan(server, &loan, 0);
+	zassert_true(ret > 0 && ret <= 1000, "recv_loan failed (%d)", errno);
+	zassert_equal(loan.iovlen, 1, "unexpected number of segments");
+	zassert_mem_equal(loan.iov[0].iov_base, tx_buf, ret, "invalid data");
+	zassert_equal(loan.msg_flags, ret < 1000 ? ZSOCK_MSG_TRUNC : 0,
+		      "unexpected flags");
+
+	zsock_recv_loan_release(&loan);
+
+	zsock_close(client);
+	zsock_close(server);
+}
+
+ZTEST_USER(socket_recv_loan, test_invalid)
+{
+	struct zsock_recv_loan loan;
+	struct sockaddr_in server_addr;
+	int client, server;
+	ssize_t ret;
+
+	prepare_udp(&client, &server, &server_addr);
+
+	loan_init(&loan, MAX_IOV);
+	ret = zsock_recv_loan(server, &loan, ZSOCK_MSG_PEEK);
+	zassert_equal(ret, -1, "MSG_PEEK should be rejected");
+	zassert_equal(errno, EINVAL, "unexpected errno (%d)", errno);
+
+	loan_init(&loan, 0);
+	ret = zsock_recv_loan(server, &loan, 0);
+	zassert_equal(ret, -1, "empty iov should be rejected");
+	zassert_equal(errno, EINVAL, "unexpected errno (%d)", errno);
+
+	zsock_close(client);
+	zsock_close(server);
+}
+
+ZTEST_USER(socket_recv_loan, test_tcp_stream)
+{
+	struct zsock_recv_loan loan;
+	size_t received = 0;
+	size_t sent = 0;
+	int client, server;
+	ssize_t ret;
+
+	prepare_tcp(&client, &server);
+	fill_pattern(tx_buf, sizeof(tx_buf));
+
+	while (received < sizeof(rx_buf)) {
+		if (sent == received) {
+			ret = zsock_send(client, tx_buf + sent,
+					 MIN(1024, sizeof(tx_buf) - sent), 0);
+			zassert_true(ret > 0, "send failed (%d)", errno);
+			sent += ret;
+		}
+
+		loan_init(&loan, MAX_IOV);
+		ret = zsock_recv_loan(server, &loan, 0);
+		zassert_true(ret > 0, "recv_loan failed (%d)", errno);
+		zassert_true(received + ret <= sent, "too much data");
+		zassert_equal(loan_gather(&loan, rx_buf + received), ret,
+			      "segments do not add up");
+
+		zsock_recv_loan_release(&loan);
+		received += ret;
+	}
+
+	zassert_mem_equal(rx_buf, tx_buf, sizeof(tx_buf), "invalid data");
+
+	/* The peer closes the connection */
+	zsock_close(client);
+
+	loan_init(&loan, MAX_IOV);
+	ret = zsock_recv_loan(server, &loan, 0);
+	zassert_equal(ret, 0, "expected end of stream (%d)", errno);
+
+	zsock_close(server);
+
+	/* Let the connection go through the closing handshake */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY + 100));
+}
+
+ZTEST_USER(socket_recv_loan, test_tcp_partial)
+{
+	struct zsock_recv_loan loan;
+	size_t received = 0;
+	int client, server;
+	ssize_t ret;
+
+	prepare_tcp(&client, &server);
+	fill_pattern(tx_buf, 1000);
+
+	ret = zsock_send(client, tx_buf, 1000, 0);
+	zassert_equal(ret, 1000, "send failed (%d)", errno);
+
+	/* Lend one buffer at a time, the rest of the segment stays queued */
+	while (received < 1000) {
+		loan_init(&loan, 1);
+		ret = zsock_recv_loan(server, &loan, 0);
+		zassert_true(ret > 0, "recv_loan failed (%d)", errno);
+		zassert_equal(loan.iovlen, 1, "unexpected number of segments");
+		zassert_mem_equal(loan.iov[0].iov_base, tx_buf + received, ret,
+				  "invalid data at %zu", received);
+
+		zsock_recv_loan_release(&loan);
+		received += ret;
+	}
+
+	zassert_equal(received, 1000, "too much data");
+
+	zsock_close(client);
+	zsock_close(server);
+
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY + 100));
+}
+
+ZTEST_SUITE(socket_recv_loan, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Select the TCP congestion control algorithm per socket and compare the
+ * goodput of the available algorithms over a loopback link that delays
+ * every segment and drops a fixed share of them.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/loopback.h>
+
+#define SERVER_PORT 4242
+#define LINK_DELAY_MS 10
+#define LINK_DROP_RATIO 0.01f
+#define TRANSFER_SIZE (128 * 1024)
+#define CHUNK_SIZE 1024
+#define RECV_TIMEOUT_MS 20000
+
+#define SENDER_STACK_SIZE 2048
+#define SENDER_PRIORITY K_PRIO_PREEMPT(8)
+
+static K_THREAD_STACK_DEFINE(sender_stack, SENDER_STACK_SIZE);
+static struct k_thread sender_thread;
+
+static uint8_t tx_chunk[CHUNK_SIZE];
+static uint8_t rx_chunk[CHUNK_SIZE];
+static int sender_result;
+
+static void fill_chunk(uint8_t *buf, size_t offset, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = (uint8_t)((offset + i) * 7U);
+	}
+}
+
+static void open_connection(const char *algorithm, int *client, int *server)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	struct timeval tv = {
+		.tv_sec = RECV_TIMEOUT_MS / MSEC_PER_SEC,
+	};
+	int listener, ret;
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	listener = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(listener >= 0, "socket open failed");
+
+	ret = zsock_bind(listener, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(ret, 0, "bind failed (%d)", errno);
+
+	ret = zsock_listen(listener, 1);
+	zassert_equal(ret, 0, "listen failed (%d)", errno);
+
+	*client = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(*client >= 0, "socket open failed");
+
+	/* The congestion controller matters on the sending side only */
+	ret = zsock_setsockopt(*client, IPPROTO_TCP, TCP_CONGESTION, algorithm,
+			       strlen(algorithm));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	ret = zsock_connect(*client, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_equal(ret, 0, "connect failed (%d)", errno);
+
+	*server = zsock_accept(listener, NULL, NULL);
+	zassert_true(*server >= 0, "accept failed (%d)", errno);
+
+	ret = zsock_setsockopt(*server, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	zsock_close(listener);
+}
+
+static void sender(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	size_t offset = 0;
+	ssize_t ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (offset < TRANSFER_SIZE) {
+		size_t len = MIN(sizeof(tx_chunk), TRANSFER_SIZE - offset);
+
+		fill_chunk(tx_chunk, offset, len);
+
+		for (size_t sent = 0; sent < len; sent += ret) {
+			ret = zsock_send(sock, tx_chunk + sent, len - sent, 0);
+			if (ret < 0) {
+				sender_result = -errno;
+				return;
+			}
+		}
+
+		offset += len;
+	}
+
+	sender_result = 0;
+}
+
+static uint32_t run_transfer(const char *algorithm)
+{
+	uint8_t expected[CHUNK_SIZE];
+	size_t received = 0;
+	int client, server;
+	int64_t start;
+	uint32_t elapsed;
+	ssize_t ret;
+
+	open_connection(algorithm, &client, &server);
+
+	zassert_equal(loopback_set_packet_delay(LINK_DELAY_MS), 0,
+		      "Error setting packet delay");
+	zassert_equal(loopback_set_packet_drop_ratio(LINK_DROP_RATIO), 0,
+		      "Error setting packet drop rate");
+
+	sender_result = -EINPROGRESS;
+	start = k_uptime_get();
+
+	k_thread_create(&sender_thread, sender_stack,
+			K_THREAD_STACK_SIZEOF(sender_stack), sender,
+			INT_TO_POINTER(client), NULL, NULL,
+			SENDER_PRIORITY, 0, K_NO_WAIT);
+
+	while (received < TRANSFER_SIZE) {
+		ret = zsock_recv(server, rx_chunk, sizeof(rx_chunk), 0);
+		zassert_true(ret > 0, "recv failed after %zu bytes (%d)",
+			     received, errno);
+
+		fill_chunk(expected, received, ret);
+		zassert_mem_equal(rx_chunk, expected, ret,
+				  "corrupted data at offset %zu", received);
+
+		received += ret;
+	}
+
+	elapsed = (uint32_t)(k_uptime_get() - start);
+
+	zassert_equal(k_thread_join(&sender_thread, K_SECONDS(5)), 0,
+		      "sender did not finish");
+	zassert_equal(sender_result, 0, "send failed (%d)", sender_result);
+
+	loopback_set_packet_drop_ratio(0.0f);
+	loopback_set_packet_delay(0);
+
+	zsock_close(client);
+	zsock_close(server);
+
+	/* Let the connections go through the closing handshake */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY + 100));
+
+	return elapsed;
+}
+
+static void report(const char *algorithm, uint32_t elapsed)
+{
+	TC_PRINT("%-6s %u bytes in %u ms, goodput %u kbit/s\n", algorithm,
+		 TRANSFER_SIZE, elapsed,
+		 elapsed > 0U ? TRANSFER_SIZE * 8U / elapsed : 0U);
+}
+
+ZTEST(tcp_congestion, test_sockopt)
+{
+	char name[16];
+	socklen_t len;
+	int sock, ret;
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(sock >= 0, "socket open failed");
+
+	len = sizeof(name);
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &len);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(name, "reno"), 0, "unexpected default algorithm");
+	zassert_equal(len, sizeof("reno"), "unexpected length");
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+			       strlen("cubic"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	len = sizeof(name);
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &len);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(name, "cubic"), 0, "algorithm not changed");
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "vegas",
+			       strlen("vegas"));
+	zassert_equal(ret, -1, "unknown algorithm accepted");
+	zassert_equal(errno, ENOENT, "unexpected errno (%d)", errno);
+
+	/* A short buffer gets a truncated name */
+	len = 3;
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &len);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(name, "cu"), 0, "name not truncated");
+	zassert_equal(len, 3, "unexpected length");
+
+	zsock_close(sock);
+}
+
+ZTEST(tcp_congestion, test_goodput)
+{
+	uint32_t reno, cubic;
+
+	reno = run_transfer("reno");
+	report("reno", reno);
+
+	cubic = run_transfer("cubic");
+	report("cubic", cubic);
+}
+
+ZTEST_SUITE(tcp_congestion, NULL, NULL, NULL, NULL, NULL);
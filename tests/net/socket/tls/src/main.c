@@ -1811,6 +1811,91 @@ ZTEST(net_socket_tls, test_poll_dtls_pollerr)
 	k_msleep(10);
 }
 
+static void test_recv_pending(int sock, const char *expected)
+{
+	uint8_t rx_buf[32] = { 0 };
+	int ret;
+
+	/* Let the data go through. */
+	k_sleep(K_MSEC(10));
+
+	if (expected == NULL) {
+		ret = zsock_recv(sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+		zassert_equal(ret, -1, "recv() should've failed");
+		zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+		return;
+	}
+
+	ret = zsock_recv(sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, strlen(expected), "recv() failed");
+	zassert_mem_equal(rx_buf, expected, ret, "Invalid data received");
+}
+
+ZTEST(net_socket_tls, test_tcp_cork)
+{
+	socklen_t optlen = sizeof(int);
+	int optval = 1;
+	int ret;
+
+	test_prepare_tls_connection(AF_INET6);
+
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CORK, &optval,
+			       sizeof(optval));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	optval = 0;
+	ret = zsock_getsockopt(c_sock, IPPROTO_TCP, TCP_CORK, &optval, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optval, 1, "TCP_CORK not set");
+
+	test_send(c_sock, "te", 2, 0);
+	test_send(c_sock, "st", 2, 0);
+
+	/* Data is held back while the socket is corked. */
+	test_recv_pending(new_sock, NULL);
+
+	optval = 0;
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CORK, &optval,
+			       sizeof(optval));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	test_recv_pending(new_sock, TEST_STR_SMALL);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST(net_socket_tls, test_msg_more)
+{
+	struct iovec iov[] = {
+		{ .iov_base = "te", .iov_len = 2 },
+		{ .iov_base = NULL, .iov_len = 0 },
+		{ .iov_base = "st", .iov_len = 2 },
+	};
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+
+	test_prepare_tls_connection(AF_INET6);
+
+	test_send(c_sock, "te", 2, ZSOCK_MSG_MORE);
+	test_recv_pending(new_sock, NULL);
+
+	/* A write without the flag sends the coalesced data. */
+	test_send(c_sock, "st", 2, 0);
+	test_recv_pending(new_sock, TEST_STR_SMALL);
+
+	/* Buffers of a gather write are sent together. */
+	test_sendmsg(c_sock, &msg, 0);
+	test_recv_pending(new_sock, TEST_STR_SMALL);
+
+	test_sockets_close();
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 static void *tls_tests_setup(void)
 {
 	k_work_queue_init(&tls_test_work_queue);
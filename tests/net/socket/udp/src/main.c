@@ -2408,6 +2408,99 @@ ZTEST_USER(net_socket_udp, test_35_recvmsg_msg_controllen_update)
 	zassert_equal(rv, 0, "close failed");
 }
 
+#define MMSG_COUNT 4
+
+ZTEST_USER(net_socket_udp, test_36_v4_sendmmsg_recvmmsg)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr[MMSG_COUNT];
+	struct zsock_mmsghdr tx_msgs[MMSG_COUNT];
+	struct zsock_mmsghdr rx_msgs[MMSG_COUNT * 2];
+	struct iovec tx_io[MMSG_COUNT];
+	struct iovec rx_io[MMSG_COUNT * 2];
+	char rx_bufs[MMSG_COUNT * 2][sizeof(TEST_STR_SMALL)];
+	int i;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock,
+			(struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_bind(client_sock,
+			(struct sockaddr *)&client_addr,
+			sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	memset(tx_msgs, 0, sizeof(tx_msgs));
+	memset(rx_msgs, 0, sizeof(rx_msgs));
+
+	/* Send datagrams of different lengths so that they can be told
+	 * apart on the receiving side.
+	 */
+	for (i = 0; i < MMSG_COUNT; i++) {
+		tx_io[i].iov_base = TEST_STR_SMALL;
+		tx_io[i].iov_len = i + 1;
+		tx_msgs[i].msg_hdr.msg_iov = &tx_io[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+		tx_msgs[i].msg_hdr.msg_name = &server_addr;
+		tx_msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(rx_msgs); i++) {
+		rx_io[i].iov_base = rx_bufs[i];
+		rx_io[i].iov_len = sizeof(rx_bufs[i]);
+		rx_msgs[i].msg_hdr.msg_iov = &rx_io[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+
+		if (i < MMSG_COUNT) {
+			rx_msgs[i].msg_hdr.msg_name = &addr[i];
+			rx_msgs[i].msg_hdr.msg_namelen = sizeof(addr[i]);
+		}
+	}
+
+	rv = zsock_sendmmsg(client_sock, tx_msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", rv);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(tx_msgs[i].msg_len, i + 1, "invalid msg_len");
+	}
+
+	/* Give the stack time to deliver all the datagrams */
+	k_msleep(100);
+
+	rv = zsock_recvmmsg(server_sock, rx_msgs, ARRAY_SIZE(rx_msgs),
+			    ZSOCK_MSG_WAITFORONE, NULL);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", rv);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(rx_msgs[i].msg_len, i + 1, "invalid msg_len");
+		zassert_mem_equal(rx_bufs[i], TEST_STR_SMALL, i + 1,
+				  "wrong data");
+		zassert_equal(rx_msgs[i].msg_hdr.msg_namelen, sizeof(addr[i]),
+			      "invalid address length");
+		zassert_equal(addr[i].sin_family, AF_INET,
+			      "invalid address family");
+	}
+
+	/* Nothing queued anymore */
+	rv = zsock_recvmmsg(server_sock, rx_msgs, ARRAY_SIZE(rx_msgs),
+			    ZSOCK_MSG_DONTWAIT, NULL);
+	zassert_equal(rv, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
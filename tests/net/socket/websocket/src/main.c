@@ -398,6 +398,43 @@ ZTEST(net_websocket, test_send_and_recv_lorem_ipsum)
 	z_free_fd(fd);
 }
 
+ZTEST(net_websocket, test_send_and_recv_lorem_ipsum_iov)
+{
+	static struct websocket_context ctx;
+	struct iovec iov[3];
+	int fd, ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+
+	ctx.recv_buf.buf = temp_recv_buf;
+	ctx.recv_buf.size = sizeof(temp_recv_buf);
+
+	test_msg_len = sizeof(lorem_ipsum) - 1;
+
+	/* Odd lengths so that the masking key does not restart on a buffer */
+	iov[0].iov_base = (void *)lorem_ipsum;
+	iov[0].iov_len = 7;
+	iov[1].iov_base = (void *)(lorem_ipsum + 7);
+	iov[1].iov_len = 121;
+	iov[2].iov_base = (void *)(lorem_ipsum + 128);
+	iov[2].iov_len = test_msg_len - 128;
+
+	fd = test_fd_alloc(&ctx);
+	ret = websocket_send_msgv(fd, iov, ARRAY_SIZE(iov),
+				  WEBSOCKET_OPCODE_DATA_TEXT, true, true,
+				  SYS_FOREVER_MS);
+	zassert_equal(ret, test_msg_len,
+		      "Should have sent %zd bytes but sent %d instead",
+		      test_msg_len, ret);
+
+	ret = websocket_send_msgv(fd, iov, CONFIG_WEBSOCKET_SEND_IOV_MAX + 1,
+				  WEBSOCKET_OPCODE_DATA_TEXT, true, true,
+				  SYS_FOREVER_MS);
+	zassert_equal(ret, -EINVAL, "Too many buffers accepted");
+
+	z_free_fd(fd);
+}
+
 ZTEST(net_websocket, test_recv_two_large_split_msg)
 {
 	static struct websocket_context ctx;
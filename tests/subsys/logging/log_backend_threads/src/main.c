@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Log a storm of messages to a fast backend and to a slow backend which
+ * takes SLOW_PROCESS_MS to output each message, and report how many
+ * messages each backend processed and how many were dropped. With
+ * CONFIG_LOG_BACKEND_THREADS the slow backend is processed in its own thread
+ * and the fast backend must get every message.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/ztest.h>
+
+#define STORM_LOGS 500
+#define STORM_PERIOD_US 200
+#define SLOW_PROCESS_MS 2
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+struct mock_backend {
+	const char *name;
+	int32_t process_ms;
+	atomic_t handled;
+	atomic_t dropped;
+};
+
+static struct mock_backend fast = {
+	.name = "fast",
+};
+
+static struct mock_backend slow = {
+	.name = "slow",
+	.process_ms = SLOW_PROCESS_MS,
+};
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	struct mock_backend *mock = backend->cb->ctx;
+
+	if (mock->process_ms) {
+		k_msleep(mock->process_ms);
+	}
+
+	atomic_inc(&mock->handled);
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	struct mock_backend *mock = backend->cb->ctx;
+
+	atomic_add(&mock->dropped, cnt);
+}
+
+static void panic(const struct log_backend *const backend)
+{
+}
+
+static const struct log_backend_api mock_api = {
+	.process = process,
+	.dropped = dropped,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(fast_backend, mock_api, true, &fast);
+LOG_BACKEND_DEFINE(slow_backend, mock_api, true, &slow);
+LOG_BACKEND_THREAD_DEFINE(slow_backend, 2048);
+
+static void wait_idle(void)
+{
+	uint32_t total;
+
+	/* Wait until the slow backend stops making progress. */
+	do {
+		total = atomic_get(&slow.handled) + atomic_get(&slow.dropped);
+		k_msleep(10 * SLOW_PROCESS_MS);
+	} while (log_data_pending() ||
+		 total != atomic_get(&slow.handled) + atomic_get(&slow.dropped));
+}
+
+static void report(struct mock_backend *mock)
+{
+	TC_PRINT("%-4s backend: %u messages processed, %u dropped\n", mock->name,
+		 (uint32_t)atomic_get(&mock->handled),
+		 (uint32_t)atomic_get(&mock->dropped));
+}
+
+ZTEST(log_backend_threads, test_storm)
+{
+	/* Let the backends get activated by the log processing thread. */
+	k_msleep(100);
+	zassert_true(log_backend_is_active(&fast_backend));
+	zassert_true(log_backend_is_active(&slow_backend));
+
+	for (int i = 0; i < STORM_LOGS; i++) {
+		LOG_INF("storm %d", i);
+		k_usleep(STORM_PERIOD_US);
+	}
+
+	wait_idle();
+
+	/* Drops are reported to the backends with the next message. */
+	LOG_INF("storm done");
+	wait_idle();
+
+	TC_PRINT("%d messages, one every %d us, slow backend takes %d ms per message\n",
+		 STORM_LOGS + 1, STORM_PERIOD_US, SLOW_PROCESS_MS);
+	report(&fast);
+	report(&slow);
+
+	zassert_equal(atomic_get(&fast.handled) + atomic_get(&fast.dropped),
+		      STORM_LOGS + 1, "fast backend messages not accounted for");
+	zassert_equal(atomic_get(&slow.handled) + atomic_get(&slow.dropped),
+		      STORM_LOGS + 1, "slow backend messages not accounted for");
+
+	if (IS_ENABLED(CONFIG_LOG_BACKEND_THREADS)) {
+		zassert_equal(atomic_get(&fast.dropped), 0,
+			      "fast backend held back by the slow one");
+	}
+}
+
+ZTEST_SUITE(log_backend_threads, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/ztest.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+void noisy_err(int i);
+void noisy_inf(int i);
+
+static uint32_t processed[LOG_LEVEL_DBG + 1];
+static uint32_t test_processed;
+static uint32_t dropped_cnt;
+static int16_t noisy_id;
+static int16_t test_id;
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	const void *source = log_msg_get_source(&msg->log);
+
+	if (log_dynamic_source_id((struct log_source_dynamic_data *)source) == noisy_id) {
+		processed[log_msg_get_level(&msg->log)]++;
+	} else {
+		test_processed++;
+	}
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	dropped_cnt += cnt;
+}
+
+static void panic(const struct log_backend *const backend)
+{
+}
+
+static const struct log_backend_api mock_api = {
+	.process = process,
+	.dropped = dropped,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(mock_backend, mock_api, true);
+
+static void flush(void)
+{
+	while (log_process()) {
+	}
+}
+
+static uint32_t suppressed(uint32_t level)
+{
+	struct log_rate_limit limit;
+
+	for (uint32_t i = 0; log_rate_limit_get(i, &limit) == 0; i++) {
+		if ((limit.source_id == noisy_id) && (limit.level == level)) {
+			return limit.suppressed;
+		}
+	}
+
+	return 0;
+}
+
+ZTEST(log_rate_limit, test_sample)
+{
+	zassert_ok(log_rate_limit_set(noisy_id, LOG_LEVEL_NONE, 0, 0, 4));
+
+	for (int i = 0; i < 100; i++) {
+		noisy_err(i);
+		flush();
+	}
+
+	zassert_equal(processed[LOG_LEVEL_ERR], 25);
+	zassert_equal(suppressed(LOG_LEVEL_NONE), 75);
+}
+
+ZTEST(log_rate_limit, test_token_bucket)
+{
+	zassert_ok(log_rate_limit_set(noisy_id, LOG_LEVEL_ERR, 10, 5, 0));
+
+	for (int i = 0; i < 100; i++) {
+		noisy_err(i);
+		flush();
+	}
+
+	zassert_equal(processed[LOG_LEVEL_ERR], 5, "burst not limited");
+
+	/* Bucket is refilled with one token every 100 ms. */
+	k_msleep(250);
+
+	for (int i = 0; i < 100; i++) {
+		noisy_err(i);
+		flush();
+	}
+
+	zassert_equal(processed[LOG_LEVEL_ERR], 7, "rate not limited");
+	zassert_equal(suppressed(LOG_LEVEL_ERR), 193);
+}
+
+ZTEST(log_rate_limit, test_level)
+{
+	zassert_ok(log_rate_limit_set(noisy_id, LOG_LEVEL_NONE, 0, 0, 10));
+	zassert_ok(log_rate_limit_set(noisy_id, LOG_LEVEL_ERR, 1, 1, 0));
+
+	for (int i = 0; i < 20; i++) {
+		noisy_err(i);
+		noisy_inf(i);
+		flush();
+	}
+
+	/* Level rule takes precedence over the rule for all levels. */
+	zassert_equal(processed[LOG_LEVEL_ERR], 1);
+	zassert_equal(processed[LOG_LEVEL_INF], 2);
+}
+
+ZTEST(log_rate_limit, test_clear)
+{
+	zassert_ok(log_rate_limit_set(noisy_id, LOG_LEVEL_NONE, 1, 1, 0));
+	noisy_err(0);
+	noisy_err(1);
+	flush();
+	zassert_equal(processed[LOG_LEVEL_ERR], 1);
+
+	zassert_ok(log_rate_limit_set(noisy_id, LOG_LEVEL_NONE, 0, 0, 0));
+	zassert_equal(log_rate_limit_get(0, &(struct log_rate_limit){}), -ENOENT);
+
+	noisy_err(2);
+	noisy_err(3);
+	flush();
+	zassert_equal(processed[LOG_LEVEL_ERR], 3);
+}
+
+ZTEST(log_rate_limit, test_invalid)
+{
+	zassert_equal(log_rate_limit_set(-1, LOG_LEVEL_ERR, 1, 1, 0), -EINVAL);
+	zassert_equal(log_rate_limit_set(noisy_id, LOG_LEVEL_DBG + 1, 1, 1, 0), -EINVAL);
+	zassert_equal(log_rate_limit_set(noisy_id, LOG_LEVEL_ERR, UINT16_MAX + 1, 1, 0),
+		      -EINVAL);
+
+	BUILD_ASSERT(CONFIG_LOG_RATE_LIMIT_RULES < 2 * (LOG_LEVEL_DBG + 1));
+
+	/* Use one rule for each level of the two modules. */
+	for (int i = 0; i <= CONFIG_LOG_RATE_LIMIT_RULES; i++) {
+		int16_t id = (i > LOG_LEVEL_DBG) ? test_id : noisy_id;
+		int ret = log_rate_limit_set(id, i % (LOG_LEVEL_DBG + 1), 1, 1, 0);
+
+		zassert_equal(ret, (i < CONFIG_LOG_RATE_LIMIT_RULES) ? 0 : -ENOMEM);
+	}
+}
+
+/* An error storm from one module fills the log buffer and drops the messages
+ * of the other modules, unless the module is rate limited.
+ */
+ZTEST(log_rate_limit, test_storm)
+{
+	for (int limit = 0; limit < 2; limit++) {
+		if (limit) {
+			zassert_ok(log_rate_limit_set(noisy_id, LOG_LEVEL_ERR, 100, 10, 0));
+		}
+
+		test_processed = 0;
+		dropped_cnt = 0;
+
+		for (int i = 0; i < 1000; i++) {
+			noisy_err(i);
+			if ((i % 100) == 0) {
+				LOG_INF("still running %d", i);
+			}
+		}
+
+		flush();
+
+		TC_PRINT("%s: %u storm messages processed, %u suppressed, %u dropped, "
+			 "%u/10 other messages processed\n",
+			 limit ? "rate limited" : "not limited",
+			 processed[LOG_LEVEL_ERR], suppressed(LOG_LEVEL_ERR), dropped_cnt,
+			 test_processed);
+		processed[LOG_LEVEL_ERR] = 0;
+	}
+
+	zassert_equal(test_processed, 10, "messages dropped while rate limited");
+	zassert_equal(dropped_cnt, 0);
+}
+
+static void before(void *fixture)
+{
+	struct log_rate_limit limit;
+
+	/* Remove all rules. */
+	while (log_rate_limit_get(0, &limit) == 0) {
+		zassert_ok(log_rate_limit_set(limit.source_id, limit.level, 0, 0, 0));
+	}
+
+	flush();
+	memset(processed, 0, sizeof(processed));
+}
+
+static void *setup(void)
+{
+	noisy_id = log_source_id_get("noisy");
+	zassert_true(noisy_id >= 0);
+	test_id = log_source_id_get("test");
+	zassert_true(test_id >= 0);
+
+	return NULL;
+}
+
+ZTEST_SUITE(log_rate_limit, NULL, setup, before, NULL, NULL);
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(noisy, LOG_LEVEL_DBG);
+
+void noisy_err(int i)
+{
+	LOG_ERR("link down %d", i);
+}
+
+void noisy_inf(int i)
+{
+	LOG_INF("link state %d", i);
+}
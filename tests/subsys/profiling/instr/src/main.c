@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/profiling/instr.h>
+#include <zephyr/ztest.h>
+
+#define INNER_US 100
+#define OUTER_US 50
+
+struct trace_check {
+	const struct k_thread *thread;
+	uint32_t count;
+	uint32_t entry[2];
+	uint32_t inner_cycles;
+	int depth;
+	int max_depth;
+};
+
+static __attribute__((noinline)) void inner(void)
+{
+	k_busy_wait(INNER_US);
+}
+
+static __attribute__((noinline)) void outer(void)
+{
+	inner();
+	k_busy_wait(OUTER_US);
+	inner();
+}
+
+static __attribute__((noinline)) void empty(void)
+{
+	__asm__ volatile ("" ::: "memory");
+}
+
+static void event_check(const struct instr_event *event, void *user_data)
+{
+	struct trace_check *check = user_data;
+	int depth = check->depth;
+
+	check->count++;
+
+	if ((event->thread != check->thread) ||
+	    ((event->func != (uintptr_t)outer) && (event->func != (uintptr_t)inner))) {
+		return;
+	}
+
+	if (event->type == INSTR_EVENT_ENTRY) {
+		zassert_true(depth < ARRAY_SIZE(check->entry), "unexpected entry");
+		zassert_equal(event->func, depth == 0 ? (uintptr_t)outer : (uintptr_t)inner);
+		check->entry[depth] = event->timestamp;
+		check->depth++;
+		check->max_depth = MAX(check->max_depth, check->depth);
+	} else {
+		zassert_true(depth > 0, "exit without entry");
+		zassert_equal(event->func, depth == 1 ? (uintptr_t)outer : (uintptr_t)inner);
+		if (depth == 2) {
+			check->inner_cycles += event->timestamp - check->entry[1];
+		}
+		check->depth--;
+	}
+}
+
+ZTEST(instr, test_trace)
+{
+	struct trace_check check = {
+		.thread = k_current_get(),
+	};
+	int count;
+
+	zassert_ok(instr_start());
+	outer();
+	zassert_ok(instr_stop());
+
+	count = instr_events_foreach(event_check, &check);
+	TC_PRINT("%d events, %u cycles in inner()\n", count, check.inner_cycles);
+
+	zassert_equal(count, check.count);
+	zassert_equal(instr_lost_get(), 0);
+	zassert_equal(check.max_depth, 2, "calls not recorded");
+	zassert_equal(check.depth, 0, "exits not recorded");
+	zassert_true(check.inner_cycles >= k_us_to_cyc_floor32(2 * INNER_US),
+		     "inner() time not recorded");
+}
+
+static void event_count(const struct instr_event *event, void *user_data)
+{
+	uint32_t *count = user_data;
+
+	(*count)++;
+}
+
+ZTEST(instr, test_full)
+{
+	uint32_t count = 0;
+
+	/* Each call records an entry and an exit. */
+	zassert_ok(instr_start());
+	for (int i = 0; i < CONFIG_PROFILING_INSTR_BUFFER_SIZE; i++) {
+		empty();
+	}
+	zassert_ok(instr_stop());
+
+	zassert_equal(instr_events_foreach(event_count, &count),
+		      CONFIG_PROFILING_INSTR_BUFFER_SIZE);
+	zassert_equal(count, CONFIG_PROFILING_INSTR_BUFFER_SIZE);
+	zassert_true(instr_lost_get() >= CONFIG_PROFILING_INSTR_BUFFER_SIZE);
+}
+
+static void empty_count(const struct instr_event *event, void *user_data)
+{
+	uint32_t *count = user_data;
+
+	if (event->func == (uintptr_t)empty) {
+		(*count)++;
+	}
+}
+
+ZTEST(instr, test_control)
+{
+	uint32_t count = 0;
+
+	zassert_equal(instr_stop(), -EALREADY);
+
+	zassert_ok(instr_start());
+	zassert_equal(instr_start(), -EALREADY);
+	zassert_equal(instr_events_foreach(event_count, &count), -EBUSY);
+	zassert_ok(instr_stop());
+	zassert_equal(instr_stop(), -EALREADY);
+}
+
+ZTEST(instr, test_restart)
+{
+	uint32_t count = 0;
+
+	zassert_ok(instr_start());
+	empty();
+	zassert_ok(instr_stop());
+
+	zassert_true(instr_events_foreach(empty_count, &count) >= 2);
+	zassert_equal(count, 2, "empty() not recorded");
+
+	/* The events of the previous capture are discarded. */
+	count = 0;
+	zassert_ok(instr_start());
+	zassert_ok(instr_stop());
+
+	zassert_true(instr_events_foreach(empty_count, &count) >= 0);
+	zassert_equal(count, 0, "previous events kept");
+}
+
+ZTEST_SUITE(instr, NULL, NULL, NULL, NULL, NULL);
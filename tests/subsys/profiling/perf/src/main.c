@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/profiling/perf.h>
+#include <zephyr/ztest.h>
+
+#define SAMPLE_FREQUENCY 100
+#define BUSY_MS 500
+
+/* Bound on the size of busy_func(), to tell whether an address is in it. */
+#define BUSY_FUNC_MAX_SIZE 256
+
+struct sample_stats {
+	uint32_t count;
+	uint32_t in_busy_func;
+	size_t max_len;
+};
+
+static __attribute__((noinline)) void busy_func(void)
+{
+	int64_t end = k_uptime_get() + BUSY_MS;
+
+	while (k_uptime_get() < end) {
+		k_busy_wait(100);
+	}
+}
+
+static void sample_check(const struct perf_sample *sample, void *user_data)
+{
+	struct sample_stats *stats = user_data;
+
+	zassert_equal(sample->cpu, 0);
+	zassert_true((sample->len > 0) &&
+		     (sample->len <= CONFIG_PROFILING_PERF_STACK_DEPTH));
+
+	stats->count++;
+	stats->max_len = MAX(stats->max_len, sample->len);
+
+	if (sample->thread != k_current_get()) {
+		return;
+	}
+
+	for (size_t i = 0; i < sample->len; i++) {
+		if ((sample->trace[i] > (uintptr_t)busy_func) &&
+		    (sample->trace[i] < (uintptr_t)busy_func + BUSY_FUNC_MAX_SIZE)) {
+			stats->in_busy_func++;
+			break;
+		}
+	}
+}
+
+ZTEST(perf, test_sample)
+{
+	struct sample_stats stats = {0};
+	int count;
+
+	zassert_ok(perf_start(SAMPLE_FREQUENCY));
+	busy_func();
+	zassert_ok(perf_stop());
+
+	count = perf_samples_foreach(sample_check, &stats);
+	TC_PRINT("%d samples, %u in busy_func(), %u lost, up to %zu entries\n",
+		 count, stats.in_busy_func, perf_lost_get(), stats.max_len);
+
+	zassert_equal(count, stats.count);
+	zassert_true(count > BUSY_MS * SAMPLE_FREQUENCY / MSEC_PER_SEC / 2,
+		     "too few samples");
+
+	/* Cortex-M only records the program counter. */
+	if ((CONFIG_PROFILING_PERF_STACK_DEPTH > 1) && !IS_ENABLED(CONFIG_CPU_CORTEX_M)) {
+		/* The code interrupted is mostly the busy wait called from
+		 * busy_func().
+		 */
+		zassert_true(stats.in_busy_func > count / 2,
+			     "samples not attributed to busy_func()");
+		zassert_true(stats.max_len > 1, "no backtrace");
+	}
+}
+
+static void sample_count(const struct perf_sample *sample, void *user_data)
+{
+	uint32_t *count = user_data;
+
+	(*count)++;
+}
+
+ZTEST(perf, test_control)
+{
+	uint32_t count = 0;
+
+	zassert_equal(perf_start(0), -EINVAL);
+	zassert_equal(perf_start(USEC_PER_SEC + 1), -EINVAL);
+	zassert_equal(perf_stop(), -EALREADY);
+
+	zassert_ok(perf_start(SAMPLE_FREQUENCY));
+	zassert_equal(perf_start(SAMPLE_FREQUENCY), -EALREADY);
+	zassert_equal(perf_samples_foreach(sample_count, &count), -EBUSY);
+	zassert_ok(perf_stop());
+
+	k_msleep(10);
+	zassert_equal(perf_samples_foreach(sample_count, &count), 0,
+		      "samples taken while idle");
+	zassert_equal(count, 0);
+}
+
+ZTEST_SUITE(perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/ztest.h>
+
+STATS_SECT_START(test_stats32)
+STATS_SECT_ENTRY32(a)
+STATS_SECT_ENTRY32(b)
+STATS_SECT_ENTRY32(c)
+STATS_SECT_ENTRY32(d)
+STATS_SECT_END;
+
+STATS_NAME_START(test_stats32)
+STATS_NAME(test_stats32, a)
+STATS_NAME(test_stats32, b)
+STATS_NAME(test_stats32, c)
+STATS_NAME(test_stats32, d)
+STATS_NAME_END(test_stats32);
+
+STATS_SECT_START(test_stats16)
+STATS_SECT_ENTRY16(x)
+STATS_SECT_END;
+
+STATS_NAME_START(test_stats16)
+STATS_NAME(test_stats16, x)
+STATS_NAME_END(test_stats16);
+
+static STATS_SECT_DECL(test_stats32) test_stats32;
+static STATS_SECT_DECL(test_stats16) test_stats16;
+
+struct walk_result {
+	const char *names[4];
+	uint64_t values[4];
+	int count;
+};
+
+static int walk_cb(struct stats_hdr *hdr, void *arg, const char *name, uint16_t off)
+{
+	struct walk_result *result = arg;
+
+	zassert_true(result->count < ARRAY_SIZE(result->values));
+	result->names[result->count] = name;
+	result->values[result->count] = stats_value_get(hdr, off);
+	result->count++;
+
+	return 0;
+}
+
+static void *stats_setup(void)
+{
+	zassert_ok(STATS_INIT_AND_REG(test_stats32, STATS_SIZE_32, "test32"));
+	zassert_ok(STATS_INIT_AND_REG(test_stats16, STATS_SIZE_16, "test16"));
+
+	return NULL;
+}
+
+static void stats_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	stats_reset(&test_stats32.s_hdr);
+	stats_reset(&test_stats16.s_hdr);
+}
+
+ZTEST(stats, test_update)
+{
+	STATS_INC(test_stats32, a);
+	STATS_INCN(test_stats32, b, 5);
+	STATS_SET(test_stats32, c, 7);
+
+	zassert_equal(STATS_GET(test_stats32, a), 1);
+	zassert_equal(STATS_GET(test_stats32, b), 5);
+	zassert_equal(STATS_GET(test_stats32, c), 7);
+
+	STATS_CLEAR(test_stats32, b);
+	zassert_equal(STATS_GET(test_stats32, b), 0);
+}
+
+ZTEST(stats, test_walk)
+{
+	struct walk_result result = {0};
+
+	STATS_INC(test_stats32, a);
+	STATS_INCN(test_stats32, c, 3);
+
+	zassert_ok(stats_walk(stats_group_find("test32"), walk_cb, &result));
+	zassert_equal(result.count, 4);
+	zassert_ok(strcmp(result.names[0], "a"));
+	zassert_ok(strcmp(result.names[2], "c"));
+	zassert_equal(result.values[0], 1);
+	zassert_equal(result.values[1], 0);
+	zassert_equal(result.values[2], 3);
+}
+
+ZTEST(stats, test_reset)
+{
+	STATS_INC(test_stats32, a);
+	STATS_INC(test_stats16, x);
+
+	stats_reset(&test_stats32.s_hdr);
+
+	zassert_equal(STATS_GET(test_stats32, a), 0);
+	zassert_equal(STATS_GET(test_stats16, x), 1);
+}
+
+ZTEST(stats, test_per_cpu)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_STATS_PER_CPU);
+
+#ifdef CONFIG_STATS_PER_CPU
+	unsigned int cpu = CONFIG_MP_MAX_NUM_CPUS - 1;
+	struct walk_result result = {0};
+
+	zassert_equal((uintptr_t)&test_stats32.s_cpu[0] % CONFIG_STATS_PER_CPU_ALIGNMENT, 0);
+
+	/* The readers sum the copies of all the CPUs. */
+	STATS_INCN(test_stats32, a, 2);
+	Z_STATS_ENTRY(test_stats32, cpu, a) += 3;
+
+	zassert_equal(STATS_GET(test_stats32, a), 5);
+	zassert_ok(stats_walk(stats_group_find("test32"), walk_cb, &result));
+	zassert_equal(result.values[0], 5);
+
+	/* The sum wraps around like a single entry would. */
+	STATS_INCN(test_stats16, x, UINT16_MAX);
+	Z_STATS_ENTRY(test_stats16, cpu, x) += 2;
+
+	zassert_equal(STATS_GET(test_stats16, x), 1);
+	result.count = 0;
+	zassert_ok(stats_walk(stats_group_find("test16"), walk_cb, &result));
+	zassert_equal(result.values[0], 1);
+
+	STATS_SET(test_stats32, a, 9);
+	zassert_equal(STATS_GET(test_stats32, a), 9);
+
+	stats_reset(&test_stats32.s_hdr);
+	zassert_equal(Z_STATS_ENTRY(test_stats32, cpu, a), 0);
+	zassert_equal(STATS_GET(test_stats32, a), 0);
+#endif
+}
+
+ZTEST_SUITE(stats, NULL, stats_setup, stats_before, NULL, NULL);
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 Zephyr Project
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/tracing/tracing_format.h>
+#include <zephyr/ztest.h>
+
+#define PACKET_MAGIC 0x54524143
+#define PACKET_HDR_SIZE 5
+
+struct test_packet {
+	uint32_t magic;
+	uint32_t seq;
+} __packed;
+
+extern uint8_t ram_tracing[CONFIG_RAM_TRACING_BUFFER_SIZE];
+
+/* Position of the next packet expected from the RAM backend. */
+static uint32_t ram_pos;
+
+static void trace_packets(uint32_t first, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++) {
+		struct test_packet packet = {
+			.magic = PACKET_MAGIC,
+			.seq = first + i,
+		};
+
+		tracing_format_raw_data((uint8_t *)&packet, sizeof(packet));
+	}
+}
+
+/* Count the packets output since the last call, checking that they are
+ * consecutive starting from first.
+ */
+static uint32_t check_output(uint32_t first)
+{
+	struct test_packet packet;
+	uint32_t count = 0;
+
+	while (ram_pos + sizeof(packet) <= sizeof(ram_tracing)) {
+		memcpy(&packet, &ram_tracing[ram_pos], sizeof(packet));
+		if (packet.magic == 0U) {
+			break;
+		}
+
+		zassert_equal(packet.magic, PACKET_MAGIC, "corrupted packet");
+		zassert_equal(packet.seq, first + count, "packet out of order");
+
+		ram_pos += sizeof(packet);
+		count++;
+	}
+
+	return count;
+}
+
+ZTEST(tracing_cpu_buffers, test_output)
+{
+	Z_TEST_SKIP_IFDEF(CONFIG_TRACING_FLIGHT_RECORDER);
+
+	trace_packets(0, 32);
+	k_msleep(10);
+
+	zassert_equal(check_output(0), 32, "packets not output");
+}
+
+ZTEST(tracing_cpu_buffers, test_full)
+{
+	const uint32_t max_count = CONFIG_TRACING_PER_CPU_BUFFER_SIZE /
+				   (PACKET_HDR_SIZE + sizeof(struct test_packet));
+	uint32_t count;
+
+	Z_TEST_SKIP_IFDEF(CONFIG_TRACING_FLIGHT_RECORDER);
+
+	/* The tracing thread cannot run until the test thread sleeps, so the
+	 * buffer fills up and the newest packets are dropped.
+	 */
+	trace_packets(0, 2 * max_count);
+	k_msleep(10);
+
+	count = check_output(0);
+	zassert_true((count > max_count / 2) && (count <= max_count),
+		     "unexpected number of packets output: %u", count);
+}
+
+#ifdef CONFIG_TRACING_FLIGHT_RECORDER
+ZTEST(tracing_cpu_buffers, test_flight_recorder)
+{
+	const uint32_t max_count = CONFIG_TRACING_PER_CPU_BUFFER_SIZE /
+				   (PACKET_HDR_SIZE + sizeof(struct test_packet));
+	int count;
+
+	trace_packets(0, 3 * max_count);
+	k_msleep(10);
+	zassert_equal(check_output(0), 0, "packets output before dump");
+
+	/* The oldest packets are overwritten. */
+	count = tracing_flight_recorder_dump();
+	zassert_true((count > max_count / 2) && (count <= max_count),
+		     "unexpected number of packets dumped: %d", count);
+	zassert_equal(check_output(3 * max_count - count), count,
+		      "packets not dumped");
+
+	zassert_equal(tracing_flight_recorder_dump(), 0, "recorder not emptied");
+
+	trace_packets(0, 4);
+	zassert_equal(tracing_flight_recorder_dump(), 4, "recorder not resumed");
+	zassert_equal(check_output(0), 4, "packets not dumped");
+}
+#endif
+
+ZTEST_SUITE(tracing_cpu_buffers, NULL, NULL, NULL, NULL, NULL);